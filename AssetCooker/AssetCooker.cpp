@@ -0,0 +1,149 @@
+#include "AssetCooker.h"
+
+#include "Threading/TaskGraph.h"
+#include "Utility/FileHelper.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cwctype>
+
+AssetCooker::AssetCooker(const Settings &settings)
+    : settings(settings) {}
+
+UINT AssetCooker::cook() {
+    findSources(settings.directory);
+    wprintf(L"Found %u meshes and %u textures in %ls\n", static_cast<UINT>(meshPaths.size()),
+            static_cast<UINT>(texturePaths.size()), settings.directory.c_str());
+
+    // Every mesh is a single node and every texture is a chain of stages. They're all independent, so e.g. a texture
+    // can be written to disk while others are decoded and meshes are processed
+    std::vector<MeshCooking> meshes{};
+    std::vector<TextureCooking> textures{};
+    meshes.reserve(meshPaths.size());
+    textures.reserve(texturePaths.size());
+    TaskGraph graph{backgroundWorkerController};
+    for (const std::wstring &meshPath : meshPaths) {
+        meshes.push_back(MeshCooking{meshPath});
+        MeshCooking &mesh = meshes.back();
+        graph.addNode([this, &mesh]() { cookMesh(mesh); });
+    }
+    for (const std::wstring &texturePath : texturePaths) {
+        textures.push_back(TextureCooking{texturePath, getTextureType(texturePath)});
+        TextureCooking &texture = textures.back();
+        const auto decodeStage = graph.addNode([&texture]() { decodeTexture(texture); });
+        const auto compressStage = graph.addNode([&texture]() { compressTexture(texture); });
+        const auto writeStage = graph.addNode([&texture]() { writeTexture(texture); });
+        graph.addDependency(decodeStage, compressStage);
+        graph.addDependency(compressStage, writeStage);
+    }
+    graph.runAndWait();
+
+    UINT failuresCount = 0u;
+    for (const MeshCooking &mesh : meshes) {
+        if (mesh.failed) {
+            wprintf(L"Failed to cook mesh %ls\n", mesh.filePath.c_str());
+            failuresCount++;
+        }
+    }
+    for (const TextureCooking &texture : textures) {
+        if (texture.failed) {
+            wprintf(L"Failed to cook texture %ls\n", texture.filePath.c_str());
+            failuresCount++;
+        }
+    }
+    return failuresCount;
+}
+
+void AssetCooker::findSources(const std::wstring &directory) {
+    WIN32_FIND_DATAW findData{};
+    const HANDLE findHandle = FindFirstFileW((std::wstring{RESOURCES_PATH} + directory + L"*").c_str(), &findData);
+    if (findHandle == INVALID_HANDLE_VALUE) {
+        return;
+    }
+
+    do {
+        const std::wstring name = findData.cFileName;
+        if (findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+            if (name != L"." && name != L"..") {
+                findSources(directory + name + L"/");
+            }
+            continue;
+        }
+
+        const std::wstring extension = FileHelper::getExtension(name, false);
+        if (extension == L"obj") {
+            meshPaths.push_back(directory + name);
+        } else if (extension == L"tga" || extension == L"dds" || extension == L"hdr" ||
+                   extension == L"jpg" || extension == L"png" || extension == L"bmp") {
+            texturePaths.push_back(directory + name);
+        }
+    } while (FindNextFileW(findHandle, &findData));
+    FindClose(findHandle);
+}
+
+void AssetCooker::cookMesh(MeshCooking &mesh) {
+    // Mesh is processed like by the loader, but only the cooked file is kept
+    const MeshCpuLoadArgs args{mesh.filePath, settings.loadTextureCoordinates, settings.computeTangents, true, true,
+                               settings.quantizeVertices, settings.generateLods};
+    const MeshCpuLoadResult result = ObjLoadCpuGpuOperation::cook(args, backgroundWorkerController, []() { return false; });
+    if (result.result != DXD::Mesh::ObjLoadResult::SUCCESS) {
+        mesh.failed = true;
+        return;
+    }
+    if (!result.cookedMesh) {
+        wprintf(L"Cooked %ls: %u vertices, %u indices, %u levels of detail\n", mesh.filePath.c_str(), result.header.verticesCount,
+                result.header.indicesCount, result.header.lodsCount);
+    }
+}
+
+void AssetCooker::decodeTexture(TextureCooking &texture) {
+    const std::wstring fullFilePath = std::wstring{RESOURCES_PATH} + texture.filePath;
+    texture.cookedTexturePath = CookedTexture::getPath(fullFilePath, texture.type);
+    if (!CookedMesh::querySource(fullFilePath, static_cast<UINT>(texture.type), texture.source)) {
+        texture.failed = true;
+        return;
+    }
+    if (CookedTexture(texture.cookedTexturePath, texture.source).isValid()) {
+        texture.finished = true;
+        return;
+    }
+
+    DirectX::TexMetadata metadata{};
+    texture.failed = FAILED(CookedTexture::loadSourceImage(fullFilePath, metadata, texture.image)) ||
+                     metadata.dimension != DirectX::TEX_DIMENSION_TEXTURE2D;
+}
+
+void AssetCooker::compressTexture(TextureCooking &texture) {
+    if (texture.finished || texture.failed) {
+        return;
+    }
+    texture.failed = FAILED(CookedTexture::cook(texture.image, texture.type, texture.cookedImage));
+    texture.image.Release();
+}
+
+void AssetCooker::writeTexture(TextureCooking &texture) {
+    if (texture.finished || texture.failed) {
+        return;
+    }
+    if (!CookedTexture::write(texture.cookedTexturePath, texture.source, texture.cookedImage)) {
+        texture.failed = true;
+        return;
+    }
+
+    const DirectX::TexMetadata &cookedMetadata = texture.cookedImage.GetMetadata();
+    wprintf(L"Cooked %ls: %ux%u, %u mips, %u bytes\n", texture.filePath.c_str(), static_cast<UINT>(cookedMetadata.width),
+            static_cast<UINT>(cookedMetadata.height), static_cast<UINT>(cookedMetadata.mipLevels),
+            static_cast<UINT>(texture.cookedImage.GetPixelsSize()));
+    texture.cookedImage.Release();
+    texture.finished = true;
+}
+
+DXD::Texture::TextureType AssetCooker::getTextureType(const std::wstring &filePath) {
+    // Type is not stored in image files, so normal maps are recognized by the naming convention of the resources
+    std::wstring name = FileHelper::getNameWithoutExtension(filePath, true);
+    std::transform(name.begin(), name.end(), name.begin(), towlower);
+    const std::wstring normalMapSuffix = L"_normal";
+    const bool isNormalMap = name.size() >= normalMapSuffix.size() &&
+                             name.compare(name.size() - normalMapSuffix.size(), normalMapSuffix.size(), normalMapSuffix) == 0;
+    return isNormalMap ? DXD::Texture::TextureType::NORMAL_MAP : DXD::Texture::TextureType::ALBEDO;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "Geometry/CookedMesh.h"
+#include "Resource/CookedTexture.h"
+#include "Scene/MeshImpl.h"
+#include "Threading/BackgroundWorkerController.h"
+
+#include <DXD/ExternalHeadersWrappers/windows.h>
+#include <DXD/Texture.h>
+#include <string>
+#include <vector>
+
+/// \brief Offline preprocessing of all meshes and textures in a directory
+///
+/// Produces the cooked files which the loaders map instead of processing sources at runtime, so the
+/// work is done once on a build machine instead of on every player machine. Obj meshes go through the CPU
+/// stages of the mesh loader, which weld, optimize, quantize and simplify them and write .dxdmesh files
+/// next to them, without creating the application or uploading anything to the GPU. Images are decoded,
+/// mipmapped and block compressed into .dxdtex files. All assets are cooked in one graph run by the
+/// cooker's own background workers - a mesh is a single node, a texture is a chain of decode, compress and
+/// write stages, so stages of different assets overlap. Cooked files that are still up to date with their
+/// sources are left untouched.
+class AssetCooker {
+public:
+    struct Settings {
+        std::wstring directory = L"Resources/"; // relative to the resources path, like file paths passed to the engine
+        bool loadTextureCoordinates = false;     // mesh flags have to match the ones used by the application,
+        bool computeTangents = false;            // otherwise the loader will not find the cooked files
+        bool quantizeVertices = false;
+        bool generateLods = true;
+    };
+
+    explicit AssetCooker(const Settings &settings);
+
+    /// Cooks all assets found in the directory and its subdirectories
+    /// \return number of assets which could not be cooked
+    UINT cook();
+
+private:
+    // State of a texture passed between its stages, stages after a failed or skipped one do nothing
+    struct TextureCooking {
+        std::wstring filePath;
+        DXD::Texture::TextureType type;
+        std::wstring cookedTexturePath = {};
+        CookedMeshSource source = {};
+        DirectX::ScratchImage image = {};
+        DirectX::ScratchImage cookedImage = {};
+        bool finished = false;
+        bool failed = false;
+    };
+
+    // Result of a mesh, set by its node
+    struct MeshCooking {
+        std::wstring filePath;
+        bool failed = false;
+    };
+
+    void findSources(const std::wstring &directory);
+    void cookMesh(MeshCooking &mesh);
+    static void decodeTexture(TextureCooking &texture);
+    static void compressTexture(TextureCooking &texture);
+    static void writeTexture(TextureCooking &texture);
+    static DXD::Texture::TextureType getTextureType(const std::wstring &filePath);
+
+    const Settings settings;
+    BackgroundWorkerController backgroundWorkerController = {};
+    std::vector<std::wstring> meshPaths = {};
+    std::vector<std::wstring> texturePaths = {};
+};
@@ -0,0 +1,58 @@
+#include "AssetCooker.h"
+
+#include <cstdio>
+#include <cwchar>
+
+namespace {
+void printUsage() {
+    wprintf(L"Usage: AssetCooker [directory] [options]\n"
+            L"  directory                 relative to the resources path, Resources/ by default\n"
+            L"  --texture-coordinates     cook meshes with texture coordinates\n"
+            L"  --tangents                cook meshes with tangents\n"
+            L"  --quantize                cook meshes with 16-bit vertex attributes\n"
+            L"  --no-lods                 cook meshes without levels of detail\n"
+            L"Mesh options have to match the ones used by the application to load the meshes.\n");
+}
+
+bool parseArguments(int argc, wchar_t **argv, AssetCooker::Settings &outSettings) {
+    for (int argumentIndex = 1; argumentIndex < argc; argumentIndex++) {
+        const std::wstring argument = argv[argumentIndex];
+        if (argument == L"--texture-coordinates") {
+            outSettings.loadTextureCoordinates = true;
+        } else if (argument == L"--tangents") {
+            outSettings.computeTangents = true;
+        } else if (argument == L"--quantize") {
+            outSettings.quantizeVertices = true;
+        } else if (argument == L"--no-lods") {
+            outSettings.generateLods = false;
+        } else if (argument.compare(0, 2, L"--") != 0) {
+            outSettings.directory = argument;
+            if (outSettings.directory.back() != L'/' && outSettings.directory.back() != L'\\') {
+                outSettings.directory += L'/';
+            }
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
+int wmain(int argc, wchar_t **argv) {
+    AssetCooker::Settings settings{};
+    if (!parseArguments(argc, argv, settings)) {
+        printUsage();
+        return 2;
+    }
+
+    // No application is created, so COM is initialized here. Main thread decodes images too, while waiting for the workers
+    CoInitializeEx(NULL, COINIT_APARTMENTTHREADED);
+    UINT failuresCount = 0u;
+    {
+        AssetCooker cooker{settings};
+        failuresCount = cooker.cook();
+    }
+    CoUninitialize();
+    wprintf(L"Cooking finished, %u failures\n", failuresCount);
+    return failuresCount == 0u ? 0 : 1;
+}
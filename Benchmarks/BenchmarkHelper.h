@@ -0,0 +1,32 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+
+namespace BenchmarkHelper {
+
+/// Runs the workload given number of times and returns average duration of a single run
+/// \param iterations how many times should the workload be executed
+/// \param workload callable to measure
+/// \return average duration in milliseconds
+template <typename Workload>
+inline double measureAverageMilliseconds(unsigned int iterations, Workload workload) {
+    const auto start = std::chrono::high_resolution_clock::now();
+    for (auto iteration = 0u; iteration < iterations; iteration++) {
+        workload();
+    }
+    const auto end = std::chrono::high_resolution_clock::now();
+    const std::chrono::duration<double, std::milli> duration = end - start;
+    return duration.count() / iterations;
+}
+
+/// Prints single measurement result in a format aligned with gtest output
+inline void report(const char *benchmarkName, const char *variantName, double value, const char *unit) {
+    printf("[ BENCHMARK] %-32s %-32s %12.3f %s\n", benchmarkName, variantName, value, unit);
+}
+
+inline void report(const char *benchmarkName, const char *variantName, double milliseconds) {
+    report(benchmarkName, variantName, milliseconds, "ms");
+}
+
+} // namespace BenchmarkHelper
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Geometry/MeshWelder.h"
+#include "Geometry/ObjParser.h"
+#include "Utility/MemoryMappedFile.h"
+
+#include <string>
+#include <vector>
+
+/// Meshes shared by the geometry benchmarks
+namespace GeometryBenchmarkHelper {
+
+/// Bundled meshes of increasing size, relative to the resources path
+constexpr const wchar_t *benchmarkedMeshes[] = {
+    L"Resources/meshes/teapot_normals.obj",
+    L"Resources/meshes/dennis.obj",
+    L"Resources/meshes/porshe.obj",
+};
+
+/// Parses an obj file and welds its vertices, the same way as in ObjLoadCpuGpuOperation. Positions are followed by
+/// the requested attributes, in the order of the engine vertex layout
+/// \param normals if true and the file has normals, they follow the positions
+/// \param textureCoordinates if true, texture coordinates are the last attribute, the file has to contain them
+/// \param outVertexSizeInFloats number of elements of every welded vertex
+inline void loadWeldedMesh(const std::wstring &filePath, bool normals, bool textureCoordinates, std::vector<FLOAT> &outVertexElements,
+                           std::vector<UINT> &outIndices, UINT &outVertexSizeInFloats) {
+    const MemoryMappedFile file{filePath};
+    ObjData objData{};
+    ObjParser::parse(file.getData(), file.getDataEnd(), objData);
+
+    const bool hasNormals = normals && !objData.normals.empty();
+    outVertexSizeInFloats = 3u + (hasNormals ? 3u : 0u) + (textureCoordinates ? 2u : 0u);
+    std::vector<FLOAT> cornerVertexElements{};
+    for (const ObjFaceCorner &corner : objData.faceCorners) {
+        cornerVertexElements.insert(cornerVertexElements.end(), objData.positions.begin() + 3 * corner.position, objData.positions.begin() + 3 * corner.position + 3);
+        if (hasNormals) {
+            cornerVertexElements.insert(cornerVertexElements.end(), objData.normals.begin() + 3 * corner.normal, objData.normals.begin() + 3 * corner.normal + 3);
+        }
+        if (textureCoordinates) {
+            cornerVertexElements.insert(cornerVertexElements.end(), objData.textureCoordinates.begin() + 2 * corner.textureCoordinate,
+                                        objData.textureCoordinates.begin() + 2 * corner.textureCoordinate + 2);
+        }
+    }
+    MeshWelder::weld(cornerVertexElements, outVertexSizeInFloats, outVertexElements, outIndices);
+}
+
+} // namespace GeometryBenchmarkHelper
@@ -0,0 +1,42 @@
+#include "BenchmarkHelper.h"
+#include "Geometry/GeometryBenchmarkHelper.h"
+
+#include "Geometry/MeshOptimizer.h"
+
+#include <gtest/gtest.h>
+#include <string>
+
+TEST(MeshOptimizerBenchmarks, givenBundledMeshesWhenOptimizingVertexOrderThenReportVertexCacheStatisticsAndTimes) {
+    for (const wchar_t *mesh : GeometryBenchmarkHelper::benchmarkedMeshes) {
+        const std::wstring filePath = std::wstring{RESOURCES_PATH} + mesh;
+        const std::string meshName{filePath.begin() + filePath.find_last_of(L'/') + 1, filePath.end()};
+
+        std::vector<FLOAT> vertexElements{};
+        std::vector<UINT> indices{};
+        UINT vertexSizeInFloats{};
+        GeometryBenchmarkHelper::loadWeldedMesh(filePath, true, false, vertexElements, indices, vertexSizeInFloats);
+        const auto verticesCount = static_cast<UINT>(vertexElements.size() / vertexSizeInFloats);
+        const VertexCacheStatistics statisticsBefore = MeshOptimizer::analyzeVertexCache(indices, verticesCount);
+
+        const double vertexCacheTime = BenchmarkHelper::measureAverageMilliseconds(1u, [&]() {
+            MeshOptimizer::optimizeVertexCache(indices, verticesCount);
+        });
+        const VertexCacheStatistics statisticsVertexCache = MeshOptimizer::analyzeVertexCache(indices, verticesCount);
+        const double overdrawTime = BenchmarkHelper::measureAverageMilliseconds(1u, [&]() {
+            MeshOptimizer::optimizeOverdraw(indices, vertexElements, vertexSizeInFloats);
+        });
+        const double vertexFetchTime = BenchmarkHelper::measureAverageMilliseconds(1u, [&]() {
+            MeshOptimizer::optimizeVertexFetch(indices, vertexElements, vertexSizeInFloats);
+        });
+        const VertexCacheStatistics statisticsAfter = MeshOptimizer::analyzeVertexCache(indices, static_cast<UINT>(vertexElements.size() / vertexSizeInFloats));
+
+        BenchmarkHelper::report(meshName.c_str(), "ACMR unoptimized", statisticsBefore.acmr, "");
+        BenchmarkHelper::report(meshName.c_str(), "ACMR vertex cache", statisticsVertexCache.acmr, "");
+        BenchmarkHelper::report(meshName.c_str(), "ACMR vertex cache+overdraw", statisticsAfter.acmr, "");
+        BenchmarkHelper::report(meshName.c_str(), "ATVR unoptimized", statisticsBefore.atvr, "");
+        BenchmarkHelper::report(meshName.c_str(), "ATVR optimized", statisticsAfter.atvr, "");
+        BenchmarkHelper::report(meshName.c_str(), "optimizeVertexCache", vertexCacheTime);
+        BenchmarkHelper::report(meshName.c_str(), "optimizeOverdraw", overdrawTime);
+        BenchmarkHelper::report(meshName.c_str(), "optimizeVertexFetch", vertexFetchTime);
+    }
+}
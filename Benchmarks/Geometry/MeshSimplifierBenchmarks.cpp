@@ -0,0 +1,39 @@
+#include "BenchmarkHelper.h"
+#include "Geometry/GeometryBenchmarkHelper.h"
+
+#include "Geometry/MeshSimplifier.h"
+
+#include <gtest/gtest.h>
+#include <limits>
+#include <string>
+
+TEST(MeshSimplifierBenchmarks, givenBundledMeshesWhenGeneratingLodChainThenReportTrianglesCountsErrorsAndTimes) {
+    for (const wchar_t *mesh : GeometryBenchmarkHelper::benchmarkedMeshes) {
+        const std::wstring filePath = std::wstring{RESOURCES_PATH} + mesh;
+        const std::string meshName{filePath.begin() + filePath.find_last_of(L'/') + 1, filePath.end()};
+
+        std::vector<FLOAT> vertexElements{};
+        std::vector<UINT> indices{};
+        UINT vertexSizeInFloats{};
+        GeometryBenchmarkHelper::loadWeldedMesh(filePath, true, false, vertexElements, indices, vertexSizeInFloats);
+        BenchmarkHelper::report(meshName.c_str(), "LOD0 triangles", static_cast<double>(indices.size() / 3), "");
+
+        // Each level is simplified from the previous one, the same way as in ObjLoadCpuGpuOperation
+        FLOAT error = 0.f;
+        for (auto lodIndex = 1u; lodIndex < 4u; lodIndex++) {
+            std::vector<UINT> simplifiedIndices{};
+            FLOAT levelError{};
+            const double time = BenchmarkHelper::measureAverageMilliseconds(1u, [&]() {
+                levelError = MeshSimplifier::simplify(indices, vertexElements, vertexSizeInFloats, static_cast<UINT>(indices.size() / 6 * 3),
+                                                      std::numeric_limits<FLOAT>::max(), simplifiedIndices);
+            });
+            error += levelError;
+            indices = std::move(simplifiedIndices);
+
+            const std::string lodName = "LOD" + std::to_string(lodIndex);
+            BenchmarkHelper::report(meshName.c_str(), (lodName + " triangles").c_str(), static_cast<double>(indices.size() / 3), "");
+            BenchmarkHelper::report(meshName.c_str(), (lodName + " error").c_str(), error, "");
+            BenchmarkHelper::report(meshName.c_str(), (lodName + " simplify").c_str(), time);
+        }
+    }
+}
@@ -0,0 +1,116 @@
+#include "BenchmarkHelper.h"
+#include "Geometry/GeometryBenchmarkHelper.h"
+
+#include "Application/ApplicationImpl.h"
+#include "Geometry/ObjParser.h"
+#include "Utility/MemoryMappedFile.h"
+
+#include <fstream>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+
+namespace {
+// Reference implementation - parsing as it was done by ObjLoadCpuGpuOperation before introducing ObjParser
+void parseObjWithStreams(const std::wstring &filePath, ObjData &outData) {
+    std::fstream inputFile{filePath, std::ios::in};
+    std::vector<std::string> indexTokens;
+    std::string lineType;
+    FLOAT x, y, z;
+    std::string f1, f2, f3, f4;
+    for (std::string line; getline(inputFile, line).good();) {
+        if (line.empty()) {
+            continue;
+        }
+
+        std::istringstream strs(line);
+        strs >> lineType;
+        if (lineType == "v") {
+            strs >> x >> y >> z;
+            outData.positions.insert(outData.positions.end(), {x, y, z});
+        } else if (lineType == "f") {
+            strs >> f1 >> f2 >> f3;
+            indexTokens.insert(indexTokens.end(), {f1, f2, f3});
+            if (!strs.eof()) {
+                strs >> f4;
+                if (!f4.empty()) {
+                    indexTokens.insert(indexTokens.end(), {f1, f3, f4});
+                }
+            }
+        } else if (lineType == "vn") {
+            strs >> x >> y >> z;
+            outData.normals.insert(outData.normals.end(), {x, y, z});
+        } else if (lineType == "vt") {
+            strs >> x >> y >> z;
+            outData.textureCoordinates.insert(outData.textureCoordinates.end(), {x, y});
+        }
+    }
+
+    for (const std::string &indexToken : indexTokens) {
+        ObjFaceCorner corner{};
+        size_t rightPosition = indexToken.find('/', 0u);
+        corner.position = std::stoi(indexToken.substr(0, rightPosition)) - 1;
+        size_t leftPosition = rightPosition + 1;
+        rightPosition = indexToken.find('/', leftPosition);
+        if (rightPosition != std::string::npos && leftPosition != rightPosition) {
+            corner.textureCoordinate = std::stoi(indexToken.substr(leftPosition, rightPosition)) - 1;
+        }
+        leftPosition = rightPosition + 1;
+        if (rightPosition != std::string::npos && leftPosition < indexToken.size()) {
+            corner.normal = std::stoi(indexToken.substr(leftPosition)) - 1;
+        }
+        outData.faceCorners.push_back(corner);
+    }
+}
+
+void parseObjWithMemoryMapping(const std::wstring &filePath, ObjData &outData) {
+    const MemoryMappedFile file{filePath};
+    ObjParser::parse(file.getData(), file.getDataEnd(), outData);
+}
+
+void parseObjInParallel(const std::wstring &filePath, ObjData &outData) {
+    const MemoryMappedFile file{filePath};
+    auto &backgroundWorkerController = ApplicationImpl::getInstance().getBackgroundWorkerController();
+    const auto chunks = ObjParser::splitIntoChunks(file.getData(), file.getDataEnd(), backgroundWorkerController.getWorkersCount() + 1, 256 * 1024);
+    std::vector<ObjData> chunksData(chunks.size());
+    backgroundWorkerController.executeInParallel(static_cast<UINT>(chunks.size()), [&](UINT chunkIndex) {
+        ObjParser::parse(chunks[chunkIndex].begin, chunks[chunkIndex].end, chunksData[chunkIndex]);
+    });
+    ObjParser::merge(chunksData, outData);
+}
+} // namespace
+
+TEST(ObjParserBenchmarks, givenBundledMeshesWhenParsingThenReportStreamMemoryMappedAndParallelParsingTimes) {
+    constexpr unsigned int iterations = 5u;
+    for (const wchar_t *mesh : GeometryBenchmarkHelper::benchmarkedMeshes) {
+        const std::wstring filePath = std::wstring{RESOURCES_PATH} + mesh;
+        const std::string meshName{filePath.begin() + filePath.find_last_of(L'/') + 1, filePath.end()};
+
+        ObjData streamData{};
+        ObjData mappedData{};
+        ObjData parallelData{};
+        parseObjWithStreams(filePath, streamData);
+        parseObjWithMemoryMapping(filePath, mappedData);
+        parseObjInParallel(filePath, parallelData);
+        ASSERT_EQ(streamData.positions, mappedData.positions);
+        ASSERT_EQ(streamData.faceCorners.size(), mappedData.faceCorners.size());
+        ASSERT_EQ(mappedData.positions, parallelData.positions);
+        ASSERT_EQ(mappedData.faceCorners.size(), parallelData.faceCorners.size());
+
+        const double streamTime = BenchmarkHelper::measureAverageMilliseconds(iterations, [&filePath]() {
+            ObjData data{};
+            parseObjWithStreams(filePath, data);
+        });
+        const double mappedTime = BenchmarkHelper::measureAverageMilliseconds(iterations, [&filePath]() {
+            ObjData data{};
+            parseObjWithMemoryMapping(filePath, data);
+        });
+        const double parallelTime = BenchmarkHelper::measureAverageMilliseconds(iterations, [&filePath]() {
+            ObjData data{};
+            parseObjInParallel(filePath, data);
+        });
+        BenchmarkHelper::report(meshName.c_str(), "istringstream", streamTime);
+        BenchmarkHelper::report(meshName.c_str(), "MemoryMappedFile+ObjParser", mappedTime);
+        BenchmarkHelper::report(meshName.c_str(), "MemoryMappedFile+ObjParser parallel", parallelTime);
+    }
+}
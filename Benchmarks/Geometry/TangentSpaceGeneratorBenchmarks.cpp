@@ -0,0 +1,43 @@
+#include "BenchmarkHelper.h"
+#include "Geometry/GeometryBenchmarkHelper.h"
+
+#include "Geometry/TangentSpaceGenerator.h"
+#include "Utility/CpuFeatures.h"
+
+#include <gtest/gtest.h>
+#include <string>
+
+TEST(TangentSpaceGeneratorBenchmarks, givenBundledMeshesWhenComputingNormalsAndTangentsThenReportTimesForEachSimdLevel) {
+    using SimdLevel = TangentSpaceGenerator::SimdLevel;
+    struct {
+        SimdLevel simdLevel;
+        const char *name;
+    } simdLevels[] = {{SimdLevel::SCALAR, "scalar"}, {SimdLevel::SSE, "SSE"}, {SimdLevel::AVX, "AVX"}};
+
+    for (const wchar_t *mesh : GeometryBenchmarkHelper::benchmarkedMeshes) {
+        const std::wstring filePath = std::wstring{RESOURCES_PATH} + mesh;
+        const std::string meshName{filePath.begin() + filePath.find_last_of(L'/') + 1, filePath.end()};
+
+        std::vector<FLOAT> vertexElements{};
+        std::vector<UINT> indices{};
+        UINT vertexSizeInFloats{};
+        GeometryBenchmarkHelper::loadWeldedMesh(filePath, false, true, vertexElements, indices, vertexSizeInFloats);
+        const auto verticesCount = static_cast<UINT>(vertexElements.size() / vertexSizeInFloats);
+        std::vector<FLOAT> normals(3 * verticesCount);
+        std::vector<FLOAT> tangents(3 * verticesCount);
+
+        for (const auto &simdLevel : simdLevels) {
+            if (simdLevel.simdLevel == SimdLevel::AVX && !CpuFeatures::isAvxSupported()) {
+                continue;
+            }
+            const double time = BenchmarkHelper::measureAverageMilliseconds(10u, [&]() {
+                TangentSpaceGenerator::computeNormals({vertexElements.data(), vertexSizeInFloats}, verticesCount, indices, TangentSpaceGenerator::Weighting::ANGLE,
+                                                      normals.data(), 3u, simdLevel.simdLevel);
+                TangentSpaceGenerator::computeTangents({vertexElements.data(), vertexSizeInFloats}, {vertexElements.data() + 3, vertexSizeInFloats}, {normals.data(), 3u},
+                                                       verticesCount, indices, TangentSpaceGenerator::Weighting::ANGLE,
+                                                       tangents.data(), 3u, simdLevel.simdLevel);
+            });
+            BenchmarkHelper::report(meshName.c_str(), simdLevel.name, time);
+        }
+    }
+}
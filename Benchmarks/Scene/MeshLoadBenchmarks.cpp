@@ -0,0 +1,38 @@
+#include "BenchmarkHelper.h"
+#include "Geometry/GeometryBenchmarkHelper.h"
+
+#include "Geometry/CookedMesh.h"
+#include "Scene/MeshImpl.h"
+
+#include "DXD/Mesh.h"
+
+#include <gtest/gtest.h>
+#include <string>
+
+namespace {
+void loadMesh(const std::wstring &filePath) {
+    DXD::Mesh::ObjLoadResult loadResult{};
+    auto mesh = DXD::Mesh::createFromObjSynchronously(filePath, false, false, &loadResult);
+    ASSERT_EQ(DXD::Mesh::ObjLoadResult::SUCCESS, loadResult);
+}
+} // namespace
+
+TEST(MeshLoadBenchmarks, givenBundledMeshesWhenLoadingWithAndWithoutCookedMeshThenReportColdAndWarmLoadTimes) {
+    constexpr unsigned int iterations = 5u;
+    for (const wchar_t *mesh : GeometryBenchmarkHelper::benchmarkedMeshes) {
+        const std::wstring filePath{mesh};
+        const std::string meshName{filePath.begin() + filePath.find_last_of(L'/') + 1, filePath.end()};
+        const MeshCpuLoadArgs args{filePath, false, false, true};
+        const std::wstring cookedMeshPath = CookedMesh::getPath(std::wstring{RESOURCES_PATH} + filePath, args.getCookedMeshLoadFlags());
+
+        const double coldTime = BenchmarkHelper::measureAverageMilliseconds(iterations, [&]() {
+            DeleteFileW(cookedMeshPath.c_str());
+            loadMesh(filePath);
+        });
+        const double warmTime = BenchmarkHelper::measureAverageMilliseconds(iterations, [&]() {
+            loadMesh(filePath);
+        });
+        BenchmarkHelper::report(meshName.c_str(), "obj parsing and processing", coldTime);
+        BenchmarkHelper::report(meshName.c_str(), "cooked mesh", warmTime);
+    }
+}
@@ -0,0 +1,125 @@
+#include "BenchmarkHelper.h"
+
+#include "Threading/BackgroundWorkerController.h"
+#include "Threading/BlockingQueue.h"
+
+#include <atomic>
+#include <functional>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+namespace {
+constexpr UINT tasksCount = 1000000u;
+
+// Previous design of the controller - all workers popping std::function objects from one locked queue
+class SharedQueueWorkerPool {
+public:
+    explicit SharedQueueWorkerPool(UINT workersCount) {
+        for (auto workerIndex = 0u; workerIndex < workersCount; workerIndex++) {
+            workers.emplace_back([this]() {
+                std::function<void()> task{};
+                while (!terminate) {
+                    if (queue.blockingPop(task)) {
+                        task();
+                    }
+                }
+            });
+        }
+    }
+
+    ~SharedQueueWorkerPool() {
+        terminate = true;
+        queue.notifyAll();
+        for (std::thread &worker : workers) {
+            worker.join();
+        }
+    }
+
+    void pushTask(std::function<void()> task) {
+        queue.push(std::move(task));
+    }
+
+private:
+    std::atomic_bool terminate = false;
+    BlockingQueue<std::function<void()>> queue{};
+    std::vector<std::thread> workers{};
+};
+
+void waitForTasks(const std::atomic<UINT> &executedCount, UINT expectedCount) {
+    while (executedCount.load() != expectedCount) {
+        std::this_thread::yield();
+    }
+}
+
+double toTasksPerSecond(double milliseconds) {
+    return tasksCount / (milliseconds / 1000.0);
+}
+} // namespace
+
+TEST(BackgroundWorkerControllerBenchmarks, givenTinyTasksPushedFromMainThreadThenReportThroughput) {
+    std::atomic<UINT> executedCount{0u};
+    const auto workersCount = std::thread::hardware_concurrency();
+
+    double sharedQueueTime{};
+    {
+        SharedQueueWorkerPool pool{workersCount};
+        sharedQueueTime = BenchmarkHelper::measureAverageMilliseconds(1u, [&]() {
+            for (auto taskIndex = 0u; taskIndex < tasksCount; taskIndex++) {
+                pool.pushTask([&executedCount]() { executedCount++; });
+            }
+            waitForTasks(executedCount, tasksCount);
+        });
+    }
+
+    executedCount = 0u;
+    BackgroundWorkerController controller{workersCount};
+    const double workStealingTime = BenchmarkHelper::measureAverageMilliseconds(1u, [&]() {
+        for (auto taskIndex = 0u; taskIndex < tasksCount; taskIndex++) {
+            controller.pushTask([&executedCount]() { executedCount++; });
+        }
+        waitForTasks(executedCount, tasksCount);
+    });
+
+    BenchmarkHelper::report("1M tasks from main thread", "shared queue", toTasksPerSecond(sharedQueueTime), "tasks/s");
+    BenchmarkHelper::report("1M tasks from main thread", "work stealing", toTasksPerSecond(workStealingTime), "tasks/s");
+}
+
+TEST(BackgroundWorkerControllerBenchmarks, givenTinyTasksSpawnedByWorkersThenReportThroughput) {
+    // Each worker-side task spawns a batch of children, the typical pattern of a loader splitting its work
+    constexpr UINT parentsCount = 1000u;
+    constexpr UINT childrenPerParent = tasksCount / parentsCount;
+    std::atomic<UINT> executedCount{0u};
+    const auto workersCount = std::thread::hardware_concurrency();
+
+    double sharedQueueTime{};
+    {
+        SharedQueueWorkerPool pool{workersCount};
+        sharedQueueTime = BenchmarkHelper::measureAverageMilliseconds(1u, [&]() {
+            for (auto parentIndex = 0u; parentIndex < parentsCount; parentIndex++) {
+                pool.pushTask([&]() {
+                    for (auto childIndex = 0u; childIndex < childrenPerParent; childIndex++) {
+                        pool.pushTask([&executedCount]() { executedCount++; });
+                    }
+                });
+            }
+            waitForTasks(executedCount, tasksCount);
+        });
+    }
+
+    executedCount = 0u;
+    BackgroundWorkerController controller{workersCount};
+    const double workStealingTime = BenchmarkHelper::measureAverageMilliseconds(1u, [&]() {
+        for (auto parentIndex = 0u; parentIndex < parentsCount; parentIndex++) {
+            controller.pushTask([&]() {
+                for (auto childIndex = 0u; childIndex < childrenPerParent; childIndex++) {
+                    controller.pushTask([&executedCount]() { executedCount++; });
+                }
+            });
+        }
+        waitForTasks(executedCount, tasksCount);
+    });
+
+    BenchmarkHelper::report("1M tasks from workers", "shared queue", toTasksPerSecond(sharedQueueTime), "tasks/s");
+    BenchmarkHelper::report("1M tasks from workers", "work stealing", toTasksPerSecond(workStealingTime), "tasks/s");
+}
@@ -0,0 +1,49 @@
+#include "BenchmarkHelper.h"
+
+#include "Threading/BlockingQueue.h"
+#include "Threading/LockFreeBlockingQueue.h"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+constexpr UINT elementsCount = 1000000u;
+
+// Equal number of producers and consumers passing integers through the queue as fast as possible
+template <typename Queue>
+double measureElementsPerSecond(Queue &queue, UINT threadsCount) {
+    const UINT elementsPerThread = elementsCount / threadsCount;
+    const double milliseconds = BenchmarkHelper::measureAverageMilliseconds(1u, [&]() {
+        std::vector<std::thread> threads{};
+        for (auto threadIndex = 0u; threadIndex < threadsCount; threadIndex++) {
+            threads.emplace_back([&]() {
+                for (auto i = 0u; i < elementsPerThread; i++) {
+                    queue.push(i);
+                }
+            });
+            threads.emplace_back([&]() {
+                UINT value{};
+                for (auto i = 0u; i < elementsPerThread;) {
+                    i += queue.blockingPop(value) ? 1u : 0u;
+                }
+            });
+        }
+        for (std::thread &thread : threads) {
+            thread.join();
+        }
+    });
+    return elementsPerThread * threadsCount / (milliseconds / 1000.0);
+}
+} // namespace
+
+TEST(BlockingQueueBenchmarks, givenProducersAndConsumersThenReportThroughput) {
+    for (UINT threadsCount : {1u, 2u, 4u, 16u}) {
+        const std::string benchmarkName = std::to_string(threadsCount) + " producers/consumers";
+        BlockingQueue<UINT> blockingQueue{};
+        LockFreeBlockingQueue<UINT> lockFreeQueue{};
+        BenchmarkHelper::report(benchmarkName.c_str(), "BlockingQueue", measureElementsPerSecond(blockingQueue, threadsCount), "elements/s");
+        BenchmarkHelper::report(benchmarkName.c_str(), "LockFreeBlockingQueue", measureElementsPerSecond(lockFreeQueue, threadsCount), "elements/s");
+    }
+}
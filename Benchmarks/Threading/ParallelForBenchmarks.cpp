@@ -0,0 +1,113 @@
+#include "BenchmarkHelper.h"
+
+#include "Threading/BackgroundWorkerController.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+constexpr size_t elementsCount = 100000u;
+constexpr size_t grainSize = 256u;
+constexpr UINT iterations = 20u;
+
+// Stands in for per-object work of a frame, e.g. updating a model matrix and testing it against the frustum
+float processElement(size_t index) {
+    float value = static_cast<float>(index);
+    for (int step = 0; step < 16; step++) {
+        value = std::sin(value) * 0.5f + std::cos(value * 0.25f);
+    }
+    return value;
+}
+
+// Caller takes part in the work, so N threads means the caller and N - 1 workers
+std::vector<UINT> getThreadsCounts() {
+    const UINT hardwareThreadsCount = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<UINT> threadsCounts{};
+    for (UINT threadsCount = 1u; threadsCount < hardwareThreadsCount; threadsCount *= 2) {
+        threadsCounts.push_back(threadsCount);
+    }
+    threadsCounts.push_back(hardwareThreadsCount);
+    return threadsCounts;
+}
+} // namespace
+
+TEST(ParallelForBenchmarks, givenElementsProcessedInParallelForThenReportScaling) {
+    std::vector<float> results(elementsCount);
+    const double sequentialTime = BenchmarkHelper::measureAverageMilliseconds(iterations, [&]() {
+        for (size_t index = 0u; index < elementsCount; index++) {
+            results[index] = processElement(index);
+        }
+    });
+    BenchmarkHelper::report("parallelFor 100k elements", "sequential", sequentialTime);
+
+    for (UINT threadsCount : getThreadsCounts()) {
+        BackgroundWorkerController controller{threadsCount - 1};
+        const double time = BenchmarkHelper::measureAverageMilliseconds(iterations, [&]() {
+            controller.parallelFor(0u, elementsCount, grainSize, [&](size_t begin, size_t end) {
+                for (size_t index = begin; index < end; index++) {
+                    results[index] = processElement(index);
+                }
+            });
+        });
+        const std::string variantName = std::to_string(threadsCount) + " threads";
+        BenchmarkHelper::report("parallelFor 100k elements", variantName.c_str(), time);
+        BenchmarkHelper::report("parallelFor 100k elements", (variantName + ", speedup").c_str(), sequentialTime / time, "x");
+    }
+}
+
+TEST(ParallelForBenchmarks, givenElementsPushedAsSeparateTasksThenReportTimeForComparison) {
+    // What per-object parallelism looked like without the primitive, one task per element
+    std::vector<float> results(elementsCount);
+    const UINT threadsCount = std::max(1u, std::thread::hardware_concurrency());
+    BackgroundWorkerController controller{threadsCount};
+    std::atomic<size_t> processedCount{0u};
+    const double time = BenchmarkHelper::measureAverageMilliseconds(iterations, [&]() {
+        processedCount = 0u;
+        for (size_t index = 0u; index < elementsCount; index++) {
+            controller.pushTask([&results, &processedCount, index]() {
+                results[index] = processElement(index);
+                processedCount++;
+            });
+        }
+        while (processedCount.load() != elementsCount) {
+            std::this_thread::yield();
+        }
+    });
+    BenchmarkHelper::report("parallelFor 100k elements", "task per element", time);
+}
+
+TEST(ParallelForBenchmarks, givenElementsReducedInParallelReduceThenReportScaling) {
+    std::vector<float> values(elementsCount);
+    for (size_t index = 0u; index < elementsCount; index++) {
+        values[index] = processElement(index);
+    }
+    auto reduceRange = [&](size_t begin, size_t end, double accumulator) {
+        for (size_t index = begin; index < end; index++) {
+            accumulator += processElement(index) * values[index];
+        }
+        return accumulator;
+    };
+
+    double sequentialResult = 0.0;
+    const double sequentialTime = BenchmarkHelper::measureAverageMilliseconds(iterations, [&]() {
+        sequentialResult = reduceRange(0u, elementsCount, 0.0);
+    });
+    BenchmarkHelper::report("parallelReduce 100k elements", "sequential", sequentialTime);
+
+    for (UINT threadsCount : getThreadsCounts()) {
+        BackgroundWorkerController controller{threadsCount - 1};
+        double result = 0.0;
+        const double time = BenchmarkHelper::measureAverageMilliseconds(iterations, [&]() {
+            result = controller.parallelReduce(0u, elementsCount, grainSize, 0.0, reduceRange, [](double left, double right) { return left + right; });
+        });
+        EXPECT_NEAR(sequentialResult, result, std::abs(sequentialResult) * 1e-9 + 1e-6);
+        const std::string variantName = std::to_string(threadsCount) + " threads";
+        BenchmarkHelper::report("parallelReduce 100k elements", variantName.c_str(), time);
+        BenchmarkHelper::report("parallelReduce 100k elements", (variantName + ", speedup").c_str(), sequentialTime / time, "x");
+    }
+}
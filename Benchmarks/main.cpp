@@ -0,0 +1,9 @@
+#include "Application/ApplicationImpl.h"
+
+#include <gtest/gtest.h>
+
+int main(int argc, char **argv) {
+    auto application = DXD::Application::create(false, false, DXD::Application::MinimizeBehavior::Keep);
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
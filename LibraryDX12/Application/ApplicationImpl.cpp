@@ -3,6 +3,7 @@
 #include "Utility/ThrowIfFailed.h"
 
 #include <cassert>
+#include <chrono>
 
 namespace DXD {
 std::unique_ptr<Application> Application::create(bool debugLayer, bool debugShaders, MinimizeBehavior minimizeBehavior) {
@@ -24,6 +25,8 @@ ApplicationImpl::ApplicationImpl(bool debugLayer, bool debugShaders, MinimizeBeh
       descriptorController(device),
       copyCommandQueue(device, D3D12_COMMAND_LIST_TYPE_COPY),
       directCommandQueue(device, D3D12_COMMAND_LIST_TYPE_DIRECT),
+      vertexGeometryPool(device, copyCommandQueue, directCommandQueue, L"VertexGeometryPool", 64 * 1024 * 1024),
+      indexGeometryPool(device, copyCommandQueue, directCommandQueue, L"IndexGeometryPool", 16 * 1024 * 1024),
       backgroundWorkerController() {
     instance = this;
     pipelineStateController.compileAll();
@@ -31,6 +34,13 @@ ApplicationImpl::ApplicationImpl(bool debugLayer, bool debugShaders, MinimizeBeh
 }
 
 ApplicationImpl::~ApplicationImpl() {
+    // Workers are stopped explicitly to measure how long the tasks still running delay the shutdown
+    const auto shutdownStart = std::chrono::steady_clock::now();
+    backgroundWorkerController.stop();
+    waitMetrics.record(WaitMetrics::Category::SHUTDOWN,
+                       std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - shutdownStart));
+    waitMetrics.log();
+
     CoUninitialize();
     instance = nullptr;
 }
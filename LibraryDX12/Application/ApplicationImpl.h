@@ -5,13 +5,19 @@
 #include "CommandList/CommandQueue.h"
 #include "Descriptor/DescriptorController.h"
 #include "PipelineState/PipelineStateController.h"
+#include "Resource/GeometryPool.h"
 #include "Threading/BackgroundWorkerController.h"
+#include "Threading/WaitMetrics.h"
+#include "Utility/AssetCache.h"
 #include "Utility/LazyLoadHelper.h"
 
 #include "DXD/Application.h"
 
 #include <DXD/ExternalHeadersWrappers/dxgi.h>
 
+class MeshImpl;
+class TextureImpl;
+
 class ApplicationImpl : public DXD::Application {
 protected:
     friend class DXD::Application;
@@ -40,8 +46,13 @@ public:
     auto &getPipelineStateController() { return pipelineStateController; }
     auto &getDescriptorController() { return descriptorController; }
     auto &getBackgroundWorkerController() { return backgroundWorkerController; }
+    auto &getWaitMetrics() { return waitMetrics; }
+    auto &getMeshCache() { return meshCache; }
+    auto &getTextureCache() { return textureCache; }
     auto &getDirectCommandQueue() { return directCommandQueue; }
     auto &getCopyCommandQueue() { return copyCommandQueue; }
+    auto &getVertexGeometryPool() { return vertexGeometryPool; }
+    auto &getIndexGeometryPool() { return indexGeometryPool; }
     D2DContext &getD2DContext();
     bool isD2DContextInitialized();
 
@@ -72,7 +83,12 @@ protected:
     DescriptorController descriptorController;
     CommandQueue copyCommandQueue;
     CommandQueue directCommandQueue;
+    GeometryPool vertexGeometryPool;
+    GeometryPool indexGeometryPool;
+    WaitMetrics waitMetrics;
     BackgroundWorkerController backgroundWorkerController;
+    AssetCache<MeshImpl> meshCache;
+    AssetCache<TextureImpl> textureCache;
 
     // DX11 context
     std::unique_ptr<D2DContext> d2dContext;
@@ -3,11 +3,14 @@
 #include "CommandList/CommandAllocatorController.h"
 #include "CommandList/CommandQueue.h"
 #include "Descriptor/DescriptorAllocation.h"
+#include "Geometry/MeshletCuller.h"
+#include "Resource/GeometryPool.h"
 #include "Resource/VertexOrIndexBuffer.h"
 #include "Scene/MeshImpl.h"
 #include "Utility/ThrowIfFailed.h"
 
 #include <cassert>
+#include <cstring>
 
 CommandList::CommandList(CommandQueue &commandQueue, ID3D12PipelineState *initialPipelineState)
     : descriptorController(ApplicationImpl::getInstance().getDescriptorController()),
@@ -133,6 +136,7 @@ void CommandList::IASetVertexBuffers(UINT startSlot, UINT numBuffers, VertexBuff
     }
 
     commandList->IASetVertexBuffers(startSlot, numBuffers, views.get());
+    boundVertexBufferView = {};
     addUsedResources(resources.get(), numBuffers);
 }
 
@@ -140,24 +144,49 @@ void CommandList::IASetVertexBuffer(UINT slot, VertexBuffer &vertexBuffer) {
     transitionBarrier(vertexBuffer, D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER);
     commandList->IASetVertexBuffers(slot, 1, &vertexBuffer.getView());
     addUsedResource(vertexBuffer.getResource());
+    boundVertexBufferView = {};
 }
 
 void CommandList::IASetVertexBuffer(VertexBuffer &vertexBuffer) {
     transitionBarrier(vertexBuffer, D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER);
     commandList->IASetVertexBuffers(0, 1, &vertexBuffer.getView());
     addUsedResource(vertexBuffer.getResource());
+    boundVertexBufferView = {};
 }
 
 void CommandList::IASetIndexBuffer(IndexBuffer &indexBuffer) {
     transitionBarrier(indexBuffer, D3D12_RESOURCE_STATE_INDEX_BUFFER);
     commandList->IASetIndexBuffer(&indexBuffer.getView());
     addUsedResource(indexBuffer.getResource());
+    boundIndexBufferView = {};
 }
 
 void CommandList::IASetVertexAndIndexBuffer(MeshImpl &mesh) {
-    IASetVertexBuffer(*mesh.getVertexBuffer());
-    if (mesh.getIndicesCount() > 0u) {
-        IASetIndexBuffer(*mesh.getIndexBuffer());
+    IASetGeometry(mesh.getVertexAllocation(), mesh.getIndexAllocation(), mesh.getIndexFormat());
+}
+
+void CommandList::IASetPositionAndIndexBuffer(MeshImpl &mesh) {
+    IASetGeometry(mesh.getPositionAllocation(), mesh.getIndexAllocation(), mesh.getIndexFormat());
+}
+
+void CommandList::IASetGeometry(const GeometryAllocation &vertexAllocation, const GeometryAllocation &indexAllocation, DXGI_FORMAT indexFormat) {
+    // Pages are not transitioned, they're implicitly promoted to vertex and index buffer states, see GeometryPool.
+    // Consecutive meshes usually share pages, so views are set only when they change.
+    const D3D12_VERTEX_BUFFER_VIEW vertexBufferView = vertexAllocation.getVertexBufferView();
+    if (std::memcmp(&vertexBufferView, &boundVertexBufferView, sizeof(vertexBufferView)) != 0) {
+        commandList->IASetVertexBuffers(0, 1, &vertexBufferView);
+        addUsedResource(vertexAllocation.page);
+        boundVertexBufferView = vertexBufferView;
+    }
+
+    if (!indexAllocation.isNull()) {
+        // Width of the indices is encoded in the view, draws address them in elements, so they work with any of them
+        const D3D12_INDEX_BUFFER_VIEW indexBufferView = indexAllocation.getIndexBufferView(indexFormat);
+        if (std::memcmp(&indexBufferView, &boundIndexBufferView, sizeof(indexBufferView)) != 0) {
+            commandList->IASetIndexBuffer(&indexBufferView);
+            addUsedResource(indexAllocation.page);
+            boundIndexBufferView = indexBufferView;
+        }
     }
 }
 
@@ -217,6 +246,14 @@ void CommandList::drawIndexed(UINT verticesCount, INT startVertexLocation, INT s
     commandList->DrawIndexedInstanced(verticesCount, 1, startIndexLocation, startVertexLocation, 0);
 }
 
+void CommandList::drawIndexed(const std::vector<IndexRange> &indexRanges, UINT startIndexLocation, INT baseVertexLocation) {
+    commitResourceBarriers();
+    commitDescriptors();
+    for (const IndexRange &indexRange : indexRanges) {
+        commandList->DrawIndexedInstanced(indexRange.indicesCount, 1, startIndexLocation + indexRange.firstIndex, baseVertexLocation, 0);
+    }
+}
+
 void CommandList::draw(UINT verticesCount, INT startIndexLocation) {
     commitResourceBarriers();
     commitDescriptors();
@@ -20,6 +20,8 @@ class DescriptorAllocation;
 class MeshImpl;
 class Resource;
 class CommandQueue;
+struct IndexRange;
+struct GeometryAllocation;
 
 /// Class encapsulating DX12 command list
 class CommandList : DXD::NonCopyableAndMovable {
@@ -52,6 +54,8 @@ public:
     void IASetVertexBuffer(VertexBuffer &vertexBuffer);
     void IASetIndexBuffer(IndexBuffer &indexBuffer);
     void IASetVertexAndIndexBuffer(MeshImpl &mesh);
+    void IASetPositionAndIndexBuffer(MeshImpl &mesh);
+    void IASetGeometry(const GeometryAllocation &vertexAllocation, const GeometryAllocation &indexAllocation, DXGI_FORMAT indexFormat);
     void IASetPrimitiveTopology(D3D12_PRIMITIVE_TOPOLOGY primitiveTopology);
     void IASetPrimitiveTopologyTriangleList();
 
@@ -74,6 +78,8 @@ public:
     void setRoot32BitConstant(UINT rootParameterIndex, const ConstantType &constant);
 
     void drawIndexed(UINT verticesCount, INT startVertexLocation = 0u, INT startIndexLocation = 0u);
+    /// Draws ranges of indices relative to the given locations, e.g. of a mesh suballocated from GeometryPool
+    void drawIndexed(const std::vector<IndexRange> &indexRanges, UINT startIndexLocation, INT baseVertexLocation);
     void draw(UINT verticesCount, INT startVertexLocation = 0u);
 
     void dispatch(UINT threadGroupCountX, UINT threadGroupCountY, UINT threadGroupCountZ);
@@ -114,6 +120,8 @@ private:
 
     // Data currently set on this CommandList
     PipelineStateController::Identifier pipelineStateIdentifier;
+    D3D12_VERTEX_BUFFER_VIEW boundVertexBufferView = {}; // only for geometry from pools, zeroed when other buffers are set
+    D3D12_INDEX_BUFFER_VIEW boundIndexBufferView = {};
 
     // Data cached to be flushed when needed
     std::vector<D3D12_RESOURCE_BARRIER> cachedResourceBarriers = {};
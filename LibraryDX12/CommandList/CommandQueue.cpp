@@ -37,10 +37,19 @@ bool CommandQueue::isFenceComplete(uint64_t fenceValue) const {
     return this->fence.isComplete(fenceValue);
 }
 
+uint64_t CommandQueue::getLastSignalledFenceValue() {
+    std::unique_lock<std::mutex> lock = getLock(true);
+    return fence.getLastSignalledFenceValue();
+}
+
 void CommandQueue::waitOnCpu(uint64_t fenceValue) const {
     return this->fence.waitOnCpu(fenceValue);
 }
 
+bool CommandQueue::waitOnCpu(uint64_t fenceValue, std::chrono::milliseconds timeout) const {
+    return this->fence.waitOnCpu(fenceValue, timeout);
+}
+
 void CommandQueue::waitOnGpu(const CommandQueue &queueToWaitFor, uint64_t fenceValue) {
     this->commandQueue->Wait(queueToWaitFor.fence.getFence().Get(), fenceValue);
 }
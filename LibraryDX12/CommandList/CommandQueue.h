@@ -6,6 +6,7 @@
 #include "Synchronization/Fence.h"
 
 #include <DXD/ExternalHeadersWrappers/d3d12.h>
+#include <chrono>
 #include <mutex>
 #include <vector>
 
@@ -20,7 +21,9 @@ public:
     auto &getCommandAllocatorController() { return commandAllocatorController; }
 
     bool isFenceComplete(uint64_t fenceValue) const;
+    uint64_t getLastSignalledFenceValue();
     void waitOnCpu(uint64_t fenceValue) const;
+    bool waitOnCpu(uint64_t fenceValue, std::chrono::milliseconds timeout) const;
     void waitOnGpu(const CommandQueue &queueToWaitFor, uint64_t fenceValue);
 
 
@@ -0,0 +1,112 @@
+#include "CookedMesh.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+
+CookedMesh::CookedMesh(const std::wstring &path, const CookedMeshSource &expectedSource)
+    : file(path) {
+    if (!file.isValid() || file.getSize() < sizeof(CookedMeshHeader)) {
+        return;
+    }
+
+    const auto candidate = reinterpret_cast<const CookedMeshHeader *>(file.getData());
+    if (candidate->magic != CookedMeshHeader::expectedMagic || candidate->version != CookedMeshHeader::currentVersion) {
+        return;
+    }
+    if (candidate->source.size != expectedSource.size ||
+        candidate->source.lastWriteTime != expectedSource.lastWriteTime ||
+        candidate->source.loadFlags != expectedSource.loadFlags) {
+        return;
+    }
+
+    const size_t expectedFileSize = sizeof(CookedMeshHeader) +
+                                    static_cast<size_t>(candidate->verticesCount) * candidate->vertexSizeInBytes +
+                                    static_cast<size_t>(candidate->indicesCount) * sizeof(UINT) +
+                                    static_cast<size_t>(candidate->meshletsCount) * sizeof(Meshlet) +
+                                    static_cast<size_t>(candidate->lodsCount) * sizeof(MeshLod) +
+                                    static_cast<size_t>(candidate->submeshesCount) * sizeof(MeshSubmesh);
+    if (file.getSize() != expectedFileSize || candidate->vertexSizeInBytes % sizeof(FLOAT) != 0) {
+        return;
+    }
+    if (candidate->submeshesCount == 0u || candidate->lodsCount % candidate->submeshesCount != 0) {
+        return;
+    }
+
+    header = candidate;
+}
+
+bool CookedMesh::write(const std::wstring &path, const CookedMeshHeader &header, const void *vertexData, const UINT *indexData,
+                       const Meshlet *meshletData, const MeshLod *lodData, const MeshSubmesh *submeshData) {
+    const std::wstring temporaryPath = path + L"." + std::to_wstring(GetCurrentThreadId()) + L".tmp";
+    {
+        std::ofstream outputFile{temporaryPath, std::ios::out | std::ios::binary | std::ios::trunc};
+        outputFile.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        outputFile.write(reinterpret_cast<const char *>(vertexData), static_cast<std::streamsize>(header.verticesCount) * header.vertexSizeInBytes);
+        outputFile.write(reinterpret_cast<const char *>(indexData), static_cast<std::streamsize>(header.indicesCount) * sizeof(UINT));
+        outputFile.write(reinterpret_cast<const char *>(meshletData), static_cast<std::streamsize>(header.meshletsCount) * sizeof(Meshlet));
+        outputFile.write(reinterpret_cast<const char *>(lodData), static_cast<std::streamsize>(header.lodsCount) * sizeof(MeshLod));
+        outputFile.write(reinterpret_cast<const char *>(submeshData), static_cast<std::streamsize>(header.submeshesCount) * sizeof(MeshSubmesh));
+        if (!outputFile.good()) {
+            outputFile.close();
+            DeleteFileW(temporaryPath.c_str());
+            return false;
+        }
+    }
+
+    if (!MoveFileExW(temporaryPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING)) {
+        DeleteFileW(temporaryPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+std::wstring CookedMesh::getPath(const std::wstring &sourcePath, UINT loadFlags) {
+    return sourcePath + L"." + std::to_wstring(loadFlags) + L".dxdmesh";
+}
+
+bool CookedMesh::querySource(const std::wstring &sourcePath, UINT loadFlags, CookedMeshSource &outSource) {
+    WIN32_FILE_ATTRIBUTE_DATA attributes = {};
+    if (!GetFileAttributesExW(sourcePath.c_str(), GetFileExInfoStandard, &attributes)) {
+        return false;
+    }
+
+    outSource.size = (static_cast<UINT64>(attributes.nFileSizeHigh) << 32) | attributes.nFileSizeLow;
+    outSource.lastWriteTime = (static_cast<UINT64>(attributes.ftLastWriteTime.dwHighDateTime) << 32) | attributes.ftLastWriteTime.dwLowDateTime;
+    outSource.loadFlags = loadFlags;
+    return true;
+}
+
+void CookedMesh::computeBounds(const FLOAT *vertexData, UINT verticesCount, UINT vertexSizeInBytes, FLOAT outMin[3], FLOAT outMax[3]) {
+    for (auto component = 0u; component < 3u; component++) {
+        outMin[component] = verticesCount > 0 ? std::numeric_limits<FLOAT>::max() : 0.f;
+        outMax[component] = verticesCount > 0 ? std::numeric_limits<FLOAT>::lowest() : 0.f;
+    }
+
+    const size_t vertexSizeInFloats = vertexSizeInBytes / sizeof(FLOAT);
+    for (size_t vertexIndex = 0u; vertexIndex < verticesCount; vertexIndex++) {
+        const FLOAT *position = vertexData + vertexIndex * vertexSizeInFloats;
+        for (auto component = 0u; component < 3u; component++) {
+            outMin[component] = std::min(outMin[component], position[component]);
+            outMax[component] = std::max(outMax[component], position[component]);
+        }
+    }
+}
+
+void CookedMesh::computeBoundingSphere(const FLOAT *vertexData, UINT verticesCount, UINT vertexSizeInBytes,
+                                       const FLOAT boundsMin[3], const FLOAT boundsMax[3], FLOAT outSphere[4]) {
+    for (auto component = 0u; component < 3u; component++) {
+        outSphere[component] = (boundsMin[component] + boundsMax[component]) * 0.5f;
+    }
+
+    // Squared distances are compared, so there is only one square root
+    const size_t vertexSizeInFloats = vertexSizeInBytes / sizeof(FLOAT);
+    FLOAT maxDistanceSquared = 0.f;
+    for (size_t vertexIndex = 0u; vertexIndex < verticesCount; vertexIndex++) {
+        const FLOAT *position = vertexData + vertexIndex * vertexSizeInFloats;
+        const FLOAT offset[3] = {position[0] - outSphere[0], position[1] - outSphere[1], position[2] - outSphere[2]};
+        maxDistanceSquared = std::max(maxDistanceSquared, offset[0] * offset[0] + offset[1] * offset[1] + offset[2] * offset[2]);
+    }
+    outSphere[3] = std::sqrt(maxDistanceSquared);
+}
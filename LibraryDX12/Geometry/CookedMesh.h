@@ -0,0 +1,90 @@
+#pragma once
+
+#include "Geometry/MeshSimplifier.h"
+#include "Geometry/MeshletBuilder.h"
+#include "Utility/MemoryMappedFile.h"
+
+#include "DXD/Utility/NonCopyableAndMovable.h"
+
+#include <DXD/ExternalHeadersWrappers/windows.h>
+#include <string>
+
+/// \brief Identification of the source file a cooked mesh has been generated from
+struct CookedMeshSource {
+    UINT64 size;
+    UINT64 lastWriteTime;
+    UINT loadFlags; // loader-defined flags which affect the processing, e.g. whether tangents are computed
+    UINT reserved = 0u;
+};
+
+/// \brief Fixed-size header at the beginning of a cooked mesh file
+struct CookedMeshHeader {
+    constexpr static UINT expectedMagic = 0x4D445844; // "DXDM"
+    constexpr static UINT currentVersion = 7u;        // has to be bumped each time file layout or mesh processing changes
+
+    UINT magic;
+    UINT version;
+    CookedMeshSource source;
+    UINT meshType;
+    UINT vertexSizeInBytes;
+    UINT verticesCount;
+    UINT indicesCount;
+    FLOAT boundsMin[3];
+    FLOAT boundsMax[3];
+    FLOAT boundingSphere[4]; // center and radius
+    UINT meshletsCount;
+    UINT lodsCount; // one per submesh at each level of detail
+    UINT submeshesCount;
+    UINT reserved;
+    CookedMeshSource materialLibrarySource; // materials are baked into submeshes, so the library has to be up to date as well
+    char materialLibrary[256];              // path relative to the source, empty if there are no materials
+};
+static_assert(sizeof(CookedMeshHeader) % sizeof(UINT64) == 0, "Vertex data following the header has to be aligned");
+
+/// \brief Binary mesh file containing results of CPU processing of a source mesh
+///
+/// File consists of CookedMeshHeader followed by interleaved vertex blob, 32-bit index blob, meshlet
+/// blob, level of detail blob and submesh blob, so the data can be uploaded to GPU straight from the mapped file without any parsing. Cooked mesh
+/// is matched with its source by size and last write time, hence any edit to the source file makes
+/// it stale and it's simply regenerated by the loader.
+class CookedMesh : DXD::NonCopyableAndMovable {
+public:
+    /// Maps the file and validates it against the source. Missing, corrupted, stale files and files
+    /// of other versions result in an invalid object.
+    CookedMesh(const std::wstring &path, const CookedMeshSource &expectedSource);
+
+    bool isValid() const { return header != nullptr; }
+    const CookedMeshHeader &getHeader() const { return *header; }
+    const void *getVertexData() const { return header + 1; }
+    const UINT *getIndexData() const { return reinterpret_cast<const UINT *>(static_cast<const BYTE *>(getVertexData()) + getVertexDataSize()); }
+    const Meshlet *getMeshletData() const { return reinterpret_cast<const Meshlet *>(getIndexData() + header->indicesCount); }
+    const MeshLod *getLodData() const { return reinterpret_cast<const MeshLod *>(getMeshletData() + header->meshletsCount); }
+    const MeshSubmesh *getSubmeshData() const { return reinterpret_cast<const MeshSubmesh *>(getLodData() + header->lodsCount); }
+
+    /// Writes cooked mesh to a temporary file and then moves it to the final location, so concurrent
+    /// readers never see a partially written file.
+    /// \return true on success, failures should not be fatal to the loader, it's just a cache
+    static bool write(const std::wstring &path, const CookedMeshHeader &header, const void *vertexData, const UINT *indexData,
+                      const Meshlet *meshletData, const MeshLod *lodData, const MeshSubmesh *submeshData);
+
+    /// Cooked meshes are stored next to their sources. Load flags are a part of the name, so meshes
+    /// loaded from the same source with different settings do not overwrite each other.
+    static std::wstring getPath(const std::wstring &sourcePath, UINT loadFlags);
+
+    /// Fills size and last write time of the source, returns false if it cannot be queried
+    static bool querySource(const std::wstring &sourcePath, UINT loadFlags, CookedMeshSource &outSource);
+
+    /// Computes axis aligned bounds of vertex positions, which are assumed to be first 3 elements of a vertex
+    static void computeBounds(const FLOAT *vertexData, UINT verticesCount, UINT vertexSizeInBytes, FLOAT outMin[3], FLOAT outMax[3]);
+
+    /// Computes sphere centered in the middle of axis aligned bounds, containing all vertex positions. It's usually
+    /// tighter than the sphere circumscribed on the box, since corners of the box are rarely occupied.
+    static void computeBoundingSphere(const FLOAT *vertexData, UINT verticesCount, UINT vertexSizeInBytes,
+                                      const FLOAT boundsMin[3], const FLOAT boundsMax[3], FLOAT outSphere[4]);
+
+private:
+    size_t getVertexDataSize() const { return static_cast<size_t>(header->verticesCount) * header->vertexSizeInBytes; }
+
+    MemoryMappedFile file;
+    const CookedMeshHeader *header = nullptr;
+};
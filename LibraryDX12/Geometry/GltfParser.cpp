@@ -0,0 +1,505 @@
+#include "GltfParser.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+// ----------------------------------------------------------------- JSON
+
+namespace {
+/// Minimal JSON tree, strings point into the parsed text and their escape sequences are not decoded,
+/// which is enough for glTF keys and enumerations
+struct JsonValue {
+    enum class Type {
+        NUL,
+        BOOLEAN,
+        NUMBER,
+        STRING,
+        ARRAY,
+        OBJECT,
+    };
+
+    Type type = Type::NUL;
+    double number = 0.0;
+    const char *stringBegin = nullptr;
+    const char *stringEnd = nullptr;
+    std::vector<JsonValue> elements = {};                             // array elements or object member values
+    std::vector<std::pair<const char *, const char *>> memberNames = {}; // object member names, parallel to elements
+
+    const JsonValue *find(const char *name) const {
+        if (type != Type::OBJECT) {
+            return nullptr;
+        }
+        const size_t nameLength = std::strlen(name);
+        for (auto i = 0u; i < memberNames.size(); i++) {
+            const size_t length = static_cast<size_t>(memberNames[i].second - memberNames[i].first);
+            if (length == nameLength && std::memcmp(memberNames[i].first, name, length) == 0) {
+                return &elements[i];
+            }
+        }
+        return nullptr;
+    }
+
+    const JsonValue *at(size_t index) const {
+        return (type == Type::ARRAY && index < elements.size()) ? &elements[index] : nullptr;
+    }
+
+    bool isUnsigned() const {
+        return type == Type::NUMBER && number >= 0.0 && number <= 4294967295.0 && std::floor(number) == number;
+    }
+};
+
+class JsonParser {
+public:
+    JsonParser(const char *begin, const char *end) : current(begin), end(end) {}
+
+    bool parse(JsonValue &outValue) {
+        if (!parseValue(outValue, 0u)) {
+            return false;
+        }
+        skipSpaces();
+        return current == end;
+    }
+
+private:
+    constexpr static uint32_t maxDepth = 64u;
+
+    void skipSpaces() {
+        while (current < end && (*current == ' ' || *current == '\t' || *current == '\r' || *current == '\n')) {
+            current++;
+        }
+    }
+
+    bool consume(char character) {
+        skipSpaces();
+        if (current < end && *current == character) {
+            current++;
+            return true;
+        }
+        return false;
+    }
+
+    bool consumeKeyword(const char *keyword) {
+        const size_t length = std::strlen(keyword);
+        if (static_cast<size_t>(end - current) < length || std::memcmp(current, keyword, length) != 0) {
+            return false;
+        }
+        current += length;
+        return true;
+    }
+
+    bool parseValue(JsonValue &outValue, uint32_t depth) {
+        if (depth > maxDepth) {
+            return false;
+        }
+
+        skipSpaces();
+        if (current == end) {
+            return false;
+        }
+        switch (*current) {
+        case '{':
+            return parseObject(outValue, depth);
+        case '[':
+            return parseArray(outValue, depth);
+        case '"':
+            outValue.type = JsonValue::Type::STRING;
+            return parseString(outValue.stringBegin, outValue.stringEnd);
+        case 't':
+            outValue.type = JsonValue::Type::BOOLEAN;
+            outValue.number = 1.0;
+            return consumeKeyword("true");
+        case 'f':
+            outValue.type = JsonValue::Type::BOOLEAN;
+            return consumeKeyword("false");
+        case 'n':
+            outValue.type = JsonValue::Type::NUL;
+            return consumeKeyword("null");
+        default:
+            outValue.type = JsonValue::Type::NUMBER;
+            return parseNumber(outValue.number);
+        }
+    }
+
+    bool parseObject(JsonValue &outValue, uint32_t depth) {
+        outValue.type = JsonValue::Type::OBJECT;
+        current++;
+        if (consume('}')) {
+            return true;
+        }
+        do {
+            skipSpaces();
+            std::pair<const char *, const char *> name{};
+            if (current == end || *current != '"' || !parseString(name.first, name.second) || !consume(':')) {
+                return false;
+            }
+            outValue.memberNames.push_back(name);
+            outValue.elements.emplace_back();
+            if (!parseValue(outValue.elements.back(), depth + 1)) {
+                return false;
+            }
+        } while (consume(','));
+        return consume('}');
+    }
+
+    bool parseArray(JsonValue &outValue, uint32_t depth) {
+        outValue.type = JsonValue::Type::ARRAY;
+        current++;
+        if (consume(']')) {
+            return true;
+        }
+        do {
+            outValue.elements.emplace_back();
+            if (!parseValue(outValue.elements.back(), depth + 1)) {
+                return false;
+            }
+        } while (consume(','));
+        return consume(']');
+    }
+
+    bool parseString(const char *&outBegin, const char *&outEnd) {
+        outBegin = ++current;
+        while (current < end && *current != '"') {
+            current += (*current == '\\') ? 2 : 1;
+        }
+        if (current >= end) {
+            return false;
+        }
+        outEnd = current++;
+        return true;
+    }
+
+    bool parseNumber(double &outValue) {
+        const bool negative = current < end && *current == '-';
+        if (negative) {
+            current++;
+        }
+
+        // Mantissa is accumulated as an integer, so offsets and counts are exact
+        double mantissa = 0.0;
+        int exponent = 0;
+        bool anyDigit = false;
+        for (; current < end && *current >= '0' && *current <= '9'; current++) {
+            mantissa = mantissa * 10.0 + (*current - '0');
+            anyDigit = true;
+        }
+        if (current < end && *current == '.') {
+            for (current++; current < end && *current >= '0' && *current <= '9'; current++) {
+                mantissa = mantissa * 10.0 + (*current - '0');
+                exponent--;
+                anyDigit = true;
+            }
+        }
+        if (!anyDigit) {
+            return false;
+        }
+        if (current < end && (*current == 'e' || *current == 'E')) {
+            current++;
+            const bool negativeExponent = current < end && *current == '-';
+            if (current < end && (*current == '-' || *current == '+')) {
+                current++;
+            }
+            int explicitExponent = 0;
+            bool anyExponentDigit = false;
+            for (; current < end && *current >= '0' && *current <= '9'; current++) {
+                explicitExponent = std::min(explicitExponent * 10 + (*current - '0'), 10000);
+                anyExponentDigit = true;
+            }
+            if (!anyExponentDigit) {
+                return false;
+            }
+            exponent += negativeExponent ? -explicitExponent : explicitExponent;
+        }
+
+        outValue = mantissa * std::pow(10.0, exponent);
+        if (negative) {
+            outValue = -outValue;
+        }
+        return true;
+    }
+
+    const char *current;
+    const char *end;
+};
+
+// ----------------------------------------------------------------- glTF helpers
+
+uint32_t readUint32(const char *data) {
+    uint32_t value{};
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+bool getUnsigned(const JsonValue &object, const char *name, uint32_t defaultValue, uint32_t &outValue) {
+    const JsonValue *value = object.find(name);
+    if (value == nullptr) {
+        outValue = defaultValue;
+        return true;
+    }
+    if (!value->isUnsigned()) {
+        return false;
+    }
+    outValue = static_cast<uint32_t>(value->number);
+    return true;
+}
+
+bool getComponentsCount(const JsonValue &typeValue, uint32_t &outCount) {
+    if (typeValue.type != JsonValue::Type::STRING) {
+        return false;
+    }
+    const size_t length = static_cast<size_t>(typeValue.stringEnd - typeValue.stringBegin);
+    const char *names[] = {"SCALAR", "VEC2", "VEC3", "VEC4"};
+    for (auto i = 0u; i < 4u; i++) {
+        if (length == std::strlen(names[i]) && std::memcmp(typeValue.stringBegin, names[i], length) == 0) {
+            outCount = i + 1;
+            return true;
+        }
+    }
+    return false; // matrices are never used for vertex attributes
+}
+
+bool isComponentTypeValid(uint32_t componentType) {
+    switch (static_cast<GltfAccessor::ComponentType>(componentType)) {
+    case GltfAccessor::ComponentType::BYTE:
+    case GltfAccessor::ComponentType::UNSIGNED_BYTE:
+    case GltfAccessor::ComponentType::SHORT:
+    case GltfAccessor::ComponentType::UNSIGNED_SHORT:
+    case GltfAccessor::ComponentType::UNSIGNED_INT:
+    case GltfAccessor::ComponentType::FLOAT:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Resolves accessor and its buffer view to a range of the binary chunk, validating all bounds
+bool resolveAccessor(const JsonValue &root, uint32_t accessorIndex, const char *binChunk, size_t binChunkSize, GltfAccessor &outAccessor) {
+    const JsonValue *accessors = root.find("accessors");
+    const JsonValue *accessor = accessors != nullptr ? accessors->at(accessorIndex) : nullptr;
+    if (accessor == nullptr || accessor->find("sparse") != nullptr) {
+        return false;
+    }
+
+    uint32_t bufferViewIndex{}, accessorOffset{}, componentType{}, count{};
+    const JsonValue *type = accessor->find("type");
+    const JsonValue *normalized = accessor->find("normalized");
+    if (accessor->find("bufferView") == nullptr || type == nullptr ||
+        !getUnsigned(*accessor, "bufferView", 0u, bufferViewIndex) ||
+        !getUnsigned(*accessor, "byteOffset", 0u, accessorOffset) ||
+        !getUnsigned(*accessor, "componentType", 0u, componentType) ||
+        !getUnsigned(*accessor, "count", 0u, count) ||
+        !isComponentTypeValid(componentType) ||
+        !getComponentsCount(*type, outAccessor.componentsCount)) {
+        return false;
+    }
+    outAccessor.componentType = static_cast<GltfAccessor::ComponentType>(componentType);
+    outAccessor.count = count;
+    outAccessor.normalized = normalized != nullptr && normalized->type == JsonValue::Type::BOOLEAN && normalized->number != 0.0;
+
+    const JsonValue *bufferViews = root.find("bufferViews");
+    const JsonValue *bufferView = bufferViews != nullptr ? bufferViews->at(bufferViewIndex) : nullptr;
+    uint32_t bufferIndex{}, viewOffset{}, viewLength{}, viewStride{};
+    if (bufferView == nullptr ||
+        !getUnsigned(*bufferView, "buffer", 0u, bufferIndex) ||
+        !getUnsigned(*bufferView, "byteOffset", 0u, viewOffset) ||
+        !getUnsigned(*bufferView, "byteLength", 0u, viewLength) ||
+        !getUnsigned(*bufferView, "byteStride", 0u, viewStride)) {
+        return false;
+    }
+
+    // Only the buffer stored in the binary chunk of the glb is supported
+    const JsonValue *buffers = root.find("buffers");
+    const JsonValue *buffer = buffers != nullptr ? buffers->at(bufferIndex) : nullptr;
+    if (bufferIndex != 0u || buffer == nullptr || buffer->find("uri") != nullptr) {
+        return false;
+    }
+
+    const uint32_t elementSize = outAccessor.getElementSizeInBytes();
+    outAccessor.strideInBytes = viewStride != 0u ? viewStride : elementSize;
+    const size_t accessedSize = count == 0u ? 0u : static_cast<size_t>(outAccessor.strideInBytes) * (count - 1) + elementSize;
+    if (static_cast<size_t>(viewOffset) + viewLength > binChunkSize || static_cast<size_t>(accessorOffset) + accessedSize > viewLength) {
+        return false;
+    }
+    if ((static_cast<size_t>(viewOffset) + accessorOffset) % outAccessor.getComponentSizeInBytes() != 0u) {
+        return false;
+    }
+    outAccessor.data = reinterpret_cast<const uint8_t *>(binChunk) + viewOffset + accessorOffset;
+    return true;
+}
+
+bool resolveAttribute(const JsonValue &root, const JsonValue &attributes, const char *name, const char *binChunk, size_t binChunkSize,
+                      GltfAccessor &outAccessor) {
+    uint32_t accessorIndex{};
+    if (attributes.find(name) == nullptr) {
+        return true; // absent attributes are left empty
+    }
+    return getUnsigned(attributes, name, 0u, accessorIndex) &&
+           resolveAccessor(root, accessorIndex, binChunk, binChunkSize, outAccessor);
+}
+} // namespace
+
+// ----------------------------------------------------------------- GltfAccessor
+
+uint32_t GltfAccessor::getComponentSizeInBytes() const {
+    switch (componentType) {
+    case ComponentType::BYTE:
+    case ComponentType::UNSIGNED_BYTE:
+        return 1u;
+    case ComponentType::SHORT:
+    case ComponentType::UNSIGNED_SHORT:
+        return 2u;
+    default:
+        return 4u;
+    }
+}
+
+float GltfAccessor::readFloat(uint32_t element, uint32_t component) const {
+    const uint8_t *address = data + static_cast<size_t>(element) * strideInBytes + component * getComponentSizeInBytes();
+    switch (componentType) {
+    case ComponentType::BYTE: {
+        const auto value = *reinterpret_cast<const int8_t *>(address);
+        return normalized ? std::max(value / 127.f, -1.f) : value;
+    }
+    case ComponentType::UNSIGNED_BYTE: {
+        const auto value = *reinterpret_cast<const uint8_t *>(address);
+        return normalized ? value / 255.f : value;
+    }
+    case ComponentType::SHORT: {
+        const auto value = *reinterpret_cast<const int16_t *>(address);
+        return normalized ? std::max(value / 32767.f, -1.f) : value;
+    }
+    case ComponentType::UNSIGNED_SHORT: {
+        const auto value = *reinterpret_cast<const uint16_t *>(address);
+        return normalized ? value / 65535.f : value;
+    }
+    case ComponentType::UNSIGNED_INT:
+        return static_cast<float>(*reinterpret_cast<const uint32_t *>(address));
+    default:
+        return *reinterpret_cast<const float *>(address);
+    }
+}
+
+uint32_t GltfAccessor::readUnsigned(uint32_t element) const {
+    const uint8_t *address = data + static_cast<size_t>(element) * strideInBytes;
+    switch (componentType) {
+    case ComponentType::UNSIGNED_BYTE:
+        return *address;
+    case ComponentType::UNSIGNED_SHORT:
+        return *reinterpret_cast<const uint16_t *>(address);
+    case ComponentType::UNSIGNED_INT:
+        return *reinterpret_cast<const uint32_t *>(address);
+    default:
+        return static_cast<uint32_t>(readFloat(element, 0u));
+    }
+}
+
+// ----------------------------------------------------------------- GltfParser
+
+bool GltfParser::parseGlb(const char *data, size_t size, std::vector<GltfPrimitive> &outPrimitives) {
+    outPrimitives.clear();
+
+    // Header and chunks, JSON is always first and binary chunk is optional
+    constexpr size_t headerSize = 12u;
+    constexpr size_t chunkHeaderSize = 8u;
+    if (size < headerSize + chunkHeaderSize || readUint32(data) != glbMagic || readUint32(data + 4) != 2u || readUint32(data + 8) > size) {
+        return false;
+    }
+    const size_t fileSize = readUint32(data + 8);
+    const size_t jsonChunkSize = readUint32(data + headerSize);
+    const char *jsonChunk = data + headerSize + chunkHeaderSize;
+    if (readUint32(data + headerSize + 4) != jsonChunkType || headerSize + chunkHeaderSize + jsonChunkSize > fileSize) {
+        return false;
+    }
+    const char *binChunk = nullptr;
+    size_t binChunkSize = 0u;
+    const size_t binChunkHeaderOffset = headerSize + chunkHeaderSize + jsonChunkSize;
+    if (binChunkHeaderOffset + chunkHeaderSize <= fileSize && readUint32(data + binChunkHeaderOffset + 4) == binChunkType) {
+        binChunkSize = readUint32(data + binChunkHeaderOffset);
+        binChunk = data + binChunkHeaderOffset + chunkHeaderSize;
+        if (binChunkHeaderOffset + chunkHeaderSize + binChunkSize > fileSize) {
+            return false;
+        }
+    }
+
+    JsonValue root{};
+    if (!JsonParser{jsonChunk, jsonChunk + jsonChunkSize}.parse(root)) {
+        return false;
+    }
+
+    // Only the first mesh is loaded, all of its primitives have to be triangle lists
+    const JsonValue *meshes = root.find("meshes");
+    const JsonValue *mesh = meshes != nullptr ? meshes->at(0) : nullptr;
+    const JsonValue *primitives = mesh != nullptr ? mesh->find("primitives") : nullptr;
+    if (primitives == nullptr || primitives->type != JsonValue::Type::ARRAY || primitives->elements.empty()) {
+        return false;
+    }
+    for (const JsonValue &primitive : primitives->elements) {
+        constexpr uint32_t trianglesMode = 4u;
+        uint32_t mode{};
+        const JsonValue *attributes = primitive.find("attributes");
+        if (attributes == nullptr || attributes->find("POSITION") == nullptr ||
+            !getUnsigned(primitive, "mode", trianglesMode, mode) || mode != trianglesMode) {
+            return false;
+        }
+
+        GltfPrimitive result{};
+        if (!resolveAttribute(root, *attributes, "POSITION", binChunk, binChunkSize, result.positions) ||
+            !resolveAttribute(root, *attributes, "NORMAL", binChunk, binChunkSize, result.normals) ||
+            !resolveAttribute(root, *attributes, "TANGENT", binChunk, binChunkSize, result.tangents) ||
+            !resolveAttribute(root, *attributes, "TEXCOORD_0", binChunk, binChunkSize, result.textureCoordinates)) {
+            return false;
+        }
+        if (primitive.find("indices") != nullptr) {
+            uint32_t indicesAccessor{};
+            if (!getUnsigned(primitive, "indices", 0u, indicesAccessor) ||
+                !resolveAccessor(root, indicesAccessor, binChunk, binChunkSize, result.indices)) {
+                return false;
+            }
+        }
+
+        // Validate types mandated by the specification, so the loader can rely on them
+        const auto isFloat3 = [](const GltfAccessor &accessor) {
+            return accessor.componentType == GltfAccessor::ComponentType::FLOAT && accessor.componentsCount == 3u;
+        };
+        const uint32_t verticesCount = result.positions.count;
+        const bool positionsValid = isFloat3(result.positions);
+        const bool normalsValid = !result.normals.isPresent() || (isFloat3(result.normals) && result.normals.count == verticesCount);
+        const bool tangentsValid = !result.tangents.isPresent() || (result.tangents.componentType == GltfAccessor::ComponentType::FLOAT &&
+                                                                    result.tangents.componentsCount == 4u && result.tangents.count == verticesCount);
+        const bool textureCoordinatesValid = !result.textureCoordinates.isPresent() ||
+                                             (result.textureCoordinates.componentsCount == 2u && result.textureCoordinates.count == verticesCount);
+        const bool indicesValid = !result.indices.isPresent() || (result.indices.componentsCount == 1u && result.indices.count % 3 == 0u &&
+                                                                  (result.indices.componentType == GltfAccessor::ComponentType::UNSIGNED_BYTE ||
+                                                                   result.indices.componentType == GltfAccessor::ComponentType::UNSIGNED_SHORT ||
+                                                                   result.indices.componentType == GltfAccessor::ComponentType::UNSIGNED_INT));
+        if (!positionsValid || !normalsValid || !tangentsValid || !textureCoordinatesValid || !indicesValid) {
+            return false;
+        }
+        if (!result.indices.isPresent() && verticesCount % 3 != 0u) {
+            return false;
+        }
+        for (uint32_t index = 0u; result.indices.isPresent() && index < result.indices.count; index++) {
+            if (result.indices.readUnsigned(index) >= verticesCount) {
+                return false;
+            }
+        }
+
+        outPrimitives.push_back(result);
+    }
+    return true;
+}
+
+bool GltfParser::hasRequestedAttributes(const std::vector<GltfPrimitive> &primitives, bool textureCoordinates, bool tangents) {
+    if (tangents && !textureCoordinates) {
+        return false;
+    }
+    for (const GltfPrimitive &primitive : primitives) {
+        const bool textureCoordinatesAvailable = primitive.textureCoordinates.isPresent();
+        const bool tangentsAvailable = primitive.tangents.isPresent() || textureCoordinatesAvailable;
+        if ((textureCoordinates && !textureCoordinatesAvailable) || (tangents && !tangentsAvailable)) {
+            return false;
+        }
+    }
+    return true;
+}
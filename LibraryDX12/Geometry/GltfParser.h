@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// \brief Typed view of elements stored in the binary chunk of a glb file, as described by a glTF accessor
+///
+/// Data is not copied, the view points directly into the parsed buffer.
+struct GltfAccessor {
+    enum class ComponentType : uint32_t {
+        BYTE = 5120,
+        UNSIGNED_BYTE = 5121,
+        SHORT = 5122,
+        UNSIGNED_SHORT = 5123,
+        UNSIGNED_INT = 5125,
+        FLOAT = 5126,
+    };
+
+    const uint8_t *data = nullptr; // first element, nullptr if the accessor is not present
+    uint32_t count = 0u;
+    uint32_t componentsCount = 0u; // e.g. 3 for VEC3
+    ComponentType componentType = ComponentType::FLOAT;
+    uint32_t strideInBytes = 0u; // distance between consecutive elements, equal to the element size if they're tightly packed
+    bool normalized = false;
+
+    bool isPresent() const { return data != nullptr; }
+    uint32_t getComponentSizeInBytes() const;
+    uint32_t getElementSizeInBytes() const { return componentsCount * getComponentSizeInBytes(); }
+    bool isTightlyPacked() const { return strideInBytes == getElementSizeInBytes(); }
+
+    /// Converts component to float, normalized integers are mapped to [0, 1] or [-1, 1] range
+    float readFloat(uint32_t element, uint32_t component) const;
+    /// Reads first component of an integer element, used for indices
+    uint32_t readUnsigned(uint32_t element) const;
+};
+
+/// \brief Triangle list with attributes used by the engine, absent attributes have no data
+struct GltfPrimitive {
+    GltfAccessor positions = {};
+    GltfAccessor normals = {};
+    GltfAccessor tangents = {};
+    GltfAccessor textureCoordinates = {};
+    GltfAccessor indices = {}; // if not present, every 3 consecutive vertices form a triangle
+};
+
+/// \brief Parser of binary glTF 2.0 files (.glb)
+///
+/// JSON chunk is parsed to resolve accessors and buffer views of the first mesh in the file. Vertex and
+/// index data are never copied, returned accessors point into the binary chunk of the input buffer, which
+/// is typically a MemoryMappedFile. Buffers referenced by URI and sparse accessors are not supported.
+/// Parser depends only on the standard library, so it can be tested on any platform.
+class GltfParser {
+public:
+    GltfParser() = delete;
+
+    /// \param data contents of the whole glb file, it has to outlive returned accessors
+    /// \param size size of the file in bytes
+    /// \param outPrimitives triangle primitives of the first mesh, previous contents are discarded
+    /// \return false if the file is malformed or uses unsupported features
+    static bool parseGlb(const char *data, size_t size, std::vector<GltfPrimitive> &outPrimitives);
+
+    /// Checks if all primitives provide attributes requested by the loader. Tangents are used only for normal mapping,
+    /// which needs texture coordinates, so they cannot be requested without them, like for meshes created from memory
+    /// \param textureCoordinates texture coordinates have to be stored in the file
+    /// \param tangents tangents have to be stored in the file or computable from texture coordinates
+    /// \return false if any requested attribute is unavailable or the combination is not supported
+    static bool hasRequestedAttributes(const std::vector<GltfPrimitive> &primitives, bool textureCoordinates, bool tangents);
+
+    constexpr static uint32_t glbMagic = 0x46546C67;     // "glTF"
+    constexpr static uint32_t jsonChunkType = 0x4E4F534A; // "JSON"
+    constexpr static uint32_t binChunkType = 0x004E4942;  // "BIN\0"
+};
@@ -0,0 +1,306 @@
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// ----------------------------------------------------------------- Helpers
+
+namespace {
+constexpr UINT invalidIndex = std::numeric_limits<UINT>::max();
+
+// FIFO cache simulated with timestamps - vertex is cached, if less than cacheSize misses happened since it was loaded
+struct VertexCache {
+    VertexCache(UINT verticesCount, UINT cacheSize) : timestamps(verticesCount, 0u), cacheSize(cacheSize), time(cacheSize + 1) {}
+
+    bool isCached(UINT vertex) const { return time - timestamps[vertex] <= cacheSize; }
+    UINT getAge(UINT vertex) const { return time - timestamps[vertex]; }
+    void clear() { time += cacheSize + 1; }
+
+    // Returns number of misses caused by the triangle
+    UINT processTriangle(const UINT *triangle) {
+        UINT misses = 0u;
+        for (auto corner = 0u; corner < 3u; corner++) {
+            misses += processVertex(triangle[corner]);
+        }
+        return misses;
+    }
+
+    UINT processVertex(UINT vertex) {
+        if (isCached(vertex)) {
+            return 0u;
+        }
+        timestamps[vertex] = time++;
+        return 1u;
+    }
+
+    std::vector<UINT> timestamps;
+    const UINT cacheSize;
+    UINT time;
+};
+
+struct Float3 {
+    FLOAT x, y, z;
+};
+
+Float3 getPosition(const std::vector<FLOAT> &vertexElements, UINT vertexSizeInFloats, UINT vertex) {
+    const FLOAT *position = vertexElements.data() + static_cast<size_t>(vertex) * vertexSizeInFloats;
+    return Float3{position[0], position[1], position[2]};
+}
+} // namespace
+
+// ----------------------------------------------------------------- Vertex cache
+
+void MeshOptimizer::optimizeVertexCache(std::vector<UINT> &indices, UINT verticesCount, UINT cacheSize) {
+    const UINT trianglesCount = static_cast<UINT>(indices.size() / 3);
+
+    // Triangles adjacent to each vertex, stored contiguously with per-vertex offsets
+    std::vector<UINT> adjacencyOffsets(verticesCount + 1, 0u);
+    for (UINT index : indices) {
+        adjacencyOffsets[index + 1]++;
+    }
+    for (UINT vertex = 0u; vertex < verticesCount; vertex++) {
+        adjacencyOffsets[vertex + 1] += adjacencyOffsets[vertex];
+    }
+    std::vector<UINT> adjacency(indices.size());
+    std::vector<UINT> adjacencyFill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+    for (UINT triangle = 0u; triangle < trianglesCount; triangle++) {
+        for (auto corner = 0u; corner < 3u; corner++) {
+            adjacency[adjacencyFill[indices[3 * triangle + corner]]++] = triangle;
+        }
+    }
+
+    // Tipsify state
+    std::vector<UINT> liveTriangles(verticesCount);
+    for (UINT vertex = 0u; vertex < verticesCount; vertex++) {
+        liveTriangles[vertex] = adjacencyOffsets[vertex + 1] - adjacencyOffsets[vertex];
+    }
+    std::vector<char> emitted(trianglesCount, false);
+    std::vector<UINT> deadEndStack{};
+    std::vector<UINT> candidates{};
+    VertexCache cache{verticesCount, cacheSize};
+    UINT cursor = 0u;
+    std::vector<UINT> outIndices{};
+    outIndices.reserve(indices.size());
+
+    auto findNextVertexWithLiveTriangles = [&]() {
+        while (!deadEndStack.empty()) {
+            const UINT vertex = deadEndStack.back();
+            deadEndStack.pop_back();
+            if (liveTriangles[vertex] > 0) {
+                return vertex;
+            }
+        }
+        for (; cursor < verticesCount; cursor++) {
+            if (liveTriangles[cursor] > 0) {
+                return cursor;
+            }
+        }
+        return invalidIndex;
+    };
+
+    // Emit all triangles around the fanning vertex, then select the next one among their vertices
+    for (UINT fanningVertex = findNextVertexWithLiveTriangles(); fanningVertex != invalidIndex;) {
+        candidates.clear();
+        for (UINT adjacencyIndex = adjacencyOffsets[fanningVertex]; adjacencyIndex < adjacencyOffsets[fanningVertex + 1]; adjacencyIndex++) {
+            const UINT triangle = adjacency[adjacencyIndex];
+            if (emitted[triangle]) {
+                continue;
+            }
+            for (auto corner = 0u; corner < 3u; corner++) {
+                const UINT vertex = indices[3 * triangle + corner];
+                outIndices.push_back(vertex);
+                deadEndStack.push_back(vertex);
+                candidates.push_back(vertex);
+                liveTriangles[vertex]--;
+                cache.processVertex(vertex);
+            }
+            emitted[triangle] = true;
+        }
+
+        // Prefer vertices which will still be in the cache after emitting all their remaining triangles
+        UINT bestVertex = invalidIndex;
+        INT bestPriority = -1;
+        for (UINT vertex : candidates) {
+            if (liveTriangles[vertex] == 0) {
+                continue;
+            }
+            INT priority = 0;
+            if (cache.getAge(vertex) + 2 * liveTriangles[vertex] <= cacheSize) {
+                priority = static_cast<INT>(cache.getAge(vertex));
+            }
+            if (priority > bestPriority) {
+                bestPriority = priority;
+                bestVertex = vertex;
+            }
+        }
+        fanningVertex = bestVertex != invalidIndex ? bestVertex : findNextVertexWithLiveTriangles();
+    }
+
+    indices = std::move(outIndices);
+}
+
+// ----------------------------------------------------------------- Overdraw
+
+void MeshOptimizer::optimizeOverdraw(std::vector<UINT> &indices, const std::vector<FLOAT> &vertexElements, UINT vertexSizeInFloats,
+                                     UINT cacheSize, FLOAT threshold) {
+    const UINT trianglesCount = static_cast<UINT>(indices.size() / 3);
+    const UINT verticesCount = static_cast<UINT>(vertexElements.size() / vertexSizeInFloats);
+    if (trianglesCount == 0u) {
+        return;
+    }
+
+    // Hard boundaries - triangles missing the cache with all their vertices, usually a jump to a different part of the mesh
+    VertexCache cache{verticesCount, cacheSize};
+    std::vector<UINT> hardBoundaries{};
+    for (UINT triangle = 0u; triangle < trianglesCount; triangle++) {
+        if (cache.processTriangle(indices.data() + 3 * triangle) == 3u || triangle == 0u) {
+            hardBoundaries.push_back(triangle);
+        }
+    }
+    hardBoundaries.push_back(trianglesCount);
+
+    // Soft boundaries - split hard clusters as soon as the subcluster reaches ACMR close enough to the whole cluster
+    std::vector<UINT> clusterBoundaries{};
+    for (size_t hardClusterIndex = 0u; hardClusterIndex + 1 < hardBoundaries.size(); hardClusterIndex++) {
+        const UINT clusterBegin = hardBoundaries[hardClusterIndex];
+        const UINT clusterEnd = hardBoundaries[hardClusterIndex + 1];
+
+        cache.clear();
+        UINT clusterMisses = 0u;
+        for (UINT triangle = clusterBegin; triangle < clusterEnd; triangle++) {
+            clusterMisses += cache.processTriangle(indices.data() + 3 * triangle);
+        }
+        const FLOAT targetAcmr = threshold * clusterMisses / (clusterEnd - clusterBegin);
+
+        clusterBoundaries.push_back(clusterBegin);
+        cache.clear();
+        UINT runningMisses = 0u;
+        UINT runningTriangles = 0u;
+        for (UINT triangle = clusterBegin; triangle < clusterEnd; triangle++) {
+            runningMisses += cache.processTriangle(indices.data() + 3 * triangle);
+            runningTriangles++;
+            if (static_cast<FLOAT>(runningMisses) / runningTriangles <= targetAcmr) {
+                clusterBoundaries.push_back(triangle + 1);
+                cache.clear();
+                runningMisses = 0u;
+                runningTriangles = 0u;
+            }
+        }
+
+        // Last subcluster is usually small and inefficient, so it's merged with the previous one
+        if (clusterBoundaries.back() != clusterBegin) {
+            clusterBoundaries.pop_back();
+        }
+    }
+    clusterBoundaries.push_back(trianglesCount);
+
+    // Area-weighted centroid and normal of each cluster
+    struct Cluster {
+        UINT begin;
+        UINT end;
+        Float3 centroid;
+        Float3 normal;
+        FLOAT area;
+        FLOAT sortKey;
+    };
+    std::vector<Cluster> clusters{};
+    Float3 meshCentroid{};
+    FLOAT meshArea = 0.f;
+    for (size_t clusterIndex = 0u; clusterIndex + 1 < clusterBoundaries.size(); clusterIndex++) {
+        Cluster cluster{clusterBoundaries[clusterIndex], clusterBoundaries[clusterIndex + 1]};
+        for (UINT triangle = cluster.begin; triangle < cluster.end; triangle++) {
+            const Float3 a = getPosition(vertexElements, vertexSizeInFloats, indices[3 * triangle + 0]);
+            const Float3 b = getPosition(vertexElements, vertexSizeInFloats, indices[3 * triangle + 1]);
+            const Float3 c = getPosition(vertexElements, vertexSizeInFloats, indices[3 * triangle + 2]);
+            const Float3 ab{b.x - a.x, b.y - a.y, b.z - a.z};
+            const Float3 ac{c.x - a.x, c.y - a.y, c.z - a.z};
+            const Float3 cross{ab.y * ac.z - ab.z * ac.y, ab.z * ac.x - ab.x * ac.z, ab.x * ac.y - ab.y * ac.x};
+            const FLOAT area = std::sqrt(cross.x * cross.x + cross.y * cross.y + cross.z * cross.z);
+
+            cluster.centroid.x += area * (a.x + b.x + c.x) / 3;
+            cluster.centroid.y += area * (a.y + b.y + c.y) / 3;
+            cluster.centroid.z += area * (a.z + b.z + c.z) / 3;
+            cluster.normal.x += cross.x;
+            cluster.normal.y += cross.y;
+            cluster.normal.z += cross.z;
+            cluster.area += area;
+        }
+        meshCentroid.x += cluster.centroid.x;
+        meshCentroid.y += cluster.centroid.y;
+        meshCentroid.z += cluster.centroid.z;
+        meshArea += cluster.area;
+        clusters.push_back(cluster);
+    }
+    if (meshArea > 0.f) {
+        meshCentroid = Float3{meshCentroid.x / meshArea, meshCentroid.y / meshArea, meshCentroid.z / meshArea};
+    }
+
+    // Clusters facing away from the center of the mesh are likely to occlude others, so they go first
+    for (Cluster &cluster : clusters) {
+        cluster.sortKey = 0.f;
+        const FLOAT normalLength = std::sqrt(cluster.normal.x * cluster.normal.x + cluster.normal.y * cluster.normal.y + cluster.normal.z * cluster.normal.z);
+        if (cluster.area > 0.f && normalLength > 0.f) {
+            const Float3 offset{cluster.centroid.x / cluster.area - meshCentroid.x,
+                                cluster.centroid.y / cluster.area - meshCentroid.y,
+                                cluster.centroid.z / cluster.area - meshCentroid.z};
+            cluster.sortKey = (offset.x * cluster.normal.x + offset.y * cluster.normal.y + offset.z * cluster.normal.z) / normalLength;
+        }
+    }
+    std::stable_sort(clusters.begin(), clusters.end(), [](const Cluster &left, const Cluster &right) {
+        return left.sortKey > right.sortKey;
+    });
+
+    std::vector<UINT> outIndices{};
+    outIndices.reserve(indices.size());
+    for (const Cluster &cluster : clusters) {
+        outIndices.insert(outIndices.end(), indices.begin() + 3 * cluster.begin, indices.begin() + 3 * cluster.end);
+    }
+    indices = std::move(outIndices);
+}
+
+// ----------------------------------------------------------------- Vertex fetch
+
+void MeshOptimizer::optimizeVertexFetch(std::vector<UINT> &indices, std::vector<FLOAT> &vertexElements, UINT vertexSizeInFloats) {
+    const UINT verticesCount = static_cast<UINT>(vertexElements.size() / vertexSizeInFloats);
+    std::vector<UINT> remap(verticesCount, invalidIndex);
+    std::vector<FLOAT> outVertexElements{};
+    outVertexElements.reserve(vertexElements.size());
+
+    UINT nextVertex = 0u;
+    for (UINT &index : indices) {
+        if (remap[index] == invalidIndex) {
+            remap[index] = nextVertex++;
+            const auto vertexBegin = vertexElements.begin() + static_cast<size_t>(index) * vertexSizeInFloats;
+            outVertexElements.insert(outVertexElements.end(), vertexBegin, vertexBegin + vertexSizeInFloats);
+        }
+        index = remap[index];
+    }
+
+    vertexElements = std::move(outVertexElements);
+}
+
+// ----------------------------------------------------------------- Analysis
+
+VertexCacheStatistics MeshOptimizer::analyzeVertexCache(const std::vector<UINT> &indices, UINT verticesCount, UINT cacheSize) {
+    const UINT trianglesCount = static_cast<UINT>(indices.size() / 3);
+    VertexCache cache{verticesCount, cacheSize};
+    std::vector<char> referenced(verticesCount, false);
+    UINT misses = 0u;
+    UINT referencedVerticesCount = 0u;
+    for (UINT triangle = 0u; triangle < trianglesCount; triangle++) {
+        misses += cache.processTriangle(indices.data() + 3 * triangle);
+        for (auto corner = 0u; corner < 3u; corner++) {
+            const UINT vertex = indices[3 * triangle + corner];
+            referencedVerticesCount += !referenced[vertex];
+            referenced[vertex] = true;
+        }
+    }
+
+    VertexCacheStatistics statistics{};
+    if (trianglesCount > 0u) {
+        statistics.acmr = static_cast<FLOAT>(misses) / trianglesCount;
+        statistics.atvr = static_cast<FLOAT>(misses) / referencedVerticesCount;
+    }
+    return statistics;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "DXD/Utility/NonCopyableAndMovable.h"
+
+#include <DXD/ExternalHeadersWrappers/windows.h>
+#include <vector>
+
+/// \brief Post-transform vertex cache efficiency of an index buffer, simulated with a FIFO cache
+struct VertexCacheStatistics {
+    FLOAT acmr; // average cache miss ratio - vertex shader invocations per triangle, from 0.5 (best) to 3 (worst)
+    FLOAT atvr; // average transform to vertex ratio - vertex shader invocations per referenced vertex, 1 is optimal
+};
+
+/// \brief Reorders indexed triangle lists for better GPU efficiency
+///
+/// Stages are meant to be run in order: optimizeVertexCache, optimizeOverdraw, optimizeVertexFetch.
+/// Each of them only changes the order of triangles or vertices, the geometry itself is not altered.
+class MeshOptimizer : DXD::NonInstantiatable {
+public:
+    constexpr static UINT defaultCacheSize = 16u;
+    constexpr static FLOAT defaultOverdrawThreshold = 1.05f;
+
+    /// Reorders triangles, so vertices are reused while they're still in the post-transform cache.
+    /// Uses Tipsify algorithm (Sander, Nehab, Barczak 2007), which runs in linear time.
+    static void optimizeVertexCache(std::vector<UINT> &indices, UINT verticesCount, UINT cacheSize = defaultCacheSize);
+
+    /// Splits triangles into clusters and sorts them, so parts facing outwards of the mesh are drawn
+    /// first and early depth test can reject more of the occluded pixels. Clusters are only split at
+    /// places where it doesn't increase ACMR of the cluster by more than threshold times.
+    /// \param vertexElements interleaved vertices, position has to be first 3 elements of each vertex
+    static void optimizeOverdraw(std::vector<UINT> &indices, const std::vector<FLOAT> &vertexElements, UINT vertexSizeInFloats,
+                                 UINT cacheSize = defaultCacheSize, FLOAT threshold = defaultOverdrawThreshold);
+
+    /// Renumbers vertices in order of their first use by the index buffer, so vertex fetches are
+    /// mostly sequential in memory. Vertices not referenced by any triangle are removed.
+    static void optimizeVertexFetch(std::vector<UINT> &indices, std::vector<FLOAT> &vertexElements, UINT vertexSizeInFloats);
+
+    static VertexCacheStatistics analyzeVertexCache(const std::vector<UINT> &indices, UINT verticesCount, UINT cacheSize = defaultCacheSize);
+};
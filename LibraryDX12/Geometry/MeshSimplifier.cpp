@@ -0,0 +1,424 @@
+#include "MeshSimplifier.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <queue>
+
+// ----------------------------------------------------------------- Helpers
+
+namespace {
+constexpr UINT invalidIndex = std::numeric_limits<UINT>::max();
+
+struct Vector3 {
+    double x, y, z;
+};
+
+Vector3 subtract(const Vector3 &a, const Vector3 &b) {
+    return Vector3{a.x - b.x, a.y - b.y, a.z - b.z};
+}
+
+Vector3 cross(const Vector3 &a, const Vector3 &b) {
+    return Vector3{a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+}
+
+double dot(const Vector3 &a, const Vector3 &b) {
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+double length(const Vector3 &a) {
+    return std::sqrt(dot(a, a));
+}
+
+// Weighted sum of squared distances to a set of planes, stored as a symmetric 4x4 matrix
+struct Quadric {
+    void addPlane(const Vector3 &normal, double d, double planeWeight) {
+        a2 += planeWeight * normal.x * normal.x;
+        ab += planeWeight * normal.x * normal.y;
+        ac += planeWeight * normal.x * normal.z;
+        ad += planeWeight * normal.x * d;
+        b2 += planeWeight * normal.y * normal.y;
+        bc += planeWeight * normal.y * normal.z;
+        bd += planeWeight * normal.y * d;
+        c2 += planeWeight * normal.z * normal.z;
+        cd += planeWeight * normal.z * d;
+        d2 += planeWeight * d * d;
+    }
+
+    void add(const Quadric &other) {
+        a2 += other.a2, ab += other.ab, ac += other.ac, ad += other.ad;
+        b2 += other.b2, bc += other.bc, bd += other.bd;
+        c2 += other.c2, cd += other.cd;
+        d2 += other.d2;
+        weight += other.weight;
+    }
+
+    // Returns mean squared distance, so the error doesn't depend on the amount of merged planes
+    double evaluate(const Vector3 &p) const {
+        const double sum = a2 * p.x * p.x + 2 * ab * p.x * p.y + 2 * ac * p.x * p.z + 2 * ad * p.x +
+                           b2 * p.y * p.y + 2 * bc * p.y * p.z + 2 * bd * p.y +
+                           c2 * p.z * p.z + 2 * cd * p.z +
+                           d2;
+        return weight > 0 ? std::max(sum / weight, 0.0) : 0.0;
+    }
+
+    double a2 = 0, ab = 0, ac = 0, ad = 0, b2 = 0, bc = 0, bd = 0, c2 = 0, cd = 0, d2 = 0;
+    double weight = 0; // total area of triangles, constraint planes do not contribute
+};
+
+struct Collapse {
+    double cost;
+    double reverseCost;
+    UINT source;
+    UINT target;
+    UINT sourceVersion;
+    UINT targetVersion;
+    bool reverseAllowed;
+
+    bool operator<(const Collapse &other) const { return cost > other.cost; } // cheapest collapse on top of std::priority_queue
+};
+
+// Vertices are identified by their indices (wedges), but the topology is analyzed on unique positions,
+// so attribute seams are not treated as borders of the mesh
+class Simplifier {
+public:
+    Simplifier(const std::vector<UINT> &indices, const std::vector<FLOAT> &vertexElements, UINT vertexSizeInFloats) {
+        assignPositions(vertexElements, vertexSizeInFloats);
+        createTriangles(indices);
+        computeQuadrics();
+        createEdges();
+    }
+
+    FLOAT run(UINT targetTrianglesCount, FLOAT maxError) {
+        const double costLimit = static_cast<double>(maxError) * maxError;
+        double maxCost = 0;
+        while (aliveTrianglesCount > targetTrianglesCount && !collapses.empty() && collapses.top().cost <= costLimit) {
+            const Collapse collapse = collapses.top();
+            collapses.pop();
+            if (!isPositionAlive[collapse.source] || !isPositionAlive[collapse.target] ||
+                positionVersions[collapse.source] != collapse.sourceVersion ||
+                positionVersions[collapse.target] != collapse.targetVersion) {
+                continue;
+            }
+
+            if (!tryCollapse(collapse.source, collapse.target)) {
+                if (collapse.reverseAllowed) {
+                    collapses.push(Collapse{collapse.reverseCost, collapse.cost, collapse.target, collapse.source,
+                                            collapse.targetVersion, collapse.sourceVersion, false});
+                }
+                continue;
+            }
+            maxCost = std::max(maxCost, collapse.cost);
+        }
+        return static_cast<FLOAT>(std::sqrt(maxCost));
+    }
+
+    void writeIndices(std::vector<UINT> &outIndices) const {
+        outIndices.clear();
+        outIndices.reserve(static_cast<size_t>(aliveTrianglesCount) * 3);
+        for (UINT triangle = 0u; triangle < isTriangleAlive.size(); triangle++) {
+            if (isTriangleAlive[triangle]) {
+                outIndices.insert(outIndices.end(), triangles.begin() + triangle * 3, triangles.begin() + triangle * 3 + 3);
+            }
+        }
+    }
+
+private:
+    void assignPositions(const std::vector<FLOAT> &vertexElements, UINT vertexSizeInFloats) {
+        const auto verticesCount = static_cast<UINT>(vertexElements.size() / vertexSizeInFloats);
+        auto getPosition = [&](UINT vertex) {
+            return vertexElements.data() + static_cast<size_t>(vertex) * vertexSizeInFloats;
+        };
+
+        // Sort vertices by their positions, so equal positions are adjacent
+        std::vector<UINT> sortedVertices(verticesCount);
+        std::iota(sortedVertices.begin(), sortedVertices.end(), 0u);
+        std::sort(sortedVertices.begin(), sortedVertices.end(), [&](UINT left, UINT right) {
+            return std::lexicographical_compare(getPosition(left), getPosition(left) + 3, getPosition(right), getPosition(right) + 3);
+        });
+
+        vertexPositions.resize(verticesCount);
+        for (UINT sortedIndex = 0u; sortedIndex < verticesCount; sortedIndex++) {
+            const UINT vertex = sortedVertices[sortedIndex];
+            const FLOAT *position = getPosition(vertex);
+            if (sortedIndex == 0 || !std::equal(position, position + 3, getPosition(sortedVertices[sortedIndex - 1]))) {
+                positions.push_back(Vector3{position[0], position[1], position[2]});
+            }
+            vertexPositions[vertex] = static_cast<UINT>(positions.size() - 1);
+        }
+
+        const auto positionsCount = positions.size();
+        isPositionAlive.assign(positionsCount, true);
+        positionVersions.assign(positionsCount, 0u);
+        positionTriangles.resize(positionsCount);
+        quadrics.resize(positionsCount);
+    }
+
+    void createTriangles(const std::vector<UINT> &indices) {
+        // Triangles degenerate in position space are never visible, they're dropped right away
+        triangles.reserve(indices.size());
+        for (size_t index = 0u; index < indices.size(); index += 3) {
+            const UINT p0 = vertexPositions[indices[index]];
+            const UINT p1 = vertexPositions[indices[index + 1]];
+            const UINT p2 = vertexPositions[indices[index + 2]];
+            if (p0 == p1 || p1 == p2 || p2 == p0) {
+                continue;
+            }
+
+            const auto triangle = static_cast<UINT>(triangles.size() / 3);
+            triangles.insert(triangles.end(), indices.begin() + index, indices.begin() + index + 3);
+            positionTriangles[p0].push_back(triangle);
+            positionTriangles[p1].push_back(triangle);
+            positionTriangles[p2].push_back(triangle);
+        }
+        aliveTrianglesCount = static_cast<UINT>(triangles.size() / 3);
+        isTriangleAlive.assign(aliveTrianglesCount, true);
+    }
+
+    void computeQuadrics() {
+        for (UINT triangle = 0u; triangle < aliveTrianglesCount; triangle++) {
+            const Vector3 &p0 = positions[getTrianglePosition(triangle, 0)];
+            const Vector3 &p1 = positions[getTrianglePosition(triangle, 1)];
+            const Vector3 &p2 = positions[getTrianglePosition(triangle, 2)];
+            const Vector3 normal = cross(subtract(p1, p0), subtract(p2, p0));
+            const double normalLength = length(normal);
+            if (normalLength == 0) {
+                continue;
+            }
+
+            const Vector3 unitNormal{normal.x / normalLength, normal.y / normalLength, normal.z / normalLength};
+            const double area = normalLength * 0.5;
+            Quadric quadric{};
+            quadric.addPlane(unitNormal, -dot(unitNormal, p0), area);
+            quadric.weight = area;
+            for (auto corner = 0u; corner < 3u; corner++) {
+                quadrics[getTrianglePosition(triangle, corner)].add(quadric);
+            }
+        }
+    }
+
+    void createEdges() {
+        // Each triangle edge as a key made of sorted position ids, edges used by a single triangle are borders
+        std::vector<std::pair<UINT64, UINT>> edges{};
+        edges.reserve(triangles.size());
+        for (UINT triangle = 0u; triangle < aliveTrianglesCount; triangle++) {
+            for (auto corner = 0u; corner < 3u; corner++) {
+                const UINT a = getTrianglePosition(triangle, corner);
+                const UINT b = getTrianglePosition(triangle, (corner + 1) % 3);
+                edges.emplace_back((static_cast<UINT64>(std::min(a, b)) << 32) | std::max(a, b), triangle);
+            }
+        }
+        std::sort(edges.begin(), edges.end());
+
+        for (size_t edgeIndex = 0u; edgeIndex < edges.size();) {
+            size_t edgeEnd = edgeIndex + 1;
+            while (edgeEnd < edges.size() && edges[edgeEnd].first == edges[edgeIndex].first) {
+                edgeEnd++;
+            }
+
+            const auto a = static_cast<UINT>(edges[edgeIndex].first >> 32);
+            const auto b = static_cast<UINT>(edges[edgeIndex].first & 0xFFFFFFFF);
+            if (edgeEnd - edgeIndex == 1) {
+                addBorderConstraint(a, b, edges[edgeIndex].second);
+            }
+            edgeIndex = edgeEnd;
+        }
+
+        // Costs are computed after all border constraints are added
+        for (size_t edgeIndex = 0u; edgeIndex < edges.size(); edgeIndex++) {
+            if (edgeIndex == 0 || edges[edgeIndex].first != edges[edgeIndex - 1].first) {
+                pushCollapse(static_cast<UINT>(edges[edgeIndex].first >> 32), static_cast<UINT>(edges[edgeIndex].first & 0xFFFFFFFF));
+            }
+        }
+    }
+
+    void addBorderConstraint(UINT a, UINT b, UINT triangle) {
+        // Plane containing the border edge and perpendicular to the triangle keeps the border in place
+        const Vector3 &p0 = positions[getTrianglePosition(triangle, 0)];
+        const Vector3 &p1 = positions[getTrianglePosition(triangle, 1)];
+        const Vector3 &p2 = positions[getTrianglePosition(triangle, 2)];
+        const Vector3 edge = subtract(positions[b], positions[a]);
+        const Vector3 planeNormal = cross(edge, cross(subtract(p1, p0), subtract(p2, p0)));
+        const double planeNormalLength = length(planeNormal);
+        if (planeNormalLength == 0) {
+            return;
+        }
+
+        constexpr double borderWeight = 10.0;
+        const Vector3 unitNormal{planeNormal.x / planeNormalLength, planeNormal.y / planeNormalLength, planeNormal.z / planeNormalLength};
+        Quadric quadric{};
+        quadric.addPlane(unitNormal, -dot(unitNormal, positions[a]), borderWeight * dot(edge, edge));
+        quadrics[a].add(quadric);
+        quadrics[b].add(quadric);
+    }
+
+    void pushCollapse(UINT a, UINT b) {
+        Quadric quadric = quadrics[a];
+        quadric.add(quadrics[b]);
+        const double costAToB = quadric.evaluate(positions[b]);
+        const double costBToA = quadric.evaluate(positions[a]);
+        if (costAToB <= costBToA) {
+            collapses.push(Collapse{costAToB, costBToA, a, b, positionVersions[a], positionVersions[b], true});
+        } else {
+            collapses.push(Collapse{costBToA, costAToB, b, a, positionVersions[b], positionVersions[a], true});
+        }
+    }
+
+    bool tryCollapse(UINT source, UINT target) {
+        compactTriangles(source);
+        compactTriangles(target);
+
+        // Every vertex at the source position has to be moved to a vertex at the target position connected with it by an edge,
+        // otherwise attributes of some triangles would be taken from the other side of a seam
+        wedgeMapping.clear();
+        UINT sharedTrianglesCount = 0u;
+        for (UINT triangle : positionTriangles[source]) {
+            const UINT targetCorner = findCorner(triangle, target);
+            if (targetCorner == 3u) {
+                continue;
+            }
+            sharedTrianglesCount++;
+
+            const UINT sourceVertex = triangles[triangle * 3 + findCorner(triangle, source)];
+            const UINT targetVertex = triangles[triangle * 3 + targetCorner];
+            const UINT mappedVertex = findMappedVertex(sourceVertex);
+            if (mappedVertex == invalidIndex) {
+                wedgeMapping.emplace_back(sourceVertex, targetVertex);
+            } else if (mappedVertex != targetVertex) {
+                return false;
+            }
+        }
+        if (sharedTrianglesCount == 0u) {
+            return false;
+        }
+
+        for (UINT triangle : positionTriangles[source]) {
+            if (findCorner(triangle, target) != 3u) {
+                continue;
+            }
+            const UINT sourceCorner = findCorner(triangle, source);
+            if (findMappedVertex(triangles[triangle * 3 + sourceCorner]) == invalidIndex || isFlippedByMove(triangle, sourceCorner, positions[target])) {
+                return false;
+            }
+        }
+
+        // Positions adjacent to both endpoints can only be the ones opposite to the collapsed edge, other common
+        // neighbours mean the collapse would create non-manifold geometry
+        gatherNeighbours(source, sourceNeighbours);
+        gatherNeighbours(target, targetNeighbours);
+        commonNeighbours.clear();
+        std::set_intersection(sourceNeighbours.begin(), sourceNeighbours.end(), targetNeighbours.begin(), targetNeighbours.end(),
+                              std::back_inserter(commonNeighbours));
+        if (commonNeighbours.size() > sharedTrianglesCount) {
+            return false;
+        }
+
+        // Move triangles to the target position, the ones containing the collapsed edge disappear
+        for (UINT triangle : positionTriangles[source]) {
+            const UINT sourceCorner = findCorner(triangle, source);
+            if (findCorner(triangle, target) != 3u) {
+                isTriangleAlive[triangle] = false;
+                aliveTrianglesCount--;
+                continue;
+            }
+            triangles[triangle * 3 + sourceCorner] = findMappedVertex(triangles[triangle * 3 + sourceCorner]);
+            positionTriangles[target].push_back(triangle);
+        }
+        positionTriangles[source] = {};
+        quadrics[target].add(quadrics[source]);
+        isPositionAlive[source] = false;
+        positionVersions[target]++;
+
+        // Costs of edges around the target have changed
+        compactTriangles(target);
+        gatherNeighbours(target, targetNeighbours);
+        for (UINT neighbour : targetNeighbours) {
+            pushCollapse(target, neighbour);
+        }
+        return true;
+    }
+
+    bool isFlippedByMove(UINT triangle, UINT movedCorner, const Vector3 &newPosition) const {
+        Vector3 corners[3] = {positions[getTrianglePosition(triangle, 0)], positions[getTrianglePosition(triangle, 1)], positions[getTrianglePosition(triangle, 2)]};
+        const Vector3 normalBefore = cross(subtract(corners[1], corners[0]), subtract(corners[2], corners[0]));
+        corners[movedCorner] = newPosition;
+        const Vector3 normalAfter = cross(subtract(corners[1], corners[0]), subtract(corners[2], corners[0]));
+
+        // Small rotations are expected, anything close to a right angle would create a visible fold
+        constexpr double minCosine = 0.2;
+        return dot(normalBefore, normalAfter) < minCosine * length(normalBefore) * length(normalAfter);
+    }
+
+    void compactTriangles(UINT position) {
+        auto &adjacentTriangles = positionTriangles[position];
+        adjacentTriangles.erase(std::remove_if(adjacentTriangles.begin(), adjacentTriangles.end(), [this](UINT triangle) { return !isTriangleAlive[triangle]; }),
+                                adjacentTriangles.end());
+    }
+
+    void gatherNeighbours(UINT position, std::vector<UINT> &outNeighbours) const {
+        outNeighbours.clear();
+        for (UINT triangle : positionTriangles[position]) {
+            for (auto corner = 0u; corner < 3u; corner++) {
+                const UINT neighbour = getTrianglePosition(triangle, corner);
+                if (neighbour != position) {
+                    outNeighbours.push_back(neighbour);
+                }
+            }
+        }
+        std::sort(outNeighbours.begin(), outNeighbours.end());
+        outNeighbours.erase(std::unique(outNeighbours.begin(), outNeighbours.end()), outNeighbours.end());
+    }
+
+    UINT findCorner(UINT triangle, UINT position) const {
+        for (auto corner = 0u; corner < 3u; corner++) {
+            if (getTrianglePosition(triangle, corner) == position) {
+                return corner;
+            }
+        }
+        return 3u;
+    }
+
+    UINT findMappedVertex(UINT vertex) const {
+        for (const auto &mapping : wedgeMapping) {
+            if (mapping.first == vertex) {
+                return mapping.second;
+            }
+        }
+        return invalidIndex;
+    }
+
+    UINT getTrianglePosition(UINT triangle, UINT corner) const { return vertexPositions[triangles[triangle * 3 + corner]]; }
+
+    // Positions
+    std::vector<Vector3> positions{};
+    std::vector<UINT> vertexPositions{}; // position id of each vertex
+    std::vector<bool> isPositionAlive{};
+    std::vector<UINT> positionVersions{}; // incremented when costs of adjacent edges change, to discard outdated collapses
+    std::vector<std::vector<UINT>> positionTriangles{};
+    std::vector<Quadric> quadrics{};
+
+    // Triangles
+    std::vector<UINT> triangles{};
+    std::vector<bool> isTriangleAlive{};
+    UINT aliveTrianglesCount = 0u;
+
+    // Collapses
+    std::priority_queue<Collapse> collapses{};
+    std::vector<std::pair<UINT, UINT>> wedgeMapping{};
+    std::vector<UINT> sourceNeighbours{};
+    std::vector<UINT> targetNeighbours{};
+    std::vector<UINT> commonNeighbours{};
+};
+} // namespace
+
+// ----------------------------------------------------------------- Simplification
+
+FLOAT MeshSimplifier::simplify(const std::vector<UINT> &indices, const std::vector<FLOAT> &vertexElements, UINT vertexSizeInFloats,
+                               UINT targetIndicesCount, FLOAT maxError, std::vector<UINT> &outIndices) {
+    Simplifier simplifier{indices, vertexElements, vertexSizeInFloats};
+    const FLOAT error = simplifier.run(targetIndicesCount / 3, maxError);
+    simplifier.writeIndices(outIndices);
+    return error;
+}
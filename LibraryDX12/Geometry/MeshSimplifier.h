@@ -0,0 +1,47 @@
+#pragma once
+
+#include "DXD/Utility/NonCopyableAndMovable.h"
+
+#include <DXD/ExternalHeadersWrappers/windows.h>
+#include <vector>
+
+/// \brief Simplified version of a mesh, drawn instead of the full geometry when details are not visible
+///
+/// All levels of detail share one vertex buffer, each of them occupies its own range of the index buffer
+/// and of the meshlets array. Level 0 is the original geometry. Every level has one entry per submesh,
+/// entry of submesh s at level l is stored at index l * submeshesCount + s and all entries of a level
+/// have the same error.
+struct MeshLod {
+    UINT firstIndex;
+    UINT indicesCount;
+    UINT firstMeshlet;
+    UINT meshletsCount;
+    FLOAT error; // estimated deviation from the original surface in object space units
+};
+
+/// \brief Part of a mesh drawn with its own material from the same vertex and index buffers as the other parts
+struct MeshSubmesh {
+    UINT hasMaterial; // if 0, properties of the object are used instead
+    FLOAT albedoColor[3];
+    FLOAT specularity;
+};
+
+/// \brief Reduces triangle count of indexed triangle lists using quadric error metric
+///
+/// Implements edge collapses ordered by quadric error (Garland, Heckbert 1997). Vertices are always
+/// collapsed onto one of the edge endpoints, so simplified meshes can reuse the original vertex
+/// buffer and only the index buffer is regenerated. Vertices sharing a position (e.g. on texture
+/// seams) are collapsed together, so no cracks are introduced. Open borders are preserved with
+/// additional constraint planes.
+class MeshSimplifier : DXD::NonInstantiatable {
+public:
+    /// \param indices triangle list to simplify
+    /// \param vertexElements interleaved vertices, position has to be first 3 elements of each vertex
+    /// \param targetIndicesCount desired size of simplified index buffer, it may not be reached, if
+    /// further collapses would damage the mesh topology or attribute seams
+    /// \param maxError simplification stops before exceeding this deviation, even if the target is not reached
+    /// \param outIndices simplified triangle list, referencing the same vertices as the input
+    /// \return estimated deviation of the simplified surface from the input surface
+    static FLOAT simplify(const std::vector<UINT> &indices, const std::vector<FLOAT> &vertexElements, UINT vertexSizeInFloats,
+                          UINT targetIndicesCount, FLOAT maxError, std::vector<UINT> &outIndices);
+};
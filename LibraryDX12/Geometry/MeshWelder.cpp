@@ -0,0 +1,88 @@
+#include "MeshWelder.h"
+
+#include <cstring>
+
+// ----------------------------------------------------------------- MeshWelder
+
+void MeshWelder::weld(const std::vector<FLOAT> &vertexElements, UINT vertexSizeInFloats,
+                      std::vector<FLOAT> &outVertexElements, std::vector<UINT> &outIndices) {
+    const size_t inputVerticesCount = vertexElements.size() / vertexSizeInFloats;
+    IncrementalMeshWelder welder{vertexSizeInFloats, outVertexElements, outIndices};
+    welder.reserve(inputVerticesCount);
+    outIndices.reserve(inputVerticesCount);
+    for (size_t vertexIndex = 0u; vertexIndex < inputVerticesCount; vertexIndex++) {
+        welder.addVertex(vertexElements.data() + vertexIndex * vertexSizeInFloats);
+    }
+}
+
+// ----------------------------------------------------------------- IncrementalMeshWelder
+
+IncrementalMeshWelder::IncrementalMeshWelder(UINT vertexSizeInFloats, std::vector<FLOAT> &outVertexElements, std::vector<UINT> &outIndices)
+    : vertexSizeInFloats(vertexSizeInFloats),
+      outVertexElements(outVertexElements),
+      outIndices(outIndices) {
+    outVertexElements.clear();
+    outIndices.clear();
+    rehash(16u);
+}
+
+void IncrementalMeshWelder::reserve(size_t uniqueVerticesCount) {
+    size_t tableSize = table.size();
+    while (tableSize < uniqueVerticesCount * 2) {
+        tableSize *= 2;
+    }
+    if (tableSize != table.size()) {
+        rehash(tableSize);
+    }
+}
+
+void IncrementalMeshWelder::addVertex(const FLOAT *vertex) {
+    // Linear probing until we find the same vertex or an empty slot
+    const size_t vertexSizeInBytes = vertexSizeInFloats * sizeof(FLOAT);
+    const size_t tableMask = table.size() - 1;
+    size_t slot = static_cast<size_t>(hashVertex(vertex, vertexSizeInFloats)) & tableMask;
+    while (table[slot] != emptySlot) {
+        const FLOAT *candidate = outVertexElements.data() + static_cast<size_t>(table[slot]) * vertexSizeInFloats;
+        if (std::memcmp(candidate, vertex, vertexSizeInBytes) == 0) {
+            outIndices.push_back(table[slot]);
+            return;
+        }
+        slot = (slot + 1) & tableMask;
+    }
+
+    table[slot] = uniqueVerticesCount;
+    outIndices.push_back(uniqueVerticesCount);
+    outVertexElements.insert(outVertexElements.end(), vertex, vertex + vertexSizeInFloats);
+    uniqueVerticesCount++;
+    if (static_cast<size_t>(uniqueVerticesCount) * 2 > table.size()) {
+        rehash(table.size() * 2);
+    }
+}
+
+UINT64 IncrementalMeshWelder::hashVertex(const FLOAT *vertex, UINT vertexSizeInFloats) {
+    // FNV-1a over 32-bit words followed by a final avalanche, so low bits used for slots are well mixed
+    UINT64 hash = 14695981039346656037ull;
+    for (UINT elementIndex = 0u; elementIndex < vertexSizeInFloats; elementIndex++) {
+        UINT bits{};
+        std::memcpy(&bits, vertex + elementIndex, sizeof(bits));
+        hash = (hash ^ bits) * 1099511628211ull;
+    }
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdull;
+    hash ^= hash >> 33;
+    return hash;
+}
+
+void IncrementalMeshWelder::rehash(size_t tableSize) {
+    // Unique vertices are already stored in the output, so their hashes can be recomputed from there
+    table.assign(tableSize, emptySlot);
+    const size_t tableMask = tableSize - 1;
+    for (UINT vertexIndex = 0u; vertexIndex < uniqueVerticesCount; vertexIndex++) {
+        const FLOAT *vertex = outVertexElements.data() + static_cast<size_t>(vertexIndex) * vertexSizeInFloats;
+        size_t slot = static_cast<size_t>(hashVertex(vertex, vertexSizeInFloats)) & tableMask;
+        while (table[slot] != emptySlot) {
+            slot = (slot + 1) & tableMask;
+        }
+        table[slot] = vertexIndex;
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "DXD/Utility/NonCopyableAndMovable.h"
+
+#include <DXD/ExternalHeadersWrappers/windows.h>
+#include <vector>
+
+/// \brief Merges identical vertices of a triangle list into indexed geometry
+///
+/// Loaders produce one interleaved vertex per triangle corner, so vertices shared by neighbouring
+/// triangles are duplicated. Welding keeps only the first occurrence of every unique vertex and
+/// generates an index buffer referencing them. Vertices are compared bitwise over all attributes,
+/// hence corners with different normals, tangents or texture coordinates stay separate.
+class MeshWelder : DXD::NonInstantiatable {
+public:
+    /// \param vertexElements interleaved vertices, each vertexSizeInFloats consecutive elements form a vertex
+    /// \param vertexSizeInFloats number of FLOAT elements in a single vertex
+    /// \param outVertexElements unique vertices in order of their first occurrence, previous contents are discarded
+    /// \param outIndices one index per input vertex, previous contents are discarded
+    static void weld(const std::vector<FLOAT> &vertexElements, UINT vertexSizeInFloats,
+                     std::vector<FLOAT> &outVertexElements, std::vector<UINT> &outIndices);
+};
+
+/// \brief Welds vertices one at a time, as they are produced
+///
+/// Works the same way as MeshWelder::weld, but the input vertices do not have to be stored anywhere,
+/// so a mesh can be welded while it's being read, with memory proportional only to the welded output.
+/// The hash table grows along with the number of unique vertices, unless enough space is reserved upfront.
+class IncrementalMeshWelder : DXD::NonCopyableAndMovable {
+public:
+    /// \param vertexSizeInFloats number of FLOAT elements in a single vertex
+    /// \param outVertexElements unique vertices are appended here, previous contents are discarded
+    /// \param outIndices one index per added vertex is appended here, previous contents are discarded
+    IncrementalMeshWelder(UINT vertexSizeInFloats, std::vector<FLOAT> &outVertexElements, std::vector<UINT> &outIndices);
+
+    /// Sizes the hash table for the expected number of unique vertices, so it does not have to be rehashed
+    void reserve(size_t uniqueVerticesCount);
+
+    /// Appends index of the vertex, the vertex itself is appended only if it was not added before
+    void addVertex(const FLOAT *vertex);
+
+    size_t getHashTableSizeInBytes() const { return table.capacity() * sizeof(UINT); }
+
+private:
+    constexpr static UINT emptySlot = 0xffffffff;
+
+    static UINT64 hashVertex(const FLOAT *vertex, UINT vertexSizeInFloats);
+    void rehash(size_t tableSize);
+
+    const UINT vertexSizeInFloats;
+    std::vector<FLOAT> &outVertexElements;
+    std::vector<UINT> &outIndices;
+    std::vector<UINT> table = {}; // open addressing with linear probing, stores indices of unique vertices, kept at most half full
+    UINT uniqueVerticesCount = 0u;
+};
@@ -0,0 +1,132 @@
+#include "MeshletBuilder.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+namespace {
+void subtract(const FLOAT *a, const FLOAT *b, FLOAT *out) {
+    out[0] = a[0] - b[0];
+    out[1] = a[1] - b[1];
+    out[2] = a[2] - b[2];
+}
+
+FLOAT dot(const FLOAT *a, const FLOAT *b) {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+} // namespace
+
+void MeshletBuilder::build(const std::vector<UINT> &indices, const std::vector<FLOAT> &vertexElements, UINT vertexSizeInFloats,
+                           std::vector<Meshlet> &outMeshlets, UINT maxVertices, UINT maxTriangles) {
+    assert(indices.size() % 3 == 0);
+    assert(maxVertices >= 3u && maxTriangles >= 1u);
+    outMeshlets.clear();
+
+    // Each vertex remembers the last meshlet it has been added to, so unique vertices can be counted without clearing anything
+    const size_t verticesCount = vertexElements.size() / vertexSizeInFloats;
+    std::vector<UINT> vertexMeshlet(verticesCount, std::numeric_limits<UINT>::max());
+
+    UINT meshletIndex = 0u;
+    UINT meshletFirstIndex = 0u;
+    UINT meshletVerticesCount = 0u;
+    for (UINT index = 0u; index < indices.size(); index += 3) {
+        const UINT *triangle = indices.data() + index;
+        UINT newVerticesCount = 0u;
+        for (auto corner = 0u; corner < 3u; corner++) {
+            const bool repeatedInTriangle = (corner > 0 && triangle[corner] == triangle[0]) || (corner > 1 && triangle[corner] == triangle[1]);
+            newVerticesCount += vertexMeshlet[triangle[corner]] != meshletIndex && !repeatedInTriangle;
+        }
+
+        // Close current meshlet if the triangle doesn't fit
+        const UINT meshletTrianglesCount = (index - meshletFirstIndex) / 3;
+        if (meshletVerticesCount + newVerticesCount > maxVertices || meshletTrianglesCount == maxTriangles) {
+            outMeshlets.push_back(computeBounds(indices, meshletFirstIndex, index - meshletFirstIndex, vertexElements, vertexSizeInFloats));
+            meshletIndex++;
+            meshletFirstIndex = index;
+            meshletVerticesCount = 0u;
+        }
+
+        for (auto corner = 0u; corner < 3u; corner++) {
+            if (vertexMeshlet[triangle[corner]] != meshletIndex) {
+                vertexMeshlet[triangle[corner]] = meshletIndex;
+                meshletVerticesCount++;
+            }
+        }
+    }
+
+    const auto indicesCount = static_cast<UINT>(indices.size());
+    if (meshletFirstIndex < indicesCount) {
+        outMeshlets.push_back(computeBounds(indices, meshletFirstIndex, indicesCount - meshletFirstIndex, vertexElements, vertexSizeInFloats));
+    }
+}
+
+Meshlet MeshletBuilder::computeBounds(const std::vector<UINT> &indices, UINT firstIndex, UINT indicesCount,
+                                      const std::vector<FLOAT> &vertexElements, UINT vertexSizeInFloats) {
+    Meshlet meshlet{firstIndex, indicesCount};
+    auto getPosition = [&](UINT index) {
+        return vertexElements.data() + static_cast<size_t>(indices[index]) * vertexSizeInFloats;
+    };
+
+    // Bounding sphere is centered in the middle of the bounding box, it's not minimal, but tight enough for culling
+    FLOAT boundsMin[3] = {std::numeric_limits<FLOAT>::max(), std::numeric_limits<FLOAT>::max(), std::numeric_limits<FLOAT>::max()};
+    FLOAT boundsMax[3] = {std::numeric_limits<FLOAT>::lowest(), std::numeric_limits<FLOAT>::lowest(), std::numeric_limits<FLOAT>::lowest()};
+    for (UINT index = firstIndex; index < firstIndex + indicesCount; index++) {
+        const FLOAT *position = getPosition(index);
+        for (auto component = 0u; component < 3u; component++) {
+            boundsMin[component] = std::min(boundsMin[component], position[component]);
+            boundsMax[component] = std::max(boundsMax[component], position[component]);
+        }
+    }
+    FLOAT radiusSquared = 0.f;
+    for (auto component = 0u; component < 3u; component++) {
+        meshlet.center[component] = (boundsMin[component] + boundsMax[component]) * 0.5f;
+    }
+    for (UINT index = firstIndex; index < firstIndex + indicesCount; index++) {
+        FLOAT offset[3] = {};
+        subtract(getPosition(index), meshlet.center, offset);
+        radiusSquared = std::max(radiusSquared, dot(offset, offset));
+    }
+    meshlet.radius = std::sqrt(radiusSquared);
+
+    // Normal cone axis is an average of unit triangle normals
+    std::vector<FLOAT> normals{};
+    normals.reserve(indicesCount);
+    FLOAT axis[3] = {};
+    for (UINT index = firstIndex; index < firstIndex + indicesCount; index += 3) {
+        FLOAT edge1[3] = {}, edge2[3] = {};
+        subtract(getPosition(index + 1), getPosition(index), edge1);
+        subtract(getPosition(index + 2), getPosition(index), edge2);
+        FLOAT normal[3] = {edge1[1] * edge2[2] - edge1[2] * edge2[1],
+                           edge1[2] * edge2[0] - edge1[0] * edge2[2],
+                           edge1[0] * edge2[1] - edge1[1] * edge2[0]};
+        const FLOAT length = std::sqrt(dot(normal, normal));
+        if (length == 0.f) {
+            continue; // degenerate triangles are never rasterized, so they don't constrain the cone
+        }
+        for (auto component = 0u; component < 3u; component++) {
+            normal[component] /= length;
+            axis[component] += normal[component];
+        }
+        normals.insert(normals.end(), normal, normal + 3);
+    }
+
+    // Cone is not usable if normals differ too much, meshlet can't be entirely back facing then anyway
+    const FLOAT axisLength = std::sqrt(dot(axis, axis));
+    meshlet.coneCutoff = 1.f;
+    if (axisLength == 0.f) {
+        return meshlet;
+    }
+    FLOAT minimumDot = 1.f;
+    for (auto component = 0u; component < 3u; component++) {
+        meshlet.coneAxis[component] = axis[component] / axisLength;
+    }
+    for (size_t normalIndex = 0u; normalIndex < normals.size(); normalIndex += 3) {
+        minimumDot = std::min(minimumDot, dot(normals.data() + normalIndex, meshlet.coneAxis));
+    }
+    if (minimumDot > 0.1f) {
+        // Cone of view directions for which the meshlet is back facing has half angle of 90 degrees minus normal cone half angle
+        meshlet.coneCutoff = std::sqrt(1.f - minimumDot * minimumDot);
+    }
+    return meshlet;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "DXD/Utility/NonCopyableAndMovable.h"
+
+#include <DXD/ExternalHeadersWrappers/windows.h>
+#include <vector>
+
+/// \brief Small cluster of neighbouring triangles, which can be culled as a whole
+struct Meshlet {
+    UINT firstIndex;    // meshlet triangles occupy contiguous range of the mesh index buffer
+    UINT indicesCount;  // 3 per triangle
+    FLOAT center[3];    // bounding sphere of all vertices in object space
+    FLOAT radius;       //
+    FLOAT coneAxis[3];  // average direction of triangle normals
+    FLOAT coneCutoff;   // sine of the normal cone half angle, values greater or equal to 1 mean the cone cannot be used for culling
+};
+
+/// \brief Partitions indexed triangle lists into meshlets
+///
+/// Triangles are assigned to meshlets in the order of the index buffer, so the buffer itself does
+/// not have to be modified and the meshlets can be drawn as its subranges. The index buffer should
+/// already be optimized for vertex cache, because such order also has good spatial locality.
+class MeshletBuilder : DXD::NonInstantiatable {
+public:
+    constexpr static UINT defaultMaxVertices = 64u;
+    constexpr static UINT defaultMaxTriangles = 124u;
+
+    /// \param indices triangle list
+    /// \param vertexElements interleaved vertices, position has to be first 3 elements of each vertex
+    /// \param maxVertices maximum count of unique vertices referenced by a single meshlet
+    /// \param maxTriangles maximum count of triangles in a single meshlet
+    /// \param outMeshlets created meshlets, previous contents are discarded
+    static void build(const std::vector<UINT> &indices, const std::vector<FLOAT> &vertexElements, UINT vertexSizeInFloats,
+                      std::vector<Meshlet> &outMeshlets, UINT maxVertices = defaultMaxVertices, UINT maxTriangles = defaultMaxTriangles);
+
+private:
+    static Meshlet computeBounds(const std::vector<UINT> &indices, UINT firstIndex, UINT indicesCount,
+                                 const std::vector<FLOAT> &vertexElements, UINT vertexSizeInFloats);
+};
@@ -0,0 +1,78 @@
+#include "MeshletCuller.h"
+
+#include <cmath>
+
+void MeshletCuller::cull(const Meshlet *meshlets, UINT meshletsCount, const XMFLOAT4X4 &objectToClip, const XMFLOAT3 *eyePosition,
+                         std::vector<IndexRange> &outVisibleRanges) {
+    outVisibleRanges.clear();
+
+    XMFLOAT4 frustumPlanes[6];
+    extractFrustumPlanes(objectToClip, frustumPlanes);
+
+    for (UINT meshletIndex = 0u; meshletIndex < meshletsCount; meshletIndex++) {
+        const Meshlet &meshlet = meshlets[meshletIndex];
+        if (isOutsideFrustum(meshlet, frustumPlanes) || (eyePosition != nullptr && isBackFacing(meshlet, *eyePosition))) {
+            continue;
+        }
+
+        if (!outVisibleRanges.empty()) {
+            IndexRange &lastRange = outVisibleRanges.back();
+            if (lastRange.firstIndex + lastRange.indicesCount == meshlet.firstIndex) {
+                lastRange.indicesCount += meshlet.indicesCount;
+                continue;
+            }
+        }
+        outVisibleRanges.push_back(IndexRange{meshlet.firstIndex, meshlet.indicesCount});
+    }
+}
+
+bool MeshletCuller::isOutsideFrustum(const Meshlet &meshlet, const XMFLOAT4 frustumPlanes[6]) {
+    for (auto planeIndex = 0u; planeIndex < 6u; planeIndex++) {
+        const XMFLOAT4 &plane = frustumPlanes[planeIndex];
+        const FLOAT distance = plane.x * meshlet.center[0] + plane.y * meshlet.center[1] + plane.z * meshlet.center[2] + plane.w;
+        if (distance < -meshlet.radius) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool MeshletCuller::isBackFacing(const Meshlet &meshlet, const XMFLOAT3 &eyePosition) {
+    if (meshlet.coneCutoff >= 1.f) {
+        return false;
+    }
+
+    const FLOAT toCenter[3] = {meshlet.center[0] - eyePosition.x, meshlet.center[1] - eyePosition.y, meshlet.center[2] - eyePosition.z};
+    const FLOAT distance = std::sqrt(toCenter[0] * toCenter[0] + toCenter[1] * toCenter[1] + toCenter[2] * toCenter[2]);
+    const FLOAT projection = toCenter[0] * meshlet.coneAxis[0] + toCenter[1] * meshlet.coneAxis[1] + toCenter[2] * meshlet.coneAxis[2];
+    return projection >= meshlet.coneCutoff * distance + meshlet.radius;
+}
+
+void MeshletCuller::extractFrustumPlanes(const XMFLOAT4X4 &objectToClip, XMFLOAT4 outFrustumPlanes[6]) {
+    // Clip space position is a row vector multiplied by the matrix, so its components are dot products with matrix columns
+    auto column = [&objectToClip](int index) {
+        return XMFLOAT4(objectToClip.m[0][index], objectToClip.m[1][index], objectToClip.m[2][index], objectToClip.m[3][index]);
+    };
+    auto add = [](const XMFLOAT4 &a, const XMFLOAT4 &b, FLOAT sign) {
+        return XMFLOAT4(a.x + sign * b.x, a.y + sign * b.y, a.z + sign * b.z, a.w + sign * b.w);
+    };
+    const XMFLOAT4 x = column(0);
+    const XMFLOAT4 y = column(1);
+    const XMFLOAT4 z = column(2);
+    const XMFLOAT4 w = column(3);
+
+    outFrustumPlanes[0] = add(w, x, 1.f);  // left
+    outFrustumPlanes[1] = add(w, x, -1.f); // right
+    outFrustumPlanes[2] = add(w, y, 1.f);  // bottom
+    outFrustumPlanes[3] = add(w, y, -1.f); // top
+    outFrustumPlanes[4] = z;               // near
+    outFrustumPlanes[5] = add(w, z, -1.f); // far
+
+    for (auto planeIndex = 0u; planeIndex < 6u; planeIndex++) {
+        XMFLOAT4 &plane = outFrustumPlanes[planeIndex];
+        const FLOAT length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+        if (length > 0.f) {
+            plane = XMFLOAT4(plane.x / length, plane.y / length, plane.z / length, plane.w / length);
+        }
+    }
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Geometry/MeshletBuilder.h"
+
+#include "DXD/Utility/NonCopyableAndMovable.h"
+
+#include <DXD/ExternalHeadersWrappers/DirectXMath.h>
+#include <vector>
+
+/// \brief Contiguous range of an index buffer, which can be drawn with a single draw call
+struct IndexRange {
+    UINT firstIndex;
+    UINT indicesCount;
+};
+
+/// \brief Selects meshlets which can be visible from given viewpoint
+///
+/// Meshlets are tested against view frustum with their bounding spheres and against the eye
+/// position with their normal cones. Meshlets adjacent in the index buffer are merged, so in
+/// the common case of mostly visible mesh only a couple of draw calls are needed.
+class MeshletCuller : DXD::NonInstantiatable {
+public:
+    /// \param objectToClip matrix transforming object space positions to clip space, i.e. model-view-projection
+    /// \param eyePosition camera position in object space, nullptr disables back facing meshlets culling, e.g. for
+    /// orthographic projections or when both faces are rasterized
+    /// \param outVisibleRanges index ranges to draw, previous contents are discarded
+    static void cull(const Meshlet *meshlets, UINT meshletsCount, const XMFLOAT4X4 &objectToClip, const XMFLOAT3 *eyePosition,
+                     std::vector<IndexRange> &outVisibleRanges);
+
+    static bool isOutsideFrustum(const Meshlet &meshlet, const XMFLOAT4 frustumPlanes[6]);
+    static bool isBackFacing(const Meshlet &meshlet, const XMFLOAT3 &eyePosition);
+
+    /// Extracts normalized planes with normals pointing inside from row-vector convention matrix.
+    /// Near plane is at z=0, as in Direct3D clip space.
+    static void extractFrustumPlanes(const XMFLOAT4X4 &objectToClip, XMFLOAT4 outFrustumPlanes[6]);
+};
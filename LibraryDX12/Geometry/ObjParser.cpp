@@ -0,0 +1,466 @@
+#include "ObjParser.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+// ----------------------------------------------------------------- Character helpers
+
+namespace {
+inline bool isSpace(char character) {
+    return character == ' ' || character == '\t' || character == '\r';
+}
+
+inline bool isDigit(char character) {
+    return character >= '0' && character <= '9';
+}
+
+inline const char *skipSpaces(const char *current, const char *end) {
+    while (current < end && isSpace(*current)) {
+        current++;
+    }
+    return current;
+}
+
+// Checks if line starts with given statement keyword followed by a whitespace
+template <size_t keywordLengthWithNull>
+inline bool isStatement(const char *current, const char *lineEnd, const char (&keyword)[keywordLengthWithNull]) {
+    constexpr size_t keywordLength = keywordLengthWithNull - 1;
+    if (static_cast<size_t>(lineEnd - current) <= keywordLength) {
+        return false;
+    }
+    return std::memcmp(current, keyword, keywordLength) == 0 && isSpace(current[keywordLength]);
+}
+
+inline double getPowerOfTen(int exponent) {
+    // Powers of ten up to 1e22 are exactly representable in double
+    constexpr static double exactPowers[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                             1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    if (exponent < static_cast<int>(sizeof(exactPowers) / sizeof(exactPowers[0]))) {
+        return exactPowers[exponent];
+    }
+    return std::pow(10.0, exponent);
+}
+
+// Calls the callback with bounds of each line, leading whitespace skipped. Stops if the callback returns false
+template <typename Callback>
+inline bool forEachStatement(const char *begin, const char *end, Callback &&callback) {
+    for (const char *current = begin; current < end;) {
+        const char *lineEnd = static_cast<const char *>(std::memchr(current, '\n', end - current));
+        if (lineEnd == nullptr) {
+            lineEnd = end;
+        }
+
+        if (!callback(skipSpaces(current, lineEnd), lineEnd)) {
+            return false;
+        }
+        current = lineEnd + 1;
+    }
+    return true;
+}
+} // namespace
+
+// ----------------------------------------------------------------- Public interface
+
+bool ObjParser::parse(const char *begin, const char *end, ObjData &outData) {
+    return forEachStatement(begin, end, [&](const char *current, const char *lineEnd) {
+        if (isStatement(current, lineEnd, "v")) {
+            parseFloats(current + 1, lineEnd, outData.positions, 3);
+        } else if (isStatement(current, lineEnd, "vn")) {
+            parseFloats(current + 2, lineEnd, outData.normals, 3);
+        } else if (isStatement(current, lineEnd, "vt")) {
+            parseFloats(current + 2, lineEnd, outData.textureCoordinates, 2);
+        } else if (isStatement(current, lineEnd, "f")) {
+            return parseFace(current + 1, lineEnd, outData.faceCorners);
+        } else if (isStatement(current, lineEnd, "usemtl")) {
+            parseMaterialSwitch(current + 6, lineEnd, outData.faceCorners.size(), outData);
+        } else if (isStatement(current, lineEnd, "mtllib") && outData.materialLibrary.empty()) {
+            outData.materialLibrary = parseName(current + 6, lineEnd);
+        }
+        return true;
+    });
+}
+
+bool ObjParser::parseAttributes(const char *begin, const char *end, ObjData &outData, size_t &outFaceCornersCount) {
+    // Faces are parsed only to validate and count them, corners of one face at a time are stored
+    std::vector<ObjFaceCorner> faceCorners{};
+    return forEachStatement(begin, end, [&](const char *current, const char *lineEnd) {
+        if (isStatement(current, lineEnd, "v")) {
+            parseFloats(current + 1, lineEnd, outData.positions, 3);
+        } else if (isStatement(current, lineEnd, "vn")) {
+            parseFloats(current + 2, lineEnd, outData.normals, 3);
+        } else if (isStatement(current, lineEnd, "vt")) {
+            parseFloats(current + 2, lineEnd, outData.textureCoordinates, 2);
+        } else if (isStatement(current, lineEnd, "f")) {
+            faceCorners.clear();
+            if (!parseFace(current + 1, lineEnd, faceCorners)) {
+                return false;
+            }
+            outFaceCornersCount += faceCorners.size();
+        } else if (isStatement(current, lineEnd, "usemtl")) {
+            parseMaterialSwitch(current + 6, lineEnd, outFaceCornersCount, outData);
+        } else if (isStatement(current, lineEnd, "mtllib") && outData.materialLibrary.empty()) {
+            outData.materialLibrary = parseName(current + 6, lineEnd);
+        }
+        return true;
+    });
+}
+
+bool ObjParser::parseFaces(const char *begin, const char *end, std::vector<ObjFaceCorner> &outCorners) {
+    return forEachStatement(begin, end, [&](const char *current, const char *lineEnd) {
+        if (isStatement(current, lineEnd, "f")) {
+            return parseFace(current + 1, lineEnd, outCorners);
+        }
+        return true;
+    });
+}
+
+const char *ObjParser::findLineAlignedChunkEnd(const char *begin, const char *end, size_t desiredSize) {
+    if (static_cast<size_t>(end - begin) <= desiredSize) {
+        return end;
+    }
+
+    const char *searchStart = begin + desiredSize - 1;
+    const char *lineFeed = static_cast<const char *>(std::memchr(searchStart, '\n', end - searchStart));
+    return lineFeed != nullptr ? lineFeed + 1 : end;
+}
+
+std::vector<ObjChunk> ObjParser::splitIntoChunks(const char *begin, const char *end, size_t maxChunksCount, size_t minChunkSize) {
+    const size_t size = static_cast<size_t>(end - begin);
+    const size_t chunkSize = std::max(minChunkSize, (size + maxChunksCount - 1) / std::max(maxChunksCount, size_t{1u}));
+
+    std::vector<ObjChunk> chunks{};
+    for (const char *chunkBegin = begin; chunkBegin < end;) {
+        const char *chunkEnd = findLineAlignedChunkEnd(chunkBegin, end, chunkSize);
+        chunks.push_back(ObjChunk{chunkBegin, chunkEnd});
+        chunkBegin = chunkEnd;
+    }
+    return chunks;
+}
+
+void ObjParser::merge(std::vector<ObjData> &chunksData, ObjData &outData) {
+    if (chunksData.size() == 1u) {
+        outData = std::move(chunksData[0]);
+        return;
+    }
+
+    // Compute offsets of each chunk in the merged arrays
+    std::vector<size_t> positionsOffsets{}, normalsOffsets{}, textureCoordinatesOffsets{}, faceCornersOffsets{};
+    size_t positionsCount = 0u, normalsCount = 0u, textureCoordinatesCount = 0u, faceCornersCount = 0u;
+    for (const ObjData &chunk : chunksData) {
+        positionsOffsets.push_back(positionsCount);
+        normalsOffsets.push_back(normalsCount);
+        textureCoordinatesOffsets.push_back(textureCoordinatesCount);
+        faceCornersOffsets.push_back(faceCornersCount);
+        positionsCount += chunk.positions.size();
+        normalsCount += chunk.normals.size();
+        textureCoordinatesCount += chunk.textureCoordinates.size();
+        faceCornersCount += chunk.faceCorners.size();
+    }
+
+    // Allocate once and copy each chunk to its place
+    outData.positions.resize(positionsCount);
+    outData.normals.resize(normalsCount);
+    outData.textureCoordinates.resize(textureCoordinatesCount);
+    outData.faceCorners.resize(faceCornersCount);
+    for (size_t chunkIndex = 0u; chunkIndex < chunksData.size(); chunkIndex++) {
+        const ObjData &chunk = chunksData[chunkIndex];
+        std::copy(chunk.positions.begin(), chunk.positions.end(), outData.positions.begin() + positionsOffsets[chunkIndex]);
+        std::copy(chunk.normals.begin(), chunk.normals.end(), outData.normals.begin() + normalsOffsets[chunkIndex]);
+        std::copy(chunk.textureCoordinates.begin(), chunk.textureCoordinates.end(), outData.textureCoordinates.begin() + textureCoordinatesOffsets[chunkIndex]);
+        std::copy(chunk.faceCorners.begin(), chunk.faceCorners.end(), outData.faceCorners.begin() + faceCornersOffsets[chunkIndex]);
+    }
+
+    // Materials are few, so they're merged serially with a lookup by name
+    outData.materialNames.clear();
+    outData.materialSwitches.clear();
+    outData.materialLibrary.clear();
+    std::vector<UINT> materialsRemap{};
+    for (size_t chunkIndex = 0u; chunkIndex < chunksData.size(); chunkIndex++) {
+        const ObjData &chunk = chunksData[chunkIndex];
+        materialsRemap.clear();
+        for (const std::string &materialName : chunk.materialNames) {
+            materialsRemap.push_back(findOrAddMaterialName(materialName, outData.materialNames));
+        }
+        for (const ObjMaterialSwitch &materialSwitch : chunk.materialSwitches) {
+            addMaterialSwitch(materialSwitch.firstFaceCorner + faceCornersOffsets[chunkIndex], materialsRemap[materialSwitch.material],
+                              outData.materialSwitches);
+        }
+        if (outData.materialLibrary.empty()) {
+            outData.materialLibrary = chunk.materialLibrary;
+        }
+    }
+}
+
+void ObjParser::parseMaterialLibrary(const char *begin, const char *end, std::vector<ObjMaterial> &outMaterials) {
+    forEachStatement(begin, end, [&](const char *current, const char *lineEnd) {
+        if (isStatement(current, lineEnd, "newmtl")) {
+            outMaterials.push_back(ObjMaterial{parseName(current + 6, lineEnd)});
+        } else if (outMaterials.empty()) {
+            return true; // properties outside of any material are ignored
+        } else if (isStatement(current, lineEnd, "Kd")) {
+            parseColor(current + 2, lineEnd, outMaterials.back().diffuseColor);
+        } else if (isStatement(current, lineEnd, "Ks")) {
+            parseColor(current + 2, lineEnd, outMaterials.back().specularColor);
+        }
+        return true;
+    });
+}
+
+void ObjParser::groupTrianglesByMaterial(const std::vector<ObjMaterialSwitch> &materialSwitches, UINT materialsCount,
+                                         std::vector<UINT> &indices, std::vector<ObjMaterialGroup> &outGroups) {
+    outGroups.clear();
+    const auto indicesCount = static_cast<UINT>(indices.size());
+    if (materialSwitches.empty()) {
+        if (indicesCount > 0u) {
+            outGroups.push_back(ObjMaterialGroup{ObjMaterialSwitch::noMaterial, 0u, indicesCount});
+        }
+        return;
+    }
+
+    // Consecutive faces of one material form a run. Slot 0 is used for faces without material, slot i + 1 for material i
+    auto forEachRun = [&](auto &&callback) {
+        callback(0u, 0u, static_cast<UINT>(std::min<size_t>(materialSwitches[0].firstFaceCorner, indicesCount)));
+        for (size_t switchIndex = 0u; switchIndex < materialSwitches.size(); switchIndex++) {
+            const size_t runEnd = switchIndex + 1 < materialSwitches.size() ? materialSwitches[switchIndex + 1].firstFaceCorner : indicesCount;
+            const auto begin = static_cast<UINT>(std::min<size_t>(materialSwitches[switchIndex].firstFaceCorner, indicesCount));
+            const auto end = static_cast<UINT>(std::min<size_t>(runEnd, indicesCount));
+            callback(materialSwitches[switchIndex].material + 1, begin, end);
+        }
+    };
+
+    // Counting sort of the runs, which keeps order of triangles within each material
+    std::vector<UINT> slotsOffsets(materialsCount + 2, 0u);
+    forEachRun([&](UINT slot, UINT begin, UINT end) { slotsOffsets[slot + 1] += end - begin; });
+    for (auto slot = 1u; slot < slotsOffsets.size(); slot++) {
+        slotsOffsets[slot] += slotsOffsets[slot - 1];
+    }
+    for (auto slot = 0u; slot <= materialsCount; slot++) {
+        const UINT slotIndicesCount = slotsOffsets[slot + 1] - slotsOffsets[slot];
+        if (slotIndicesCount > 0u) {
+            const UINT material = slot == 0u ? ObjMaterialSwitch::noMaterial : slot - 1;
+            outGroups.push_back(ObjMaterialGroup{material, slotsOffsets[slot], slotIndicesCount});
+        }
+    }
+    if (outGroups.size() == 1u) {
+        return; // there's nothing to reorder
+    }
+
+    std::vector<UINT> sortedIndices(indices.size());
+    forEachRun([&](UINT slot, UINT begin, UINT end) {
+        std::copy(indices.begin() + begin, indices.begin() + end, sortedIndices.begin() + slotsOffsets[slot]);
+        slotsOffsets[slot] += end - begin;
+    });
+    indices = std::move(sortedIndices);
+}
+
+const char *ObjParser::parseFloat(const char *current, const char *end, FLOAT &outValue) {
+    // Sign
+    bool negative = false;
+    if (current < end && (*current == '-' || *current == '+')) {
+        negative = *current == '-';
+        current++;
+    }
+
+    // Mantissa - digits beyond what fits in 64 bits only affect the exponent
+    constexpr int maxSignificantDigits = 19;
+    uint64_t mantissa = 0u;
+    int significantDigits = 0;
+    int exponent = 0;
+    bool anyDigits = false;
+    for (; current < end && isDigit(*current); current++) {
+        anyDigits = true;
+        if (significantDigits < maxSignificantDigits) {
+            mantissa = mantissa * 10 + (*current - '0');
+            significantDigits += (mantissa != 0u);
+        } else {
+            exponent++;
+        }
+    }
+    if (current < end && *current == '.') {
+        current++;
+        for (; current < end && isDigit(*current); current++) {
+            anyDigits = true;
+            if (significantDigits < maxSignificantDigits) {
+                mantissa = mantissa * 10 + (*current - '0');
+                significantDigits += (mantissa != 0u);
+                exponent--;
+            }
+        }
+    }
+    if (!anyDigits) {
+        return nullptr;
+    }
+
+    // Optional exponent, 'e' not followed by digits is left unconsumed
+    if (current < end && (*current == 'e' || *current == 'E')) {
+        const char *exponentCurrent = current + 1;
+        bool negativeExponent = false;
+        if (exponentCurrent < end && (*exponentCurrent == '-' || *exponentCurrent == '+')) {
+            negativeExponent = *exponentCurrent == '-';
+            exponentCurrent++;
+        }
+        if (exponentCurrent < end && isDigit(*exponentCurrent)) {
+            int explicitExponent = 0;
+            for (; exponentCurrent < end && isDigit(*exponentCurrent); exponentCurrent++) {
+                if (explicitExponent < 10000) {
+                    explicitExponent = explicitExponent * 10 + (*exponentCurrent - '0');
+                }
+            }
+            exponent += negativeExponent ? -explicitExponent : explicitExponent;
+            current = exponentCurrent;
+        }
+    }
+
+    // Compose the value
+    double value = static_cast<double>(mantissa);
+    if (exponent < 0) {
+        value /= getPowerOfTen(-exponent);
+    } else if (exponent > 0) {
+        value *= getPowerOfTen(exponent);
+    }
+    outValue = static_cast<FLOAT>(negative ? -value : value);
+    return current;
+}
+
+const char *ObjParser::parseUnsigned(const char *current, const char *end, UINT &outValue) {
+    if (current == end || !isDigit(*current)) {
+        return nullptr;
+    }
+
+    uint64_t value = 0u;
+    for (; current < end && isDigit(*current); current++) {
+        value = value * 10 + (*current - '0');
+        if (value > std::numeric_limits<UINT>::max()) {
+            return nullptr;
+        }
+    }
+    outValue = static_cast<UINT>(value);
+    return current;
+}
+
+// ----------------------------------------------------------------- Statements parsing
+
+void ObjParser::parseFloats(const char *current, const char *end, std::vector<FLOAT> &outValues, size_t count) {
+    for (size_t index = 0u; index < count; index++) {
+        // Missing or malformed values are set to 0
+        FLOAT value = 0.f;
+        if (current != nullptr) {
+            current = skipSpaces(current, end);
+            current = parseFloat(current, end, value);
+        }
+        outValues.push_back(value);
+    }
+}
+
+const char *ObjParser::parseFaceCorner(const char *current, const char *end, ObjFaceCorner &outCorner) {
+    outCorner = ObjFaceCorner{};
+
+    // Position index is mandatory, indices in file are 1-based
+    UINT index = 0u;
+    current = parseUnsigned(current, end, index);
+    if (current == nullptr || index == 0u) {
+        return nullptr;
+    }
+    outCorner.position = index - 1;
+
+    // Optional texture coordinate index
+    if (current == end || *current != '/') {
+        return current;
+    }
+    current++;
+    if (current < end && *current != '/') {
+        current = parseUnsigned(current, end, index);
+        if (current == nullptr || index == 0u) {
+            return nullptr;
+        }
+        outCorner.textureCoordinate = index - 1;
+    }
+
+    // Optional normal index
+    if (current == end || *current != '/') {
+        return current;
+    }
+    current++;
+    current = parseUnsigned(current, end, index);
+    if (current == nullptr || index == 0u) {
+        return nullptr;
+    }
+    outCorner.normal = index - 1;
+    return current;
+}
+
+bool ObjParser::parseFace(const char *current, const char *end, std::vector<ObjFaceCorner> &outCorners) {
+    // Polygons are triangulated as a fan around the first corner
+    ObjFaceCorner firstCorner{};
+    ObjFaceCorner previousCorner{};
+    UINT cornersCount = 0u;
+    for (current = skipSpaces(current, end); current < end; current = skipSpaces(current, end)) {
+        ObjFaceCorner corner{};
+        current = parseFaceCorner(current, end, corner);
+        if (current == nullptr) {
+            return false;
+        }
+
+        if (cornersCount == 0u) {
+            firstCorner = corner;
+        } else if (cornersCount >= 2u) {
+            outCorners.push_back(firstCorner);
+            outCorners.push_back(previousCorner);
+            outCorners.push_back(corner);
+        }
+        previousCorner = corner;
+        cornersCount++;
+    }
+    return cornersCount >= 3u;
+}
+
+void ObjParser::parseMaterialSwitch(const char *current, const char *end, size_t faceCornersCount, ObjData &outData) {
+    const UINT material = findOrAddMaterialName(parseName(current, end), outData.materialNames);
+    addMaterialSwitch(faceCornersCount, material, outData.materialSwitches);
+}
+
+void ObjParser::addMaterialSwitch(size_t faceCornersCount, UINT material, std::vector<ObjMaterialSwitch> &materialSwitches) {
+    // Switch not followed by any face is overridden, switch to the current material is redundant
+    if (!materialSwitches.empty() && materialSwitches.back().firstFaceCorner == faceCornersCount) {
+        materialSwitches.pop_back();
+    }
+    if (materialSwitches.empty() || materialSwitches.back().material != material) {
+        materialSwitches.push_back(ObjMaterialSwitch{faceCornersCount, material});
+    }
+}
+
+void ObjParser::parseColor(const char *current, const char *end, FLOAT (&outColor)[3]) {
+    // Green and blue components are optional, they're equal to red if not present
+    UINT componentsCount = 0u;
+    for (; componentsCount < 3u; componentsCount++) {
+        current = skipSpaces(current, end);
+        current = parseFloat(current, end, outColor[componentsCount]);
+        if (current == nullptr) {
+            break;
+        }
+    }
+    if (componentsCount == 1u) {
+        outColor[1] = outColor[2] = outColor[0];
+    }
+}
+
+std::string ObjParser::parseName(const char *current, const char *end) {
+    // Names may contain spaces, only the surrounding ones are trimmed
+    current = skipSpaces(current, end);
+    while (end > current && isSpace(end[-1])) {
+        end--;
+    }
+    return std::string{current, end};
+}
+
+UINT ObjParser::findOrAddMaterialName(const std::string &name, std::vector<std::string> &materialNames) {
+    const auto it = std::find(materialNames.begin(), materialNames.end(), name);
+    if (it != materialNames.end()) {
+        return static_cast<UINT>(std::distance(materialNames.begin(), it));
+    }
+    materialNames.push_back(name);
+    return static_cast<UINT>(materialNames.size() - 1);
+}
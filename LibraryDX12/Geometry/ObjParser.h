@@ -0,0 +1,133 @@
+#pragma once
+
+#include "DXD/Utility/NonCopyableAndMovable.h"
+
+#include <DXD/ExternalHeadersWrappers/windows.h>
+#include <string>
+#include <vector>
+
+/// \brief Indices of attributes used by a single corner of a face, already converted to 0-based
+///
+/// Components not specified in the file (e.g. texture coordinate in "1//2") are set to 0.
+struct ObjFaceCorner {
+    UINT position;
+    UINT textureCoordinate;
+    UINT normal;
+};
+
+/// \brief Material used by faces following given face corner, set with usemtl statement
+struct ObjMaterialSwitch {
+    constexpr static UINT noMaterial = 0xFFFFFFFF; // faces before the first usemtl statement
+
+    size_t firstFaceCorner;
+    UINT material; // index into ObjData::materialNames
+};
+
+/// \brief Range of the index buffer containing triangles of one material, see ObjParser::groupTrianglesByMaterial
+struct ObjMaterialGroup {
+    UINT material; // index into ObjData::materialNames or ObjMaterialSwitch::noMaterial
+    UINT firstIndex;
+    UINT indicesCount;
+};
+
+/// \brief Material defined in mtl file with newmtl statement, only properties supported by the engine are read
+struct ObjMaterial {
+    std::string name;
+    FLOAT diffuseColor[3] = {1.f, 1.f, 1.f};
+    FLOAT specularColor[3] = {0.f, 0.f, 0.f};
+};
+
+/// \brief Raw contents of wavefront obj file
+///
+/// Attributes are stored as tightly packed floats, the same way they're written in the file.
+/// Polygons are triangulated upon parsing, so every 3 consecutive face corners form a triangle.
+struct ObjData {
+    std::vector<FLOAT> positions = {};          // 3 elements per vertex
+    std::vector<FLOAT> normals = {};            // 3 elements per normal
+    std::vector<FLOAT> textureCoordinates = {}; // 2 elements per coordinate, w is discarded
+    std::vector<ObjFaceCorner> faceCorners = {};
+    std::vector<std::string> materialNames = {};          // in order of first use
+    std::vector<ObjMaterialSwitch> materialSwitches = {}; // sorted by face corner
+    std::string materialLibrary = {};                     // file referenced by the first mtllib statement, relative to the obj
+};
+
+/// \brief Line-aligned part of obj file which can be parsed independently of other chunks
+struct ObjChunk {
+    const char *begin;
+    const char *end;
+};
+
+/// \brief Allocation-free tokenizer of wavefront obj files
+///
+/// Works directly on a read-only character buffer (typically a MemoryMappedFile). Numbers are
+/// converted in place without constructing any strings or streams, the only allocations made
+/// are growths of output vectors in ObjData. Unsupported statements and comments are skipped.
+/// Object (o) and group (g) statements only name parts of the model, so they're skipped as well.
+/// Faces are grouped by their material instead, which results in the fewest draws.
+class ObjParser : DXD::NonInstantiatable {
+public:
+    /// Parses all lines contained in the range and appends read data to the output. Range should
+    /// start at the beginning of a line and end at the end of a line (see findLineAlignedChunkEnd).
+    /// \param begin first character of the range
+    /// \param end one past the last character of the range
+    /// \param outData parsed data is appended here
+    /// \return false if a malformed face statement has been encountered
+    static bool parse(const char *begin, const char *end, ObjData &outData);
+
+    /// Two-pass alternative to parse for files too big to keep all face corners in memory. This pass
+    /// appends only attributes and materials to the output. Faces are validated and counted after triangulation,
+    /// so outputs can be preallocated before the faces are read with parseFaces.
+    /// \param outFaceCornersCount number of triangulated face corners in the range is added here, material
+    /// switches are positioned relative to its initial value
+    /// \return false if a malformed face statement has been encountered
+    static bool parseAttributes(const char *begin, const char *end, ObjData &outData, size_t &outFaceCornersCount);
+
+    /// Second pass of the two-pass parsing, appends triangulated corners of faces in the range to the output
+    /// and skips all other statements. Typically called on consecutive windows of a file with the output
+    /// cleared in between, so only a window worth of corners is kept in memory at a time.
+    /// \return false if a malformed face statement has been encountered
+    static bool parseFaces(const char *begin, const char *end, std::vector<ObjFaceCorner> &outCorners);
+
+    /// Returns end of a chunk starting at begin, which is at least desiredSize bytes long (unless the
+    /// whole range is shorter) and ends right after a line feed, so no line is split between chunks.
+    static const char *findLineAlignedChunkEnd(const char *begin, const char *end, size_t desiredSize);
+
+    /// Splits the range into at most maxChunksCount line-aligned chunks of similar size. Chunks are not
+    /// made smaller than minChunkSize, so small files are not split at all.
+    static std::vector<ObjChunk> splitIntoChunks(const char *begin, const char *end, size_t maxChunksCount, size_t minChunkSize);
+
+    /// Concatenates data of independently parsed chunks, preserving their order. Face indices in obj
+    /// files are absolute, so they're valid after the merge without any rebasing. Each chunk is copied
+    /// to its final location, determined by prefix sum of sizes of preceding chunks. Material indices
+    /// are local to each chunk, so they're remapped by name. Faces at the beginning of a chunk keep
+    /// material of the previous chunk, since there is no switch before them.
+    /// \param chunksData results of parsing consecutive chunks, they're left in unspecified state
+    /// \param outData merged data, previous contents are discarded
+    static void merge(std::vector<ObjData> &chunksData, ObjData &outData);
+
+    /// Parses contents of mtl file and appends all materials defined in it to the output
+    static void parseMaterialLibrary(const char *begin, const char *end, std::vector<ObjMaterial> &outMaterials);
+
+    /// Stable sorts triangles by their material, so each material occupies one contiguous range of indices
+    /// and can be drawn with a single call. Triangles without material come first, empty groups are omitted.
+    /// \param materialSwitches switches of material, positioned by face corner
+    /// \param materialsCount number of materials referenced by the switches
+    /// \param indices one index per face corner in the order of the file, triangles are reordered in place
+    /// \param outGroups index ranges of materials, previous contents are discarded
+    static void groupTrianglesByMaterial(const std::vector<ObjMaterialSwitch> &materialSwitches, UINT materialsCount,
+                                         std::vector<UINT> &indices, std::vector<ObjMaterialGroup> &outGroups);
+
+    // Number parsing helpers, they return pointer past the last consumed character or nullptr on failure
+    static const char *parseFloat(const char *current, const char *end, FLOAT &outValue);
+    static const char *parseUnsigned(const char *current, const char *end, UINT &outValue);
+
+private:
+    static void parseFloats(const char *current, const char *end, std::vector<FLOAT> &outValues, size_t count);
+    static const char *parseFaceCorner(const char *current, const char *end, ObjFaceCorner &outCorner);
+    static bool parseFace(const char *current, const char *end, std::vector<ObjFaceCorner> &outCorners);
+    static void parseMaterialSwitch(const char *current, const char *end, size_t faceCornersCount, ObjData &outData);
+    static void addMaterialSwitch(size_t faceCornersCount, UINT material, std::vector<ObjMaterialSwitch> &materialSwitches);
+    static void parseColor(const char *current, const char *end, FLOAT (&outColor)[3]);
+    static std::string parseName(const char *current, const char *end);
+    static UINT findOrAddMaterialName(const std::string &name, std::vector<std::string> &materialNames);
+};
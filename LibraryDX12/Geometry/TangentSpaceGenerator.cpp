@@ -0,0 +1,298 @@
+#include "TangentSpaceGenerator.h"
+
+#include "Utility/CpuFeatures.h"
+
+#include <algorithm>
+#include <cmath>
+#include <intrin.h>
+
+// ----------------------------------------------------------------- SIMD lanes
+
+namespace {
+constexpr UINT maxBatchWidth = 8u;
+constexpr FLOAT epsilon = 1e-30f;
+constexpr FLOAT pi = 3.14159265358979f;
+
+// Attributes of a batch of triangles in structure of arrays layout, each array has one element per triangle
+struct alignas(32) TriangleBatch {
+    FLOAT position[3][3][maxBatchWidth];          // [corner][component][triangle]
+    FLOAT textureCoordinate[3][2][maxBatchWidth]; // [corner][component][triangle]
+    FLOAT normal[3][maxBatchWidth];               // unit face normal
+    FLOAT tangent[3][maxBatchWidth];              // unit face tangent, zero for degenerate texture mapping
+    FLOAT weight[3][maxBatchWidth];               // weight of the triangle contribution for each corner
+};
+
+struct ScalarLanes {
+    using Vector = FLOAT;
+    constexpr static UINT width = 1u;
+    static Vector load(const FLOAT *data) { return *data; }
+    static void store(FLOAT *data, Vector value) { *data = value; }
+    static Vector set(FLOAT value) { return value; }
+    static Vector add(Vector a, Vector b) { return a + b; }
+    static Vector sub(Vector a, Vector b) { return a - b; }
+    static Vector mul(Vector a, Vector b) { return a * b; }
+    static Vector min(Vector a, Vector b) { return std::min(a, b); }
+    static Vector max(Vector a, Vector b) { return std::max(a, b); }
+    static Vector sqrt(Vector a) { return std::sqrt(a); }
+    static Vector abs(Vector a) { return std::abs(a); }
+    static Vector step(Vector a, FLOAT threshold) { return a > threshold ? 1.f : 0.f; }
+    static Vector safeReciprocal(Vector a) { return a > epsilon ? 1.f / a : 0.f; }
+    static Vector selectIfNegative(Vector condition, Vector ifNegative, Vector otherwise) { return condition < 0.f ? ifNegative : otherwise; }
+};
+
+struct SseLanes {
+    using Vector = __m128;
+    constexpr static UINT width = 4u;
+    static Vector load(const FLOAT *data) { return _mm_load_ps(data); }
+    static void store(FLOAT *data, Vector value) { _mm_store_ps(data, value); }
+    static Vector set(FLOAT value) { return _mm_set1_ps(value); }
+    static Vector add(Vector a, Vector b) { return _mm_add_ps(a, b); }
+    static Vector sub(Vector a, Vector b) { return _mm_sub_ps(a, b); }
+    static Vector mul(Vector a, Vector b) { return _mm_mul_ps(a, b); }
+    static Vector min(Vector a, Vector b) { return _mm_min_ps(a, b); }
+    static Vector max(Vector a, Vector b) { return _mm_max_ps(a, b); }
+    static Vector sqrt(Vector a) { return _mm_sqrt_ps(a); }
+    static Vector abs(Vector a) { return _mm_andnot_ps(_mm_set1_ps(-0.f), a); }
+    static Vector step(Vector a, FLOAT threshold) { return _mm_and_ps(_mm_cmpgt_ps(a, _mm_set1_ps(threshold)), _mm_set1_ps(1.f)); }
+    static Vector safeReciprocal(Vector a) { return _mm_and_ps(_mm_cmpgt_ps(a, _mm_set1_ps(epsilon)), _mm_div_ps(_mm_set1_ps(1.f), a)); }
+    static Vector selectIfNegative(Vector condition, Vector ifNegative, Vector otherwise) {
+        const Vector mask = _mm_cmplt_ps(condition, _mm_setzero_ps());
+        return _mm_or_ps(_mm_and_ps(mask, ifNegative), _mm_andnot_ps(mask, otherwise));
+    }
+};
+
+struct AvxLanes {
+    using Vector = __m256;
+    constexpr static UINT width = 8u;
+    static Vector load(const FLOAT *data) { return _mm256_load_ps(data); }
+    static void store(FLOAT *data, Vector value) { _mm256_store_ps(data, value); }
+    static Vector set(FLOAT value) { return _mm256_set1_ps(value); }
+    static Vector add(Vector a, Vector b) { return _mm256_add_ps(a, b); }
+    static Vector sub(Vector a, Vector b) { return _mm256_sub_ps(a, b); }
+    static Vector mul(Vector a, Vector b) { return _mm256_mul_ps(a, b); }
+    static Vector min(Vector a, Vector b) { return _mm256_min_ps(a, b); }
+    static Vector max(Vector a, Vector b) { return _mm256_max_ps(a, b); }
+    static Vector sqrt(Vector a) { return _mm256_sqrt_ps(a); }
+    static Vector abs(Vector a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.f), a); }
+    static Vector step(Vector a, FLOAT threshold) { return _mm256_and_ps(_mm256_cmp_ps(a, _mm256_set1_ps(threshold), _CMP_GT_OQ), _mm256_set1_ps(1.f)); }
+    static Vector safeReciprocal(Vector a) { return _mm256_and_ps(_mm256_cmp_ps(a, _mm256_set1_ps(epsilon), _CMP_GT_OQ), _mm256_div_ps(_mm256_set1_ps(1.f), a)); }
+    static Vector selectIfNegative(Vector condition, Vector ifNegative, Vector otherwise) {
+        return _mm256_blendv_ps(otherwise, ifNegative, _mm256_cmp_ps(condition, _mm256_setzero_ps(), _CMP_LT_OQ));
+    }
+};
+
+// ----------------------------------------------------------------- Batch kernel
+
+template <typename Lanes>
+struct Vector3 {
+    using Vector = typename Lanes::Vector;
+    Vector x, y, z;
+
+    static Vector3 load(const FLOAT (&data)[3][maxBatchWidth]) { return {Lanes::load(data[0]), Lanes::load(data[1]), Lanes::load(data[2])}; }
+    void store(FLOAT (&data)[3][maxBatchWidth]) const {
+        Lanes::store(data[0], x);
+        Lanes::store(data[1], y);
+        Lanes::store(data[2], z);
+    }
+    Vector3 operator-(const Vector3 &other) const { return {Lanes::sub(x, other.x), Lanes::sub(y, other.y), Lanes::sub(z, other.z)}; }
+    Vector3 operator*(Vector scale) const { return {Lanes::mul(x, scale), Lanes::mul(y, scale), Lanes::mul(z, scale)}; }
+    Vector dot(const Vector3 &other) const { return Lanes::add(Lanes::add(Lanes::mul(x, other.x), Lanes::mul(y, other.y)), Lanes::mul(z, other.z)); }
+    Vector3 cross(const Vector3 &other) const {
+        return {Lanes::sub(Lanes::mul(y, other.z), Lanes::mul(z, other.y)),
+                Lanes::sub(Lanes::mul(z, other.x), Lanes::mul(x, other.z)),
+                Lanes::sub(Lanes::mul(x, other.y), Lanes::mul(y, other.x))};
+    }
+};
+
+// Abramowitz and Stegun 4.4.45, absolute error below 7e-5 radians
+template <typename Lanes>
+typename Lanes::Vector acosApproximation(typename Lanes::Vector x) {
+    x = Lanes::min(Lanes::max(x, Lanes::set(-1.f)), Lanes::set(1.f));
+    const auto absX = Lanes::abs(x);
+    auto polynomial = Lanes::set(-0.0187293f);
+    polynomial = Lanes::add(Lanes::mul(polynomial, absX), Lanes::set(0.0742610f));
+    polynomial = Lanes::sub(Lanes::mul(polynomial, absX), Lanes::set(0.2121144f));
+    polynomial = Lanes::add(Lanes::mul(polynomial, absX), Lanes::set(1.5707288f));
+    const auto result = Lanes::mul(Lanes::sqrt(Lanes::sub(Lanes::set(1.f), absX)), polynomial);
+    return Lanes::selectIfNegative(x, Lanes::sub(Lanes::set(pi), result), result);
+}
+
+// Computes face normals, tangents and corner weights of the first Lanes::width triangles of the batch
+template <typename Lanes>
+void processBatch(TriangleBatch &batch, bool withTangents, TangentSpaceGenerator::Weighting weighting) {
+    using Vector = typename Lanes::Vector;
+    const auto a = Vector3<Lanes>::load(batch.position[0]);
+    const auto b = Vector3<Lanes>::load(batch.position[1]);
+    const auto c = Vector3<Lanes>::load(batch.position[2]);
+    const auto edgeAB = b - a;
+    const auto edgeAC = c - a;
+    const auto edgeBC = c - b;
+
+    // Face normal, its length is twice the triangle area
+    const auto normal = edgeAB.cross(edgeAC);
+    const Vector normalLength = Lanes::sqrt(normal.dot(normal));
+    (normal * Lanes::safeReciprocal(normalLength)).store(batch.normal);
+
+    // Weights of the contribution to each corner
+    if (weighting == TangentSpaceGenerator::Weighting::AREA) {
+        Lanes::store(batch.weight[0], normalLength);
+        Lanes::store(batch.weight[1], normalLength);
+        Lanes::store(batch.weight[2], normalLength);
+    } else {
+        const Vector lengthSquaredAB = edgeAB.dot(edgeAB);
+        const Vector lengthSquaredAC = edgeAC.dot(edgeAC);
+        const Vector lengthSquaredBC = edgeBC.dot(edgeBC);
+        const Vector cosineA = Lanes::mul(edgeAB.dot(edgeAC), Lanes::safeReciprocal(Lanes::sqrt(Lanes::mul(lengthSquaredAB, lengthSquaredAC))));
+        const Vector cosineB = Lanes::mul(Lanes::sub(Lanes::set(0.f), edgeAB.dot(edgeBC)), Lanes::safeReciprocal(Lanes::sqrt(Lanes::mul(lengthSquaredAB, lengthSquaredBC))));
+        const Vector cosineC = Lanes::mul(edgeAC.dot(edgeBC), Lanes::safeReciprocal(Lanes::sqrt(Lanes::mul(lengthSquaredAC, lengthSquaredBC))));
+        const Vector isNotDegenerate = Lanes::step(normalLength, epsilon);
+        Lanes::store(batch.weight[0], Lanes::mul(acosApproximation<Lanes>(cosineA), isNotDegenerate));
+        Lanes::store(batch.weight[1], Lanes::mul(acosApproximation<Lanes>(cosineB), isNotDegenerate));
+        Lanes::store(batch.weight[2], Lanes::mul(acosApproximation<Lanes>(cosineC), isNotDegenerate));
+    }
+
+    // Face tangent, pointing towards increasing u coordinate
+    if (withTangents) {
+        const Vector uA = Lanes::load(batch.textureCoordinate[0][0]);
+        const Vector vA = Lanes::load(batch.textureCoordinate[0][1]);
+        const Vector deltaU1 = Lanes::sub(Lanes::load(batch.textureCoordinate[1][0]), uA);
+        const Vector deltaV1 = Lanes::sub(Lanes::load(batch.textureCoordinate[1][1]), vA);
+        const Vector deltaU2 = Lanes::sub(Lanes::load(batch.textureCoordinate[2][0]), uA);
+        const Vector deltaV2 = Lanes::sub(Lanes::load(batch.textureCoordinate[2][1]), vA);
+        const Vector determinant = Lanes::sub(Lanes::mul(deltaU1, deltaV2), Lanes::mul(deltaU2, deltaV1));
+
+        const auto tangent = (edgeAB * deltaV2) - (edgeAC * deltaV1);
+        const Vector sign = Lanes::selectIfNegative(determinant, Lanes::set(-1.f), Lanes::set(1.f));
+        const Vector scale = Lanes::mul(Lanes::mul(sign, Lanes::safeReciprocal(Lanes::sqrt(tangent.dot(tangent)))),
+                                        Lanes::step(Lanes::abs(determinant), epsilon));
+        (tangent * scale).store(batch.tangent);
+    }
+}
+
+using ProcessBatchFunction = void (*)(TriangleBatch &, bool, TangentSpaceGenerator::Weighting);
+
+void normalizeOrFallback(FLOAT vector[3], const FLOAT fallback[3]) {
+    const FLOAT length = std::sqrt(vector[0] * vector[0] + vector[1] * vector[1] + vector[2] * vector[2]);
+    for (auto component = 0u; component < 3u; component++) {
+        vector[component] = length > epsilon ? vector[component] / length : fallback[component];
+    }
+}
+} // namespace
+
+// ----------------------------------------------------------------- Public interface
+
+void TangentSpaceGenerator::computeNormals(VertexAttributeView positions, UINT verticesCount, const std::vector<UINT> &indices,
+                                           Weighting weighting, FLOAT *outNormals, UINT outStrideInFloats, SimdLevel simdLevel) {
+    std::vector<FLOAT> accumulatedNormals(3 * static_cast<size_t>(verticesCount), 0.f);
+    accumulateNormals(positions, verticesCount, indices, weighting, accumulatedNormals.data(), simdLevel);
+    normalizeAccumulatedNormals(accumulatedNormals.data(), verticesCount, outNormals, outStrideInFloats);
+}
+
+void TangentSpaceGenerator::accumulateNormals(VertexAttributeView positions, UINT verticesCount, const std::vector<UINT> &indices,
+                                              Weighting weighting, FLOAT *inOutAccumulatedNormals, SimdLevel simdLevel) {
+    accumulate(positions, nullptr, verticesCount, indices, weighting, simdLevel, inOutAccumulatedNormals, nullptr);
+}
+
+void TangentSpaceGenerator::normalizeAccumulatedNormals(const FLOAT *accumulatedNormals, UINT verticesCount, FLOAT *outNormals, UINT outStrideInFloats) {
+    // Vertices not used by any triangle get an arbitrary unit normal
+    const FLOAT fallbackNormal[3] = {0.f, 1.f, 0.f};
+    for (UINT vertex = 0u; vertex < verticesCount; vertex++) {
+        const FLOAT *accumulatedNormal = accumulatedNormals + 3 * static_cast<size_t>(vertex);
+        FLOAT normal[3] = {accumulatedNormal[0], accumulatedNormal[1], accumulatedNormal[2]};
+        normalizeOrFallback(normal, fallbackNormal);
+        std::copy(normal, normal + 3, outNormals + static_cast<size_t>(vertex) * outStrideInFloats);
+    }
+}
+
+void TangentSpaceGenerator::computeTangents(VertexAttributeView positions, VertexAttributeView textureCoordinates, VertexAttributeView normals,
+                                            UINT verticesCount, const std::vector<UINT> &indices, Weighting weighting,
+                                            FLOAT *outTangents, UINT outStrideInFloats, SimdLevel simdLevel) {
+    std::vector<FLOAT> accumulatedTangents(3 * static_cast<size_t>(verticesCount), 0.f);
+    accumulate(positions, &textureCoordinates, verticesCount, indices, weighting, simdLevel, nullptr, accumulatedTangents.data());
+
+    const FLOAT axisX[3] = {1.f, 0.f, 0.f};
+    for (UINT vertex = 0u; vertex < verticesCount; vertex++) {
+        const FLOAT *normal = normals.get(vertex);
+        FLOAT *tangent = accumulatedTangents.data() + 3 * static_cast<size_t>(vertex);
+
+        // Gram-Schmidt orthogonalization, if tangent is parallel to the normal, any perpendicular vector is used
+        const FLOAT projection = normal[0] * tangent[0] + normal[1] * tangent[1] + normal[2] * tangent[2];
+        for (auto component = 0u; component < 3u; component++) {
+            tangent[component] -= normal[component] * projection;
+        }
+        const bool useAxisX = std::abs(normal[0]) < 0.9f;
+        FLOAT fallbackTangent[3] = {useAxisX ? 0.f : -normal[2], useAxisX ? normal[2] : 0.f, useAxisX ? -normal[1] : normal[0]};
+        normalizeOrFallback(fallbackTangent, axisX);
+        normalizeOrFallback(tangent, fallbackTangent);
+        std::copy(tangent, tangent + 3, outTangents + static_cast<size_t>(vertex) * outStrideInFloats);
+    }
+}
+
+void TangentSpaceGenerator::accumulate(VertexAttributeView positions, const VertexAttributeView *textureCoordinates, UINT verticesCount,
+                                       const std::vector<UINT> &indices, Weighting weighting, SimdLevel simdLevel,
+                                       FLOAT *outAccumulatedNormals, FLOAT *outAccumulatedTangents) {
+    // Select kernel
+    if (simdLevel == SimdLevel::BEST_AVAILABLE) {
+        simdLevel = CpuFeatures::isAvxSupported() ? SimdLevel::AVX : SimdLevel::SSE;
+    }
+    ProcessBatchFunction processBatchFunction = processBatch<ScalarLanes>;
+    UINT batchWidth = ScalarLanes::width;
+    if (simdLevel == SimdLevel::AVX) {
+        processBatchFunction = processBatch<AvxLanes>;
+        batchWidth = AvxLanes::width;
+    } else if (simdLevel == SimdLevel::SSE) {
+        processBatchFunction = processBatch<SseLanes>;
+        batchWidth = SseLanes::width;
+    }
+
+    const bool withTangents = textureCoordinates != nullptr;
+    TriangleBatch batch = {};
+    auto gather = [&](UINT firstTriangle, UINT trianglesCount) {
+        for (UINT lane = 0u; lane < trianglesCount; lane++) {
+            for (auto corner = 0u; corner < 3u; corner++) {
+                const UINT vertex = indices[3 * (firstTriangle + lane) + corner];
+                const FLOAT *position = positions.get(vertex);
+                batch.position[corner][0][lane] = position[0];
+                batch.position[corner][1][lane] = position[1];
+                batch.position[corner][2][lane] = position[2];
+                if (withTangents) {
+                    const FLOAT *textureCoordinate = textureCoordinates->get(vertex);
+                    batch.textureCoordinate[corner][0][lane] = textureCoordinate[0];
+                    batch.textureCoordinate[corner][1][lane] = textureCoordinate[1];
+                }
+            }
+        }
+    };
+    auto scatter = [&](UINT firstTriangle, UINT trianglesCount) {
+        for (UINT lane = 0u; lane < trianglesCount; lane++) {
+            for (auto corner = 0u; corner < 3u; corner++) {
+                const size_t vertex = indices[3 * (firstTriangle + lane) + corner];
+                const FLOAT weight = batch.weight[corner][lane];
+                if (outAccumulatedNormals != nullptr) {
+                    for (auto component = 0u; component < 3u; component++) {
+                        outAccumulatedNormals[3 * vertex + component] += batch.normal[component][lane] * weight;
+                    }
+                }
+                if (outAccumulatedTangents != nullptr) {
+                    for (auto component = 0u; component < 3u; component++) {
+                        outAccumulatedTangents[3 * vertex + component] += batch.tangent[component][lane] * weight;
+                    }
+                }
+            }
+        }
+    };
+
+    // Full batches are processed by the selected kernel, the remainder one triangle at a time
+    const auto trianglesCount = static_cast<UINT>(indices.size() / 3);
+    UINT triangle = 0u;
+    for (; triangle + batchWidth <= trianglesCount; triangle += batchWidth) {
+        gather(triangle, batchWidth);
+        processBatchFunction(batch, withTangents, weighting);
+        scatter(triangle, batchWidth);
+    }
+    for (; triangle < trianglesCount; triangle++) {
+        gather(triangle, 1u);
+        processBatch<ScalarLanes>(batch, withTangents, weighting);
+        scatter(triangle, 1u);
+    }
+}
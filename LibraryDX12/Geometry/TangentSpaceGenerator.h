@@ -0,0 +1,67 @@
+#pragma once
+
+#include "DXD/Utility/NonCopyableAndMovable.h"
+
+#include <DXD/ExternalHeadersWrappers/windows.h>
+#include <vector>
+
+/// \brief Non-owning view of a single attribute in possibly interleaved vertex data
+struct VertexAttributeView {
+    const FLOAT *data;
+    UINT strideInFloats;
+
+    const FLOAT *get(UINT vertex) const { return data + static_cast<size_t>(vertex) * strideInFloats; }
+};
+
+/// \brief Generates smooth per-vertex normals and tangents of indexed triangle meshes
+///
+/// Contributions of all triangles adjacent to a vertex are accumulated and normalized. Triangles
+/// are processed in batches by a SIMD kernel working on structure of arrays registers - 8 triangles
+/// per iteration with AVX and 4 with SSE. Gathering attributes and scattering results is scalar,
+/// since triangles in a batch can share vertices.
+class TangentSpaceGenerator : DXD::NonInstantiatable {
+public:
+    enum class Weighting {
+        AREA,  // contribution proportional to triangle area, cheap but biased towards big triangles
+        ANGLE, // contribution proportional to triangle angle at the vertex, independent of tessellation
+    };
+
+    enum class SimdLevel {
+        SCALAR,
+        SSE,
+        AVX,
+        BEST_AVAILABLE,
+    };
+
+    /// \param positions vertex positions, 3 elements each
+    /// \param verticesCount number of vertices, all indices have to be smaller
+    /// \param indices triangle list
+    /// \param outNormals normalized normals are written here, 3 elements per vertex with given stride
+    static void computeNormals(VertexAttributeView positions, UINT verticesCount, const std::vector<UINT> &indices,
+                               Weighting weighting, FLOAT *outNormals, UINT outStrideInFloats,
+                               SimdLevel simdLevel = SimdLevel::BEST_AVAILABLE);
+
+    /// Parts of computeNormals, for triangles which are not all available at once. Contributions of
+    /// consecutive batches of triangles are summed with accumulateNormals and then normalized once.
+    /// \param inOutAccumulatedNormals sums of contributions, 3 elements per vertex, has to be zeroed before the first batch
+    static void accumulateNormals(VertexAttributeView positions, UINT verticesCount, const std::vector<UINT> &indices,
+                                  Weighting weighting, FLOAT *inOutAccumulatedNormals, SimdLevel simdLevel = SimdLevel::BEST_AVAILABLE);
+    /// \param outNormals normalized normals are written here, 3 elements per vertex with given stride, can alias the input
+    static void normalizeAccumulatedNormals(const FLOAT *accumulatedNormals, UINT verticesCount, FLOAT *outNormals, UINT outStrideInFloats);
+
+    /// Tangents are aligned with the direction of increasing u texture coordinate and orthogonalized
+    /// with respect to vertex normals.
+    /// \param positions vertex positions, 3 elements each
+    /// \param textureCoordinates texture coordinates, 2 elements each
+    /// \param normals normalized vertex normals, 3 elements each
+    /// \param outTangents normalized tangents are written here, 3 elements per vertex with given stride
+    static void computeTangents(VertexAttributeView positions, VertexAttributeView textureCoordinates, VertexAttributeView normals,
+                                UINT verticesCount, const std::vector<UINT> &indices, Weighting weighting,
+                                FLOAT *outTangents, UINT outStrideInFloats, SimdLevel simdLevel = SimdLevel::BEST_AVAILABLE);
+
+private:
+    // Sums weighted face normals and tangents for each vertex, outputs can be null if not needed
+    static void accumulate(VertexAttributeView positions, const VertexAttributeView *textureCoordinates, UINT verticesCount,
+                           const std::vector<UINT> &indices, Weighting weighting, SimdLevel simdLevel,
+                           FLOAT *outAccumulatedNormals, FLOAT *outAccumulatedTangents);
+};
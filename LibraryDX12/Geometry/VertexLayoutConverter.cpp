@@ -0,0 +1,85 @@
+#include "VertexLayoutConverter.h"
+
+#include <cstring>
+
+namespace {
+bool isAttributeValid(INT offset, UINT componentsCount, UINT strideInBytes) {
+    if (offset == DXD::VertexLayout::absent) {
+        return true;
+    }
+    const auto unsignedOffset = static_cast<UINT>(offset);
+    return offset >= 0 && unsignedOffset % sizeof(FLOAT) == 0 && unsignedOffset + componentsCount * sizeof(FLOAT) <= strideInBytes;
+}
+
+void copyAttribute(const BYTE *sourceVertex, INT sourceOffset, FLOAT *targetVertex, INT targetOffset, UINT componentsCount) {
+    if (targetOffset != DXD::VertexLayout::absent) {
+        std::memcpy(reinterpret_cast<BYTE *>(targetVertex) + targetOffset, sourceVertex + sourceOffset, componentsCount * sizeof(FLOAT));
+    }
+}
+} // namespace
+
+DXD::VertexLayout VertexLayoutConverter::getPackedLayout(bool tangents, bool textureCoordinates) {
+    DXD::VertexLayout layout{};
+    layout.positionOffset = 0;
+    layout.normalOffset = 3 * sizeof(FLOAT);
+    layout.strideInBytes = 6 * sizeof(FLOAT);
+    if (tangents) {
+        layout.tangentOffset = layout.strideInBytes;
+        layout.strideInBytes += 3 * sizeof(FLOAT);
+    }
+    if (textureCoordinates) {
+        layout.textureCoordinatesOffset = layout.strideInBytes;
+        layout.strideInBytes += 2 * sizeof(FLOAT);
+    }
+    return layout;
+}
+
+bool VertexLayoutConverter::validateLayout(const DXD::VertexLayout &layout) {
+    if (layout.strideInBytes % sizeof(FLOAT) != 0 || layout.positionOffset == DXD::VertexLayout::absent || !layout.hasNormals()) {
+        return false;
+    }
+    if (layout.hasTangents() && !layout.hasTextureCoordinates()) {
+        return false;
+    }
+    return isAttributeValid(layout.positionOffset, 3, layout.strideInBytes) &&
+           isAttributeValid(layout.normalOffset, 3, layout.strideInBytes) &&
+           isAttributeValid(layout.tangentOffset, 3, layout.strideInBytes) &&
+           isAttributeValid(layout.textureCoordinatesOffset, 2, layout.strideInBytes);
+}
+
+bool VertexLayoutConverter::validateIndices(const UINT *indices, UINT indicesCount, UINT verticesCount) {
+    if (indicesCount == 0u || indicesCount % 3 != 0) {
+        return false;
+    }
+    for (auto i = 0u; i < indicesCount; i++) {
+        if (indices[i] >= verticesCount) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool VertexLayoutConverter::isSameLayout(const DXD::VertexLayout &layout, const DXD::VertexLayout &otherLayout) {
+    return layout.strideInBytes == otherLayout.strideInBytes &&
+           layout.positionOffset == otherLayout.positionOffset &&
+           layout.normalOffset == otherLayout.normalOffset &&
+           layout.tangentOffset == otherLayout.tangentOffset &&
+           layout.textureCoordinatesOffset == otherLayout.textureCoordinatesOffset;
+}
+
+void VertexLayoutConverter::convert(const void *vertexData, UINT verticesCount, const DXD::VertexLayout &layout,
+                                    const DXD::VertexLayout &targetLayout, std::vector<FLOAT> &outVertexElements) {
+    const UINT targetVertexSizeInFloats = targetLayout.strideInBytes / sizeof(FLOAT);
+    outVertexElements.resize(static_cast<size_t>(verticesCount) * targetVertexSizeInFloats);
+
+    const BYTE *sourceVertex = static_cast<const BYTE *>(vertexData);
+    FLOAT *targetVertex = outVertexElements.data();
+    for (auto vertexIndex = 0u; vertexIndex < verticesCount; vertexIndex++) {
+        copyAttribute(sourceVertex, layout.positionOffset, targetVertex, targetLayout.positionOffset, 3);
+        copyAttribute(sourceVertex, layout.normalOffset, targetVertex, targetLayout.normalOffset, 3);
+        copyAttribute(sourceVertex, layout.tangentOffset, targetVertex, targetLayout.tangentOffset, 3);
+        copyAttribute(sourceVertex, layout.textureCoordinatesOffset, targetVertex, targetLayout.textureCoordinatesOffset, 2);
+        sourceVertex += layout.strideInBytes;
+        targetVertex += targetVertexSizeInFloats;
+    }
+}
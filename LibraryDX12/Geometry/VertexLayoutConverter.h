@@ -0,0 +1,37 @@
+#pragma once
+
+#include "DXD/Utility/NonCopyableAndMovable.h"
+
+#include <DXD/ExternalHeadersWrappers/windows.h>
+#include <DXD/VertexLayout.h>
+#include <vector>
+
+/// \brief Validation and repacking of vertices described by DXD::VertexLayout
+///
+/// The engine stores float vertices as position, normal, optional tangent and optional texture coordinates,
+/// tightly packed in this order. Vertices in any other layout are converted to it before the upload.
+class VertexLayoutConverter : DXD::NonInstantiatable {
+public:
+    /// \return layout of engine vertices with given optional attributes
+    static DXD::VertexLayout getPackedLayout(bool tangents, bool textureCoordinates);
+
+    /// Checks if the layout can be read and converted to a packed layout. Positions and normals are mandatory,
+    /// tangents are used only for normal mapping, which requires texture coordinates as well.
+    /// \return false if the layout is invalid, i.e. attributes exceed the stride, are misaligned or missing
+    static bool validateLayout(const DXD::VertexLayout &layout);
+
+    /// \param indices triangle list indices, may be nullptr if indicesCount is 0
+    /// \return false if there are no complete triangles or some index references a missing vertex
+    static bool validateIndices(const UINT *indices, UINT indicesCount, UINT verticesCount);
+
+    /// \return true if both layouts describe the same memory, so no conversion is needed
+    static bool isSameLayout(const DXD::VertexLayout &layout, const DXD::VertexLayout &otherLayout);
+
+    /// Copies attributes of every vertex to the packed layout. Attributes absent in the target layout are skipped,
+    /// all attributes present in it have to be present in the source layout as well.
+    /// \param vertexData vertices described by layout, it has to be valid (see validateLayout)
+    /// \param targetLayout packed layout, see getPackedLayout
+    /// \param outVertexElements converted vertices, previous contents are discarded
+    static void convert(const void *vertexData, UINT verticesCount, const DXD::VertexLayout &layout,
+                        const DXD::VertexLayout &targetLayout, std::vector<FLOAT> &outVertexElements);
+};
@@ -0,0 +1,187 @@
+#include "VertexQuantizer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+namespace {
+void computeInverseExtents(const FLOAT boundsMin[3], const FLOAT boundsMax[3], FLOAT outInverseExtents[3]) {
+    // Degenerate extents (flat meshes) quantize to 0, dequantization multiplies by 0 anyway
+    for (auto component = 0u; component < 3u; component++) {
+        const FLOAT extent = boundsMax[component] - boundsMin[component];
+        outInverseExtents[component] = extent > 0.f ? 1.f / extent : 0.f;
+    }
+}
+} // namespace
+
+void VertexQuantizer::quantizeVertices(const std::vector<FLOAT> &vertexElements, QuantizedVertexLayout layout,
+                                       const FLOAT boundsMin[3], const FLOAT boundsMax[3], std::vector<UINT16> &outQuantizedElements) {
+    const UINT floatVertexSize = layout.getFloatVertexSizeInFloats();
+    const UINT quantizedVertexSize = layout.getQuantizedVertexSizeInElements();
+    assert(vertexElements.size() % floatVertexSize == 0);
+    const size_t verticesCount = vertexElements.size() / floatVertexSize;
+    FLOAT inverseExtents[3] = {};
+    computeInverseExtents(boundsMin, boundsMax, inverseExtents);
+
+    outQuantizedElements.resize(verticesCount * quantizedVertexSize);
+    for (size_t vertexIndex = 0u; vertexIndex < verticesCount; vertexIndex++) {
+        const FLOAT *source = vertexElements.data() + vertexIndex * floatVertexSize;
+        UINT16 *destination = outQuantizedElements.data() + vertexIndex * quantizedVertexSize;
+
+        for (auto component = 0u; component < 3u; component++) {
+            destination[component] = encodeUnorm16((source[component] - boundsMin[component]) * inverseExtents[component]);
+        }
+        destination[3] = 0u;
+        source += 3;
+        destination += 4;
+
+        INT16 encoded[2] = {};
+        encodeOctahedral(source, encoded);
+        std::memcpy(destination, encoded, sizeof(encoded));
+        source += 3;
+        destination += 2;
+
+        if (layout.hasTangents) {
+            encodeOctahedral(source, encoded);
+            std::memcpy(destination, encoded, sizeof(encoded));
+            source += 3;
+            destination += 2;
+        }
+
+        if (layout.hasTextureCoordinates) {
+            destination[0] = encodeHalf(source[0]);
+            destination[1] = encodeHalf(source[1]);
+        }
+    }
+}
+
+void VertexQuantizer::extractPositions(const void *vertexData, UINT verticesCount, UINT vertexSizeInBytes, std::vector<FLOAT> &outPositions) {
+    outPositions.resize(static_cast<size_t>(verticesCount) * 3);
+    for (size_t vertexIndex = 0u; vertexIndex < verticesCount; vertexIndex++) {
+        const BYTE *source = static_cast<const BYTE *>(vertexData) + vertexIndex * vertexSizeInBytes;
+        std::memcpy(outPositions.data() + vertexIndex * 3, source, 3 * sizeof(FLOAT));
+    }
+}
+
+void VertexQuantizer::extractQuantizedPositions(const void *vertexData, UINT verticesCount, UINT vertexSizeInBytes, bool quantized,
+                                                const FLOAT boundsMin[3], const FLOAT boundsMax[3], std::vector<UINT16> &outPositions) {
+    FLOAT inverseExtents[3] = {};
+    computeInverseExtents(boundsMin, boundsMax, inverseExtents);
+
+    outPositions.resize(static_cast<size_t>(verticesCount) * 4);
+    for (size_t vertexIndex = 0u; vertexIndex < verticesCount; vertexIndex++) {
+        const BYTE *source = static_cast<const BYTE *>(vertexData) + vertexIndex * vertexSizeInBytes;
+        UINT16 *destination = outPositions.data() + vertexIndex * 4;
+        if (quantized) {
+            std::memcpy(destination, source, 4 * sizeof(UINT16));
+            continue;
+        }
+
+        FLOAT position[3] = {};
+        std::memcpy(position, source, sizeof(position));
+        for (auto component = 0u; component < 3u; component++) {
+            destination[component] = encodeUnorm16((position[component] - boundsMin[component]) * inverseExtents[component]);
+        }
+        destination[3] = 0u;
+    }
+}
+
+UINT16 VertexQuantizer::encodeUnorm16(FLOAT value) {
+    value = std::min(std::max(value, 0.f), 1.f);
+    return static_cast<UINT16>(value * 65535.f + 0.5f);
+}
+
+FLOAT VertexQuantizer::decodeUnorm16(UINT16 value) {
+    return value / 65535.f;
+}
+
+INT16 VertexQuantizer::encodeSnorm16(FLOAT value) {
+    value = std::min(std::max(value, -1.f), 1.f);
+    return static_cast<INT16>(std::round(value * 32767.f));
+}
+
+FLOAT VertexQuantizer::decodeSnorm16(INT16 value) {
+    // Both -32768 and -32767 map to -1, as defined by D3D conversion rules
+    return std::max(value / 32767.f, -1.f);
+}
+
+void VertexQuantizer::encodeOctahedral(const FLOAT vector[3], INT16 outEncoded[2]) {
+    const FLOAT manhattanLength = std::abs(vector[0]) + std::abs(vector[1]) + std::abs(vector[2]);
+    if (manhattanLength == 0.f) {
+        outEncoded[0] = outEncoded[1] = 0;
+        return;
+    }
+
+    FLOAT x = vector[0] / manhattanLength;
+    FLOAT y = vector[1] / manhattanLength;
+    if (vector[2] < 0.f) {
+        // Lower hemisphere is folded over the diagonals
+        const FLOAT foldedX = (1.f - std::abs(y)) * (x >= 0.f ? 1.f : -1.f);
+        const FLOAT foldedY = (1.f - std::abs(x)) * (y >= 0.f ? 1.f : -1.f);
+        x = foldedX;
+        y = foldedY;
+    }
+    outEncoded[0] = encodeSnorm16(x);
+    outEncoded[1] = encodeSnorm16(y);
+}
+
+void VertexQuantizer::decodeOctahedral(const INT16 encoded[2], FLOAT outVector[3]) {
+    // Same as decodeOctahedral in shaders
+    FLOAT x = decodeSnorm16(encoded[0]);
+    FLOAT y = decodeSnorm16(encoded[1]);
+    const FLOAT z = 1.f - std::abs(x) - std::abs(y);
+    const FLOAT fold = std::max(-z, 0.f);
+    x += x >= 0.f ? -fold : fold;
+    y += y >= 0.f ? -fold : fold;
+
+    const FLOAT length = std::sqrt(x * x + y * y + z * z);
+    outVector[0] = x / length;
+    outVector[1] = y / length;
+    outVector[2] = z / length;
+}
+
+UINT16 VertexQuantizer::encodeHalf(FLOAT value) {
+    UINT32 bits{};
+    std::memcpy(&bits, &value, sizeof(bits));
+    const UINT32 sign = (bits >> 16) & 0x8000u;
+    bits &= 0x7FFFFFFFu;
+
+    UINT32 result{};
+    if (bits >= 0x47800000u) {
+        // Too big for half or already infinity/NaN
+        result = bits > 0x7F800000u ? 0x7E00u : 0x7C00u;
+    } else if (bits < 0x38800000u) {
+        // Subnormal half or zero - adding a magic number aligns mantissa bits and rounds them in the FPU
+        constexpr UINT32 magicBits = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+        FLOAT magic{}, absoluteValue{};
+        std::memcpy(&magic, &magicBits, sizeof(magic));
+        std::memcpy(&absoluteValue, &bits, sizeof(absoluteValue));
+        absoluteValue += magic;
+        std::memcpy(&result, &absoluteValue, sizeof(result));
+        result -= magicBits;
+    } else {
+        // Normal half - rebias exponent and round mantissa to nearest even
+        const UINT32 mantissaOdd = (bits >> 13) & 1u;
+        bits += (static_cast<UINT32>(15 - 127) << 23) + 0xFFFu + mantissaOdd;
+        result = bits >> 13;
+    }
+    return static_cast<UINT16>(result | sign);
+}
+
+FLOAT VertexQuantizer::decodeHalf(UINT16 value) {
+    const UINT32 sign = static_cast<UINT32>(value & 0x8000u) << 16;
+    const UINT32 exponent = (value >> 10) & 0x1Fu;
+    const UINT32 mantissa = value & 0x3FFu;
+
+    if (exponent == 0u) {
+        const FLOAT result = std::ldexp(static_cast<FLOAT>(mantissa), -24);
+        return sign ? -result : result;
+    }
+
+    UINT32 bits = sign | (mantissa << 13);
+    bits |= exponent == 0x1Fu ? 0x7F800000u : (exponent + 127u - 15u) << 23;
+    FLOAT result{};
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
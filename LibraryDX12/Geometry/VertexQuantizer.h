@@ -0,0 +1,70 @@
+#pragma once
+
+#include "DXD/Utility/NonCopyableAndMovable.h"
+
+#include <DXD/ExternalHeadersWrappers/windows.h>
+#include <vector>
+
+/// \brief Description of attributes present in an interleaved vertex
+///
+/// Float vertices consist of position (3 floats), normal (3 floats), optional tangent (3 floats)
+/// and optional texture coordinates (2 floats). Quantized vertices store the same attributes in
+/// the same order, but every element is 16-bit:
+///  - position - 4 unorm16 values relative to mesh bounds, the last one is padding (R16G16B16A16_UNORM)
+///  - normal and tangent - octahedral encoding in 2 snorm16 values (R16G16_SNORM)
+///  - texture coordinates - 2 half floats (R16G16_FLOAT)
+struct QuantizedVertexLayout {
+    bool hasTangents;
+    bool hasTextureCoordinates;
+
+    UINT getFloatVertexSizeInFloats() const { return 6u + (hasTangents ? 3u : 0u) + (hasTextureCoordinates ? 2u : 0u); }
+    UINT getQuantizedVertexSizeInElements() const { return 6u + (hasTangents ? 2u : 0u) + (hasTextureCoordinates ? 2u : 0u); }
+};
+
+/// \brief Conversion of vertex attributes to compact formats and back
+///
+/// Quantized vertices take less than half of the memory of float vertices, which saves bandwidth
+/// in every pass using them. Decoding functions mirror what the input assembler and vertex shaders
+/// do with the data and are mainly useful for validation.
+class VertexQuantizer : DXD::NonInstantiatable {
+public:
+    /// Converts float vertices to quantized vertices
+    /// \param vertexElements interleaved float vertices described by the layout
+    /// \param boundsMin minimum position of all vertices, dequantized position is boundsMin + value * (boundsMax - boundsMin)
+    /// \param boundsMax maximum position of all vertices
+    /// \param outQuantizedElements quantized vertices, previous contents are discarded
+    static void quantizeVertices(const std::vector<FLOAT> &vertexElements, QuantizedVertexLayout layout,
+                                 const FLOAT boundsMin[3], const FLOAT boundsMax[3], std::vector<UINT16> &outQuantizedElements);
+
+    /// Extracts tightly packed positions of float vertices for passes, which do not need other attributes, e.g. shadow maps.
+    /// Positions keep their full precision, so depth of these passes matches the depth of the full vertices.
+    /// \param vertexData interleaved float vertices, positions have to be their first element
+    /// \param outPositions 3 floats per vertex, previous contents are discarded
+    static void extractPositions(const void *vertexData, UINT verticesCount, UINT vertexSizeInBytes, std::vector<FLOAT> &outPositions);
+
+    /// Extracts tightly packed positions for passes, which do not need other attributes, e.g. shadow maps.
+    /// Positions are in the same format as in quantized vertices.
+    /// \param vertexData interleaved float or quantized vertices, positions have to be their first element
+    /// \param quantized true if vertexData is already quantized, its positions are copied without any changes
+    /// \param boundsMin minimum position of all vertices, the same as used for quantizeVertices
+    /// \param boundsMax maximum position of all vertices
+    /// \param outPositions 4 unorm16 values per vertex, previous contents are discarded
+    static void extractQuantizedPositions(const void *vertexData, UINT verticesCount, UINT vertexSizeInBytes, bool quantized,
+                                          const FLOAT boundsMin[3], const FLOAT boundsMax[3], std::vector<UINT16> &outPositions);
+
+    // Values in [0, 1] range
+    static UINT16 encodeUnorm16(FLOAT value);
+    static FLOAT decodeUnorm16(UINT16 value);
+
+    // Values in [-1, 1] range
+    static INT16 encodeSnorm16(FLOAT value);
+    static FLOAT decodeSnorm16(INT16 value);
+
+    /// Projects unit vector onto an octahedron and unfolds it to a square, so it can be stored in 2 values
+    static void encodeOctahedral(const FLOAT vector[3], INT16 outEncoded[2]);
+    static void decodeOctahedral(const INT16 encoded[2], FLOAT outVector[3]);
+
+    /// IEEE 754 half precision, rounded to nearest even
+    static UINT16 encodeHalf(FLOAT value);
+    static FLOAT decodeHalf(UINT16 value);
+};
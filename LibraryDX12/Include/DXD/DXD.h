@@ -5,6 +5,7 @@
 #include <DXD/Camera.h>
 #include <DXD/Event.h>
 #include <DXD/Light.h>
+#include <DXD/LoadPriority.h>
 #include <DXD/Logger.h>
 #include <DXD/Mesh.h>
 #include <DXD/Object.h>
@@ -14,4 +15,5 @@
 #include <DXD/Sprite.h>
 #include <DXD/Text.h>
 #include <DXD/Texture.h>
+#include <DXD/VertexLayout.h>
 #include <DXD/Window.h>
@@ -39,6 +39,12 @@ public:
     /// \return operation-specific data
     virtual const Data &wait() const = 0;
 
+    /// Blocks the calling thread until the asynchronous operation completes or the timeout passes.
+    /// Returns immediately if it's already completed.
+    /// \param timeoutMilliseconds maximum time to wait in milliseconds
+    /// \return true if associated operation has ended and getData can be called
+    virtual bool waitFor(unsigned int timeoutMilliseconds) const = 0;
+
     /// Factory function used to create instances of Event
     /// \return created instance
     static std::unique_ptr<Event> create();
@@ -0,0 +1,17 @@
+#pragma once
+
+namespace DXD {
+
+/// \brief Order in which asynchronous loads are processed by the background threads of the engine
+///
+/// Loads of higher priority are always started before loads of lower priority, no matter when they
+/// were requested. Loads which have already started are not interrupted. Applications streaming their
+/// assets should use CRITICAL for assets needed in the current frame, e.g. visible objects close to the
+/// camera, and BACKGROUND for prefetching assets which may be needed later.
+enum class LoadPriority {
+    CRITICAL,
+    NORMAL,
+    BACKGROUND,
+};
+
+} // namespace DXD
@@ -4,8 +4,12 @@
 #include "DXD/Utility/NonCopyableAndMovable.h"
 
 #include <DXD/Event.h>
+#include <DXD/ExternalHeadersWrappers/DirectXMath.h>
+#include <DXD/LoadPriority.h>
+#include <DXD/VertexLayout.h>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace DXD {
 
@@ -17,6 +21,33 @@ class Application;
 /// DXD::Object instances. Class is able to store various vertex attributes inside the
 /// vertices such as normals, tangents or texture coordinates. The engine internally
 /// ignores objects with meshes that have not been loaded properly or are still loading.
+///
+/// Geometry processed during the first load of an obj file is cached in a binary .dxdmesh file
+/// next to it, so subsequent loads do not have to parse the text again. The cache is regenerated
+/// automatically after the obj file is modified.
+///
+/// Faces of an obj file are grouped by their usemtl statements into submeshes, which share vertex
+/// and index buffers and are drawn one after another. Diffuse (Kd) and specular (Ks) colors of
+/// materials from the mtllib file override color and specularity of the DXD::Object for their
+/// submeshes. Faces without a material or with one missing in the library use properties of the object.
+///
+/// Meshes loaded from the same file with the same flags share geometry, so it is parsed and uploaded
+/// to the GPU only once. Requests made while the first load is still in progress wait for its result.
+///
+/// Binary glTF files (.glb) are read directly from a memory mapped file. If vertex attributes of the
+/// first mesh in the file are already interleaved in the layout used by the engine, they are uploaded
+/// to the GPU as they are, without any intermediate copies.
+///
+/// Geometry generated by the application can be passed directly from memory. It is never shared
+/// with other meshes and it is drawn without levels of detail.
+///
+/// Asynchronous loads are processed in the order of their priorities. If a load is requested again with
+/// higher priority while the first request is still waiting in the queue, it's promoted. Synchronous request
+/// for a queued load executes it right away in the calling thread. Destroying the last
+/// mesh sharing a queued load cancels it, its events are signalled with TERMINATED result.
+///
+/// Bounding volumes of the geometry are computed during the load. Before the mesh is loaded
+/// they are empty and located at the origin.
 class EXPORT Mesh : NonCopyableAndMovable {
 public:
     enum class ObjLoadResult {
@@ -27,6 +58,21 @@ public:
     };
     using ObjLoadEvent = Event<ObjLoadResult>;
 
+    enum class GltfLoadResult {
+        SUCCESS,
+        TERMINATED,
+        WRONG_FILENAME,
+        WRONG_GLTF,
+    };
+    using GltfLoadEvent = Event<GltfLoadResult>;
+
+    enum class MemoryLoadResult {
+        SUCCESS,
+        TERMINATED,
+        WRONG_DATA,
+    };
+    using MemoryLoadEvent = Event<MemoryLoadResult>;
+
     /// Factory function for loading geometry from wavefront obj file synchronously, in the calling
     /// thread. Internally handles getting the geometry to the GPU memory and all operations
     /// associated with setting it up.
@@ -37,9 +83,19 @@ public:
     /// enable normal mapping
     /// \param loadResult optional parameter for checking operation status. Application should use it
     /// to verify if the loading succeeded.
+    /// \param optimizeVertexOrder when set to true, reorders triangles and vertices for better vertex
+    /// cache utilization and less overdraw. Slows down the first load, but speeds up rendering.
+    /// \param smoothNormalsAndTangents when set to true, computed normals and tangents are averaged
+    /// between adjacent triangles. Otherwise each triangle is shaded flat.
+    /// \param quantizeVertices when set to true, vertex attributes are stored in 16-bit formats, which
+    /// takes less than half of the memory at the cost of precision.
+    /// \param generateLods when set to true, simplified versions of the geometry are generated and
+    /// drawn instead of the original one when the object is far from the camera.
     /// \return created mesh
     static std::unique_ptr<Mesh> createFromObjSynchronously(const std::wstring &filePath, bool loadTextureCoordinates,
-                                                            bool computeTangents, ObjLoadResult *loadResult);
+                                                            bool computeTangents, ObjLoadResult *loadResult,
+                                                            bool optimizeVertexOrder = true, bool smoothNormalsAndTangents = true, bool quantizeVertices = false,
+                                                            bool generateLods = true);
 
     /// Factory function for loading geometry from wavefront obj file asynchronously, in a background
     /// thread managed by the engine. Internally handles getting the geometry to the GPU memory and
@@ -51,11 +107,116 @@ public:
     /// enable normal mapping
     /// \param loadEvent optional parameter for checking operation status. Application should use it
     /// to verify if the loading succeeded.
+    /// \param optimizeVertexOrder when set to true, reorders triangles and vertices for better vertex
+    /// cache utilization and less overdraw. Slows down the first load, but speeds up rendering.
+    /// \param smoothNormalsAndTangents when set to true, computed normals and tangents are averaged
+    /// between adjacent triangles. Otherwise each triangle is shaded flat.
+    /// \param quantizeVertices when set to true, vertex attributes are stored in 16-bit formats, which
+    /// takes less than half of the memory at the cost of precision.
+    /// \param generateLods when set to true, simplified versions of the geometry are generated and
+    /// drawn instead of the original one when the object is far from the camera.
+    /// \param priority order of processing relative to other asynchronous loads
     /// \return created mesh
     static std::unique_ptr<Mesh> createFromObjAsynchronously(const std::wstring &filePath, bool loadTextureCoordinates,
-                                                             bool computeTangents, ObjLoadEvent *loadEvent);
+                                                             bool computeTangents, ObjLoadEvent *loadEvent,
+                                                             bool optimizeVertexOrder = true, bool smoothNormalsAndTangents = true, bool quantizeVertices = false,
+                                                             bool generateLods = true, LoadPriority priority = LoadPriority::NORMAL);
+
+    /// Factory function for loading geometry from binary glTF file synchronously, in the calling
+    /// thread. All triangle primitives of the first mesh in the file are merged into one geometry.
+    /// Buffers stored outside of the file and sparse accessors are not supported.
+    /// \param filePath relative or absolute path of the glb file
+    /// \param loadTextureCoordinates when set to true, adds UVs to the model. Fails if the uvs are
+    /// not available
+    /// \param computeTangents when set to true, adds tangent vectors to vertices to enable normal
+    /// mapping. Tangents stored in the file are used if available, otherwise they are computed
+    /// from UVs. Fails if neither is available or if loadTextureCoordinates is false, since normal
+    /// mapping requires UVs
+    /// \param loadResult optional parameter for checking operation status. Application should use it
+    /// to verify if the loading succeeded.
+    /// \return created mesh
+    static std::unique_ptr<Mesh> createFromGltfSynchronously(const std::wstring &filePath, bool loadTextureCoordinates,
+                                                             bool computeTangents, GltfLoadResult *loadResult);
+
+    /// Factory function for loading geometry from binary glTF file asynchronously, in a background
+    /// thread managed by the engine. All triangle primitives of the first mesh in the file are merged
+    /// into one geometry. Buffers stored outside of the file and sparse accessors are not supported.
+    /// \param filePath relative or absolute path of the glb file
+    /// \param loadTextureCoordinates when set to true, adds UVs to the model. Fails if the uvs are
+    /// not available
+    /// \param computeTangents when set to true, adds tangent vectors to vertices to enable normal
+    /// mapping. Tangents stored in the file are used if available, otherwise they are computed
+    /// from UVs. Fails if neither is available or if loadTextureCoordinates is false, since normal
+    /// mapping requires UVs
+    /// \param loadEvent optional parameter for checking operation status. Application should use it
+    /// to verify if the loading succeeded.
+    /// \param priority order of processing relative to other asynchronous loads
+    /// \return created mesh
+    static std::unique_ptr<Mesh> createFromGltfAsynchronously(const std::wstring &filePath, bool loadTextureCoordinates,
+                                                              bool computeTangents, GltfLoadEvent *loadEvent,
+                                                              LoadPriority priority = LoadPriority::NORMAL);
+
+    /// Factory function for creating mesh from vertices and indices in memory synchronously, in the
+    /// calling thread. Data is not parsed in any way, it is only repacked if it is not in the layout
+    /// used by the engine and uploaded to the GPU.
+    /// \param vertices interleaved vertices, only read during the call
+    /// \param verticesCount number of vertices
+    /// \param vertexLayout attributes of the vertices. Positions and normals are mandatory, tangents
+    /// require texture coordinates
+    /// \param indices triangle list indices, only read during the call
+    /// \param indicesCount number of indices, has to be a multiple of 3
+    /// \param loadResult optional parameter for checking operation status. Application should use it
+    /// to verify if the loading succeeded.
+    /// \return created mesh
+    static std::unique_ptr<Mesh> createFromMemorySynchronously(const void *vertices, UINT verticesCount, const VertexLayout &vertexLayout,
+                                                               const UINT *indices, UINT indicesCount, MemoryLoadResult *loadResult);
+
+    /// Factory function for creating mesh from vertices and indices in memory asynchronously, in a
+    /// background thread managed by the engine. Data is not parsed in any way, it is only repacked if
+    /// it is not in the layout used by the engine and uploaded to the GPU.
+    /// \param vertices interleaved vertices owned by the application, which have to stay valid until
+    /// the load ends, i.e. until loadEvent is signalled
+    /// \param verticesCount number of vertices
+    /// \param vertexLayout attributes of the vertices. Positions and normals are mandatory, tangents
+    /// require texture coordinates
+    /// \param indices triangle list indices owned by the application, the same lifetime rules apply
+    /// \param indicesCount number of indices, has to be a multiple of 3
+    /// \param loadEvent optional parameter for checking operation status. Application should use it
+    /// to verify if the loading succeeded.
+    /// \param priority order of processing relative to other asynchronous loads
+    /// \return created mesh
+    static std::unique_ptr<Mesh> createFromMemoryAsynchronously(const void *vertices, UINT verticesCount, const VertexLayout &vertexLayout,
+                                                                const UINT *indices, UINT indicesCount, MemoryLoadEvent *loadEvent,
+                                                                LoadPriority priority = LoadPriority::NORMAL);
+
+    /// Factory function for creating mesh from vertices and indices in memory asynchronously, in a
+    /// background thread managed by the engine. Ownership of the data is passed to the engine, which
+    /// releases it once the load ends.
+    /// \param vertices interleaved vertices, their count is computed from the stride of vertexLayout
+    /// \param vertexLayout attributes of the vertices. Positions and normals are mandatory, tangents
+    /// require texture coordinates
+    /// \param indices triangle list indices, their count has to be a multiple of 3
+    /// \param loadEvent optional parameter for checking operation status. Application should use it
+    /// to verify if the loading succeeded.
+    /// \param priority order of processing relative to other asynchronous loads
+    /// \return created mesh
+    static std::unique_ptr<Mesh> createFromMemoryAsynchronously(std::vector<FLOAT> &&vertices, const VertexLayout &vertexLayout,
+                                                                std::vector<UINT> &&indices, MemoryLoadEvent *loadEvent,
+                                                                LoadPriority priority = LoadPriority::NORMAL);
     virtual ~Mesh() = default;
 
+    /// @{
+    /// Axis aligned bounding box of vertex positions in object space, empty until the mesh is loaded
+    virtual XMFLOAT3 getBoundingBoxMin() const = 0;
+    virtual XMFLOAT3 getBoundingBoxMax() const = 0;
+    /// @}
+
+    /// @{
+    /// Sphere containing all vertex positions in object space, empty until the mesh is loaded
+    virtual XMFLOAT3 getBoundingSphereCenter() const = 0;
+    virtual FLOAT getBoundingSphereRadius() const = 0;
+    /// @}
+
 protected:
     Mesh() = default;
 };
@@ -75,6 +75,15 @@ public:
     virtual XMFLOAT2 getTextureScale() const = 0;
     /// @}
 
+    /// @{
+    /// Bounds of the mesh transformed to world space with current position, rotation and scale of the object.
+    /// They're computed lazily and cached until the transformation changes.
+    virtual XMFLOAT3 getWorldBoundingBoxMin() = 0;
+    virtual XMFLOAT3 getWorldBoundingBoxMax() = 0;
+    virtual XMFLOAT3 getWorldBoundingSphereCenter() = 0;
+    virtual FLOAT getWorldBoundingSphereRadius() = 0;
+    /// @}
+
     /// Factory method used to create Object instances
     /// \param geometry associated with the object
     /// \return Object instance
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "DXD/Event.h"
+#include "DXD/LoadPriority.h"
 #include "DXD/Utility/Export.h"
 #include "DXD/Utility/NonCopyableAndMovable.h"
 
@@ -12,6 +13,17 @@ namespace DXD {
 class Application;
 
 /// \brief 2D Texture stored on GPU
+///
+/// Textures loaded from the same file with the same type share GPU memory, so they are decoded and
+/// uploaded only once. Requests made while the first load is still in progress wait for its result.
+///
+/// If the AssetCooker tool has produced an up to date .dxdtex file next to the source, it is used instead.
+/// It contains block compressed mips, so the texture is uploaded without decoding and mip generation.
+///
+/// Asynchronous loads are processed in the order of their priorities. If a load is requested again with
+/// higher priority while the first request is still waiting in the queue, it's promoted. Synchronous request
+/// for a queued load executes it right away in the calling thread. Destroying the last
+/// texture sharing a queued load cancels it, its events are signalled with TERMINATED result.
 class EXPORT Texture : NonCopyableAndMovable {
 public:
     /// Expected usage of the texture. This gives engine knowledge about how it should treat the texture, e.g.
@@ -23,6 +35,7 @@ public:
 
     enum class TextureLoadResult {
         SUCCESS,
+        TERMINATED,
         WRONG_FILENAME,
         WRONG_TEXTURE,
     };
@@ -45,8 +58,10 @@ public:
     /// \param type expected usage of texture
     /// \param loadResult optional parameter for checking operation status. Application should use it
     /// to verify if the loading succeeded.
+    /// \param priority order of processing relative to other asynchronous loads
     /// \return created textue
-    static std::unique_ptr<Texture> loadFromFileAsynchronously(const std::wstring &filePath, TextureType type, TextureLoadEvent *loadEvent);
+    static std::unique_ptr<Texture> loadFromFileAsynchronously(const std::wstring &filePath, TextureType type, TextureLoadEvent *loadEvent,
+                                                               LoadPriority priority = LoadPriority::NORMAL);
     virtual ~Texture() = default;
 
 protected:
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <DXD/ExternalHeadersWrappers/windows.h>
+
+namespace DXD {
+
+/// \brief Description of interleaved vertices passed to the engine from memory
+///
+/// Every attribute is a sequence of 32-bit floats: 3 for positions, normals and tangents and 2 for
+/// texture coordinates. Attributes are located at given byte offsets within each vertex and can be
+/// placed in any order. Offsets of attributes, which are not present, should be set to absent.
+/// Vertices already interleaved in the order listed above, without any gaps, are used by the engine
+/// as they are, others are repacked.
+struct VertexLayout {
+    constexpr static INT absent = -1;
+
+    UINT strideInBytes = 0u;
+    INT positionOffset = 0;
+    INT normalOffset = absent;
+    INT tangentOffset = absent;
+    INT textureCoordinatesOffset = absent;
+
+    bool hasNormals() const { return normalOffset != absent; }
+    bool hasTangents() const { return tangentOffset != absent; }
+    bool hasTextureCoordinates() const { return textureCoordinatesOffset != absent; }
+};
+
+} // namespace DXD
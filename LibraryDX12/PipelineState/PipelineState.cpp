@@ -22,8 +22,8 @@ D3D12_SHADER_BYTECODE PipelineState::loadAndCompileShader(const std::wstring &na
 
 // ------------------------------------------------------------- Graphics PSO
 
-GraphicsPipelineState &GraphicsPipelineState::VS(const std::wstring &path) {
-    description.VS = loadAndCompileShader(path, "vs_5_1", nullptr);
+GraphicsPipelineState &GraphicsPipelineState::VS(const std::wstring &path, const D3D_SHADER_MACRO *defines) {
+    description.VS = loadAndCompileShader(path, "vs_5_1", defines);
     return *this;
 }
 
@@ -32,7 +32,7 @@ public:
         description.SampleDesc.Count = 1;
     }
 
-    GraphicsPipelineState &VS(const std::wstring &path);
+    GraphicsPipelineState &VS(const std::wstring &path, const D3D_SHADER_MACRO *defines = nullptr);
     GraphicsPipelineState &PS(const std::wstring &path);
     GraphicsPipelineState &DS(const std::wstring &path);
     GraphicsPipelineState &HS(const std::wstring &path);
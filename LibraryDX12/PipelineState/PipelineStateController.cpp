@@ -59,6 +59,15 @@ void PipelineStateController::compile(Identifier identifier) {
     case Identifier::PIPELINE_STATE_TEXTURE_NORMAL_MAP:
         compilePipelineStateTextureNormalMap(rootSignature, pipelineState);
         break;
+    case Identifier::PIPELINE_STATE_NORMAL_QUANTIZED:
+        compilePipelineStateNormalQuantized(rootSignature, pipelineState);
+        break;
+    case Identifier::PIPELINE_STATE_TEXTURE_NORMAL_QUANTIZED:
+        compilePipelineStateTextureNormalQuantized(rootSignature, pipelineState);
+        break;
+    case Identifier::PIPELINE_STATE_TEXTURE_NORMAL_MAP_QUANTIZED:
+        compilePipelineStateTextureNormalMapQuantized(rootSignature, pipelineState);
+        break;
     case Identifier::PIPELINE_STATE_GENERATE_MIPS:
         compilePipelineStateGenerateMips(rootSignature, pipelineState);
         break;
@@ -89,14 +98,11 @@ void PipelineStateController::compile(Identifier identifier) {
     case Identifier::PIPELINE_STATE_POST_PROCESS_BLACK_BARS:
         compilePipelineStatePostProcessBlackBars(rootSignature, pipelineState);
         break;
-    case Identifier::PIPELINE_STATE_SM_NORMAL:
-        compilePipelineStateShadowMapNormal(rootSignature, pipelineState);
-        break;
-    case Identifier::PIPELINE_STATE_SM_TEXTURE_NORMAL:
-        compilePipelineStateShadowMapTextureNormal(rootSignature, pipelineState);
+    case Identifier::PIPELINE_STATE_SM_POSITION:
+        compilePipelineStateShadowMapPosition(rootSignature, pipelineState);
         break;
-    case Identifier::PIPELINE_STATE_SM_TEXTURE_NORMAL_MAP:
-        compilePipelineStateShadowMapTextureNormalMap(rootSignature, pipelineState);
+    case Identifier::PIPELINE_STATE_SM_POSITION_QUANTIZED:
+        compilePipelineStateShadowMapPositionQuantized(rootSignature, pipelineState);
         break;
     case Identifier::PIPELINE_STATE_POST_PROCESS_CONVOLUTION:
         compilePipelineStatePostProcessConvolution(rootSignature, pipelineState);
@@ -137,22 +143,23 @@ void PipelineStateController::reset(Identifier identifier) {
 
 // --------------------------------------------------------------------------------------------- Deferred shading
 
-void PipelineStateController::compilePipelineStateNormal(RootSignature &rootSignature, ID3D12PipelineStatePtr &pipelineState) {
+// Vertex formats of quantized meshes are described by QuantizedVertexLayout
+const D3D_SHADER_MACRO quantizedShaderDefines[] = {
+    {"QUANTIZED", ""},
+    {nullptr, nullptr}};
+
+template <UINT inputLayoutSize>
+inline void compilePipelineStateNormalWithInputLayout(ID3D12DevicePtr &device, RootSignature &rootSignature, ID3D12PipelineStatePtr &pipelineState,
+                                                      const D3D12_INPUT_ELEMENT_DESC (&inputLayout)[inputLayoutSize], const D3D_SHADER_MACRO *shaderDefines) {
     // Root signature - crossthread data
     rootSignature
         .append32bitConstant<ModelMvp>(b(0), D3D12_SHADER_VISIBILITY_VERTEX)
         .append32bitConstant<ObjectPropertiesCB>(b(2), D3D12_SHADER_VISIBILITY_PIXEL)
         .compile(device);
 
-    // Input layout - per vertex data
-    const D3D12_INPUT_ELEMENT_DESC inputLayout[] = {
-        {"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
-        {"NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
-    };
-
     // Pipeline state object
     GraphicsPipelineState{inputLayout, rootSignature}
-        .VS(L"3D/normal_VS.hlsl")
+        .VS(L"3D/normal_VS.hlsl", shaderDefines)
         .PS(L"3D/normal_PS.hlsl")
         .setRenderTargetsCount(3)
         .setRenderTargetFormat(1, DXGI_FORMAT_R16G16B16A16_SNORM)
@@ -160,7 +167,27 @@ void PipelineStateController::compilePipelineStateNormal(RootSignature &rootSign
         .compile(device, pipelineState);
 }
 
-void PipelineStateController::compilePipelineStateTextureNormal(RootSignature &rootSignature, ID3D12PipelineStatePtr &pipelineState) {
+void PipelineStateController::compilePipelineStateNormal(RootSignature &rootSignature, ID3D12PipelineStatePtr &pipelineState) {
+    // Input layout - per vertex data
+    const D3D12_INPUT_ELEMENT_DESC inputLayout[] = {
+        {"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+        {"NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+    };
+    compilePipelineStateNormalWithInputLayout(device, rootSignature, pipelineState, inputLayout, nullptr);
+}
+
+void PipelineStateController::compilePipelineStateNormalQuantized(RootSignature &rootSignature, ID3D12PipelineStatePtr &pipelineState) {
+    // Input layout - per vertex data
+    const D3D12_INPUT_ELEMENT_DESC inputLayout[] = {
+        {"POSITION", 0, DXGI_FORMAT_R16G16B16A16_UNORM, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+        {"NORMAL", 0, DXGI_FORMAT_R16G16_SNORM, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+    };
+    compilePipelineStateNormalWithInputLayout(device, rootSignature, pipelineState, inputLayout, quantizedShaderDefines);
+}
+
+template <UINT inputLayoutSize>
+inline void compilePipelineStateTextureNormalWithInputLayout(ID3D12DevicePtr &device, RootSignature &rootSignature, ID3D12PipelineStatePtr &pipelineState,
+                                                             const D3D12_INPUT_ELEMENT_DESC (&inputLayout)[inputLayoutSize], const D3D_SHADER_MACRO *shaderDefines) {
     // Root signature - crossthread data
     StaticSampler sampler{D3D12_SHADER_VISIBILITY_PIXEL};
     sampler.addressMode(D3D12_TEXTURE_ADDRESS_MODE_MIRROR);
@@ -174,16 +201,9 @@ void PipelineStateController::compilePipelineStateTextureNormal(RootSignature &r
         .appendStaticSampler(s(0), sampler)
         .compile(device);
 
-    // Input layout - per vertex data
-    const D3D12_INPUT_ELEMENT_DESC inputLayout[] = {
-        {"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
-        {"NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
-        {"TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
-    };
-
     // Pipeline state object
     GraphicsPipelineState{inputLayout, rootSignature}
-        .VS(L"3D/normal_texture_VS.hlsl")
+        .VS(L"3D/normal_texture_VS.hlsl", shaderDefines)
         .PS(L"3D/normal_texture_PS.hlsl")
         .setRenderTargetsCount(3)
         .setRenderTargetFormat(1, DXGI_FORMAT_R16G16B16A16_SNORM)
@@ -191,7 +211,29 @@ void PipelineStateController::compilePipelineStateTextureNormal(RootSignature &r
         .compile(device, pipelineState);
 }
 
-void PipelineStateController::compilePipelineStateTextureNormalMap(RootSignature &rootSignature, ID3D12PipelineStatePtr &pipelineState) {
+void PipelineStateController::compilePipelineStateTextureNormal(RootSignature &rootSignature, ID3D12PipelineStatePtr &pipelineState) {
+    // Input layout - per vertex data
+    const D3D12_INPUT_ELEMENT_DESC inputLayout[] = {
+        {"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+        {"NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+        {"TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+    };
+    compilePipelineStateTextureNormalWithInputLayout(device, rootSignature, pipelineState, inputLayout, nullptr);
+}
+
+void PipelineStateController::compilePipelineStateTextureNormalQuantized(RootSignature &rootSignature, ID3D12PipelineStatePtr &pipelineState) {
+    // Input layout - per vertex data
+    const D3D12_INPUT_ELEMENT_DESC inputLayout[] = {
+        {"POSITION", 0, DXGI_FORMAT_R16G16B16A16_UNORM, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+        {"NORMAL", 0, DXGI_FORMAT_R16G16_SNORM, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+        {"TEXCOORD", 0, DXGI_FORMAT_R16G16_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+    };
+    compilePipelineStateTextureNormalWithInputLayout(device, rootSignature, pipelineState, inputLayout, quantizedShaderDefines);
+}
+
+template <UINT inputLayoutSize>
+inline void compilePipelineStateTextureNormalMapWithInputLayout(ID3D12DevicePtr &device, RootSignature &rootSignature, ID3D12PipelineStatePtr &pipelineState,
+                                                                const D3D12_INPUT_ELEMENT_DESC (&inputLayout)[inputLayoutSize], const D3D_SHADER_MACRO *shaderDefines) {
     // Root signature - crossthread data
     StaticSampler sampler{D3D12_SHADER_VISIBILITY_PIXEL};
     sampler.addressMode(D3D12_TEXTURE_ADDRESS_MODE_MIRROR);
@@ -205,6 +247,17 @@ void PipelineStateController::compilePipelineStateTextureNormalMap(RootSignature
         .appendStaticSampler(s(0), sampler)
         .compile(device);
 
+    // Pipeline state object
+    GraphicsPipelineState{inputLayout, rootSignature}
+        .VS(L"3D/texture_normal_map_VS.hlsl", shaderDefines)
+        .PS(L"3D/texture_normal_map_PS.hlsl")
+        .setRenderTargetsCount(3)
+        .setRenderTargetFormat(1, DXGI_FORMAT_R16G16B16A16_SNORM)
+        .setRenderTargetFormat(2, DXGI_FORMAT_R8G8_UNORM)
+        .compile(device, pipelineState);
+}
+
+void PipelineStateController::compilePipelineStateTextureNormalMap(RootSignature &rootSignature, ID3D12PipelineStatePtr &pipelineState) {
     // Input layout - per vertex data
     const D3D12_INPUT_ELEMENT_DESC inputLayout[] = {
         {"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
@@ -212,15 +265,18 @@ void PipelineStateController::compilePipelineStateTextureNormalMap(RootSignature
         {"TANGENT", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
         {"TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
     };
+    compilePipelineStateTextureNormalMapWithInputLayout(device, rootSignature, pipelineState, inputLayout, nullptr);
+}
 
-    // Pipeline state object
-    GraphicsPipelineState{inputLayout, rootSignature}
-        .VS(L"3D/texture_normal_map_VS.hlsl")
-        .PS(L"3D/texture_normal_map_PS.hlsl")
-        .setRenderTargetsCount(3)
-        .setRenderTargetFormat(1, DXGI_FORMAT_R16G16B16A16_SNORM)
-        .setRenderTargetFormat(2, DXGI_FORMAT_R8G8_UNORM)
-        .compile(device, pipelineState);
+void PipelineStateController::compilePipelineStateTextureNormalMapQuantized(RootSignature &rootSignature, ID3D12PipelineStatePtr &pipelineState) {
+    // Input layout - per vertex data
+    const D3D12_INPUT_ELEMENT_DESC inputLayout[] = {
+        {"POSITION", 0, DXGI_FORMAT_R16G16B16A16_UNORM, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+        {"NORMAL", 0, DXGI_FORMAT_R16G16_SNORM, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+        {"TANGENT", 0, DXGI_FORMAT_R16G16_SNORM, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+        {"TEXCOORD", 0, DXGI_FORMAT_R16G16_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+    };
+    compilePipelineStateTextureNormalMapWithInputLayout(device, rootSignature, pipelineState, inputLayout, quantizedShaderDefines);
 }
 
 void PipelineStateController::compilePipelineStateLighting(RootSignature &rootSignature, ID3D12PipelineStatePtr &pipelineState) {
@@ -271,64 +327,35 @@ void PipelineStateController::compilePipelineStateLighting(RootSignature &rootSi
 
 // --------------------------------------------------------------------------------------------- Shadow maps
 
-void PipelineStateController::compilePipelineStateShadowMapNormal(RootSignature &rootSignature, ID3D12PipelineStatePtr &pipelineState) {
+template <UINT inputLayoutSize>
+inline void compilePipelineStateShadowMapWithInputLayout(ID3D12DevicePtr &device, RootSignature &rootSignature, ID3D12PipelineStatePtr &pipelineState,
+                                                         const D3D12_INPUT_ELEMENT_DESC (&inputLayout)[inputLayoutSize]) {
     // Root signature - crossthread data
     rootSignature
         .append32bitConstant<ShadowMapCB>(b(0), D3D12_SHADER_VISIBILITY_VERTEX) // register(b0)
         .compile(device);
 
-    // Input layout - per vertex data
-    const D3D12_INPUT_ELEMENT_DESC inputLayout[] = {
-        {"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
-        {"NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
-    };
-
     // Pipeline state object
     GraphicsPipelineState{inputLayout, rootSignature}
         .setDsvFormat(DXGI_FORMAT_D16_UNORM)
-        .VS(L"ShadowMap/normal_VS.hlsl")
+        .VS(L"ShadowMap/position_VS.hlsl")
         .compile(device, pipelineState);
 }
 
-void PipelineStateController::compilePipelineStateShadowMapTextureNormal(RootSignature &rootSignature, ID3D12PipelineStatePtr &pipelineState) {
-    // Root signature - crossthread data
-    rootSignature
-        .append32bitConstant<ShadowMapCB>(b(0), D3D12_SHADER_VISIBILITY_VERTEX) // register(b0)
-        .compile(device);
-
-    // Input layout - per vertex data
+void PipelineStateController::compilePipelineStateShadowMapPosition(RootSignature &rootSignature, ID3D12PipelineStatePtr &pipelineState) {
+    // Input layout - per vertex data, separate stream of float positions
     const D3D12_INPUT_ELEMENT_DESC inputLayout[] = {
         {"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
-        {"NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
-        {"TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
     };
-
-    // Pipeline state object
-    GraphicsPipelineState{inputLayout, rootSignature}
-        .setDsvFormat(DXGI_FORMAT_D16_UNORM)
-        .VS(L"ShadowMap/normal_texture_VS.hlsl")
-        .compile(device, pipelineState);
+    compilePipelineStateShadowMapWithInputLayout(device, rootSignature, pipelineState, inputLayout);
 }
 
-void PipelineStateController::compilePipelineStateShadowMapTextureNormalMap(RootSignature &rootSignature, ID3D12PipelineStatePtr &pipelineState) {
-    // Root signature - crossthread data
-    rootSignature
-        .append32bitConstant<ShadowMapCB>(b(0), D3D12_SHADER_VISIBILITY_VERTEX) // register(b0)
-        .compile(device);
-
-    // Input layout - per vertex data
+void PipelineStateController::compilePipelineStateShadowMapPositionQuantized(RootSignature &rootSignature, ID3D12PipelineStatePtr &pipelineState) {
+    // Input layout - per vertex data, separate stream of quantized positions
     const D3D12_INPUT_ELEMENT_DESC inputLayout[] = {
-        {"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
-        {"NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
-        {"TANGENT", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
-        {"TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
+        {"POSITION", 0, DXGI_FORMAT_R16G16B16A16_UNORM, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
     };
-
-    // Pipeline state object
-    GraphicsPipelineState{inputLayout, rootSignature}
-        .setDsvFormat(DXGI_FORMAT_D16_UNORM)
-        .VS(L"ShadowMap/texture_normal_map_VS.hlsl")
-        .compile(device, pipelineState);
+    compilePipelineStateShadowMapWithInputLayout(device, rootSignature, pipelineState, inputLayout);
 }
 
 // --------------------------------------------------------------------------------------------- Mip maps
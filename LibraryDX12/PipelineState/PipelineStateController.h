@@ -16,10 +16,12 @@ public:
         PIPELINE_STATE_NORMAL,
         PIPELINE_STATE_TEXTURE_NORMAL,
         PIPELINE_STATE_TEXTURE_NORMAL_MAP,
+        PIPELINE_STATE_NORMAL_QUANTIZED,
+        PIPELINE_STATE_TEXTURE_NORMAL_QUANTIZED,
+        PIPELINE_STATE_TEXTURE_NORMAL_MAP_QUANTIZED,
         // Shadow maps
-        PIPELINE_STATE_SM_NORMAL,
-        PIPELINE_STATE_SM_TEXTURE_NORMAL,
-        PIPELINE_STATE_SM_TEXTURE_NORMAL_MAP,
+        PIPELINE_STATE_SM_POSITION,
+        PIPELINE_STATE_SM_POSITION_QUANTIZED,
         // Mip maps
         PIPELINE_STATE_GENERATE_MIPS,
         // SSAO
@@ -69,11 +71,13 @@ private:
     void compilePipelineStateNormal(RootSignature &rootSignature, ID3D12PipelineStatePtr &pipelineState);
     void compilePipelineStateTextureNormal(RootSignature &rootSignature, ID3D12PipelineStatePtr &pipelineState);
     void compilePipelineStateTextureNormalMap(RootSignature &rootSignature, ID3D12PipelineStatePtr &pipelineState);
+    void compilePipelineStateNormalQuantized(RootSignature &rootSignature, ID3D12PipelineStatePtr &pipelineState);
+    void compilePipelineStateTextureNormalQuantized(RootSignature &rootSignature, ID3D12PipelineStatePtr &pipelineState);
+    void compilePipelineStateTextureNormalMapQuantized(RootSignature &rootSignature, ID3D12PipelineStatePtr &pipelineState);
     void compilePipelineStateLighting(RootSignature &rootSignature, ID3D12PipelineStatePtr &pipelineState);
     // Shadow maps
-    void compilePipelineStateShadowMapNormal(RootSignature &rootSignature, ID3D12PipelineStatePtr &pipelineState);
-    void compilePipelineStateShadowMapTextureNormal(RootSignature &rootSignature, ID3D12PipelineStatePtr &pipelineState);
-    void compilePipelineStateShadowMapTextureNormalMap(RootSignature &rootSignature, ID3D12PipelineStatePtr &pipelineState);
+    void compilePipelineStateShadowMapPosition(RootSignature &rootSignature, ID3D12PipelineStatePtr &pipelineState);
+    void compilePipelineStateShadowMapPositionQuantized(RootSignature &rootSignature, ID3D12PipelineStatePtr &pipelineState);
     // Mip maps
     void compilePipelineStateGenerateMips(RootSignature &rootSignature, ID3D12PipelineStatePtr &pipelineState);
     // SSAO
@@ -1,5 +1,6 @@
 #include "DeferredShadingRenderer.h"
 
+#include "Application/ApplicationImpl.h"
 #include "CommandList/CommandList.h"
 #include "Renderer/RenderData.h"
 #include "Scene/CameraImpl.h"
@@ -9,7 +10,7 @@
 #include "Scene/SceneImpl.h"
 #include "Window/SwapChain.h"
 
-//#include "Application/ApplicationImpl.h"
+#include <cmath>
 
 DeferredShadingRenderer::DeferredShadingRenderer(SwapChain &swapChain, RenderData &renderData, SceneImpl &scene, bool shadowsEnabled)
     : swapChain(swapChain),
@@ -35,90 +36,88 @@ void DeferredShadingRenderer::renderGBuffers(CommandList &commandList) {
     const float aspectRatio = swapChain.getWidth() / swapChain.getHeight();
     scene.getCameraImpl()->setAspectRatio(aspectRatio);
     const XMMATRIX vpMatrix = scene.getCameraImpl()->getViewProjectionMatrix();
+    const XMFLOAT3 eyePosition = scene.getCameraImpl()->getEyePosition();
+
+    // Levels of detail are switched when their error gets smaller than a pixel
+    const FLOAT maxLodErrorPerDistance = 2 * std::tan(scene.getCameraImpl()->getFovAngleY() / 2) / swapChain.getHeight();
+
+    // Culling is done for all objects up front, so it runs on all cores, while draws are recorded by this thread
+    computeVisibility(vpMatrix, eyePosition, maxLodErrorPerDistance);
 
     const Resource *rts[] = {&renderData.getGBufferAlbedo(), &renderData.getGBufferNormal(), &renderData.getGBufferSpecular()};
     commandList.OMSetRenderTargets(rts, renderData.getDepthStencilBuffer());
 
     //Draw NORMAL
-    commandList.setPipelineStateAndGraphicsRootSignature(PipelineStateController::Identifier::PIPELINE_STATE_NORMAL);
-
-    for (ObjectImpl *object : scene.getObjects()) {
-        MeshImpl &mesh = object->getMesh();
-        if (mesh.getPipelineStateIdentifier() == commandList.getPipelineStateIdentifier()) {
-            ModelMvp mmvp;
-            mmvp.modelMatrix = object->getModelMatrix();
-            mmvp.modelViewProjectionMatrix = XMMatrixMultiply(mmvp.modelMatrix, vpMatrix);
-            commandList.setRoot32BitConstant(0, mmvp);
-
-            ObjectPropertiesCB op = {};
-            op.albedoColor = object->getColor();
-            op.specularity = object->getSpecularity();
-            op.bloomFactor = object->getBloomFactor();
-            commandList.setRoot32BitConstant(1, op);
-
-            commandList.IASetVertexAndIndexBuffer(mesh);
-            commandList.draw(static_cast<UINT>(mesh.getVerticesCount()));
+    for (auto pipelineStateIdentifier : {PipelineStateController::Identifier::PIPELINE_STATE_NORMAL, PipelineStateController::Identifier::PIPELINE_STATE_NORMAL_QUANTIZED}) {
+        commandList.setPipelineStateAndGraphicsRootSignature(pipelineStateIdentifier);
+
+        for (const ObjectVisibility &visibility : objectsVisibility) {
+            ObjectImpl *object = visibility.object;
+            MeshImpl &mesh = object->getMesh();
+            if (mesh.getPipelineStateIdentifier() == commandList.getPipelineStateIdentifier()) {
+                ModelMvp mmvp;
+                mmvp.modelMatrix = object->getModelMatrix();
+                mmvp.modelViewProjectionMatrix = XMMatrixMultiply(XMMatrixMultiply(mesh.getPositionDequantizationMatrix(), mmvp.modelMatrix), vpMatrix);
+                commandList.setRoot32BitConstant(0, mmvp);
+
+                commandList.IASetVertexAndIndexBuffer(mesh);
+                drawSubmeshes(commandList, visibility);
+            }
         }
     }
 
     //Draw TEXTURE_NORMAL
-    commandList.setPipelineStateAndGraphicsRootSignature(PipelineStateController::Identifier::PIPELINE_STATE_TEXTURE_NORMAL);
-
-    for (ObjectImpl *object : scene.getObjects()) {
-        MeshImpl &mesh = object->getMesh();
-        TextureImpl *texture = object->getTextureImpl();
-        if (mesh.getPipelineStateIdentifier() == commandList.getPipelineStateIdentifier()) {
-            NormalTextureCB cb;
-            cb.modelMatrix = object->getModelMatrix();
-            cb.modelViewProjectionMatrix = XMMatrixMultiply(cb.modelMatrix, vpMatrix);
-            cb.textureScale = object->getTextureScale();
-            commandList.setRoot32BitConstant(0, cb);
-
-            ObjectPropertiesCB op = {};
-            op.albedoColor = object->getColor();
-            op.specularity = object->getSpecularity();
-            op.bloomFactor = object->getBloomFactor();
-            commandList.setRoot32BitConstant(1, op);
-
-            commandList.IASetVertexAndIndexBuffer(mesh);
-            commandList.setSrvInDescriptorTable(2, 0, *texture);
-            commandList.draw(static_cast<UINT>(mesh.getVerticesCount()));
+    for (auto pipelineStateIdentifier : {PipelineStateController::Identifier::PIPELINE_STATE_TEXTURE_NORMAL, PipelineStateController::Identifier::PIPELINE_STATE_TEXTURE_NORMAL_QUANTIZED}) {
+        commandList.setPipelineStateAndGraphicsRootSignature(pipelineStateIdentifier);
+
+        for (const ObjectVisibility &visibility : objectsVisibility) {
+            ObjectImpl *object = visibility.object;
+            MeshImpl &mesh = object->getMesh();
+            TextureImpl *texture = object->getTextureImpl();
+            if (mesh.getPipelineStateIdentifier() == commandList.getPipelineStateIdentifier()) {
+                NormalTextureCB cb;
+                cb.modelMatrix = object->getModelMatrix();
+                cb.modelViewProjectionMatrix = XMMatrixMultiply(XMMatrixMultiply(mesh.getPositionDequantizationMatrix(), cb.modelMatrix), vpMatrix);
+                cb.textureScale = object->getTextureScale();
+                commandList.setRoot32BitConstant(0, cb);
+
+                commandList.IASetVertexAndIndexBuffer(mesh);
+                commandList.setSrvInDescriptorTable(2, 0, *texture);
+                drawSubmeshes(commandList, visibility);
+            }
         }
     }
 
     //Draw TEXTURE_NORMAL_MAP
-    commandList.setPipelineStateAndGraphicsRootSignature(PipelineStateController::Identifier::PIPELINE_STATE_TEXTURE_NORMAL_MAP);
-    for (ObjectImpl *object : scene.getObjects()) {
-        MeshImpl &mesh = object->getMesh();
-        if (mesh.getPipelineStateIdentifier() == commandList.getPipelineStateIdentifier()) {
-            TextureNormalMapCB cb;
-            cb.modelMatrix = object->getModelMatrix();
-            cb.modelViewProjectionMatrix = XMMatrixMultiply(cb.modelMatrix, vpMatrix);
-            cb.textureScale = object->getTextureScale();
-            cb.normalMapAvailable = (object->getNormalMap() != nullptr);
-            commandList.setRoot32BitConstant(0, cb);
-
-            ObjectPropertiesCB op = {};
-            op.albedoColor = object->getColor();
-            op.specularity = object->getSpecularity();
-            op.bloomFactor = object->getBloomFactor();
-            commandList.setRoot32BitConstant(1, op);
-
-            commandList.IASetVertexAndIndexBuffer(mesh);
-            if (cb.normalMapAvailable) {
-                commandList.setSrvInDescriptorTable(2, 0, *object->getNormalMapImpl());
-            } else {
-                // TODO this is quite wasteful, maybe we can have global null descriptors?
-                auto allocation = ApplicationImpl::getInstance().getDescriptorController().allocateCpu(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, 1);
-                D3D12_SHADER_RESOURCE_VIEW_DESC desc{};
-                desc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
-                desc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-                desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
-                ApplicationImpl::getInstance().getDevice()->CreateShaderResourceView(nullptr, &desc, allocation.getCpuHandle());
-                commandList.setRawDescriptorInDescriptorTable(2, 0, allocation.getCpuHandle());
+    for (auto pipelineStateIdentifier : {PipelineStateController::Identifier::PIPELINE_STATE_TEXTURE_NORMAL_MAP, PipelineStateController::Identifier::PIPELINE_STATE_TEXTURE_NORMAL_MAP_QUANTIZED}) {
+        commandList.setPipelineStateAndGraphicsRootSignature(pipelineStateIdentifier);
+        for (const ObjectVisibility &visibility : objectsVisibility) {
+            ObjectImpl *object = visibility.object;
+            MeshImpl &mesh = object->getMesh();
+            if (mesh.getPipelineStateIdentifier() == commandList.getPipelineStateIdentifier()) {
+                TextureNormalMapCB cb;
+                cb.modelMatrix = object->getModelMatrix();
+                cb.modelViewProjectionMatrix = XMMatrixMultiply(XMMatrixMultiply(mesh.getPositionDequantizationMatrix(), cb.modelMatrix), vpMatrix);
+                cb.textureScale = object->getTextureScale();
+                cb.normalMapAvailable = (object->getNormalMap() != nullptr);
+                commandList.setRoot32BitConstant(0, cb);
+
+                commandList.IASetVertexAndIndexBuffer(mesh);
+                if (cb.normalMapAvailable) {
+                    commandList.setSrvInDescriptorTable(2, 0, *object->getNormalMapImpl());
+                } else {
+                    // TODO this is quite wasteful, maybe we can have global null descriptors?
+                    auto allocation = ApplicationImpl::getInstance().getDescriptorController().allocateCpu(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, 1);
+                    D3D12_SHADER_RESOURCE_VIEW_DESC desc{};
+                    desc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+                    desc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+                    desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+                    ApplicationImpl::getInstance().getDevice()->CreateShaderResourceView(nullptr, &desc, allocation.getCpuHandle());
+                    commandList.setRawDescriptorInDescriptorTable(2, 0, allocation.getCpuHandle());
+                }
+                commandList.setSrvInDescriptorTable(2, 1, *object->getTextureImpl());
+                drawSubmeshes(commandList, visibility);
             }
-            commandList.setSrvInDescriptorTable(2, 1, *object->getTextureImpl());
-            commandList.draw(static_cast<UINT>(mesh.getVerticesCount()));
         }
     }
 
@@ -128,6 +127,53 @@ void DeferredShadingRenderer::renderGBuffers(CommandList &commandList) {
     commandList.transitionBarrier(renderData.getDepthStencilBuffer(), D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
 }
 
+void DeferredShadingRenderer::computeVisibility(const XMMATRIX &vpMatrix, const XMFLOAT3 &eyePosition, FLOAT maxLodErrorPerDistance) {
+    objectsVisibility.resize(scene.getObjects().size());
+    auto object = scene.getObjects().begin();
+    for (ObjectVisibility &visibility : objectsVisibility) {
+        visibility.object = *object++;
+    }
+
+    // Every object is processed by one thread, so its model matrix can be lazily updated. Meshes are only read.
+    // Frame waits for the result, so helpers are not queued behind loading tasks
+    constexpr size_t objectsGrainSize = 16u;
+    BackgroundWorkerController &backgroundWorkerController = ApplicationImpl::getInstance().getBackgroundWorkerController();
+    backgroundWorkerController.parallelFor(0u, objectsVisibility.size(), objectsGrainSize, TaskPriority::CRITICAL, [&](size_t begin, size_t end) {
+        for (size_t objectIndex = begin; objectIndex < end; objectIndex++) {
+            ObjectVisibility &visibility = objectsVisibility[objectIndex];
+            const XMMATRIX &modelMatrix = visibility.object->getModelMatrix();
+            const MeshImpl &mesh = visibility.object->getMesh();
+            const UINT lodLevel = mesh.selectLodLevel(modelMatrix, eyePosition, maxLodErrorPerDistance);
+            visibility.visibleIndexRanges.resize(mesh.getSubmeshesCount());
+            for (auto submeshIndex = 0u; submeshIndex < mesh.getSubmeshesCount(); submeshIndex++) {
+                mesh.cullMeshlets(mesh.getLod(lodLevel, submeshIndex), modelMatrix, vpMatrix, &eyePosition, visibility.visibleIndexRanges[submeshIndex]);
+            }
+        }
+    });
+}
+
+void DeferredShadingRenderer::drawSubmeshes(CommandList &commandList, const ObjectVisibility &visibility) {
+    // Submeshes share vertex and index buffers, so only material properties are set between the draws
+    const ObjectImpl &object = *visibility.object;
+    const MeshImpl &mesh = object.getMesh();
+    for (auto submeshIndex = 0u; submeshIndex < mesh.getSubmeshesCount(); submeshIndex++) {
+        const std::vector<IndexRange> &visibleIndexRanges = visibility.visibleIndexRanges[submeshIndex];
+        if (visibleIndexRanges.empty()) {
+            continue;
+        }
+
+        // Material of the submesh overrides properties of the object
+        const MeshSubmesh &submesh = mesh.getSubmeshes()[submeshIndex];
+        ObjectPropertiesCB op = {};
+        op.albedoColor = submesh.hasMaterial ? XMFLOAT3{submesh.albedoColor[0], submesh.albedoColor[1], submesh.albedoColor[2]} : object.getColor();
+        op.specularity = submesh.hasMaterial ? submesh.specularity : object.getSpecularity();
+        op.bloomFactor = object.getBloomFactor();
+        commandList.setRoot32BitConstant(1, op);
+
+        commandList.drawIndexed(visibleIndexRanges, mesh.getStartIndexLocation(), mesh.getBaseVertexLocation());
+    }
+}
+
 void DeferredShadingRenderer::renderLighting(CommandList &commandList, Resource &output) {
 
     commandList.RSSetViewport(0.f, 0.f, swapChain.getWidth(), swapChain.getHeight());
@@ -1,11 +1,16 @@
 #pragma once
 
+#include "Geometry/MeshletCuller.h"
+
 #include "DXD/Utility/NonCopyableAndMovable.h"
 
+#include <DXD/ExternalHeadersWrappers/DirectXMath.h>
 #include <DXD/ExternalHeadersWrappers/d3d12.h>
+#include <vector>
 
 class CommandList;
 class ConstantBuffer;
+class ObjectImpl;
 class RenderData;
 class Resource;
 class SceneImpl;
@@ -19,10 +24,19 @@ public:
     void renderLighting(CommandList &commandList, Resource &output);
 
 private:
+    // Level of detail and meshlets passing the culling for each submesh of an object
+    struct ObjectVisibility {
+        ObjectImpl *object;
+        std::vector<std::vector<IndexRange>> visibleIndexRanges;
+    };
+
     D3D12_CPU_DESCRIPTOR_HANDLE uploadLightingConstantBuffer(ConstantBuffer &lightingConstantBuffer);
+    void computeVisibility(const XMMATRIX &vpMatrix, const XMFLOAT3 &eyePosition, FLOAT maxLodErrorPerDistance);
+    void drawSubmeshes(CommandList &commandList, const ObjectVisibility &visibility);
 
     SwapChain &swapChain;
     RenderData &renderData;
     SceneImpl &scene;
     const bool shadowsEnabled;
+    std::vector<ObjectVisibility> objectsVisibility; // reused between frames to avoid allocations
 };
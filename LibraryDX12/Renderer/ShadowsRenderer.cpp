@@ -7,6 +7,9 @@
 #include "Scene/MeshImpl.h"
 #include "Scene/ObjectImpl.h"
 #include "Scene/SceneImpl.h"
+#include "Window/SwapChain.h"
+
+#include <cmath>
 
 ShadowsRenderer::ShadowsRenderer(SwapChain &swapChain, RenderData &renderData, SceneImpl &scene)
     : swapChain(swapChain),
@@ -27,55 +30,44 @@ void ShadowsRenderer::renderShadowMaps(CommandList &commandList) {
     commandList.RSSetScissorRectNoScissor();
     commandList.IASetPrimitiveTopologyTriangleList();
 
+    // Shadows are blurred and seen from the camera only indirectly, so they tolerate coarser levels of detail than the geometry itself
+    constexpr FLOAT shadowLodErrorMultiplier = 4.f;
+    const XMFLOAT3 eyePosition = scene.getCameraImpl()->getEyePosition();
+    const FLOAT maxLodErrorPerDistance = shadowLodErrorMultiplier * 2 * std::tan(scene.getCameraImpl()->getFovAngleY() / 2) / swapChain.getHeight();
+
     int lightIdx = 0;
 
     for (LightImpl *light : lights) {
         commandList.OMSetRenderTargetDepthOnly(renderData.getShadowMap(lightIdx));
         commandList.clearDepthStencilView(renderData.getShadowMap(lightIdx), D3D12_CLEAR_FLAG_DEPTH, 1.f, 0);
 
-        // View projection matrix
+        // View projection matrix, shadow maps may be rendered without back face culling, so meshlets are culled only by the frustum
         scene.getCameraImpl()->setAspectRatio(1.0f);
         const XMMATRIX smViewProjectionMatrix = light->getShadowMapViewProjectionMatrix();
 
-        // Draw NORMAL
-        commandList.setPipelineStateAndGraphicsRootSignature(PipelineStateController::Identifier::PIPELINE_STATE_SM_NORMAL);
-        for (ObjectImpl *object : scene.getObjects()) {
-            MeshImpl &mesh = object->getMesh();
-            if (mesh.getShadowMapPipelineStateIdentifier() == commandList.getPipelineStateIdentifier()) {
-                ShadowMapCB cb;
-                cb.mvp = XMMatrixMultiply(object->getModelMatrix(), smViewProjectionMatrix);
-                commandList.setRoot32BitConstant(0, cb);
-
-                commandList.IASetVertexAndIndexBuffer(mesh);
-                commandList.draw(static_cast<UINT>(mesh.getVerticesCount()));
-            }
-        }
-
-        // Draw TEXTURE NORMAL
-        commandList.setPipelineStateAndGraphicsRootSignature(PipelineStateController::Identifier::PIPELINE_STATE_SM_TEXTURE_NORMAL);
-        for (ObjectImpl *object : scene.getObjects()) {
-            MeshImpl &mesh = object->getMesh();
-            if (mesh.getShadowMapPipelineStateIdentifier() == commandList.getPipelineStateIdentifier()) {
-                ShadowMapCB cb;
-                cb.mvp = XMMatrixMultiply(object->getModelMatrix(), smViewProjectionMatrix);
-                commandList.setRoot32BitConstant(0, cb);
+        // Position streams have the format of the full vertices, float or quantized, each drawn with its own pipeline state
+        for (const auto pipelineStateIdentifier : {PipelineStateController::Identifier::PIPELINE_STATE_SM_POSITION,
+                                                   PipelineStateController::Identifier::PIPELINE_STATE_SM_POSITION_QUANTIZED}) {
+            commandList.setPipelineStateAndGraphicsRootSignature(pipelineStateIdentifier);
+            for (ObjectImpl *object : scene.getObjects()) {
+                MeshImpl &mesh = object->getMesh();
+                if (mesh.getShadowMapPipelineStateIdentifier() != pipelineStateIdentifier) {
+                    continue;
+                }
 
-                commandList.IASetVertexAndIndexBuffer(mesh);
-                commandList.draw(static_cast<UINT>(mesh.getVerticesCount()));
-            }
-        }
-
-        // Draw TEXTURE NORMAL MAP
-        commandList.setPipelineStateAndGraphicsRootSignature(PipelineStateController::Identifier::PIPELINE_STATE_SM_TEXTURE_NORMAL_MAP);
-        for (ObjectImpl *object : scene.getObjects()) {
-            MeshImpl &mesh = object->getMesh();
-            if (mesh.getShadowMapPipelineStateIdentifier() == commandList.getPipelineStateIdentifier()) {
                 ShadowMapCB cb;
-                cb.mvp = XMMatrixMultiply(object->getModelMatrix(), smViewProjectionMatrix);
+                cb.mvp = XMMatrixMultiply(XMMatrixMultiply(mesh.getPositionDequantizationMatrix(), object->getModelMatrix()), smViewProjectionMatrix);
                 commandList.setRoot32BitConstant(0, cb);
-
-                commandList.IASetVertexAndIndexBuffer(mesh);
-                commandList.draw(static_cast<UINT>(mesh.getVerticesCount()));
+                commandList.IASetPositionAndIndexBuffer(mesh);
+
+                // Materials don't matter for depth, but every submesh has its own index ranges at each level of detail
+                const UINT lodLevel = mesh.selectLodLevel(object->getModelMatrix(), eyePosition, maxLodErrorPerDistance);
+                for (auto submeshIndex = 0u; submeshIndex < mesh.getSubmeshesCount(); submeshIndex++) {
+                    mesh.cullMeshlets(mesh.getLod(lodLevel, submeshIndex), object->getModelMatrix(), smViewProjectionMatrix, nullptr, visibleIndexRanges);
+                    if (!visibleIndexRanges.empty()) {
+                        commandList.drawIndexed(visibleIndexRanges, mesh.getStartIndexLocation(), mesh.getPositionBaseVertexLocation());
+                    }
+                }
             }
         }
 
@@ -1,7 +1,11 @@
 #pragma once
 
+#include "Geometry/MeshletCuller.h"
+
 #include "DXD/Utility/NonCopyableAndMovable.h"
 
+#include <vector>
+
 class RenderData;
 class SceneImpl;
 class SwapChain;
@@ -19,4 +23,5 @@ private:
     RenderData &renderData;
     SceneImpl &scene;
     const bool enabled;
+    std::vector<IndexRange> visibleIndexRanges; // reused between objects to avoid allocations
 };
@@ -0,0 +1,177 @@
+#include "CookedTexture.h"
+
+#include "Resource/Resource.h"
+#include "Utility/DxgiFormatHelper.h"
+#include "Utility/FileHelper.h"
+
+#include <algorithm>
+#include <fstream>
+
+namespace {
+bool computeMipsSize(const CookedTextureHeader &header, size_t &outSize) {
+    outSize = 0u;
+    for (auto mip = 0u; mip < header.mipLevels; mip++) {
+        size_t rowPitch{};
+        size_t slicePitch{};
+        const HRESULT result = DirectX::ComputePitch(static_cast<DXGI_FORMAT>(header.format), std::max(1u, header.width >> mip),
+                                                     std::max(1u, header.height >> mip), rowPitch, slicePitch);
+        if (FAILED(result)) {
+            return false;
+        }
+        outSize += slicePitch;
+    }
+    return true;
+}
+
+bool isFloatFormat(DXGI_FORMAT format) {
+    switch (format) {
+    case DXGI_FORMAT_R32G32B32A32_FLOAT:
+    case DXGI_FORMAT_R32G32B32_FLOAT:
+    case DXGI_FORMAT_R16G16B16A16_FLOAT:
+    case DXGI_FORMAT_R11G11B10_FLOAT:
+        return true;
+    default:
+        return false;
+    }
+}
+} // namespace
+
+CookedTexture::CookedTexture(const std::wstring &path, const CookedMeshSource &expectedSource)
+    : file(path) {
+    if (!file.isValid() || file.getSize() < sizeof(CookedTextureHeader)) {
+        return;
+    }
+
+    const auto candidate = reinterpret_cast<const CookedTextureHeader *>(file.getData());
+    if (candidate->magic != CookedTextureHeader::expectedMagic || candidate->version != CookedTextureHeader::currentVersion) {
+        return;
+    }
+    if (candidate->source.size != expectedSource.size ||
+        candidate->source.lastWriteTime != expectedSource.lastWriteTime ||
+        candidate->source.loadFlags != expectedSource.loadFlags) {
+        return;
+    }
+    if (candidate->width == 0u || candidate->height == 0u || candidate->mipLevels == 0u || candidate->mipLevels > Resource::maxSubresourcesCount) {
+        return;
+    }
+
+    size_t mipsSize{};
+    if (!computeMipsSize(*candidate, mipsSize) || file.getSize() != sizeof(CookedTextureHeader) + mipsSize) {
+        return;
+    }
+
+    header = candidate;
+}
+
+void CookedTexture::getSubresources(std::vector<D3D12_SUBRESOURCE_DATA> &outSubresources) const {
+    outSubresources.resize(header->mipLevels);
+    const BYTE *mipData = reinterpret_cast<const BYTE *>(header + 1);
+    for (auto mip = 0u; mip < header->mipLevels; mip++) {
+        size_t rowPitch{};
+        size_t slicePitch{};
+        DirectX::ComputePitch(static_cast<DXGI_FORMAT>(header->format), std::max(1u, header->width >> mip),
+                              std::max(1u, header->height >> mip), rowPitch, slicePitch);
+        outSubresources[mip].pData = mipData;
+        outSubresources[mip].RowPitch = static_cast<LONG_PTR>(rowPitch);
+        outSubresources[mip].SlicePitch = static_cast<LONG_PTR>(slicePitch);
+        mipData += slicePitch;
+    }
+}
+
+bool CookedTexture::write(const std::wstring &path, const CookedMeshSource &source, const DirectX::ScratchImage &image) {
+    const DirectX::TexMetadata &metadata = image.GetMetadata();
+    if (metadata.dimension != DirectX::TEX_DIMENSION_TEXTURE2D || metadata.arraySize != 1u || metadata.depth != 1u) {
+        return false;
+    }
+
+    const CookedTextureHeader header{CookedTextureHeader::expectedMagic, CookedTextureHeader::currentVersion, source,
+                                     static_cast<UINT>(metadata.format), static_cast<UINT>(metadata.width),
+                                     static_cast<UINT>(metadata.height), static_cast<UINT>(metadata.mipLevels)};
+    const std::wstring temporaryPath = path + L"." + std::to_wstring(GetCurrentThreadId()) + L".tmp";
+    {
+        std::ofstream outputFile{temporaryPath, std::ios::out | std::ios::binary | std::ios::trunc};
+        outputFile.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        for (auto mip = 0u; mip < metadata.mipLevels; mip++) {
+            // Rows of a scratch image are tightly packed, so each mip can be written at once
+            const DirectX::Image *mipImage = image.GetImage(mip, 0, 0);
+            outputFile.write(reinterpret_cast<const char *>(mipImage->pixels), static_cast<std::streamsize>(mipImage->slicePitch));
+        }
+        if (!outputFile.good()) {
+            outputFile.close();
+            DeleteFileW(temporaryPath.c_str());
+            return false;
+        }
+    }
+
+    if (!MoveFileExW(temporaryPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING)) {
+        DeleteFileW(temporaryPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+std::wstring CookedTexture::getPath(const std::wstring &sourcePath, DXD::Texture::TextureType type) {
+    return sourcePath + L"." + std::to_wstring(static_cast<UINT>(type)) + L".dxdtex";
+}
+
+HRESULT CookedTexture::loadSourceImage(const std::wstring &path, DirectX::TexMetadata &outMetadata, DirectX::ScratchImage &outImage) {
+    const auto extension = FileHelper::getExtension(path, true);
+    if (extension == L"tga") {
+        return DirectX::LoadFromTGAFile(path.c_str(), &outMetadata, outImage);
+    } else if (extension == L"dds") {
+        return DirectX::LoadFromDDSFile(path.c_str(), DirectX::DDS_FLAGS_FORCE_RGB, &outMetadata, outImage);
+    } else if (extension == L"hdr") {
+        return DirectX::LoadFromHDRFile(path.c_str(), &outMetadata, outImage);
+    } else if (extension == L"jpg" || extension == L"png" || extension == L"bmp") {
+        return DirectX::LoadFromWICFile(path.c_str(), DirectX::WIC_FLAGS_FORCE_RGB, &outMetadata, outImage);
+    }
+    return HRESULT_FROM_WIN32(ERROR_NOT_SUPPORTED);
+}
+
+HRESULT CookedTexture::cook(const DirectX::ScratchImage &image, DXD::Texture::TextureType type, DirectX::ScratchImage &outImage) {
+    // Only the most detailed level of the source is used, mips are always regenerated
+    DirectX::ScratchImage baseImage{};
+    const DirectX::Image &sourceImage = *image.GetImage(0, 0, 0);
+    HRESULT result = DirectX::IsCompressed(sourceImage.format) ? DirectX::Decompress(sourceImage, DXGI_FORMAT_UNKNOWN, baseImage)
+                                                               : baseImage.InitializeFromImage(sourceImage);
+    if (FAILED(result)) {
+        return result;
+    }
+    if (type == DXD::Texture::TextureType::NORMAL_MAP) {
+        baseImage.OverrideFormat(DxgiFormatHelper::convertToNonSrgbFormat(baseImage.GetMetadata().format));
+    }
+
+    // Mip count matches the one used for textures loaded from their sources
+    const DirectX::TexMetadata metadata = baseImage.GetMetadata();
+    const UINT mipsCount = computeMipsCount(static_cast<UINT>(metadata.width), static_cast<UINT>(metadata.height));
+    DirectX::ScratchImage mipChain{};
+    if (mipsCount > 1u) {
+        result = DirectX::GenerateMipMaps(*baseImage.GetImage(0, 0, 0), DirectX::TEX_FILTER_DEFAULT, mipsCount, mipChain);
+        if (FAILED(result)) {
+            return result;
+        }
+    } else {
+        mipChain = std::move(baseImage);
+    }
+
+    // Block compressed textures require the most detailed mip to consist of whole blocks
+    if (metadata.width % 4 != 0 || metadata.height % 4 != 0) {
+        outImage = std::move(mipChain);
+        return S_OK;
+    }
+    DXGI_FORMAT compressedFormat = DirectX::IsSRGB(metadata.format) ? DXGI_FORMAT_BC7_UNORM_SRGB : DXGI_FORMAT_BC7_UNORM;
+    if (isFloatFormat(metadata.format)) {
+        compressedFormat = DXGI_FORMAT_BC6H_UF16;
+    }
+    return DirectX::Compress(mipChain.GetImages(), mipChain.GetImageCount(), mipChain.GetMetadata(), compressedFormat,
+                             DirectX::TEX_COMPRESS_DEFAULT, DirectX::TEX_THRESHOLD_DEFAULT, outImage);
+}
+
+UINT CookedTexture::computeMipsCount(UINT width, UINT height) {
+    // Smallest 1x1 mip is skipped, like in TextureImpl
+    UINT mipsCount = 0u;
+    for (UINT biggerDimension = std::max(width, height); biggerDimension > 1u; biggerDimension >>= 1) {
+        mipsCount++;
+    }
+    return std::max(1u, std::min(mipsCount, Resource::maxSubresourcesCount));
+}
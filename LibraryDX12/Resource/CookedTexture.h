@@ -0,0 +1,69 @@
+#pragma once
+
+#include "DirectXTex/DirectXTex/DirectXTex.h"
+#include "Geometry/CookedMesh.h"
+#include "Utility/MemoryMappedFile.h"
+
+#include "DXD/Utility/NonCopyableAndMovable.h"
+
+#include <DXD/ExternalHeadersWrappers/d3d12.h>
+#include <DXD/ExternalHeadersWrappers/windows.h>
+#include <DXD/Texture.h>
+#include <string>
+#include <vector>
+
+/// \brief Fixed-size header at the beginning of a cooked texture file
+struct CookedTextureHeader {
+    constexpr static UINT expectedMagic = 0x54445844; // "DXDT"
+    constexpr static UINT currentVersion = 1u;        // has to be bumped each time file layout or texture processing changes
+
+    UINT magic;
+    UINT version;
+    CookedMeshSource source; // identified the same way as sources of cooked meshes, load flags hold the texture type
+    UINT format;
+    UINT width;
+    UINT height;
+    UINT mipLevels;
+};
+static_assert(sizeof(CookedTextureHeader) % sizeof(UINT64) == 0, "Mip data following the header has to be aligned");
+
+/// \brief Binary 2D texture file containing a full mip chain in its final, usually block compressed, format
+///
+/// File consists of CookedTextureHeader followed by tightly packed mips, starting with the most detailed
+/// one, so they can be uploaded to GPU straight from the mapped file. Generating mips and compressing
+/// blocks is too slow to be done on every load, so cooked textures are produced offline by the asset
+/// cooker and the loader only reads them. Stale files are ignored and the loader falls back to the source.
+class CookedTexture : DXD::NonCopyableAndMovable {
+public:
+    /// Maps the file and validates it against the source. Missing, corrupted, stale files and files
+    /// of other versions result in an invalid object.
+    CookedTexture(const std::wstring &path, const CookedMeshSource &expectedSource);
+
+    bool isValid() const { return header != nullptr; }
+    const CookedTextureHeader &getHeader() const { return *header; }
+
+    /// Fills locations and pitches of all mips in the mapped file, one element per subresource
+    void getSubresources(std::vector<D3D12_SUBRESOURCE_DATA> &outSubresources) const;
+
+    /// Writes cooked texture to a temporary file and then moves it to the final location, so concurrent
+    /// readers never see a partially written file.
+    /// \param image 2D texture with a single array slice, usually a result of cook
+    /// \return true on success
+    static bool write(const std::wstring &path, const CookedMeshSource &source, const DirectX::ScratchImage &image);
+
+    /// Cooked textures are stored next to their sources. Type is a part of the name, since it affects the format.
+    static std::wstring getPath(const std::wstring &sourcePath, DXD::Texture::TextureType type);
+
+    /// Decodes an image file in any of the formats supported by the texture loader, i.e. tga, dds, hdr, jpg, png and bmp
+    static HRESULT loadSourceImage(const std::wstring &path, DirectX::TexMetadata &outMetadata, DirectX::ScratchImage &outImage);
+
+    /// Generates mips on the CPU and compresses them to BC7 (BC6H for floating point images). Normal maps
+    /// are forced to linear formats. Images with dimensions not divisible by 4 are left uncompressed.
+    static HRESULT cook(const DirectX::ScratchImage &image, DXD::Texture::TextureType type, DirectX::ScratchImage &outImage);
+
+private:
+    static UINT computeMipsCount(UINT width, UINT height);
+
+    MemoryMappedFile file;
+    const CookedTextureHeader *header = nullptr;
+};
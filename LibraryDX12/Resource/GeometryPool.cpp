@@ -0,0 +1,161 @@
+#include "GeometryPool.h"
+
+#include "CommandList/CommandList.h"
+#include "CommandList/CommandQueue.h"
+#include "Utility/DxObjectNaming.h"
+#include "Utility/ThrowIfFailed.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+// ------------------------------------------------------------------------------------- GeometryAllocation
+
+D3D12_VERTEX_BUFFER_VIEW GeometryAllocation::getVertexBufferView() const {
+    D3D12_VERTEX_BUFFER_VIEW view{};
+    view.BufferLocation = page->GetGPUVirtualAddress();
+    view.SizeInBytes = static_cast<UINT>(page->GetDesc().Width);
+    view.StrideInBytes = elementSize;
+    return view;
+}
+
+D3D12_INDEX_BUFFER_VIEW GeometryAllocation::getIndexBufferView(DXGI_FORMAT format) const {
+    D3D12_INDEX_BUFFER_VIEW view{};
+    view.BufferLocation = page->GetGPUVirtualAddress();
+    view.SizeInBytes = static_cast<UINT>(page->GetDesc().Width);
+    view.Format = format;
+    return view;
+}
+
+// ------------------------------------------------------------------------------------- Creation
+
+GeometryPool::Page::Page(ID3D12DevicePtr device, UINT64 size, bool dedicated)
+    : buffer(std::make_unique<Resource>(device, D3D12_HEAP_TYPE_DEFAULT, D3D12_HEAP_FLAG_NONE, size, D3D12_RESOURCE_STATE_COMMON, nullptr)),
+      allocator(size),
+      dedicated(dedicated) {}
+
+GeometryPool::GeometryPool(ID3D12DevicePtr device, CommandQueue &copyCommandQueue, CommandQueue &directCommandQueue,
+                           const wchar_t *name, UINT64 pageSize)
+    : device(device),
+      copyCommandQueue(copyCommandQueue),
+      directCommandQueue(directCommandQueue),
+      name(name),
+      pageSize(pageSize) {}
+
+// ------------------------------------------------------------------------------------- Allocation
+
+GeometryAllocation GeometryPool::allocate(UINT elementSize, UINT elementsCount) {
+    assert(elementSize > 0u);
+    std::lock_guard<std::mutex> lock{this->lock};
+    freeCompletedRanges();
+
+    GeometryAllocation allocation{};
+    allocation.size = static_cast<UINT64>(elementSize) * elementsCount;
+    allocation.elementSize = elementSize;
+    if (allocation.size == 0u) {
+        return allocation;
+    }
+
+    // Regular pages first, dedicated ones are always full
+    for (auto pageIndex = 0u; pageIndex < pages.size(); pageIndex++) {
+        Page &page = pages[pageIndex];
+        if (page.buffer != nullptr && page.allocator.allocate(allocation.size, elementSize, allocation.offset)) {
+            allocation.page = page.buffer->getResource();
+            allocation.pageIndex = pageIndex;
+            return allocation;
+        }
+    }
+
+    // Allocation which doesn't leave any space in a new page gets a dedicated one
+    const bool dedicated = allocation.size >= pageSize;
+    allocation.pageIndex = createPage(std::max(pageSize, allocation.size), dedicated);
+    const bool allocated = pages[allocation.pageIndex].allocator.allocate(allocation.size, elementSize, allocation.offset);
+    assert(allocated);
+    allocation.page = pages[allocation.pageIndex].buffer->getResource();
+    return allocation;
+}
+
+void GeometryPool::free(const GeometryAllocation &allocation) {
+    if (allocation.isNull()) {
+        return;
+    }
+
+    const uint64_t copyQueueFenceValue = copyCommandQueue.getLastSignalledFenceValue();
+    const uint64_t directQueueFenceValue = directCommandQueue.getLastSignalledFenceValue();
+    std::lock_guard<std::mutex> lock{this->lock};
+    pendingFrees.push_back(PendingFree{allocation, copyQueueFenceValue, directQueueFenceValue});
+}
+
+void GeometryPool::freeCompletedRanges() {
+    auto it = pendingFrees.begin();
+    while (it != pendingFrees.end()) {
+        if (copyCommandQueue.isFenceComplete(it->copyQueueFenceValue) && directCommandQueue.isFenceComplete(it->directQueueFenceValue)) {
+            Page &page = pages[it->allocation.pageIndex];
+            page.allocator.free(it->allocation.offset, it->allocation.size);
+            if (page.dedicated && page.allocator.isEmpty()) {
+                releaseDedicatedPage(it->allocation.pageIndex);
+            }
+            it = pendingFrees.erase(it);
+        } else {
+            it++;
+        }
+    }
+}
+
+UINT GeometryPool::createPage(UINT64 size, bool dedicated) {
+    // Reuse slot of a released dedicated page, so indices of other pages stay valid
+    auto it = std::find_if(pages.begin(), pages.end(), [](const Page &page) { return page.buffer == nullptr; });
+    if (it == pages.end()) {
+        it = pages.emplace(pages.end(), device, size, dedicated);
+    } else {
+        *it = Page(device, size, dedicated);
+    }
+
+    const UINT pageIndex = static_cast<UINT>(std::distance(pages.begin(), it));
+    SET_OBJECT_NAME(*it->buffer, L"%s%u", name, pageIndex);
+    return pageIndex;
+}
+
+void GeometryPool::releaseDedicatedPage(UINT pageIndex) {
+    // GPU is done with the page and the freed allocation was its only user
+    pages[pageIndex].buffer.reset();
+}
+
+// ------------------------------------------------------------------------------------- Upload
+
+void GeometryPool::recordUploadCommands(CommandList &commandList, const GeometryAllocation &allocation, const void *data) {
+    assert(!allocation.isNull());
+
+    // Create buffer on upload heap and fill it
+    Resource intermediateResource(device, D3D12_HEAP_TYPE_UPLOAD, D3D12_HEAP_FLAG_NONE, allocation.size, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr);
+    void *mappedData{};
+    const D3D12_RANGE readRange{0, 0};
+    throwIfFailed(intermediateResource.getResource()->Map(0, &readRange, &mappedData));
+    std::memcpy(mappedData, data, static_cast<size_t>(allocation.size));
+    intermediateResource.getResource()->Unmap(0, nullptr);
+
+    // Page is implicitly promoted to copy destination state, see class description
+    commandList.getCommandList()->CopyBufferRegion(allocation.page.Get(), allocation.offset, intermediateResource.getResource().Get(), 0, allocation.size);
+
+    // Make both resources tracked so they're not deleted while still being processed on the GPU
+    commandList.addUsedResource(intermediateResource.getResource());
+    commandList.addUsedResource(allocation.page);
+}
+
+// ------------------------------------------------------------------------------------- Accessors
+
+size_t GeometryPool::getPagesCount() {
+    std::lock_guard<std::mutex> lock{this->lock};
+    return static_cast<size_t>(std::count_if(pages.begin(), pages.end(), [](const Page &page) { return page.buffer != nullptr; }));
+}
+
+UINT64 GeometryPool::getAllocatedSize() {
+    std::lock_guard<std::mutex> lock{this->lock};
+    UINT64 result = 0u;
+    for (const Page &page : pages) {
+        if (page.buffer != nullptr) {
+            result += page.allocator.getSize() - page.allocator.getFreeSize();
+        }
+    }
+    return result;
+}
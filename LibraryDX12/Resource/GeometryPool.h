@@ -0,0 +1,94 @@
+#pragma once
+
+#include "Resource/Resource.h"
+#include "Utility/FreeListAllocator.h"
+
+#include "DXD/Utility/NonCopyableAndMovable.h"
+
+#include <DXD/ExternalHeadersWrappers/d3d12.h>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class CommandQueue;
+
+/// \brief Handle to a range of geometry suballocated from a GeometryPool
+struct GeometryAllocation {
+    ID3D12ResourcePtr page = {}; // buffer containing the range, null for null allocations
+    UINT pageIndex = 0u;
+    UINT64 offset = 0u;    // in bytes, multiple of elementSize
+    UINT64 size = 0u;      // in bytes
+    UINT elementSize = 0u; // vertex stride or index size
+
+    bool isNull() const { return page == nullptr; }
+    UINT getFirstElement() const { return static_cast<UINT>(offset / elementSize); }
+
+    /// Views span the whole page, so draws of all allocations within it can share them
+    D3D12_VERTEX_BUFFER_VIEW getVertexBufferView() const;
+    D3D12_INDEX_BUFFER_VIEW getIndexBufferView(DXGI_FORMAT format) const;
+};
+
+/// \brief Storage of static geometry shared by all meshes
+///
+/// Vertices or indices of many meshes are suballocated from a few large buffers on the default heap (pages),
+/// so consecutive draws of different meshes usually bind the same buffers and address their data with
+/// base vertex and start index locations. Each allocation is aligned to its element size for that reason.
+/// Allocations filling a whole page or bigger get a dedicated one, which is released as soon as it's freed.
+///
+/// Pages are shared by meshes in different stages of their lifetime - one mesh can be uploaded on the copy queue,
+/// while the direct queue is drawing another one. Explicit state tracking of Resource class cannot express that,
+/// so pages are never transitioned. They stay in the common state and rely on implicit promotion to copy destination
+/// or vertex/index buffer states and decay back to common at the end of each ExecuteCommandLists. Buffers have no
+/// layout, so accessing disjoint ranges from different queues this way is valid.
+///
+/// Freed ranges can still be read by the GPU, so they're returned to the free list only after all work submitted
+/// to the copy and the direct queue at the time of freeing is completed.
+class GeometryPool : DXD::NonCopyableAndMovable {
+public:
+    /// \param name used for naming created pages
+    /// \param pageSize size of regular pages in bytes
+    GeometryPool(ID3D12DevicePtr device, CommandQueue &copyCommandQueue, CommandQueue &directCommandQueue,
+                 const wchar_t *name, UINT64 pageSize);
+
+    /// Suballocates space for elements of given size, creating a new page if no existing one has enough free space
+    /// \return null allocation if elementsCount is 0
+    GeometryAllocation allocate(UINT elementSize, UINT elementsCount);
+
+    /// Returns the range to the pool once the GPU stops using it. Null allocations are ignored
+    void free(const GeometryAllocation &allocation);
+
+    /// Records copy of the data to the allocated range. The command list should belong to the copy queue.
+    void recordUploadCommands(CommandList &commandList, const GeometryAllocation &allocation, const void *data);
+
+    // Statistics
+    size_t getPagesCount();
+    UINT64 getAllocatedSize();
+
+private:
+    struct Page {
+        Page(ID3D12DevicePtr device, UINT64 size, bool dedicated);
+        std::unique_ptr<Resource> buffer; // null if the page was dedicated and its slot can be reused
+        FreeListAllocator allocator;
+        bool dedicated; // holds a single allocation and is released when it's freed
+    };
+
+    struct PendingFree {
+        GeometryAllocation allocation;
+        uint64_t copyQueueFenceValue;
+        uint64_t directQueueFenceValue;
+    };
+
+    void freeCompletedRanges();
+    UINT createPage(UINT64 size, bool dedicated);
+    void releaseDedicatedPage(UINT pageIndex);
+
+    ID3D12DevicePtr device;
+    CommandQueue &copyCommandQueue;
+    CommandQueue &directCommandQueue;
+    const wchar_t *name;
+    const UINT64 pageSize;
+
+    std::vector<Page> pages = {};
+    std::vector<PendingFree> pendingFrees = {};
+    std::mutex lock = {};
+};
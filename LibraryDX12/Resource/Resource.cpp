@@ -58,6 +58,23 @@ bool Resource::isWaitingForGpuDependencies() {
     return !gpuDependencies.isComplete();
 }
 
+bool Resource::waitOnCpuForGpuDependencies(std::chrono::milliseconds timeout) {
+    // Wait on a copy, so the lock is not held until the timeout by a thread waiting for an upload
+    GpuDependencies dependencies{};
+    {
+        std::lock_guard<std::mutex> gpuDependenciesLock{this->gpuDependenciesLock};
+        dependencies.add(gpuDependencies);
+    }
+    if (!dependencies.waitOnCpu(timeout)) {
+        return false;
+    }
+
+    // Dependencies added in the meantime are kept
+    std::lock_guard<std::mutex> gpuDependenciesLock{this->gpuDependenciesLock};
+    gpuDependencies.removeCompleted();
+    return true;
+}
+
 void Resource::addGpuDependency(CommandQueue &queue, uint64_t fenceValue) {
     std::lock_guard<std::mutex> gpuDependenciesLock{this->gpuDependenciesLock};
     gpuDependencies.add(queue, fenceValue);
@@ -69,11 +86,19 @@ void Resource::waitOnGpuForGpuUpload(CommandQueue &queue) {
 }
 
 void Resource::uploadToGPU(ApplicationImpl &application, const void *data, UINT rowPitch, UINT slicePitch) {
+    D3D12_SUBRESOURCE_DATA subresourceData = {};
+    subresourceData.pData = data;
+    subresourceData.RowPitch = rowPitch;
+    subresourceData.SlicePitch = slicePitch;
+    uploadToGPU(application, &subresourceData, 1u);
+}
+
+void Resource::uploadToGPU(ApplicationImpl &application, const D3D12_SUBRESOURCE_DATA *subresourcesData, UINT subresourcesCount) {
     CommandQueue &commandQueue = application.getCopyCommandQueue();
 
     // Record command list for GPU upload
     CommandList commandList{commandQueue};
-    recordGpuUploadCommands(application.getDevice(), commandList, data, rowPitch, slicePitch);
+    recordGpuUploadCommands(application.getDevice(), commandList, subresourcesData, subresourcesCount);
     commandList.close();
 
     // Execute on GPU
@@ -82,17 +107,22 @@ void Resource::uploadToGPU(ApplicationImpl &application, const void *data, UINT
 }
 
 void Resource::recordGpuUploadCommands(ID3D12DevicePtr device, CommandList &commandList, const void *data, UINT rowPitch, UINT slicePitch) {
+    D3D12_SUBRESOURCE_DATA subresourceData = {};
+    subresourceData.pData = data;
+    subresourceData.RowPitch = rowPitch;
+    subresourceData.SlicePitch = slicePitch;
+    recordGpuUploadCommands(device, commandList, &subresourceData, 1u);
+}
+
+void Resource::recordGpuUploadCommands(ID3D12DevicePtr device, CommandList &commandList, const D3D12_SUBRESOURCE_DATA *subresourcesData, UINT subresourcesCount) {
     assert(getState().areAllSubresourcesInState(D3D12_RESOURCE_STATE_COPY_DEST));
 
     // Create buffer on upload heap
-    Resource intermediateResource(device, D3D12_HEAP_TYPE_UPLOAD, D3D12_HEAP_FLAG_NONE, GetRequiredIntermediateSize(resource.Get(), 0, 1), D3D12_RESOURCE_STATE_GENERIC_READ, nullptr);
+    Resource intermediateResource(device, D3D12_HEAP_TYPE_UPLOAD, D3D12_HEAP_FLAG_NONE, GetRequiredIntermediateSize(resource.Get(), 0, subresourcesCount),
+                                  D3D12_RESOURCE_STATE_GENERIC_READ, nullptr);
 
     // Transfer data through the upload heap to destination resource
-    D3D12_SUBRESOURCE_DATA subresourceData = {};
-    subresourceData.pData = data;
-    subresourceData.RowPitch = rowPitch;
-    subresourceData.SlicePitch = slicePitch;
-    UpdateSubresources<1>(commandList.getCommandList().Get(), this->resource.Get(), intermediateResource.getResource().Get(), 0, 0, 1, &subresourceData);
+    UpdateSubresources(commandList.getCommandList().Get(), this->resource.Get(), intermediateResource.getResource().Get(), 0, 0, subresourcesCount, subresourcesData);
 
     // Make intermediateResource tracked so it's not deleted while still being processed on the GPU
     commandList.addUsedResource(intermediateResource.getResource());
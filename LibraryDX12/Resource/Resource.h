@@ -7,6 +7,7 @@
 #include "DXD/Utility/NonCopyableAndMovable.h"
 
 #include <ExternalHeaders/Wrappers/d3dx12.h>
+#include <chrono>
 #include <mutex>
 
 class ApplicationImpl;
@@ -64,6 +65,7 @@ public:
 
     // Gpu dependency functions
     bool isWaitingForGpuDependencies();
+    bool waitOnCpuForGpuDependencies(std::chrono::milliseconds timeout);
     void addGpuDependency(CommandQueue &queue, uint64_t fenceValue);
 
     // Descriptors
@@ -87,7 +89,9 @@ protected:
     // Gpu dependency functions
     void waitOnGpuForGpuUpload(CommandQueue &queue);
     void uploadToGPU(ApplicationImpl &application, const void *data, UINT rowPitch, UINT slicePitch);
+    void uploadToGPU(ApplicationImpl &application, const D3D12_SUBRESOURCE_DATA *subresourcesData, UINT subresourcesCount);
     void recordGpuUploadCommands(ID3D12DevicePtr device, CommandList &commandList, const void *data, UINT rowPitch, UINT slicePitch);
+    void recordGpuUploadCommands(ID3D12DevicePtr device, CommandList &commandList, const D3D12_SUBRESOURCE_DATA *subresourcesData, UINT subresourcesCount);
 
 private:
     // helpers
@@ -4,6 +4,7 @@
 #include "CommandList/CommandList.h"
 #include "CommandList/CommandQueue.h"
 #include "ConstantBuffers/ConstantBuffers.h"
+#include "Resource/CookedTexture.h"
 #include "Threading/EventImpl.inl"
 #include "Utility/DxgiFormatHelper.h"
 #include "Utility/FileHelper.h"
@@ -14,38 +15,65 @@
 #include <ExternalHeaders/Wrappers/d3dx12.h>
 #include <cassert>
 #include <cstdlib>
+#include <vector>
 
 // ----------------------------------------------------------------- Creation and destruction
 
 namespace DXD {
 
 std::unique_ptr<Texture> Texture::loadFromFileSynchronously(const std::wstring &filePath, DXD::Texture::TextureType type, Texture::TextureLoadResult *loadResult) {
-    return std::unique_ptr<Texture>(new TextureImpl(filePath, type, loadResult));
+    return std::unique_ptr<Texture>(new TextureHandle(TextureImpl::loadSynchronously(filePath, type, loadResult)));
 }
 
-std::unique_ptr<Texture> Texture::loadFromFileAsynchronously(const std::wstring &filePath, DXD::Texture::TextureType type, Texture::TextureLoadEvent *loadEvent) {
-    return std::unique_ptr<Texture>(new TextureImpl(filePath, type, loadEvent));
+std::unique_ptr<Texture> Texture::loadFromFileAsynchronously(const std::wstring &filePath, DXD::Texture::TextureType type, Texture::TextureLoadEvent *loadEvent,
+                                                             LoadPriority priority) {
+    return std::unique_ptr<Texture>(new TextureHandle(TextureImpl::loadAsynchronously(filePath, type, loadEvent, priority)));
 }
 
 template std::unique_ptr<Event<Texture::TextureLoadResult>> Event<Texture::TextureLoadResult>::create();
 } // namespace DXD
 
-TextureImpl::TextureImpl(const std::wstring &filePath, DXD::Texture::TextureType type, TextureLoadEvent *loadEvent)
+TextureImpl::TextureImpl()
     : loadOperation(*this) {
-    const TextureCpuLoadArgs args{filePath, type};
-    loadOperation.runAsynchronously(args, loadEvent);
-}
-
-TextureImpl::TextureImpl(const std::wstring &filePath, DXD::Texture::TextureType type, TextureLoadResult *loadResult)
-    : loadOperation(*this) {
-    const TextureCpuLoadArgs args{filePath, type};
-    loadOperation.runSynchronously(args, loadResult);
 }
 
 TextureImpl::~TextureImpl() {
     loadOperation.terminate(true);
 }
 
+// ----------------------------------------------------------------- Shared instances
+
+std::shared_ptr<TextureImpl> TextureImpl::loadSynchronously(const std::wstring &filePath, DXD::Texture::TextureType type, DXD::Texture::TextureLoadResult *loadResult) {
+    bool created{};
+    std::shared_ptr<TextureImpl> texture = acquire(filePath, type, created);
+    if (created) {
+        texture->loadOperation.runSynchronously(TextureCpuLoadArgs{filePath, type}, loadResult);
+    } else {
+        texture->loadOperation.attachSynchronously(loadResult);
+    }
+    return texture;
+}
+
+std::shared_ptr<TextureImpl> TextureImpl::loadAsynchronously(const std::wstring &filePath, DXD::Texture::TextureType type, DXD::Texture::TextureLoadEvent *loadEvent,
+                                                             DXD::LoadPriority priority) {
+    bool created{};
+    std::shared_ptr<TextureImpl> texture = acquire(filePath, type, created);
+    if (created) {
+        texture->loadOperation.runAsynchronously(TextureCpuLoadArgs{filePath, type}, loadEvent, priority);
+    } else {
+        texture->loadOperation.attachAsynchronously(loadEvent, priority);
+    }
+    return texture;
+}
+
+std::shared_ptr<TextureImpl> TextureImpl::acquire(const std::wstring &filePath, DXD::Texture::TextureType type, bool &outCreated) {
+    // Type is a part of the key, because it affects format of the texture. Failed loads are retried, the file may have been fixed
+    const AssetCache<TextureImpl>::Key key{FileHelper::getCanonicalPath(std::wstring{RESOURCES_PATH} + filePath), static_cast<UINT>(type)};
+    auto factory = []() { return std::make_shared<TextureImpl>(); };
+    auto isReusable = [](const TextureImpl &texture) { return !texture.loadOperation.hasFailed(); };
+    return ApplicationImpl::getInstance().getTextureCache().getOrCreate(key, factory, isReusable, outCreated);
+}
+
 // ----------------------------------------------------------------- Accessors
 
 bool TextureImpl::isReady() {
@@ -61,34 +89,27 @@ TextureImpl::TextureCpuLoadResult TextureImpl::TextureLoadCpuGpuOperation::cpuLo
         return TextureCpuLoadResult{DXD::Texture::TextureLoadResult::WRONG_FILENAME};
     }
 
-    // Load image
-    TextureCpuLoadResult result = {};
-    const auto extension = FileHelper::getExtension(args.filePath, true);
-    if (extension == L"tga") {
-        throwIfFailed(DirectX::LoadFromTGAFile(
-            fullFilePath.c_str(),
-            &result.metadata,
-            result.scratchImage));
-    } else if (extension == L"dds") {
-        throwIfFailed(DirectX::LoadFromDDSFile(
-            fullFilePath.c_str(),
-            DirectX::DDS_FLAGS_FORCE_RGB,
-            &result.metadata,
-            result.scratchImage));
-    } else if (extension == L"hdr") {
-        throwIfFailed(DirectX::LoadFromHDRFile(
-            fullFilePath.c_str(),
-            &result.metadata,
-            result.scratchImage));
-    } else if (extension == L"jpg" || extension == L"png" || extension == L"bmp") {
-        throwIfFailed(DirectX::LoadFromWICFile(
-            fullFilePath.c_str(),
-            DirectX::WIC_FLAGS_FORCE_RGB,
-            &result.metadata,
-            result.scratchImage));
-    } else {
-        UNREACHABLE_CODE();
+    // Use texture prepared by the asset cooker, if it's up to date
+    const UINT cookedTextureLoadFlags = static_cast<UINT>(args.type);
+    CookedMeshSource cookedTextureSource{};
+    if (CookedMesh::querySource(fullFilePath, cookedTextureLoadFlags, cookedTextureSource)) {
+        auto cookedTexture = std::make_unique<CookedTexture>(CookedTexture::getPath(fullFilePath, args.type), cookedTextureSource);
+        if (cookedTexture->isValid()) {
+            const CookedTextureHeader &header = cookedTexture->getHeader();
+            texture.description = CD3DX12_RESOURCE_DESC::Tex2D(static_cast<DXGI_FORMAT>(header.format), header.width, header.height,
+                                                               1u, static_cast<UINT16>(header.mipLevels));
+            TextureCpuLoadResult result{DXD::Texture::TextureLoadResult::SUCCESS};
+            result.cookedTexture = std::move(cookedTexture);
+            return std::move(result);
+        }
+    }
+
+    // Load image, decoding is the longest part, so skip it if the texture is no longer needed
+    if (isCpuLoadTerminated()) {
+        return TextureCpuLoadResult{DXD::Texture::TextureLoadResult::TERMINATED};
     }
+    TextureCpuLoadResult result = {};
+    throwIfFailed(CookedTexture::loadSourceImage(fullFilePath, result.metadata, result.scratchImage));
 
     // Compute resource description
     texture.description = TextureImpl::createTextureDescription(result.metadata);
@@ -116,10 +137,16 @@ void TextureImpl::TextureLoadCpuGpuOperation::gpuLoad(const TextureImpl::Texture
                         D3D12_RESOURCE_STATE_COPY_DEST, texture.description.MipLevels);
     texture.description.Format = realFormat;
 
-    // Upload data to the GPU resource
-    texture.uploadToGPU(application, args.scratchImage.GetPixels(),
-                        static_cast<UINT>(args.scratchImage.GetImages()->rowPitch),
-                        static_cast<UINT>(args.scratchImage.GetImages()->slicePitch));
+    // Upload data to the GPU resource, cooked textures contain all of their mips
+    if (args.cookedTexture) {
+        std::vector<D3D12_SUBRESOURCE_DATA> subresourcesData{};
+        args.cookedTexture->getSubresources(subresourcesData);
+        texture.uploadToGPU(application, subresourcesData.data(), static_cast<UINT>(subresourcesData.size()));
+    } else {
+        texture.uploadToGPU(application, args.scratchImage.GetPixels(),
+                            static_cast<UINT>(args.scratchImage.GetImages()->rowPitch),
+                            static_cast<UINT>(args.scratchImage.GetImages()->slicePitch));
+    }
 
     // Create SRV
     D3D12_SHADER_RESOURCE_VIEW_DESC srvDescription = {};
@@ -132,7 +159,7 @@ void TextureImpl::TextureLoadCpuGpuOperation::gpuLoad(const TextureImpl::Texture
     srvDescription.Texture2D.ResourceMinLODClamp = 0;
     texture.createSrv(&srvDescription);
 
-    if (texture.description.MipLevels > 1u) {
+    if (texture.description.MipLevels > 1u && !args.cookedTexture) {
         assert(texture.description.Dimension == D3D12_RESOURCE_DIMENSION_TEXTURE2D);
         texture.generateMips();
     }
@@ -142,6 +169,10 @@ bool TextureImpl::TextureLoadCpuGpuOperation::hasGpuLoadEnded() {
     return !texture.isWaitingForGpuDependencies();
 }
 
+bool TextureImpl::TextureLoadCpuGpuOperation::waitForGpuLoad(std::chrono::milliseconds timeout) {
+    return texture.waitOnCpuForGpuDependencies(timeout);
+}
+
 DXD::Texture::TextureLoadResult TextureImpl::TextureLoadCpuGpuOperation::getOperationResult(const TextureCpuLoadResult &cpuLoadResult) const {
     return cpuLoadResult.result;
 }
@@ -2,26 +2,36 @@
 
 #include "Descriptor/DescriptorAllocation.h"
 #include "DirectXTex/DirectXTex/DirectXTex.h"
+#include "Resource/CookedTexture.h"
 #include "Resource/Resource.h"
 #include "Threading/CpuGpuOperation.h"
 
 #include <DXD/ExternalHeadersWrappers/d3d12.h>
 #include <DXD/Texture.h>
 #include <atomic>
+#include <memory>
 
 class ApplicationImpl;
 
-class TextureImpl : public DXD::Texture, public Resource {
+/// \brief Texture shared by all DXD::Texture instances loaded from the same file with the same type
+///
+/// Instances are registered in the texture cache of ApplicationImpl. Requests for a texture which is already
+/// loaded or being loaded attach to its existing load operation instead of decoding and uploading it again.
+class TextureImpl : public Resource {
 public:
-    bool isReady();
-
-protected:
-    friend class DXD::Texture;
-    TextureImpl(const std::wstring &filePath, DXD::Texture::TextureType type, TextureLoadEvent *loadEvent);
-    TextureImpl(const std::wstring &filePath, DXD::Texture::TextureType type, TextureLoadResult *loadResult);
+    TextureImpl();
     ~TextureImpl() override;
 
+    // Shared instances
+    static std::shared_ptr<TextureImpl> loadSynchronously(const std::wstring &filePath, DXD::Texture::TextureType type, DXD::Texture::TextureLoadResult *loadResult);
+    static std::shared_ptr<TextureImpl> loadAsynchronously(const std::wstring &filePath, DXD::Texture::TextureType type, DXD::Texture::TextureLoadEvent *loadEvent,
+                                                            DXD::LoadPriority priority);
+
+    bool isReady();
+
 private:
+    static std::shared_ptr<TextureImpl> acquire(const std::wstring &filePath, DXD::Texture::TextureType type, bool &outCreated);
+
     // Helpers
     static D3D12_RESOURCE_DESC createTextureDescription(const DirectX::TexMetadata &metadata);
     static uint16_t computeMaxMipsCount(size_t width, size_t height);
@@ -40,6 +50,7 @@ private:
         DXD::Texture::TextureLoadResult result = {};
         DirectX::TexMetadata metadata = {};
         DirectX::ScratchImage scratchImage = {};
+        std::unique_ptr<CookedTexture> cookedTexture = {}; // if present, mips are uploaded directly from the mapped file
     };
 
     class TextureLoadCpuGpuOperation : public CpuGpuOperation<TextureCpuLoadArgs, TextureCpuLoadResult, DXD::Texture::TextureLoadResult> {
@@ -51,6 +62,7 @@ private:
         bool isCpuLoadSuccessful(const TextureCpuLoadResult &cpuLoadResult) override;
         void gpuLoad(const TextureCpuLoadResult &args) override;
         bool hasGpuLoadEnded() override;
+        bool waitForGpuLoad(std::chrono::milliseconds timeout) override;
         DXD::Texture::TextureLoadResult getOperationResult(const TextureCpuLoadResult &cpuLoadResult) const override;
 
     private:
@@ -62,3 +74,18 @@ private:
     D3D12_RESOURCE_DESC description = {};
     std::wstring fileName = {};
 };
+
+/// \brief Implementation of DXD::Texture returned to the application
+///
+/// Many handles can share one TextureImpl, which is destroyed along with the last handle or engine object using it.
+class TextureHandle : public DXD::Texture {
+public:
+    TextureHandle(const std::shared_ptr<TextureImpl> &texture) : texture(texture) {}
+
+    static std::shared_ptr<TextureImpl> getTextureImpl(DXD::Texture *texture) {
+        return texture != nullptr ? static_cast<TextureHandle *>(texture)->texture : nullptr;
+    }
+
+private:
+    std::shared_ptr<TextureImpl> texture;
+};
@@ -4,6 +4,8 @@
 #include "Resource/Resource.h"
 
 #include <DXD/ExternalHeadersWrappers/d3d12.h>
+#include <cassert>
+#include <vector>
 
 // ---------------------------------------------------------------------------------------------------------------- Template class handling index or vertex buffer
 
@@ -40,6 +42,23 @@ public:
     }
     const auto &getView() const { return view; }
 
+    /// Selects the narrowest format able to address all vertices. Index 0xFFFF is never used, so
+    /// it cannot be interpreted as a strip cut value. Used by meshes suballocating indices from GeometryPool
+    static DXGI_FORMAT selectFormat(UINT verticesCount) {
+        return verticesCount <= 0xFFFF ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
+    }
+    static UINT getIndexSize(DXGI_FORMAT format) {
+        return format == DXGI_FORMAT_R16_UINT ? sizeof(UINT16) : sizeof(UINT);
+    }
+    static std::vector<UINT16> narrowIndices(const UINT *indices, UINT indicesCount) {
+        std::vector<UINT16> result(indicesCount);
+        for (auto i = 0u; i < indicesCount; i++) {
+            assert(indices[i] <= 0xFFFF);
+            result[i] = static_cast<UINT16>(indices[i]);
+        }
+        return result;
+    }
+
 private:
     D3D12_INDEX_BUFFER_VIEW view = {};
 };
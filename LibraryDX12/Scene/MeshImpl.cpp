@@ -2,13 +2,27 @@
 
 #include "Application/ApplicationImpl.h"
 #include "CommandList/CommandList.h"
+#include "Geometry/MeshOptimizer.h"
+#include "Geometry/MeshSimplifier.h"
+#include "Geometry/MeshletBuilder.h"
+#include "Geometry/MeshWelder.h"
+#include "Geometry/TangentSpaceGenerator.h"
+#include "Geometry/VertexLayoutConverter.h"
+#include "Geometry/VertexQuantizer.h"
 #include "Threading/EventImpl.inl"
+#include "Threading/TaskGraph.h"
+#include "Utility/FileHelper.h"
+#include "Utility/MemoryMappedFile.h"
 #include "Utility/ThrowIfFailed.h"
 
+#include "DXD/Logger.h"
+
 #include <algorithm>
+#include <atomic>
 #include <cassert>
-#include <fstream>
-#include <sstream>
+#include <cstring>
+#include <functional>
+#include <limits>
 #include <string>
 
 // ----------------------------------------------------------------- Creation and destruction
@@ -16,47 +30,333 @@
 namespace DXD {
 
 std::unique_ptr<Mesh> Mesh::createFromObjSynchronously(const std::wstring &filePath, bool loadTextureCoordinates,
-                                                       bool computeTangents, Mesh::ObjLoadResult *loadResult) {
-    return std::unique_ptr<Mesh>(new MeshImpl(filePath, loadTextureCoordinates, computeTangents, loadResult));
+                                                       bool computeTangents, Mesh::ObjLoadResult *loadResult,
+                                                       bool optimizeVertexOrder, bool smoothNormalsAndTangents, bool quantizeVertices, bool generateLods) {
+    const MeshCpuLoadArgs args{filePath, loadTextureCoordinates, computeTangents, optimizeVertexOrder, smoothNormalsAndTangents, quantizeVertices, generateLods};
+    return std::unique_ptr<Mesh>(new MeshHandle(MeshImpl::loadSynchronously(args, loadResult)));
 }
 std::unique_ptr<Mesh> Mesh::createFromObjAsynchronously(const std::wstring &filePath, bool loadTextureCoordinates,
-                                                        bool computeTangents, Mesh::ObjLoadEvent *loadEvent) {
-    return std::unique_ptr<Mesh>(new MeshImpl(filePath, loadTextureCoordinates, computeTangents, loadEvent));
+                                                        bool computeTangents, Mesh::ObjLoadEvent *loadEvent,
+                                                        bool optimizeVertexOrder, bool smoothNormalsAndTangents, bool quantizeVertices, bool generateLods,
+                                                        LoadPriority priority) {
+    const MeshCpuLoadArgs args{filePath, loadTextureCoordinates, computeTangents, optimizeVertexOrder, smoothNormalsAndTangents, quantizeVertices, generateLods};
+    return std::unique_ptr<Mesh>(new MeshHandle(MeshImpl::loadAsynchronously(args, loadEvent, priority)));
+}
+
+std::unique_ptr<Mesh> Mesh::createFromGltfSynchronously(const std::wstring &filePath, bool loadTextureCoordinates,
+                                                        bool computeTangents, Mesh::GltfLoadResult *loadResult) {
+    const GltfCpuLoadArgs args{filePath, loadTextureCoordinates, computeTangents};
+    return std::unique_ptr<Mesh>(new MeshHandle(MeshImpl::loadSynchronously(args, loadResult)));
+}
+std::unique_ptr<Mesh> Mesh::createFromGltfAsynchronously(const std::wstring &filePath, bool loadTextureCoordinates,
+                                                         bool computeTangents, Mesh::GltfLoadEvent *loadEvent, LoadPriority priority) {
+    const GltfCpuLoadArgs args{filePath, loadTextureCoordinates, computeTangents};
+    return std::unique_ptr<Mesh>(new MeshHandle(MeshImpl::loadAsynchronously(args, loadEvent, priority)));
+}
+
+std::unique_ptr<Mesh> Mesh::createFromMemorySynchronously(const void *vertices, UINT verticesCount, const VertexLayout &vertexLayout,
+                                                          const UINT *indices, UINT indicesCount, Mesh::MemoryLoadResult *loadResult) {
+    const MemoryCpuLoadArgs args{vertices, verticesCount, vertexLayout, indices, indicesCount};
+    return std::unique_ptr<Mesh>(new MeshHandle(MeshImpl::loadSynchronously(args, loadResult)));
+}
+std::unique_ptr<Mesh> Mesh::createFromMemoryAsynchronously(const void *vertices, UINT verticesCount, const VertexLayout &vertexLayout,
+                                                           const UINT *indices, UINT indicesCount, Mesh::MemoryLoadEvent *loadEvent,
+                                                           LoadPriority priority) {
+    const MemoryCpuLoadArgs args{vertices, verticesCount, vertexLayout, indices, indicesCount};
+    return std::unique_ptr<Mesh>(new MeshHandle(MeshImpl::loadAsynchronously(args, loadEvent, priority)));
+}
+std::unique_ptr<Mesh> Mesh::createFromMemoryAsynchronously(std::vector<FLOAT> &&vertices, const VertexLayout &vertexLayout,
+                                                           std::vector<UINT> &&indices, Mesh::MemoryLoadEvent *loadEvent,
+                                                           LoadPriority priority) {
+    auto ownedVertexElements = std::make_shared<const std::vector<FLOAT>>(std::move(vertices));
+    auto ownedIndices = std::make_shared<const std::vector<UINT>>(std::move(indices));
+    const auto verticesCount = vertexLayout.strideInBytes == 0u ? 0u : static_cast<UINT>(ownedVertexElements->size() * sizeof(FLOAT) / vertexLayout.strideInBytes);
+    const MemoryCpuLoadArgs args{ownedVertexElements->data(), verticesCount, vertexLayout, ownedIndices->data(), static_cast<UINT>(ownedIndices->size()),
+                                 ownedVertexElements, ownedIndices};
+    return std::unique_ptr<Mesh>(new MeshHandle(MeshImpl::loadAsynchronously(args, loadEvent, priority)));
 }
 
 template std::unique_ptr<Event<Mesh::ObjLoadResult>> Event<Mesh::ObjLoadResult>::create();
+template std::unique_ptr<Event<Mesh::GltfLoadResult>> Event<Mesh::GltfLoadResult>::create();
+template std::unique_ptr<Event<Mesh::MemoryLoadResult>> Event<Mesh::MemoryLoadResult>::create();
 } // namespace DXD
 
-MeshImpl::MeshImpl(const std::wstring &filePath, bool loadTextureCoordinates, bool computeTangents, DXD::Mesh::ObjLoadResult *loadResult)
-    : loadOperation(*this) {
-    const MeshCpuLoadArgs args{filePath, loadTextureCoordinates, computeTangents};
-    loadOperation.runSynchronously(args, loadResult);
+MeshImpl::~MeshImpl() {
+    if (objLoadOperation) {
+        objLoadOperation->terminate(true);
+    }
+    if (gltfLoadOperation) {
+        gltfLoadOperation->terminate(true);
+    }
+    if (memoryLoadOperation) {
+        memoryLoadOperation->terminate(true);
+    }
+
+    ApplicationImpl &application = ApplicationImpl::getInstance();
+    application.getVertexGeometryPool().free(vertexAllocation);
+    application.getVertexGeometryPool().free(positionAllocation);
+    application.getIndexGeometryPool().free(indexAllocation);
 }
 
-MeshImpl::MeshImpl(const std::wstring &filePath, bool loadTextureCoordinates, bool computeTangents, DXD::Mesh::ObjLoadEvent *loadEvent)
-    : loadOperation(*this) {
-    const MeshCpuLoadArgs args{filePath, loadTextureCoordinates, computeTangents};
-    loadOperation.runAsynchronously(args, loadEvent);
+// ----------------------------------------------------------------- Shared instances
+
+std::shared_ptr<MeshImpl> MeshImpl::loadSynchronously(const MeshCpuLoadArgs &args, DXD::Mesh::ObjLoadResult *loadResult) {
+    bool created{};
+    std::shared_ptr<MeshImpl> mesh = acquire(args.filePath, args.getCookedMeshLoadFlags(), createWithObjLoadOperation, created);
+    if (created) {
+        mesh->objLoadOperation->runSynchronously(args, loadResult);
+    } else {
+        mesh->objLoadOperation->attachSynchronously(loadResult);
+    }
+    return mesh;
 }
 
-MeshImpl::~MeshImpl() {
-    loadOperation.terminate(true);
+std::shared_ptr<MeshImpl> MeshImpl::loadAsynchronously(const MeshCpuLoadArgs &args, DXD::Mesh::ObjLoadEvent *loadEvent, DXD::LoadPriority priority) {
+    bool created{};
+    std::shared_ptr<MeshImpl> mesh = acquire(args.filePath, args.getCookedMeshLoadFlags(), createWithObjLoadOperation, created);
+    if (created) {
+        mesh->objLoadOperation->runAsynchronously(args, loadEvent, priority);
+    } else {
+        mesh->objLoadOperation->attachAsynchronously(loadEvent, priority);
+    }
+    return mesh;
+}
+
+std::shared_ptr<MeshImpl> MeshImpl::loadSynchronously(const GltfCpuLoadArgs &args, DXD::Mesh::GltfLoadResult *loadResult) {
+    bool created{};
+    std::shared_ptr<MeshImpl> mesh = acquire(args.filePath, args.getLoadFlags(), createWithGltfLoadOperation, created);
+    if (created) {
+        mesh->gltfLoadOperation->runSynchronously(args, loadResult);
+    } else {
+        mesh->gltfLoadOperation->attachSynchronously(loadResult);
+    }
+    return mesh;
+}
+
+std::shared_ptr<MeshImpl> MeshImpl::loadAsynchronously(const GltfCpuLoadArgs &args, DXD::Mesh::GltfLoadEvent *loadEvent, DXD::LoadPriority priority) {
+    bool created{};
+    std::shared_ptr<MeshImpl> mesh = acquire(args.filePath, args.getLoadFlags(), createWithGltfLoadOperation, created);
+    if (created) {
+        mesh->gltfLoadOperation->runAsynchronously(args, loadEvent, priority);
+    } else {
+        mesh->gltfLoadOperation->attachAsynchronously(loadEvent, priority);
+    }
+    return mesh;
+}
+
+std::shared_ptr<MeshImpl> MeshImpl::loadSynchronously(const MemoryCpuLoadArgs &args, DXD::Mesh::MemoryLoadResult *loadResult) {
+    std::shared_ptr<MeshImpl> mesh = createWithMemoryLoadOperation();
+    mesh->memoryLoadOperation->runSynchronously(args, loadResult);
+    return mesh;
+}
+
+std::shared_ptr<MeshImpl> MeshImpl::loadAsynchronously(const MemoryCpuLoadArgs &args, DXD::Mesh::MemoryLoadEvent *loadEvent, DXD::LoadPriority priority) {
+    std::shared_ptr<MeshImpl> mesh = createWithMemoryLoadOperation();
+    mesh->memoryLoadOperation->runAsynchronously(args, loadEvent, priority);
+    return mesh;
+}
+
+std::shared_ptr<MeshImpl> MeshImpl::acquire(const std::wstring &filePath, UINT loadFlags, const AssetCache<MeshImpl>::Factory &factory, bool &outCreated) {
+    // Meshes are shared only if they were processed in the same way. Failed loads are retried, the file may have been fixed
+    const AssetCache<MeshImpl>::Key key{FileHelper::getCanonicalPath(std::wstring{RESOURCES_PATH} + filePath), loadFlags};
+    auto isReusable = [](const MeshImpl &mesh) { return !mesh.hasLoadFailed(); };
+    return ApplicationImpl::getInstance().getMeshCache().getOrCreate(key, factory, isReusable, outCreated);
+}
+
+std::shared_ptr<MeshImpl> MeshImpl::createWithObjLoadOperation() {
+    auto mesh = std::make_shared<MeshImpl>();
+    mesh->objLoadOperation = std::make_unique<ObjLoadCpuGpuOperation>(*mesh);
+    return mesh;
+}
+
+std::shared_ptr<MeshImpl> MeshImpl::createWithGltfLoadOperation() {
+    auto mesh = std::make_shared<MeshImpl>();
+    mesh->gltfLoadOperation = std::make_unique<GltfLoadCpuGpuOperation>(*mesh);
+    return mesh;
+}
+
+std::shared_ptr<MeshImpl> MeshImpl::createWithMemoryLoadOperation() {
+    auto mesh = std::make_shared<MeshImpl>();
+    mesh->memoryLoadOperation = std::make_unique<MemoryLoadCpuGpuOperation>(*mesh);
+    return mesh;
+}
+
+bool MeshImpl::hasLoadFailed() const {
+    if (objLoadOperation) {
+        return objLoadOperation->hasFailed();
+    }
+    if (gltfLoadOperation) {
+        return gltfLoadOperation->hasFailed();
+    }
+    return memoryLoadOperation->hasFailed();
 }
 
 // ----------------------------------------------------------------- Setters for loaders
 
-void MeshImpl::setCpuData(MeshType meshType, UINT vertexSizeInBytes, UINT verticesCount, UINT indicesCount) {
+void MeshImpl::setCpuData(MeshType meshType, UINT vertexSizeInBytes, UINT verticesCount, UINT indicesCount,
+                          const FLOAT boundsMin[3], const FLOAT boundsMax[3], const FLOAT boundingSphere[4]) {
     this->meshType = meshType;
     this->vertexSizeInBytes = vertexSizeInBytes;
     this->verticesCount = verticesCount;
     this->indicesCount = indicesCount;
+    this->indexFormat = IndexBuffer::selectFormat(verticesCount);
+    this->boundsMin = XMFLOAT3{boundsMin[0], boundsMin[1], boundsMin[2]};
+    this->boundsMax = XMFLOAT3{boundsMax[0], boundsMax[1], boundsMax[2]};
+    this->boundingSphereCenter = XMFLOAT3{boundingSphere[0], boundingSphere[1], boundingSphere[2]};
+    this->boundingSphereRadius = boundingSphere[3];
     this->pipelineStateIdentifier = computePipelineStateIdentifier(meshType);
-    this->shadowMapPipelineStateIdentifier = computeShadowMapPipelineStateIdentifier(meshType);
 }
 
-void MeshImpl::setGpuData(std::unique_ptr<VertexBuffer> &vertexBuffer, std::unique_ptr<IndexBuffer> &indexBuffer) {
-    this->vertexBuffer = std::move(vertexBuffer);
-    this->indexBuffer = std::move(indexBuffer);
+void MeshImpl::setLods(std::vector<MeshLod> &&lods, std::vector<Meshlet> &&meshlets, std::vector<MeshSubmesh> &&submeshes) {
+    assert(!submeshes.empty() && lods.size() % submeshes.size() == 0);
+    this->lods = std::move(lods);
+    this->meshlets = std::move(meshlets);
+    this->submeshes = std::move(submeshes);
+}
+
+void MeshImpl::uploadGpuData(const void *vertexData, const UINT *indexData) {
+    const bool useIndexBuffer = indicesCount > 0;
+
+    // Context
+    ApplicationImpl &application = ApplicationImpl::getInstance();
+    GeometryPool &vertexPool = application.getVertexGeometryPool();
+    GeometryPool &indexPool = application.getIndexGeometryPool();
+    CommandQueue &commandQueue = application.getCopyCommandQueue();
+
+    // Depth only passes read positions from a separate stream, so they don't fetch the other attributes. Stream has
+    // the precision of the full vertices, so depth of these passes matches the depth of the geometry
+    const bool quantized = (meshType & QUANTIZED) != 0;
+    std::vector<FLOAT> positions{};
+    std::vector<UINT16> quantizedPositions{};
+    if (quantized) {
+        VertexQuantizer::extractQuantizedPositions(vertexData, verticesCount, vertexSizeInBytes, true, &boundsMin.x, &boundsMax.x, quantizedPositions);
+    } else {
+        VertexQuantizer::extractPositions(vertexData, verticesCount, vertexSizeInBytes, positions);
+    }
+    const UINT positionSizeInBytes = quantized ? 4 * sizeof(UINT16) : 3 * sizeof(FLOAT);
+    const void *positionData = quantized ? static_cast<const void *>(quantizedPositions.data()) : positions.data();
+
+    // Suballocate geometry from the shared pools
+    vertexAllocation = vertexPool.allocate(vertexSizeInBytes, verticesCount);
+    positionAllocation = vertexPool.allocate(positionSizeInBytes, verticesCount);
+    if (useIndexBuffer) {
+        indexAllocation = indexPool.allocate(IndexBuffer::getIndexSize(indexFormat), indicesCount);
+    }
+
+    // Record command list for GPU upload
+    CommandList commandList{commandQueue};
+    vertexPool.recordUploadCommands(commandList, vertexAllocation, vertexData);
+    vertexPool.recordUploadCommands(commandList, positionAllocation, positionData);
+    if (useIndexBuffer) {
+        if (indexFormat == DXGI_FORMAT_R16_UINT) {
+            indexPool.recordUploadCommands(commandList, indexAllocation, IndexBuffer::narrowIndices(indexData, indicesCount).data());
+        } else {
+            indexPool.recordUploadCommands(commandList, indexAllocation, indexData);
+        }
+    }
+    commandList.close();
+
+    // Execute and register upload status
+    const uint64_t fenceValue = commandQueue.executeCommandListAndSignal(commandList);
+    std::lock_guard<std::mutex> lock{gpuUploadDependenciesLock};
+    gpuUploadDependencies.add(commandQueue, fenceValue);
+}
+
+bool MeshImpl::isGpuDataUploaded() {
+    std::lock_guard<std::mutex> lock{gpuUploadDependenciesLock};
+    return gpuUploadDependencies.isComplete();
+}
+
+bool MeshImpl::waitForGpuDataUpload(std::chrono::milliseconds timeout) {
+    // Wait on a copy, so isGpuDataUploaded and uploads from other threads are not blocked until the timeout
+    GpuDependencies dependencies{};
+    {
+        std::lock_guard<std::mutex> lock{gpuUploadDependenciesLock};
+        dependencies.add(gpuUploadDependencies);
+    }
+    if (!dependencies.waitOnCpu(timeout)) {
+        return false;
+    }
+
+    // Dependencies added in the meantime are kept
+    std::lock_guard<std::mutex> lock{gpuUploadDependenciesLock};
+    gpuUploadDependencies.removeCompleted();
+    return true;
+}
+
+// ----------------------------------------------------------------- Getters
+
+XMFLOAT3 MeshImpl::getBoundingBoxMin() {
+    return isReady() ? boundsMin : XMFLOAT3{};
+}
+
+XMFLOAT3 MeshImpl::getBoundingBoxMax() {
+    return isReady() ? boundsMax : XMFLOAT3{};
+}
+
+XMFLOAT3 MeshImpl::getBoundingSphereCenter() {
+    return isReady() ? boundingSphereCenter : XMFLOAT3{};
+}
+
+FLOAT MeshImpl::getBoundingSphereRadius() {
+    return isReady() ? boundingSphereRadius : 0.f;
+}
+
+bool MeshImpl::isReady() {
+    if (objLoadOperation) {
+        return objLoadOperation->isReady();
+    }
+    if (gltfLoadOperation) {
+        return gltfLoadOperation->isReady();
+    }
+    return memoryLoadOperation->isReady();
+}
+
+XMMATRIX MeshImpl::getPositionDequantizationMatrix() const {
+    if (!(meshType & QUANTIZED)) {
+        return XMMatrixIdentity();
+    }
+
+    // Quantized positions are in [0, 1] range relative to the bounds
+    const XMMATRIX scale = XMMatrixScaling(boundsMax.x - boundsMin.x, boundsMax.y - boundsMin.y, boundsMax.z - boundsMin.z);
+    const XMMATRIX translation = XMMatrixTranslation(boundsMin.x, boundsMin.y, boundsMin.z);
+    return XMMatrixMultiply(scale, translation);
+}
+
+UINT MeshImpl::selectLodLevel(const XMMATRIX &modelMatrix, const XMFLOAT3 &eyePosition, FLOAT maxErrorPerDistance) const {
+    // Distance is measured to the bounding sphere, so the error is never underestimated for any part of the object
+    const XMVECTOR center = XMVector3TransformCoord(XMLoadFloat3(&boundingSphereCenter), modelMatrix);
+    const FLOAT scale = MathHelper::getMaxScale(modelMatrix);
+    const FLOAT radius = scale * boundingSphereRadius;
+    const FLOAT distance = XMVectorGetX(XMVector3Length(XMVectorSubtract(center, XMLoadFloat3(&eyePosition)))) - radius;
+
+    const auto lodLevelsCount = static_cast<UINT>(lods.size() / submeshes.size());
+    for (auto lodLevel = lodLevelsCount - 1; lodLevel > 0; lodLevel--) {
+        if (getLod(lodLevel, 0u).error * scale <= maxErrorPerDistance * distance) {
+            return lodLevel;
+        }
+    }
+    return 0u;
+}
+
+void MeshImpl::cullMeshlets(const MeshLod &lod, const XMMATRIX &modelMatrix, const XMMATRIX &viewProjectionMatrix, const XMFLOAT3 *eyePosition,
+                            std::vector<IndexRange> &outVisibleRanges) const {
+    if (lod.meshletsCount == 0u) {
+        outVisibleRanges.assign(1, IndexRange{lod.firstIndex, lod.indicesCount});
+        return;
+    }
+
+    // Meshlet bounds are in object space, so the viewpoint is transformed there instead of transforming every meshlet
+    const Meshlet *lodMeshlets = meshlets.data() + lod.firstMeshlet;
+    XMFLOAT4X4 objectToClip;
+    XMStoreFloat4x4(&objectToClip, XMMatrixMultiply(modelMatrix, viewProjectionMatrix));
+    if (eyePosition == nullptr) {
+        MeshletCuller::cull(lodMeshlets, lod.meshletsCount, objectToClip, nullptr, outVisibleRanges);
+        return;
+    }
+    const XMMATRIX worldToObject = XMMatrixInverse(nullptr, modelMatrix);
+    const XMFLOAT3 eyePositionInObjectSpace = XMStoreFloat3(XMVector3TransformCoord(XMLoadFloat3(eyePosition), worldToObject));
+    MeshletCuller::cull(lodMeshlets, lod.meshletsCount, objectToClip, &eyePositionInObjectSpace, outVisibleRanges);
 }
 
 // ----------------------------------------------------------------- Helpers
@@ -80,6 +380,11 @@ MeshImpl::MeshType MeshImpl::computeMeshType(const std::vector<FLOAT> &normals,
 
 UINT MeshImpl::computeVertexSize(MeshType meshType) {
     UINT vertexSize = 0;
+    if (meshType & QUANTIZED) {
+        // Every element is 16-bit, see QuantizedVertexLayout
+        const QuantizedVertexLayout layout{(meshType & TANGENTS) != 0, (meshType & TEXTURE_COORDS) != 0};
+        return layout.getQuantizedVertexSizeInElements() * sizeof(UINT16);
+    }
     if (meshType & TRIANGLE_STRIP) {
         vertexSize += 3;
     }
@@ -100,6 +405,9 @@ std::map<MeshImpl::MeshType, PipelineStateController::Identifier> MeshImpl::getP
     map[TRIANGLE_STRIP | NORMALS] = PipelineStateController::Identifier::PIPELINE_STATE_NORMAL;
     map[TRIANGLE_STRIP | NORMALS | TEXTURE_COORDS] = PipelineStateController::Identifier::PIPELINE_STATE_TEXTURE_NORMAL;
     map[TRIANGLE_STRIP | NORMALS | TEXTURE_COORDS | TANGENTS] = PipelineStateController::Identifier::PIPELINE_STATE_TEXTURE_NORMAL_MAP;
+    map[TRIANGLE_STRIP | NORMALS | QUANTIZED] = PipelineStateController::Identifier::PIPELINE_STATE_NORMAL_QUANTIZED;
+    map[TRIANGLE_STRIP | NORMALS | TEXTURE_COORDS | QUANTIZED] = PipelineStateController::Identifier::PIPELINE_STATE_TEXTURE_NORMAL_QUANTIZED;
+    map[TRIANGLE_STRIP | NORMALS | TEXTURE_COORDS | TANGENTS | QUANTIZED] = PipelineStateController::Identifier::PIPELINE_STATE_TEXTURE_NORMAL_MAP_QUANTIZED;
     return std::move(map);
 }
 
@@ -112,93 +420,110 @@ PipelineStateController::Identifier MeshImpl::computePipelineStateIdentifier(Mes
     return it->second;
 }
 
-std::map<MeshImpl::MeshType, PipelineStateController::Identifier> MeshImpl::getShadowMapPipelineStateIdentifierMap() {
-    std::map<MeshImpl::MeshType, PipelineStateController::Identifier> map = {};
-    map[TRIANGLE_STRIP | NORMALS] = PipelineStateController::Identifier::PIPELINE_STATE_SM_NORMAL;
-    map[TRIANGLE_STRIP | NORMALS | TEXTURE_COORDS] = PipelineStateController::Identifier::PIPELINE_STATE_SM_TEXTURE_NORMAL;
-    map[TRIANGLE_STRIP | NORMALS | TEXTURE_COORDS | TANGENTS] = PipelineStateController::Identifier::PIPELINE_STATE_SM_TEXTURE_NORMAL_MAP;
-    return std::move(map);
-}
+// ----------------------------------------------------------------- ObjLoadCpuGpuOperation class
 
-PipelineStateController::Identifier MeshImpl::computeShadowMapPipelineStateIdentifier(MeshType meshType) {
-    static const auto map = getShadowMapPipelineStateIdentifierMap();
-    auto it = map.find(meshType);
-    if (it == map.end()) {
-        UNREACHABLE_CODE();
-    }
-    return it->second;
+namespace {
+template <typename T>
+size_t getSizeInBytes(const std::vector<T> &vector) {
+    return vector.capacity() * sizeof(T);
 }
 
-// ----------------------------------------------------------------- ObjLoadCpuGpuOperation class
+size_t getSizeInBytes(const ObjData &objData) {
+    return getSizeInBytes(objData.positions) + getSizeInBytes(objData.normals) +
+           getSizeInBytes(objData.textureCoordinates) + getSizeInBytes(objData.faceCorners);
+}
+} // namespace
 
 MeshCpuLoadResult ObjLoadCpuGpuOperation::cpuLoad(const MeshCpuLoadArgs &args) {
+    MeshCpuLoadResult result = cook(args, ApplicationImpl::getInstance().getBackgroundWorkerController(),
+                                    [this]() { return isCpuLoadTerminated(); });
+    if (result.result != DXD::Mesh::ObjLoadResult::SUCCESS) {
+        return std::move(result);
+    }
+
+    // Set data to Mesh instance, cooked file is mapped and its data is copied, otherwise the vectors are kept for the upload
+    const CookedMeshHeader &header = result.header;
+    mesh.setCpuData(header.meshType, header.vertexSizeInBytes, header.verticesCount, header.indicesCount,
+                    header.boundsMin, header.boundsMax, header.boundingSphere);
+    if (result.cookedMesh) {
+        const CookedMesh &cookedMesh = *result.cookedMesh;
+        mesh.setLods(std::vector<MeshLod>(cookedMesh.getLodData(), cookedMesh.getLodData() + header.lodsCount),
+                     std::vector<Meshlet>(cookedMesh.getMeshletData(), cookedMesh.getMeshletData() + header.meshletsCount),
+                     std::vector<MeshSubmesh>(cookedMesh.getSubmeshData(), cookedMesh.getSubmeshData() + header.submeshesCount));
+    } else {
+        mesh.setLods(std::vector<MeshLod>(result.lods), std::vector<Meshlet>(result.meshlets), std::vector<MeshSubmesh>(result.submeshes));
+    }
+    return std::move(result);
+}
+
+MeshCpuLoadResult ObjLoadCpuGpuOperation::cook(const MeshCpuLoadArgs &args, BackgroundWorkerController &backgroundWorkerController,
+                                               const std::function<bool()> &isTerminated) {
     // Initial validation
     const auto fullFilePath = std::wstring{RESOURCES_PATH} + args.filePath;
-    std::fstream inputFile{fullFilePath, std::ios::in};
-    if (!inputFile.good()) {
+    if (!FileHelper::exists(fullFilePath)) {
         return std::move(MeshCpuLoadResult{DXD::Mesh::ObjLoadResult::WRONG_FILENAME});
     }
 
-    // Temporary variables for loading
-    std::vector<FLOAT> vertexElements;     // vertex element is e.g x coordinate of vertex position
-    std::vector<std::string> indexTokens;  // index token is a bundle of 1-based indices of vertex/normal/uv delimeted by slash, e.g. 1//2, 1/3/21
-    std::vector<FLOAT> normalCoordinates;  // normal coordinate is e.g. x coordinate of a normal vector
-    std::vector<FLOAT> textureCoordinates; // normal coordinate is e.g. u coordinate of a texture coordinate
-    std::string lineType;
-    FLOAT x, y, z;
-    std::string f1, f2, f3, f4;
-
-    // Read all lines
-    for (std::string line; getline(inputFile, line).good();) {
-        if (isCpuLoadTerminated()) {
-            return MeshCpuLoadResult{DXD::Mesh::ObjLoadResult::TERMINATED};
+    // Use results of a previous load, if they're still up to date
+    const UINT cookedMeshLoadFlags = args.getCookedMeshLoadFlags();
+    const std::wstring cookedMeshPath = CookedMesh::getPath(fullFilePath, cookedMeshLoadFlags);
+    CookedMeshSource cookedMeshSource{};
+    const bool cookedMeshSourceQueried = CookedMesh::querySource(fullFilePath, cookedMeshLoadFlags, cookedMeshSource);
+    if (cookedMeshSourceQueried) {
+        auto cookedMesh = std::make_unique<CookedMesh>(cookedMeshPath, cookedMeshSource);
+        if (cookedMesh->isValid() && isMaterialLibraryUpToDate(fullFilePath, cookedMesh->getHeader())) {
+            MeshCpuLoadResult result{DXD::Mesh::ObjLoadResult::SUCCESS};
+            result.header = cookedMesh->getHeader();
+            result.cookedMesh = std::move(cookedMesh);
+            return std::move(result);
         }
+    }
 
-        if (line.empty()) {
-            continue;
-        }
+    // Map the source file
+    const MemoryMappedFile inputFile{fullFilePath};
+    if (!inputFile.isValid()) {
+        return std::move(MeshCpuLoadResult{DXD::Mesh::ObjLoadResult::WRONG_OBJ});
+    }
 
-        std::istringstream strs(line);
-        strs >> lineType;
-
-        if (lineType == "v") { //vertices
-            strs >> x;
-            strs >> y;
-            strs >> z;
-            vertexElements.push_back(x);
-            vertexElements.push_back(y);
-            vertexElements.push_back(z);
-        } else if (lineType == "f") { //faces
-            strs >> f1;
-            strs >> f2;
-            strs >> f3;
-            indexTokens.push_back(f1);
-            indexTokens.push_back(f2);
-            indexTokens.push_back(f3);
-            if (!strs.eof()) {
-                strs >> f4;
-                if (!f4.empty()) {
-                    // Lines can and with a space, hence this check
-                    indexTokens.push_back(f1);
-                    indexTokens.push_back(f3);
-                    indexTokens.push_back(f4);
-                }
+    // Files too big to keep all of their face corners in memory are streamed. Attributes are parsed first, then faces are
+    // read again in windows and each window is turned into final vertices and indices right away
+    const bool streaming = inputFile.getSize() >= streamingLoadThreshold;
+    ObjData objData{};
+    size_t faceCornersCount = 0u;
+    size_t peakMemoryInBytes = 0u;
+    if (streaming) {
+        const DXD::Mesh::ObjLoadResult parseResult = parseAttributes(inputFile, objData, faceCornersCount, isTerminated);
+        if (parseResult != DXD::Mesh::ObjLoadResult::SUCCESS) {
+            return std::move(MeshCpuLoadResult{parseResult});
+        }
+    } else {
+        // Parse line-aligned chunks of the file in parallel, each into its own ObjData and then merge them
+        constexpr size_t minParseChunkSize = 256 * 1024;
+        const size_t maxChunksCount = backgroundWorkerController.getWorkersCount() + 1;
+        const std::vector<ObjChunk> chunks = ObjParser::splitIntoChunks(inputFile.getData(), inputFile.getDataEnd(), maxChunksCount, minParseChunkSize);
+        std::vector<ObjData> chunksData(chunks.size());
+        std::vector<DXD::Mesh::ObjLoadResult> chunksResults(chunks.size(), DXD::Mesh::ObjLoadResult::SUCCESS);
+        backgroundWorkerController.executeInParallel(static_cast<UINT>(chunks.size()), [&](UINT chunkIndex) {
+            chunksResults[chunkIndex] = parseChunk(chunks[chunkIndex], chunksData[chunkIndex], isTerminated);
+        });
+        for (DXD::Mesh::ObjLoadResult chunkResult : chunksResults) {
+            if (chunkResult != DXD::Mesh::ObjLoadResult::SUCCESS) {
+                return std::move(MeshCpuLoadResult{chunkResult});
             }
-        } else if (lineType == "vn") { //normal vector
-            strs >> x;
-            strs >> y;
-            strs >> z;
-            normalCoordinates.push_back(x);
-            normalCoordinates.push_back(y);
-            normalCoordinates.push_back(z);
-        } else if (lineType == "vt") { //texture vector
-            strs >> x;
-            strs >> y;
-            strs >> z;
-            textureCoordinates.push_back(x);
-            textureCoordinates.push_back(y);
+        }
+        ObjParser::merge(chunksData, objData);
+        faceCornersCount = objData.faceCorners.size();
+        peakMemoryInBytes = getSizeInBytes(objData);
+        for (const ObjData &chunkData : chunksData) {
+            peakMemoryInBytes += getSizeInBytes(chunkData);
         }
     }
+    const std::vector<std::string> materialNames = std::move(objData.materialNames);
+    const std::vector<ObjMaterialSwitch> materialSwitches = std::move(objData.materialSwitches);
+    const std::string materialLibrary = std::move(objData.materialLibrary);
+    const std::vector<FLOAT> &vertexElements = objData.positions;              // vertex element is e.g x coordinate of vertex position
+    const std::vector<FLOAT> &normalCoordinates = objData.normals;             // normal coordinate is e.g. x coordinate of a normal vector
+    const std::vector<FLOAT> &textureCoordinates = objData.textureCoordinates; // texture coordinate is e.g. u coordinate of a texture coordinate
 
     // Compute some fields based on lines that were read
     MeshCpuLoadResult result{DXD::Mesh::ObjLoadResult::SUCCESS};
@@ -213,75 +538,263 @@ MeshCpuLoadResult ObjLoadCpuGpuOperation::cpuLoad(const MeshCpuLoadArgs &args) {
     const bool computeNormals = meshType & MeshImpl::NORMALS && !hasNormals;
     const bool computeTangents = meshType & MeshImpl::TANGENTS;
     const bool usesIndexBuffer = !hasTextureCoordinates && !hasNormals && !computeNormals && !computeTangents;
+    const bool smoothNormals = computeNormals && args.smoothNormalsAndTangents;
+    const bool smoothTangents = computeTangents && hasTextureCoordinates && args.smoothNormalsAndTangents;
+    if (!validateFaceCorners(objData, objData.faceCorners, hasTextureCoordinates, hasNormals)) {
+        return std::move(MeshCpuLoadResult{DXD::Mesh::ObjLoadResult::WRONG_OBJ});
+    }
+
+    // Sizes of all buffers held by the loader are sampled after each step, so the peak can be reported
+    std::vector<ObjFaceCorner> faceCornersWindow{};
+    std::vector<UINT> positionIndices{};
+    std::vector<FLOAT> positionNormals{};
+    auto trackMemory = [&](size_t additionalBytes) {
+        const size_t memoryInBytes = getSizeInBytes(objData) + getSizeInBytes(faceCornersWindow) + getSizeInBytes(positionIndices) +
+                                     getSizeInBytes(positionNormals) + getSizeInBytes(result.vertexElements) +
+                                     getSizeInBytes(result.quantizedVertexElements) + getSizeInBytes(result.indices) +
+                                     getSizeInBytes(result.meshlets) + additionalBytes;
+        peakMemoryInBytes = std::max(peakMemoryInBytes, memoryInBytes);
+    };
+    trackMemory(0u);
+
+    // Face corners are either all in memory already, or parsed again from the file in windows reusing the same buffer
+    auto forEachFaceCornersWindow = [&](const std::function<void(const std::vector<ObjFaceCorner> &)> &processFaceCorners) {
+        if (!streaming) {
+            processFaceCorners(objData.faceCorners);
+            return DXD::Mesh::ObjLoadResult::SUCCESS;
+        }
+        for (const char *windowBegin = inputFile.getData(); windowBegin < inputFile.getDataEnd();) {
+            if (isTerminated()) {
+                return DXD::Mesh::ObjLoadResult::TERMINATED;
+            }
+
+            const char *windowEnd = ObjParser::findLineAlignedChunkEnd(windowBegin, inputFile.getDataEnd(), parseWindowSize);
+            faceCornersWindow.clear();
+            if (!ObjParser::parseFaces(windowBegin, windowEnd, faceCornersWindow) ||
+                !validateFaceCorners(objData, faceCornersWindow, hasTextureCoordinates, hasNormals)) {
+                return DXD::Mesh::ObjLoadResult::WRONG_OBJ;
+            }
+            processFaceCorners(faceCornersWindow);
+            windowBegin = windowEnd;
+        }
+        return DXD::Mesh::ObjLoadResult::SUCCESS;
+    };
+
     if (usesIndexBuffer) {
         // Index buffer path - vertices are unmodified, we push indices to index buffer to define polygons
-        result.vertexElements = std::move(vertexElements);
-        for (int indexTokenIndex = 0; indexTokenIndex < indexTokens.size(); indexTokenIndex += 3) {
-            UINT vertexIndices[3] = {};
-            processIndexToken(indexTokens[indexTokenIndex + 0], false, false, vertexIndices + 0, nullptr, nullptr);
-            processIndexToken(indexTokens[indexTokenIndex + 1], false, false, vertexIndices + 1, nullptr, nullptr);
-            processIndexToken(indexTokens[indexTokenIndex + 2], false, false, vertexIndices + 2, nullptr, nullptr);
-            result.indices.push_back(vertexIndices[0]);
-            result.indices.push_back(vertexIndices[1]);
-            result.indices.push_back(vertexIndices[2]);
+        result.indices.reserve(faceCornersCount);
+        const DXD::Mesh::ObjLoadResult processResult = forEachFaceCornersWindow([&](const std::vector<ObjFaceCorner> &faceCorners) {
+            for (const ObjFaceCorner &faceCorner : faceCorners) {
+                result.indices.push_back(faceCorner.position);
+            }
+        });
+        if (processResult != DXD::Mesh::ObjLoadResult::SUCCESS) {
+            return std::move(MeshCpuLoadResult{processResult});
         }
+        trackMemory(0u);
+        result.vertexElements = std::move(objData.positions);
     } else {
-        // No index buffer path - we interleave all vertex attributesm, so they're next to each other
-        for (int indexTokenIndex = 0; indexTokenIndex < indexTokens.size(); indexTokenIndex += 3) {
-            // Get all vertex attributes
-            UINT vertexIndices[3] = {};
-            UINT textureCoordinateIndices[3] = {};
-            UINT normalIndices[3] = {};
-            processIndexToken(indexTokens[indexTokenIndex + 0], hasTextureCoordinates, hasNormals, vertexIndices + 0, textureCoordinateIndices + 0, normalIndices + 0);
-            processIndexToken(indexTokens[indexTokenIndex + 1], hasTextureCoordinates, hasNormals, vertexIndices + 1, textureCoordinateIndices + 1, normalIndices + 1);
-            processIndexToken(indexTokens[indexTokenIndex + 2], hasTextureCoordinates, hasNormals, vertexIndices + 2, textureCoordinateIndices + 2, normalIndices + 2);
-
-            // If user wants per-vertex tangents, we calculate them (per triangle)
-            XMFLOAT3 computedTangent = {};
-            if (computeTangents) {
-                computeVertexTangent(vertexElements, textureCoordinates, vertexIndices, textureCoordinateIndices, computedTangent);
+        // Smooth normals are shared by all triangles using given position, so they're computed per position
+        const auto positionsCount = static_cast<UINT>(vertexElements.size() / 3);
+        if (smoothNormals) {
+            positionNormals.resize(vertexElements.size(), 0.f);
+            const DXD::Mesh::ObjLoadResult processResult = forEachFaceCornersWindow([&](const std::vector<ObjFaceCorner> &faceCorners) {
+                positionIndices.clear();
+                for (const ObjFaceCorner &faceCorner : faceCorners) {
+                    positionIndices.push_back(faceCorner.position);
+                }
+                TangentSpaceGenerator::accumulateNormals({vertexElements.data(), 3u}, positionsCount, positionIndices,
+                                                         TangentSpaceGenerator::Weighting::ANGLE, positionNormals.data());
+            });
+            if (processResult != DXD::Mesh::ObjLoadResult::SUCCESS) {
+                return std::move(MeshCpuLoadResult{processResult});
             }
+            trackMemory(0u);
+            positionIndices = {};
+            TangentSpaceGenerator::normalizeAccumulatedNormals(positionNormals.data(), positionsCount, positionNormals.data(), 3u);
+        }
 
-            // Normals are mandatory, if the obj doesn't have them, we compute from vertices positions
-            XMFLOAT3 computedNormal = {};
-            if (computeNormals) {
-                computeVertexNormal(vertexElements, vertexIndices, computedNormal);
-            }
+        // Welded path - we interleave all vertex attributes of each triangle corner, so they're next to each other and
+        // weld them right away. Corners sharing all attributes are merged, so each unique vertex is stored and transformed
+        // only once. Index count is known upfront, unique vertices count is usually close to the number of positions
+        const UINT vertexSizeInFloats = vertexSizeInBytes / sizeof(FLOAT);
+        IncrementalMeshWelder welder{vertexSizeInFloats, result.vertexElements, result.indices};
+        welder.reserve(positionsCount);
+        result.vertexElements.reserve(static_cast<size_t>(positionsCount) * vertexSizeInFloats);
+        result.indices.reserve(faceCornersCount);
+        std::vector<FLOAT> cornerVertexElements{};
+        const DXD::Mesh::ObjLoadResult processResult = forEachFaceCornersWindow([&](const std::vector<ObjFaceCorner> &faceCorners) {
+            for (size_t faceCornerIndex = 0; faceCornerIndex < faceCorners.size(); faceCornerIndex += 3) {
+                // Get all vertex attributes
+                const ObjFaceCorner *triangle = faceCorners.data() + faceCornerIndex;
+                const UINT vertexIndices[3] = {triangle[0].position, triangle[1].position, triangle[2].position};
+                const UINT textureCoordinateIndices[3] = {triangle[0].textureCoordinate, triangle[1].textureCoordinate, triangle[2].textureCoordinate};
+                const UINT normalIndices[3] = {triangle[0].normal, triangle[1].normal, triangle[2].normal};
 
-            // Append interleaved attributes to the vertex buffer memory
-            for (int vertexInTriangleIndex = 0; vertexInTriangleIndex < 3; vertexInTriangleIndex++) {
-                result.vertexElements.push_back(vertexElements[3 * (vertexIndices[vertexInTriangleIndex]) + 0]);
-                result.vertexElements.push_back(vertexElements[3 * (vertexIndices[vertexInTriangleIndex]) + 1]);
-                result.vertexElements.push_back(vertexElements[3 * (vertexIndices[vertexInTriangleIndex]) + 2]);
-                if (computeNormals) {
-                    result.vertexElements.push_back(computedNormal.x);
-                    result.vertexElements.push_back(computedNormal.y);
-                    result.vertexElements.push_back(computedNormal.z);
+                // If user wants per-vertex tangents, we calculate them (per triangle, unless they're smoothed after welding)
+                XMFLOAT3 computedTangent = {};
+                if (computeTangents && !smoothTangents) {
+                    computeVertexTangent(vertexElements, textureCoordinates, vertexIndices, textureCoordinateIndices, computedTangent);
                 }
-                if (hasNormals) {
-                    result.vertexElements.push_back(normalCoordinates[3 * (normalIndices[vertexInTriangleIndex]) + 0]);
-                    result.vertexElements.push_back(normalCoordinates[3 * (normalIndices[vertexInTriangleIndex]) + 1]);
-                    result.vertexElements.push_back(normalCoordinates[3 * (normalIndices[vertexInTriangleIndex]) + 2]);
-                }
-                if (computeTangents) {
-                    result.vertexElements.push_back(computedTangent.x);
-                    result.vertexElements.push_back(computedTangent.y);
-                    result.vertexElements.push_back(computedTangent.z);
+
+                // Normals are mandatory, if the obj doesn't have them, we compute from vertices positions
+                XMFLOAT3 computedNormal = {};
+                if (computeNormals && !smoothNormals) {
+                    computeVertexNormal(vertexElements, vertexIndices, computedNormal);
                 }
-                if (hasTextureCoordinates) {
-                    result.vertexElements.push_back(textureCoordinates[2 * (textureCoordinateIndices[vertexInTriangleIndex]) + 0]);
-                    result.vertexElements.push_back(textureCoordinates[2 * (textureCoordinateIndices[vertexInTriangleIndex]) + 1]);
+
+                // Interleave attributes of the triangle corners and pass them to the welder
+                cornerVertexElements.clear();
+                for (int vertexInTriangleIndex = 0; vertexInTriangleIndex < 3; vertexInTriangleIndex++) {
+                    cornerVertexElements.push_back(vertexElements[3 * (vertexIndices[vertexInTriangleIndex]) + 0]);
+                    cornerVertexElements.push_back(vertexElements[3 * (vertexIndices[vertexInTriangleIndex]) + 1]);
+                    cornerVertexElements.push_back(vertexElements[3 * (vertexIndices[vertexInTriangleIndex]) + 2]);
+                    if (smoothNormals) {
+                        cornerVertexElements.push_back(positionNormals[3 * (vertexIndices[vertexInTriangleIndex]) + 0]);
+                        cornerVertexElements.push_back(positionNormals[3 * (vertexIndices[vertexInTriangleIndex]) + 1]);
+                        cornerVertexElements.push_back(positionNormals[3 * (vertexIndices[vertexInTriangleIndex]) + 2]);
+                    } else if (computeNormals) {
+                        cornerVertexElements.push_back(computedNormal.x);
+                        cornerVertexElements.push_back(computedNormal.y);
+                        cornerVertexElements.push_back(computedNormal.z);
+                    }
+                    if (hasNormals) {
+                        cornerVertexElements.push_back(normalCoordinates[3 * (normalIndices[vertexInTriangleIndex]) + 0]);
+                        cornerVertexElements.push_back(normalCoordinates[3 * (normalIndices[vertexInTriangleIndex]) + 1]);
+                        cornerVertexElements.push_back(normalCoordinates[3 * (normalIndices[vertexInTriangleIndex]) + 2]);
+                    }
+                    if (computeTangents) {
+                        cornerVertexElements.push_back(computedTangent.x);
+                        cornerVertexElements.push_back(computedTangent.y);
+                        cornerVertexElements.push_back(computedTangent.z);
+                    }
+                    if (hasTextureCoordinates) {
+                        cornerVertexElements.push_back(textureCoordinates[2 * (textureCoordinateIndices[vertexInTriangleIndex]) + 0]);
+                        cornerVertexElements.push_back(textureCoordinates[2 * (textureCoordinateIndices[vertexInTriangleIndex]) + 1]);
+                    }
+                    welder.addVertex(cornerVertexElements.data() + vertexInTriangleIndex * vertexSizeInFloats);
                 }
             }
+            trackMemory(welder.getHashTableSizeInBytes());
+        });
+        if (processResult != DXD::Mesh::ObjLoadResult::SUCCESS) {
+            return std::move(MeshCpuLoadResult{processResult});
+        }
+
+        // Attributes are no longer needed, everything is in the welded vertices now
+        objData = {};
+        faceCornersWindow = {};
+        positionNormals = {};
+
+        // Smooth tangents were left zeroed, so corners differing only by them got welded. Now we can accumulate them per vertex
+        if (smoothTangents) {
+            if (isTerminated()) {
+                return std::move(MeshCpuLoadResult{DXD::Mesh::ObjLoadResult::TERMINATED});
+            }
+            computeSmoothTangents(vertexSizeInBytes, result);
+        }
+    }
+
+    // Triangles of each material are moved together, so a submesh is drawn with one call. Processing below
+    // never moves triangles between material groups
+    std::vector<ObjMaterialGroup> materialGroups{};
+    ObjParser::groupTrianglesByMaterial(materialSwitches, static_cast<UINT>(materialNames.size()), result.indices, materialGroups);
+    if (materialGroups.empty()) {
+        materialGroups.push_back(ObjMaterialGroup{ObjMaterialSwitch::noMaterial, 0u, 0u});
+    }
+    const std::wstring materialLibraryPath = materialLibrary.empty() ? std::wstring{} : getMaterialLibraryPath(fullFilePath, materialLibrary);
+
+    // Remaining processing is a graph of stages, independent ones overlap on the background workers. Materials
+    // are read while the geometry is processed. Bounds only read the vertices, so they're computed and vertices are
+    // quantized while levels of detail are generated. Stages check for termination before starting
+    std::atomic_bool terminated = false;
+    TaskGraph stages{backgroundWorkerController};
+    auto addStage = [&](auto work) {
+        return stages.addNode([&terminated, &isTerminated, work]() {
+            if (terminated.load() || isTerminated()) {
+                terminated.store(true);
+                return;
+            }
+            work();
+        });
+    };
+
+    addStage([&]() { loadMaterials(materialLibraryPath, materialNames, materialGroups, result.submeshes); });
+
+    // Reorder triangles and vertices for better GPU efficiency
+    const auto optimizeStage = addStage([&]() {
+        if (args.optimizeVertexOrder) {
+            optimizeVertexOrder(args.filePath, vertexSizeInBytes, materialGroups, result);
+        }
+    });
+
+    // Append simplified levels of detail to the index buffer and split each level into meshlets
+    const auto lodsStage = addStage([&]() { generateLods(args, vertexSizeInBytes, materialGroups, result); });
+
+    // Bounds are computed from float positions, quantized positions are relative to them
+    UINT verticesCount = 0u;
+    FLOAT boundsMin[3] = {};
+    FLOAT boundsMax[3] = {};
+    FLOAT boundingSphere[4] = {};
+    const auto boundsStage = addStage([&]() {
+        verticesCount = static_cast<UINT>(result.vertexElements.size() * sizeof(FLOAT) / vertexSizeInBytes);
+        CookedMesh::computeBounds(result.vertexElements.data(), verticesCount, vertexSizeInBytes, boundsMin, boundsMax);
+        CookedMesh::computeBoundingSphere(result.vertexElements.data(), verticesCount, vertexSizeInBytes, boundsMin, boundsMax, boundingSphere);
+    });
+
+    // Compress vertex attributes to 16-bit formats
+    const auto quantizeStage = addStage([&]() {
+        if (args.quantizeVertices) {
+            const QuantizedVertexLayout layout{computeTangents, hasTextureCoordinates};
+            VertexQuantizer::quantizeVertices(result.vertexElements, layout, boundsMin, boundsMax, result.quantizedVertexElements);
         }
+    });
+
+    stages.addDependency(optimizeStage, lodsStage);
+    stages.addDependency(optimizeStage, boundsStage);
+    stages.addDependency(boundsStage, quantizeStage);
+    stages.runAndWait();
+    if (terminated.load()) {
+        return std::move(MeshCpuLoadResult{DXD::Mesh::ObjLoadResult::TERMINATED});
     }
 
-    // Set data to Mesh instance
-    const auto verticesCount = static_cast<UINT>(result.vertexElements.size() * sizeof(FLOAT) / vertexSizeInBytes);
+    // Buffers of all stages are alive at this point, which is the peak of the processing
+    trackMemory(0u);
     const auto indicesCount = static_cast<UINT>(result.indices.size());
-    mesh.setCpuData(meshType, vertexSizeInBytes, verticesCount, indicesCount);
+    MeshImpl::MeshType finalMeshType = meshType;
+    UINT finalVertexSizeInBytes = vertexSizeInBytes;
+    if (args.quantizeVertices) {
+        result.vertexElements = {};
+        finalMeshType |= MeshImpl::QUANTIZED;
+        finalVertexSizeInBytes = MeshImpl::computeVertexSize(finalMeshType);
+    }
+
+    // Describe the results, the header is what the mesh is set up from
+    CookedMeshHeader &header = result.header;
+    header = CookedMeshHeader{CookedMeshHeader::expectedMagic, CookedMeshHeader::currentVersion, cookedMeshSource,
+                              finalMeshType, finalVertexSizeInBytes, verticesCount, indicesCount};
+    header.meshletsCount = static_cast<UINT>(result.meshlets.size());
+    header.lodsCount = static_cast<UINT>(result.lods.size());
+    header.submeshesCount = static_cast<UINT>(result.submeshes.size());
+    std::copy(boundsMin, boundsMin + 3, header.boundsMin);
+    std::copy(boundsMax, boundsMax + 3, header.boundsMax);
+    std::copy(boundingSphere, boundingSphere + 4, header.boundingSphere);
+
+    // Save results, so next loads can skip parsing and processing. Materials are baked into the submeshes, so
+    // the file can be used only as long as their library is unchanged
+    const bool materialLibraryQueried = materialLibrary.empty() ||
+                                        (materialLibrary.size() < sizeof(header.materialLibrary) &&
+                                         CookedMesh::querySource(materialLibraryPath, 0u, header.materialLibrarySource));
+    if (cookedMeshSourceQueried && materialLibraryQueried) {
+        std::copy(materialLibrary.begin(), materialLibrary.end(), header.materialLibrary);
+        CookedMesh::write(cookedMeshPath, header, result.getVertexData(), result.indices.data(), result.meshlets.data(), result.lods.data(),
+                          result.submeshes.data());
+    }
 
     // Return load results
+    DXD::log("Loaded %ls%ls: %u vertices, %u indices, %u submeshes, peak memory of loader buffers %.1f MB\n", args.filePath.c_str(),
+             streaming ? L" in streaming mode" : L"", verticesCount, indicesCount, static_cast<UINT>(result.submeshes.size()),
+             peakMemoryInBytes / (1024.0 * 1024.0));
     return std::move(result);
 }
 
@@ -290,67 +803,237 @@ bool ObjLoadCpuGpuOperation::isCpuLoadSuccessful(const MeshCpuLoadResult &result
 }
 
 void ObjLoadCpuGpuOperation::gpuLoad(const MeshCpuLoadResult &args) {
-    const bool useIndexBuffer = args.indices.size() > 0;
+    mesh.uploadGpuData(args.getVertexData(), args.getIndexData());
+}
 
-    // Context
-    ApplicationImpl &application = ApplicationImpl::getInstance();
-    ID3D12DevicePtr device = application.getDevice();
-    CommandQueue &commandQueue = application.getCopyCommandQueue();
+bool ObjLoadCpuGpuOperation::hasGpuLoadEnded() {
+    return mesh.isGpuDataUploaded();
+}
 
-    // Record command list for GPU upload
-    CommandList commandList{commandQueue};
-    std::unique_ptr<VertexBuffer> vertexBuffer = std::make_unique<VertexBuffer>(device, commandList, args.vertexElements.data(),
-                                                                                mesh.getVerticesCount(), mesh.getVertexSizeInBytes());
-    std::unique_ptr<IndexBuffer> indexBuffer{};
-    if (useIndexBuffer) {
-        indexBuffer = std::make_unique<IndexBuffer>(device, commandList, args.indices.data(), static_cast<UINT>(args.indices.size()));
-    }
-    commandList.close();
+bool ObjLoadCpuGpuOperation::waitForGpuLoad(std::chrono::milliseconds timeout) {
+    return mesh.waitForGpuDataUpload(timeout);
+}
 
-    // Execute and register obtained allocator and lists to the manager
-    const uint64_t fenceValue = commandQueue.executeCommandListAndSignal(commandList);
+DXD::Mesh::ObjLoadResult ObjLoadCpuGpuOperation::getOperationResult(const MeshCpuLoadResult &cpuLoadResult) const {
+    return cpuLoadResult.result;
+}
 
-    // Register upload status for buffers
-    vertexBuffer->addGpuDependency(commandQueue, fenceValue);
-    if (useIndexBuffer) {
-        indexBuffer->addGpuDependency(commandQueue, fenceValue);
+DXD::Mesh::ObjLoadResult ObjLoadCpuGpuOperation::parseChunk(const ObjChunk &chunk, ObjData &outData, const std::function<bool()> &isTerminated) {
+    // Parse in smaller windows, so termination can be checked in between
+    for (const char *windowBegin = chunk.begin; windowBegin < chunk.end;) {
+        if (isTerminated()) {
+            return DXD::Mesh::ObjLoadResult::TERMINATED;
+        }
+
+        const char *windowEnd = ObjParser::findLineAlignedChunkEnd(windowBegin, chunk.end, parseWindowSize);
+        if (!ObjParser::parse(windowBegin, windowEnd, outData)) {
+            return DXD::Mesh::ObjLoadResult::WRONG_OBJ;
+        }
+        windowBegin = windowEnd;
     }
+    return DXD::Mesh::ObjLoadResult::SUCCESS;
+}
+
+DXD::Mesh::ObjLoadResult ObjLoadCpuGpuOperation::parseAttributes(const MemoryMappedFile &file, ObjData &outData, size_t &outFaceCornersCount,
+                                                                 const std::function<bool()> &isTerminated) {
+    // Faces are only counted, they're parsed again later one window at a time
+    for (const char *windowBegin = file.getData(); windowBegin < file.getDataEnd();) {
+        if (isTerminated()) {
+            return DXD::Mesh::ObjLoadResult::TERMINATED;
+        }
 
-    // Set buffers in Mesh instance
-    mesh.setGpuData(vertexBuffer, indexBuffer);
+        const char *windowEnd = ObjParser::findLineAlignedChunkEnd(windowBegin, file.getDataEnd(), parseWindowSize);
+        if (!ObjParser::parseAttributes(windowBegin, windowEnd, outData, outFaceCornersCount)) {
+            return DXD::Mesh::ObjLoadResult::WRONG_OBJ;
+        }
+        windowBegin = windowEnd;
+    }
+    return DXD::Mesh::ObjLoadResult::SUCCESS;
 }
 
-bool ObjLoadCpuGpuOperation::hasGpuLoadEnded() {
-    const bool vertexInProgress = mesh.getVertexBuffer()->isWaitingForGpuDependencies();
-    const bool indexInProgress = mesh.getIndexBuffer() != nullptr && mesh.getIndexBuffer()->isWaitingForGpuDependencies();
-    const bool bothEnded = !vertexInProgress && !indexInProgress;
-    return bothEnded;
+void ObjLoadCpuGpuOperation::optimizeVertexOrder(const std::wstring &filePath, UINT vertexSizeInBytes, const std::vector<ObjMaterialGroup> &materialGroups,
+                                                 MeshCpuLoadResult &result) {
+    const UINT vertexSizeInFloats = vertexSizeInBytes / sizeof(FLOAT);
+    const auto verticesCountBefore = static_cast<UINT>(result.vertexElements.size() / vertexSizeInFloats);
+    const VertexCacheStatistics statisticsBefore = MeshOptimizer::analyzeVertexCache(result.indices, verticesCountBefore);
+
+    // Triangles are reordered only within their material groups, vertices can be renumbered globally
+    std::vector<UINT> groupIndices{};
+    for (const ObjMaterialGroup &group : materialGroups) {
+        const auto groupBegin = result.indices.begin() + group.firstIndex;
+        groupIndices.assign(groupBegin, groupBegin + group.indicesCount);
+        MeshOptimizer::optimizeVertexCache(groupIndices, verticesCountBefore);
+        MeshOptimizer::optimizeOverdraw(groupIndices, result.vertexElements, vertexSizeInFloats);
+        std::copy(groupIndices.begin(), groupIndices.end(), groupBegin);
+    }
+    MeshOptimizer::optimizeVertexFetch(result.indices, result.vertexElements, vertexSizeInFloats);
+
+    const auto verticesCountAfter = static_cast<UINT>(result.vertexElements.size() / vertexSizeInFloats);
+    const VertexCacheStatistics statisticsAfter = MeshOptimizer::analyzeVertexCache(result.indices, verticesCountAfter);
+    DXD::log("Optimized vertex order of %ls: ACMR %.3f -> %.3f, ATVR %.3f -> %.3f\n", filePath.c_str(),
+             statisticsBefore.acmr, statisticsAfter.acmr, statisticsBefore.atvr, statisticsAfter.atvr);
 }
 
-DXD::Mesh::ObjLoadResult ObjLoadCpuGpuOperation::getOperationResult(const MeshCpuLoadResult &cpuLoadResult) const {
-    return cpuLoadResult.result;
+void ObjLoadCpuGpuOperation::generateLods(const MeshCpuLoadArgs &args, UINT vertexSizeInBytes, const std::vector<ObjMaterialGroup> &materialGroups,
+                                          MeshCpuLoadResult &result) {
+    const UINT vertexSizeInFloats = vertexSizeInBytes / sizeof(FLOAT);
+    const auto verticesCount = static_cast<UINT>(result.vertexElements.size() / vertexSizeInFloats);
+    const size_t submeshesCount = materialGroups.size();
+
+    // Submeshes are simplified separately, so their triangles stay in their groups. Open borders are preserved
+    // by the simplifier, hence there are no cracks between them. Each level is simplified from the previous one,
+    // so errors are accumulated. Empty entry means the submesh couldn't be simplified any further
+    std::vector<std::vector<UINT>> lodIndices{}; // entry of submesh s at level l is at l * submeshesCount + s
+    std::vector<FLOAT> lodErrors{};
+    for (const ObjMaterialGroup &group : materialGroups) {
+        lodIndices.emplace_back(result.indices.begin() + group.firstIndex, result.indices.begin() + group.firstIndex + group.indicesCount);
+    }
+    result.indices.clear();
+    lodErrors.push_back(0.f);
+    std::vector<size_t> lastSimplifiedEntries(submeshesCount);
+    std::vector<FLOAT> submeshErrors(submeshesCount, 0.f);
+    for (size_t submeshIndex = 0u; submeshIndex < submeshesCount; submeshIndex++) {
+        lastSimplifiedEntries[submeshIndex] = submeshIndex;
+    }
+    while (args.generateLods && lodErrors.size() < MeshImpl::maxLodsCount) {
+        // Submesh which got stuck at some level is not simplified again, the result would be the same
+        const size_t levelStart = lodIndices.size();
+        bool anySubmeshSimplified = false;
+        for (size_t submeshIndex = 0u; submeshIndex < submeshesCount; submeshIndex++) {
+            const size_t previousEntry = lastSimplifiedEntries[submeshIndex];
+            const bool previouslySimplified = previousEntry + submeshesCount == levelStart + submeshIndex;
+            const auto targetIndicesCount = static_cast<UINT>(lodIndices[previousEntry].size() / 6 * 3);
+            std::vector<UINT> simplifiedIndices{};
+            FLOAT error = 0.f;
+            if (previouslySimplified) {
+                error = MeshSimplifier::simplify(lodIndices[previousEntry], result.vertexElements, vertexSizeInFloats, targetIndicesCount,
+                                                 std::numeric_limits<FLOAT>::max(), simplifiedIndices);
+            }
+
+            // Simplification can get stuck on attribute seams, a level not much smaller than the previous one is useless
+            if (simplifiedIndices.empty() || simplifiedIndices.size() > lodIndices[previousEntry].size() * 3 / 4) {
+                lodIndices.emplace_back();
+                continue;
+            }
+            if (args.optimizeVertexOrder) {
+                MeshOptimizer::optimizeVertexCache(simplifiedIndices, verticesCount);
+            }
+            lastSimplifiedEntries[submeshIndex] = lodIndices.size();
+            lodIndices.push_back(std::move(simplifiedIndices));
+            submeshErrors[submeshIndex] += error;
+            anySubmeshSimplified = true;
+        }
+
+        if (!anySubmeshSimplified) {
+            lodIndices.resize(lodIndices.size() - submeshesCount);
+            break;
+        }
+        lodErrors.push_back(*std::max_element(submeshErrors.begin(), submeshErrors.end()));
+    }
+
+    // All levels are stored in one index buffer, meshlets are built separately for each submesh of each level
+    std::vector<Meshlet> lodMeshlets{};
+    for (size_t entry = 0u; entry < lodIndices.size(); entry++) {
+        const FLOAT error = lodErrors[entry / submeshesCount];
+        if (entry >= submeshesCount && lodIndices[entry].empty()) {
+            // Geometry of the previous level is reused
+            MeshLod lod = result.lods[entry - submeshesCount];
+            lod.error = error;
+            result.lods.push_back(lod);
+            continue;
+        }
+
+        MeshLod lod{static_cast<UINT>(result.indices.size()), static_cast<UINT>(lodIndices[entry].size()),
+                    static_cast<UINT>(result.meshlets.size()), 0u, error};
+        MeshletBuilder::build(lodIndices[entry], result.vertexElements, vertexSizeInFloats, lodMeshlets);
+        for (Meshlet &meshlet : lodMeshlets) {
+            meshlet.firstIndex += lod.firstIndex;
+        }
+        lod.meshletsCount = static_cast<UINT>(lodMeshlets.size());
+
+        result.indices.insert(result.indices.end(), lodIndices[entry].begin(), lodIndices[entry].end());
+        result.meshlets.insert(result.meshlets.end(), lodMeshlets.begin(), lodMeshlets.end());
+        result.lods.push_back(lod);
+    }
+    for (auto lodLevel = 1u; lodLevel < lodErrors.size(); lodLevel++) {
+        UINT trianglesCount = 0u;
+        for (size_t submeshIndex = 0u; submeshIndex < submeshesCount; submeshIndex++) {
+            trianglesCount += result.lods[lodLevel * submeshesCount + submeshIndex].indicesCount / 3;
+        }
+        DXD::log("Generated LOD%u of %ls: %u triangles, error %f\n", lodLevel, args.filePath.c_str(), trianglesCount, lodErrors[lodLevel]);
+    }
 }
 
-void ObjLoadCpuGpuOperation::processIndexToken(const std::string &indexToken, bool textures, bool normals,
-                                               UINT *outVertexIndex, UINT *outTextureCoordinateIndex, UINT *outNormalIndex) {
-    size_t leftPosition{};
-    size_t rightPosition{};
+void ObjLoadCpuGpuOperation::loadMaterials(const std::wstring &materialLibraryPath, const std::vector<std::string> &materialNames,
+                                           const std::vector<ObjMaterialGroup> &materialGroups, std::vector<MeshSubmesh> &outSubmeshes) {
+    std::vector<ObjMaterial> materials{};
+    if (!materialLibraryPath.empty()) {
+        const MemoryMappedFile materialLibraryFile{materialLibraryPath};
+        if (materialLibraryFile.isValid()) {
+            ObjParser::parseMaterialLibrary(materialLibraryFile.getData(), materialLibraryFile.getDataEnd(), materials);
+        } else {
+            DXD::log("Material library %ls could not be opened, object properties are used instead\n", materialLibraryPath.c_str());
+        }
+    }
+
+    // Submeshes with unknown materials are drawn like the ones without any
+    outSubmeshes.clear();
+    for (const ObjMaterialGroup &group : materialGroups) {
+        MeshSubmesh submesh{};
+        if (group.material != ObjMaterialSwitch::noMaterial) {
+            const std::string &materialName = materialNames[group.material];
+            auto material = std::find_if(materials.begin(), materials.end(), [&](const ObjMaterial &candidate) { return candidate.name == materialName; });
+            if (material != materials.end()) {
+                submesh.hasMaterial = 1u;
+                std::copy(material->diffuseColor, material->diffuseColor + 3, submesh.albedoColor);
+                submesh.specularity = (material->specularColor[0] + material->specularColor[1] + material->specularColor[2]) / 3;
+            }
+        }
+        outSubmeshes.push_back(submesh);
+    }
+}
 
-    rightPosition = indexToken.find('/', 0u);
-    *outVertexIndex = std::stoi(indexToken.substr(leftPosition, rightPosition)) - 1;
+std::wstring ObjLoadCpuGpuOperation::getMaterialLibraryPath(const std::wstring &fullFilePath, const std::string &materialLibrary) {
+    // Library is located relative to the obj file, its name is widened as is, since exporters write it in ASCII
+    const size_t directoryEnd = fullFilePath.find_last_of(L"/\\");
+    const std::wstring directory = directoryEnd == std::wstring::npos ? std::wstring{} : fullFilePath.substr(0, directoryEnd + 1);
+    return directory + std::wstring(materialLibrary.begin(), materialLibrary.end());
+}
 
-    leftPosition = rightPosition + 1;
-    rightPosition = indexToken.find('/', rightPosition + 1);
-    if (textures && leftPosition != rightPosition) {
-        *outTextureCoordinateIndex = std::stoi(indexToken.substr(leftPosition, rightPosition)) - 1;
+bool ObjLoadCpuGpuOperation::isMaterialLibraryUpToDate(const std::wstring &fullFilePath, const CookedMeshHeader &header) {
+    if (header.materialLibrary[0] == '\0') {
+        return true;
     }
 
-    leftPosition = rightPosition + 1;
-    rightPosition = indexToken.find('/', rightPosition + 1);
-    assert(rightPosition == std::string::npos);
-    if (normals && leftPosition < indexToken.size()) {
-        *outNormalIndex = std::stoi(indexToken.substr(leftPosition, rightPosition)) - 1;
+    CookedMeshSource materialLibrarySource{};
+    const std::wstring materialLibraryPath = getMaterialLibraryPath(fullFilePath, std::string{header.materialLibrary, strnlen(header.materialLibrary, sizeof(header.materialLibrary))});
+    return CookedMesh::querySource(materialLibraryPath, 0u, materialLibrarySource) &&
+           materialLibrarySource.size == header.materialLibrarySource.size &&
+           materialLibrarySource.lastWriteTime == header.materialLibrarySource.lastWriteTime;
+}
+
+void ObjLoadCpuGpuOperation::computeSmoothTangents(UINT vertexSizeInBytes, MeshCpuLoadResult &result) {
+    // Vertex layout is position, normal, tangent, texture coordinate
+    const UINT vertexSizeInFloats = vertexSizeInBytes / sizeof(FLOAT);
+    const auto verticesCount = static_cast<UINT>(result.vertexElements.size() / vertexSizeInFloats);
+    FLOAT *vertexData = result.vertexElements.data();
+    TangentSpaceGenerator::computeTangents({vertexData + 0, vertexSizeInFloats}, {vertexData + 9, vertexSizeInFloats}, {vertexData + 3, vertexSizeInFloats},
+                                           verticesCount, result.indices, TangentSpaceGenerator::Weighting::ANGLE, vertexData + 6, vertexSizeInFloats);
+}
+
+bool ObjLoadCpuGpuOperation::validateFaceCorners(const ObjData &objData, const std::vector<ObjFaceCorner> &faceCorners, bool textures, bool normals) {
+    const size_t positionsCount = objData.positions.size() / 3;
+    const size_t textureCoordinatesCount = objData.textureCoordinates.size() / 2;
+    const size_t normalsCount = objData.normals.size() / 3;
+    for (const ObjFaceCorner &faceCorner : faceCorners) {
+        const bool positionValid = faceCorner.position < positionsCount;
+        const bool textureCoordinateValid = !textures || faceCorner.textureCoordinate < textureCoordinatesCount;
+        const bool normalValid = !normals || faceCorner.normal < normalsCount;
+        if (!positionValid || !textureCoordinateValid || !normalValid) {
+            return false;
+        }
     }
+    return true;
 }
 
 XMFLOAT3 ObjLoadCpuGpuOperation::getVertexVector(const std::vector<FLOAT> &vertices, UINT vertexIndex) {
@@ -367,7 +1050,7 @@ XMFLOAT2 ObjLoadCpuGpuOperation::getTextureCoordinateVector(const std::vector<FL
 }
 
 void ObjLoadCpuGpuOperation::computeVertexTangent(const std::vector<FLOAT> &vertices, const std::vector<FLOAT> &textureCoordinates,
-                                                  const UINT vertexIndices[3], UINT textureCoordinateIndices[3], XMFLOAT3 &outTangent) {
+                                                  const UINT vertexIndices[3], const UINT textureCoordinateIndices[3], XMFLOAT3 &outTangent) {
     // Get position and texture coordinate deltas (edges)
     XMFLOAT3 pos1 = getVertexVector(vertices, vertexIndices[0]);
     XMFLOAT3 pos2 = getVertexVector(vertices, vertexIndices[1]);
@@ -414,3 +1097,246 @@ void ObjLoadCpuGpuOperation::computeVertexNormal(const std::vector<FLOAT> &verte
     XMVECTOR normal = XMVector3Cross(e2, e1);
     outNormal = XMStoreFloat3(normal);
 }
+
+// ----------------------------------------------------------------- GltfLoadCpuGpuOperation class
+
+GltfCpuLoadResult GltfLoadCpuGpuOperation::cpuLoad(const GltfCpuLoadArgs &args) {
+    // Initial validation
+    const auto fullFilePath = std::wstring{RESOURCES_PATH} + args.filePath;
+    if (!FileHelper::exists(fullFilePath)) {
+        return std::move(GltfCpuLoadResult{DXD::Mesh::GltfLoadResult::WRONG_FILENAME});
+    }
+
+    // Map the file and resolve accessors, they point directly into the mapping
+    GltfCpuLoadResult result{DXD::Mesh::GltfLoadResult::SUCCESS};
+    result.file = std::make_unique<MemoryMappedFile>(fullFilePath);
+    std::vector<GltfPrimitive> primitives{};
+    if (!result.file->isValid() || !GltfParser::parseGlb(result.file->getData(), result.file->getSize(), primitives)) {
+        return std::move(GltfCpuLoadResult{DXD::Mesh::GltfLoadResult::WRONG_GLTF});
+    }
+    if (!GltfParser::hasRequestedAttributes(primitives, args.loadTextureCoordinates, args.computeTangents)) {
+        return std::move(GltfCpuLoadResult{DXD::Mesh::GltfLoadResult::WRONG_GLTF});
+    }
+
+    // Compute vertex layout, normals are mandatory just like for obj files
+    MeshImpl::MeshType meshType = MeshImpl::TRIANGLE_STRIP | MeshImpl::NORMALS;
+    meshType |= args.loadTextureCoordinates ? MeshImpl::TEXTURE_COORDS : 0u;
+    meshType |= args.computeTangents ? MeshImpl::TANGENTS : 0u;
+    const UINT vertexSizeInBytes = MeshImpl::computeVertexSize(meshType);
+    const UINT vertexSizeInFloats = vertexSizeInBytes / sizeof(FLOAT);
+
+    std::vector<Meshlet> meshlets{};
+    const bool uploadDirectly = canUploadDirectly(primitives, meshType, vertexSizeInBytes);
+    if (uploadDirectly) {
+        // Vertices are already interleaved in our layout, so they're uploaded straight from the mapping. So are indices,
+        // if they're 32-bit. Meshlets are not built, since they would require a copy of the vertices
+        const GltfPrimitive &primitive = primitives[0];
+        result.mappedVertexData = primitive.positions.data;
+        if (primitive.indices.isPresent() && primitive.indices.componentType == GltfAccessor::ComponentType::UNSIGNED_INT &&
+            primitive.indices.isTightlyPacked()) {
+            result.mappedIndexData = reinterpret_cast<const UINT *>(primitive.indices.data);
+        } else {
+            appendIndices(primitive, 0u, result.indices);
+        }
+    } else {
+        // All primitives are merged into one interleaved vertex buffer, missing attributes are computed
+        std::vector<UINT> primitiveIndices{};
+        for (const GltfPrimitive &primitive : primitives) {
+            if (isCpuLoadTerminated()) {
+                return std::move(GltfCpuLoadResult{DXD::Mesh::GltfLoadResult::TERMINATED});
+            }
+
+            const auto baseVertex = static_cast<UINT>(result.vertexElements.size() / vertexSizeInFloats);
+            primitiveIndices.clear();
+            appendIndices(primitive, 0u, primitiveIndices);
+            appendVertices(primitive, meshType, primitiveIndices, result.vertexElements);
+            appendIndices(primitive, baseVertex, result.indices);
+        }
+        MeshletBuilder::build(result.indices, result.vertexElements, vertexSizeInFloats, meshlets);
+    }
+
+    // Bounds are computed from positions, which are always first in the vertex
+    const auto verticesCount = uploadDirectly ? primitives[0].positions.count : static_cast<UINT>(result.vertexElements.size() / vertexSizeInFloats);
+    const auto indicesCount = static_cast<UINT>(result.mappedIndexData ? primitives[0].indices.count : result.indices.size());
+    const auto positions = static_cast<const FLOAT *>(result.getVertexData());
+    FLOAT boundsMin[3] = {};
+    FLOAT boundsMax[3] = {};
+    FLOAT boundingSphere[4] = {};
+    CookedMesh::computeBounds(positions, verticesCount, vertexSizeInBytes, boundsMin, boundsMax);
+    CookedMesh::computeBoundingSphere(positions, verticesCount, vertexSizeInBytes, boundsMin, boundsMax, boundingSphere);
+
+    // Set data to Mesh instance, the geometry is drawn as a single level of detail
+    const MeshLod lod{0u, indicesCount, 0u, static_cast<UINT>(meshlets.size()), 0.f};
+    mesh.setCpuData(meshType, vertexSizeInBytes, verticesCount, indicesCount, boundsMin, boundsMax, boundingSphere);
+    mesh.setLods(std::vector<MeshLod>{lod}, std::move(meshlets));
+
+    // Return load results
+    DXD::log("Loaded %ls: %u vertices, %u indices, %u primitives%ls\n", args.filePath.c_str(), verticesCount, indicesCount,
+             static_cast<UINT>(primitives.size()), uploadDirectly ? L", uploaded directly from the file" : L"");
+    return std::move(result);
+}
+
+bool GltfLoadCpuGpuOperation::isCpuLoadSuccessful(const GltfCpuLoadResult &result) {
+    return result.result == DXD::Mesh::GltfLoadResult::SUCCESS;
+}
+
+void GltfLoadCpuGpuOperation::gpuLoad(const GltfCpuLoadResult &args) {
+    mesh.uploadGpuData(args.getVertexData(), args.getIndexData());
+}
+
+bool GltfLoadCpuGpuOperation::hasGpuLoadEnded() {
+    return mesh.isGpuDataUploaded();
+}
+
+bool GltfLoadCpuGpuOperation::waitForGpuLoad(std::chrono::milliseconds timeout) {
+    return mesh.waitForGpuDataUpload(timeout);
+}
+
+DXD::Mesh::GltfLoadResult GltfLoadCpuGpuOperation::getOperationResult(const GltfCpuLoadResult &cpuLoadResult) const {
+    return cpuLoadResult.result;
+}
+
+bool GltfLoadCpuGpuOperation::canUploadDirectly(const std::vector<GltfPrimitive> &primitives, UINT meshType, UINT vertexSizeInBytes) {
+    // Tangents are stored as 4 components in glTF and as 3 in our vertices, so they can never match
+    if (primitives.size() != 1u || (meshType & MeshImpl::TANGENTS)) {
+        return false;
+    }
+
+    // Every attribute of our layout has to be present at its offset within the same vertex
+    const GltfPrimitive &primitive = primitives[0];
+    const auto isAt = [&primitive](const GltfAccessor &accessor, UINT offset) {
+        return accessor.isPresent() && accessor.componentType == GltfAccessor::ComponentType::FLOAT &&
+               accessor.data == primitive.positions.data + offset && accessor.strideInBytes == primitive.positions.strideInBytes;
+    };
+    const bool textureCoordinatesMatch = !(meshType & MeshImpl::TEXTURE_COORDS) || isAt(primitive.textureCoordinates, 6 * sizeof(FLOAT));
+    return primitive.positions.strideInBytes == vertexSizeInBytes && isAt(primitive.normals, 3 * sizeof(FLOAT)) && textureCoordinatesMatch;
+}
+
+void GltfLoadCpuGpuOperation::appendIndices(const GltfPrimitive &primitive, UINT baseVertex, std::vector<UINT> &outIndices) {
+    if (!primitive.indices.isPresent()) {
+        for (UINT vertex = 0u; vertex < primitive.positions.count; vertex++) {
+            outIndices.push_back(baseVertex + vertex);
+        }
+        return;
+    }
+    for (UINT index = 0u; index < primitive.indices.count; index++) {
+        outIndices.push_back(baseVertex + primitive.indices.readUnsigned(index));
+    }
+}
+
+void GltfLoadCpuGpuOperation::appendVertices(const GltfPrimitive &primitive, UINT meshType, const std::vector<UINT> &primitiveIndices,
+                                             std::vector<FLOAT> &outVertexElements) {
+    // Read attributes into separate arrays, converting them to floats
+    const UINT verticesCount = primitive.positions.count;
+    auto readAttribute = [verticesCount](const GltfAccessor &accessor, UINT componentsCount, std::vector<FLOAT> &outElements) {
+        outElements.resize(static_cast<size_t>(verticesCount) * componentsCount);
+        for (UINT vertex = 0u; vertex < verticesCount; vertex++) {
+            for (UINT component = 0u; component < componentsCount; component++) {
+                outElements[static_cast<size_t>(vertex) * componentsCount + component] = accessor.readFloat(vertex, component);
+            }
+        }
+    };
+    std::vector<FLOAT> positions{}, normals{}, tangents{}, textureCoordinates{};
+    readAttribute(primitive.positions, 3u, positions);
+    if (primitive.textureCoordinates.isPresent()) {
+        readAttribute(primitive.textureCoordinates, 2u, textureCoordinates);
+    }
+
+    // Compute missing attributes
+    if (primitive.normals.isPresent()) {
+        readAttribute(primitive.normals, 3u, normals);
+    } else {
+        normals.resize(positions.size());
+        TangentSpaceGenerator::computeNormals({positions.data(), 3u}, verticesCount, primitiveIndices, TangentSpaceGenerator::Weighting::ANGLE,
+                                              normals.data(), 3u);
+    }
+    const bool hasTangents = meshType & MeshImpl::TANGENTS;
+    if (hasTangents && primitive.tangents.isPresent()) {
+        readAttribute(primitive.tangents, 3u, tangents); // w component is the handedness, it's not used
+    } else if (hasTangents) {
+        tangents.resize(positions.size());
+        TangentSpaceGenerator::computeTangents({positions.data(), 3u}, {textureCoordinates.data(), 2u}, {normals.data(), 3u}, verticesCount,
+                                               primitiveIndices, TangentSpaceGenerator::Weighting::ANGLE, tangents.data(), 3u);
+    }
+
+    // Interleave them in our layout - position, normal, tangent, texture coordinate
+    const bool hasTextureCoordinates = meshType & MeshImpl::TEXTURE_COORDS;
+    for (size_t vertex = 0u; vertex < verticesCount; vertex++) {
+        outVertexElements.insert(outVertexElements.end(), positions.begin() + vertex * 3, positions.begin() + vertex * 3 + 3);
+        outVertexElements.insert(outVertexElements.end(), normals.begin() + vertex * 3, normals.begin() + vertex * 3 + 3);
+        if (hasTangents) {
+            outVertexElements.insert(outVertexElements.end(), tangents.begin() + vertex * 3, tangents.begin() + vertex * 3 + 3);
+        }
+        if (hasTextureCoordinates) {
+            outVertexElements.insert(outVertexElements.end(), textureCoordinates.begin() + vertex * 2, textureCoordinates.begin() + vertex * 2 + 2);
+        }
+    }
+}
+
+// ----------------------------------------------------------------- MemoryLoadCpuGpuOperation class
+
+MemoryCpuLoadResult MemoryLoadCpuGpuOperation::cpuLoad(const MemoryCpuLoadArgs &args) {
+    // Validation, data comes from the application, so it cannot be trusted any more than a file
+    const DXD::VertexLayout &layout = args.vertexLayout;
+    if (args.vertexData == nullptr || args.verticesCount == 0u || !VertexLayoutConverter::validateLayout(layout) ||
+        !VertexLayoutConverter::validateIndices(args.indexData, args.indicesCount, args.verticesCount)) {
+        return std::move(MemoryCpuLoadResult{DXD::Mesh::MemoryLoadResult::WRONG_DATA});
+    }
+
+    // Compute vertex layout, vertices already in it are uploaded straight from the application memory
+    MeshImpl::MeshType meshType = MeshImpl::TRIANGLE_STRIP | MeshImpl::NORMALS;
+    meshType |= layout.hasTextureCoordinates() ? MeshImpl::TEXTURE_COORDS : 0u;
+    meshType |= layout.hasTangents() ? MeshImpl::TANGENTS : 0u;
+    const DXD::VertexLayout packedLayout = VertexLayoutConverter::getPackedLayout(layout.hasTangents(), layout.hasTextureCoordinates());
+    assert(packedLayout.strideInBytes == MeshImpl::computeVertexSize(meshType));
+
+    MemoryCpuLoadResult result{DXD::Mesh::MemoryLoadResult::SUCCESS};
+    result.indexData = args.indexData;
+    const bool uploadDirectly = VertexLayoutConverter::isSameLayout(layout, packedLayout);
+    if (uploadDirectly) {
+        result.callerVertexData = args.vertexData;
+    } else {
+        VertexLayoutConverter::convert(args.vertexData, args.verticesCount, layout, packedLayout, result.vertexElements);
+    }
+    if (isCpuLoadTerminated()) {
+        return std::move(MemoryCpuLoadResult{DXD::Mesh::MemoryLoadResult::TERMINATED});
+    }
+
+    // Bounds are computed from positions, which are always first in the vertex
+    const auto positions = static_cast<const FLOAT *>(result.getVertexData());
+    FLOAT boundsMin[3] = {};
+    FLOAT boundsMax[3] = {};
+    FLOAT boundingSphere[4] = {};
+    CookedMesh::computeBounds(positions, args.verticesCount, packedLayout.strideInBytes, boundsMin, boundsMax);
+    CookedMesh::computeBoundingSphere(positions, args.verticesCount, packedLayout.strideInBytes, boundsMin, boundsMax, boundingSphere);
+
+    // Set data to Mesh instance, the geometry is drawn as a single level of detail without meshlets
+    const MeshLod lod{0u, args.indicesCount, 0u, 0u, 0.f};
+    mesh.setCpuData(meshType, packedLayout.strideInBytes, args.verticesCount, args.indicesCount, boundsMin, boundsMax, boundingSphere);
+    mesh.setLods(std::vector<MeshLod>{lod}, std::vector<Meshlet>{});
+
+    // Return load results
+    DXD::log("Loaded mesh from memory: %u vertices, %u indices%ls\n", args.verticesCount, args.indicesCount,
+             uploadDirectly ? L", uploaded directly" : L"");
+    return std::move(result);
+}
+
+bool MemoryLoadCpuGpuOperation::isCpuLoadSuccessful(const MemoryCpuLoadResult &result) {
+    return result.result == DXD::Mesh::MemoryLoadResult::SUCCESS;
+}
+
+void MemoryLoadCpuGpuOperation::gpuLoad(const MemoryCpuLoadResult &args) {
+    mesh.uploadGpuData(args.getVertexData(), args.indexData);
+}
+
+bool MemoryLoadCpuGpuOperation::hasGpuLoadEnded() {
+    return mesh.isGpuDataUploaded();
+}
+
+bool MemoryLoadCpuGpuOperation::waitForGpuLoad(std::chrono::milliseconds timeout) {
+    return mesh.waitForGpuDataUpload(timeout);
+}
+
+DXD::Mesh::MemoryLoadResult MemoryLoadCpuGpuOperation::getOperationResult(const MemoryCpuLoadResult &cpuLoadResult) const {
+    return cpuLoadResult.result;
+}
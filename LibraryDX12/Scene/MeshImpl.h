@@ -1,16 +1,26 @@
 #pragma once
 
 #include "Application/ApplicationImpl.h"
+#include "Geometry/CookedMesh.h"
+#include "Geometry/GltfParser.h"
+#include "Geometry/MeshletCuller.h"
+#include "Geometry/ObjParser.h"
 #include "PipelineState/PipelineStateController.h"
-#include "Resource/Resource.h"
+#include "Resource/GeometryPool.h"
 #include "Resource/VertexOrIndexBuffer.h"
 #include "Threading/CpuGpuOperation.h"
+#include "Utility/GpuDependency.h"
 #include "Utility/MathHelper.h"
+#include "Utility/MemoryMappedFile.h"
 
 #include "DXD/Mesh.h"
 
 #include <DXD/ExternalHeadersWrappers/DirectXMath.h>
 #include <DXD/ExternalHeadersWrappers/d3d12.h>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <utility>
 #include <vector>
 
@@ -18,40 +28,178 @@ struct MeshCpuLoadArgs {
     const std::wstring filePath;
     bool loadTextureCoordinates;
     bool computeTangents;
+    bool optimizeVertexOrder;
+    bool smoothNormalsAndTangents;
+    bool quantizeVertices;
+    bool generateLods;
+
+    UINT getCookedMeshLoadFlags() const {
+        return (loadTextureCoordinates ? 0x1 : 0x0) | (computeTangents ? 0x2 : 0x0) | (optimizeVertexOrder ? 0x4 : 0x0) |
+               (smoothNormalsAndTangents ? 0x8 : 0x0) | (quantizeVertices ? 0x10 : 0x0) | (generateLods ? 0x20 : 0x0);
+    }
 };
 
 struct MeshCpuLoadResult {
     DXD::Mesh::ObjLoadResult result = {};
     std::vector<FLOAT> vertexElements = {};
+    std::vector<UINT16> quantizedVertexElements = {}; // if not empty, used instead of vertexElements
     std::vector<UINT> indices = {};
+    std::vector<Meshlet> meshlets = {};
+    std::vector<MeshLod> lods = {};
+    std::vector<MeshSubmesh> submeshes = {};
+    CookedMeshHeader header = {};                // type, sizes and bounds of the mesh, also when it wasn't written to a file
+    std::unique_ptr<CookedMesh> cookedMesh = {}; // if present, data is read directly from the mapped file instead of vectors
+
+    const void *getVertexData() const {
+        if (cookedMesh) {
+            return cookedMesh->getVertexData();
+        }
+        return quantizedVertexElements.empty() ? static_cast<const void *>(vertexElements.data()) : quantizedVertexElements.data();
+    }
+    const UINT *getIndexData() const { return cookedMesh ? cookedMesh->getIndexData() : indices.data(); }
 };
 
 class ObjLoadCpuGpuOperation : public CpuGpuOperation<MeshCpuLoadArgs, MeshCpuLoadResult, DXD::Mesh::ObjLoadResult> {
 public:
     ObjLoadCpuGpuOperation(MeshImpl &mesh) : mesh(mesh) {}
 
+    /// Runs all CPU stages of an obj load: parsing, welding, optimization, quantization, levels of detail and
+    /// writing of the cooked file. Touches neither a mesh nor the GPU, so offline tools can call it without
+    /// creating the application. If an up to date cooked file exists, it's mapped instead
+    /// \param args load flags, the same as for the mesh which will use the cooked file
+    /// \param backgroundWorkerController workers used for the parallel stages
+    /// \param isTerminated checked between stages, the load is abandoned with TERMINATED if it returns true
+    /// \return processed mesh data, or the reason of the failure
+    static MeshCpuLoadResult cook(const MeshCpuLoadArgs &args, BackgroundWorkerController &backgroundWorkerController,
+                                  const std::function<bool()> &isTerminated);
+
 protected:
     // CpuGpuOperation overrides
     MeshCpuLoadResult cpuLoad(const MeshCpuLoadArgs &args) override;
     bool isCpuLoadSuccessful(const MeshCpuLoadResult &result) override;
     void gpuLoad(const MeshCpuLoadResult &args) override;
     bool hasGpuLoadEnded() override;
+    bool waitForGpuLoad(std::chrono::milliseconds timeout) override;
     DXD::Mesh::ObjLoadResult getOperationResult(const MeshCpuLoadResult &cpuLoadResult) const override;
 
+    // Obj files are parsed in windows of this size, so termination can be checked in between
+    constexpr static size_t parseWindowSize = 1024 * 1024;
+    // Bigger obj files are streamed, i.e. their faces are never kept in memory all at once
+    constexpr static size_t streamingLoadThreshold = 256 * 1024 * 1024;
+
     // Helpers
-    static void processIndexToken(const std::string &indexToken, bool textures, bool normals,
-                                  UINT *outVertexIndex, UINT *outTextureCoordinateIndex, UINT *outNormalIndex);
+    static DXD::Mesh::ObjLoadResult parseChunk(const ObjChunk &chunk, ObjData &outData, const std::function<bool()> &isTerminated);
+    static DXD::Mesh::ObjLoadResult parseAttributes(const MemoryMappedFile &file, ObjData &outData, size_t &outFaceCornersCount,
+                                                    const std::function<bool()> &isTerminated);
+    static void optimizeVertexOrder(const std::wstring &filePath, UINT vertexSizeInBytes, const std::vector<ObjMaterialGroup> &materialGroups,
+                                    MeshCpuLoadResult &result);
+    static void generateLods(const MeshCpuLoadArgs &args, UINT vertexSizeInBytes, const std::vector<ObjMaterialGroup> &materialGroups,
+                             MeshCpuLoadResult &result);
+    static void loadMaterials(const std::wstring &materialLibraryPath, const std::vector<std::string> &materialNames,
+                              const std::vector<ObjMaterialGroup> &materialGroups, std::vector<MeshSubmesh> &outSubmeshes);
+    static std::wstring getMaterialLibraryPath(const std::wstring &fullFilePath, const std::string &materialLibrary);
+    static bool isMaterialLibraryUpToDate(const std::wstring &fullFilePath, const CookedMeshHeader &header);
+    static void computeSmoothTangents(UINT vertexSizeInBytes, MeshCpuLoadResult &result);
+    static bool validateFaceCorners(const ObjData &objData, const std::vector<ObjFaceCorner> &faceCorners, bool textures, bool normals);
     static XMFLOAT3 getVertexVector(const std::vector<FLOAT> &vertices, UINT vertexIndex);
     static XMFLOAT2 getTextureCoordinateVector(const std::vector<FLOAT> &textureCoordinates, UINT textureCoordinateIndex);
     static void computeVertexTangent(const std::vector<FLOAT> &vertices, const std::vector<FLOAT> &textureCoordinates,
-                                     const UINT vertexIndices[3], UINT textureCoordinateIndices[3], XMFLOAT3 &outTangent);
+                                     const UINT vertexIndices[3], const UINT textureCoordinateIndices[3], XMFLOAT3 &outTangent);
     static void computeVertexNormal(const std::vector<FLOAT> &vertexElements, const UINT vertexIndices[3], XMFLOAT3 &outNormal);
 
 private:
     MeshImpl &mesh;
 };
 
-class MeshImpl : public DXD::Mesh {
+struct GltfCpuLoadArgs {
+    const std::wstring filePath;
+    bool loadTextureCoordinates;
+    bool computeTangents;
+
+    // Distinct from obj flags, so a file is never shared between meshes created by different loaders
+    UINT getLoadFlags() const {
+        return 0x100 | (loadTextureCoordinates ? 0x1 : 0x0) | (computeTangents ? 0x2 : 0x0);
+    }
+};
+
+struct GltfCpuLoadResult {
+    DXD::Mesh::GltfLoadResult result = {};
+    std::unique_ptr<MemoryMappedFile> file = {}; // kept until the upload, since mapped data may be uploaded directly
+    const BYTE *mappedVertexData = nullptr;      // if present, used instead of vertexElements
+    const UINT *mappedIndexData = nullptr;       // if present, used instead of indices
+    std::vector<FLOAT> vertexElements = {};
+    std::vector<UINT> indices = {};
+
+    const void *getVertexData() const { return mappedVertexData ? static_cast<const void *>(mappedVertexData) : vertexElements.data(); }
+    const UINT *getIndexData() const { return mappedIndexData ? mappedIndexData : indices.data(); }
+};
+
+class GltfLoadCpuGpuOperation : public CpuGpuOperation<GltfCpuLoadArgs, GltfCpuLoadResult, DXD::Mesh::GltfLoadResult> {
+public:
+    GltfLoadCpuGpuOperation(MeshImpl &mesh) : mesh(mesh) {}
+
+protected:
+    // CpuGpuOperation overrides
+    GltfCpuLoadResult cpuLoad(const GltfCpuLoadArgs &args) override;
+    bool isCpuLoadSuccessful(const GltfCpuLoadResult &result) override;
+    void gpuLoad(const GltfCpuLoadResult &args) override;
+    bool hasGpuLoadEnded() override;
+    bool waitForGpuLoad(std::chrono::milliseconds timeout) override;
+    DXD::Mesh::GltfLoadResult getOperationResult(const GltfCpuLoadResult &cpuLoadResult) const override;
+
+    // Helpers
+    static bool canUploadDirectly(const std::vector<GltfPrimitive> &primitives, UINT meshType, UINT vertexSizeInBytes);
+    static void appendIndices(const GltfPrimitive &primitive, UINT baseVertex, std::vector<UINT> &outIndices);
+    static void appendVertices(const GltfPrimitive &primitive, UINT meshType, const std::vector<UINT> &primitiveIndices,
+                               std::vector<FLOAT> &outVertexElements);
+
+private:
+    MeshImpl &mesh;
+};
+
+struct MemoryCpuLoadArgs {
+    const void *vertexData;
+    UINT verticesCount;
+    DXD::VertexLayout vertexLayout;
+    const UINT *indexData;
+    UINT indicesCount;
+
+    // Data moved to the engine, pointers above point into it. Args are copied to the background thread, hence the shared pointers
+    std::shared_ptr<const std::vector<FLOAT>> ownedVertexElements;
+    std::shared_ptr<const std::vector<UINT>> ownedIndices;
+};
+
+struct MemoryCpuLoadResult {
+    DXD::Mesh::MemoryLoadResult result = {};
+    const void *callerVertexData = nullptr; // if present, used instead of vertexElements
+    std::vector<FLOAT> vertexElements = {};
+    const UINT *indexData = nullptr;
+
+    const void *getVertexData() const { return callerVertexData ? callerVertexData : vertexElements.data(); }
+};
+
+class MemoryLoadCpuGpuOperation : public CpuGpuOperation<MemoryCpuLoadArgs, MemoryCpuLoadResult, DXD::Mesh::MemoryLoadResult> {
+public:
+    MemoryLoadCpuGpuOperation(MeshImpl &mesh) : mesh(mesh) {}
+
+protected:
+    // CpuGpuOperation overrides
+    MemoryCpuLoadResult cpuLoad(const MemoryCpuLoadArgs &args) override;
+    bool isCpuLoadSuccessful(const MemoryCpuLoadResult &result) override;
+    void gpuLoad(const MemoryCpuLoadResult &args) override;
+    bool hasGpuLoadEnded() override;
+    bool waitForGpuLoad(std::chrono::milliseconds timeout) override;
+    DXD::Mesh::MemoryLoadResult getOperationResult(const MemoryCpuLoadResult &cpuLoadResult) const override;
+
+private:
+    MeshImpl &mesh;
+};
+
+/// \brief Geometry shared by all DXD::Mesh instances loaded from the same file with the same flags
+///
+/// Instances are registered in the mesh cache of ApplicationImpl. Requests for a mesh which is already
+/// loaded or being loaded attach to its existing load operation instead of parsing and uploading it again.
+class MeshImpl : DXD::NonCopyableAndMovable {
 public:
     using MeshType = unsigned int;
     constexpr static MeshType UNKNOWN = 0x0;
@@ -59,30 +207,76 @@ public:
     constexpr static MeshType TEXTURE_COORDS = 0x02;
     constexpr static MeshType NORMALS = 0x04;
     constexpr static MeshType TANGENTS = 0x08;
+    constexpr static MeshType QUANTIZED = 0x10;
 
-protected:
-    friend class DXD::Mesh;
-    MeshImpl(const std::wstring &filePath, bool loadTextureCoordinates, bool computeTangents, DXD::Mesh::ObjLoadResult *loadResult);
-    MeshImpl(const std::wstring &filePath, bool loadTextureCoordinates, bool computeTangents, DXD::Mesh::ObjLoadEvent *loadEvent);
-    ~MeshImpl() override;
+    constexpr static UINT maxLodsCount = 4u; // including the original geometry, each next level has half of the triangles
+
+    MeshImpl() = default;
+    ~MeshImpl();
+
+    // Shared instances
+    static std::shared_ptr<MeshImpl> loadSynchronously(const MeshCpuLoadArgs &args, DXD::Mesh::ObjLoadResult *loadResult);
+    static std::shared_ptr<MeshImpl> loadAsynchronously(const MeshCpuLoadArgs &args, DXD::Mesh::ObjLoadEvent *loadEvent, DXD::LoadPriority priority);
+    static std::shared_ptr<MeshImpl> loadSynchronously(const GltfCpuLoadArgs &args, DXD::Mesh::GltfLoadResult *loadResult);
+    static std::shared_ptr<MeshImpl> loadAsynchronously(const GltfCpuLoadArgs &args, DXD::Mesh::GltfLoadEvent *loadEvent, DXD::LoadPriority priority);
+
+    // Unique instances, geometry from memory has no path to be shared by
+    static std::shared_ptr<MeshImpl> loadSynchronously(const MemoryCpuLoadArgs &args, DXD::Mesh::MemoryLoadResult *loadResult);
+    static std::shared_ptr<MeshImpl> loadAsynchronously(const MemoryCpuLoadArgs &args, DXD::Mesh::MemoryLoadEvent *loadEvent, DXD::LoadPriority priority);
 
-public:
     // Setters for loaders
-    void setCpuData(MeshType meshType, UINT vertexSizeInBytes, UINT verticesCount, UINT indicesCount);
-    void setGpuData(std::unique_ptr<VertexBuffer> &vertexBuffer, std::unique_ptr<IndexBuffer> &indexBuffer);
+    void setCpuData(MeshType meshType, UINT vertexSizeInBytes, UINT verticesCount, UINT indicesCount,
+                    const FLOAT boundsMin[3], const FLOAT boundsMax[3], const FLOAT boundingSphere[4]);
+    void setLods(std::vector<MeshLod> &&lods, std::vector<Meshlet> &&meshlets, std::vector<MeshSubmesh> &&submeshes = std::vector<MeshSubmesh>(1));
+    void uploadGpuData(const void *vertexData, const UINT *indexData);
+    bool isGpuDataUploaded();
+    bool waitForGpuDataUpload(std::chrono::milliseconds timeout);
 
-    // Getters
+    // Getters, bounds are empty until the mesh is ready, since the loader thread writes them
+    XMFLOAT3 getBoundingBoxMin();
+    XMFLOAT3 getBoundingBoxMax();
+    XMFLOAT3 getBoundingSphereCenter();
+    FLOAT getBoundingSphereRadius();
     UINT getVertexSizeInBytes() const { return vertexSizeInBytes; }
     UINT getVerticesCount() const { return verticesCount; }
     UINT getIndicesCount() const { return indicesCount; }
+    DXGI_FORMAT getIndexFormat() const { return indexFormat; }
     MeshType getMeshType() const { return meshType; }
     PipelineStateController::Identifier getPipelineStateIdentifier() const { return pipelineStateIdentifier; }
-    PipelineStateController::Identifier getShadowMapPipelineStateIdentifier() const { return shadowMapPipelineStateIdentifier; }
-    bool isReady() { return loadOperation.isReady(); }
+    PipelineStateController::Identifier getShadowMapPipelineStateIdentifier() const {
+        return meshType & QUANTIZED ? PipelineStateController::Identifier::PIPELINE_STATE_SM_POSITION_QUANTIZED
+                                    : PipelineStateController::Identifier::PIPELINE_STATE_SM_POSITION;
+    }
+    bool isReady();
     bool requiresTexture() const { return meshType & TEXTURE_COORDS; }
+    XMMATRIX getPositionDequantizationMatrix() const; // applies to the full vertices and the position stream
+    const std::vector<Meshlet> &getMeshlets() const { return meshlets; }
+    const std::vector<MeshLod> &getLods() const { return lods; }
+    const std::vector<MeshSubmesh> &getSubmeshes() const { return submeshes; }
+    UINT getSubmeshesCount() const { return static_cast<UINT>(submeshes.size()); }
+    const MeshLod &getLod(UINT lodLevel, UINT submeshIndex) const { return lods[lodLevel * submeshes.size() + submeshIndex]; }
+
+    /// Selects the coarsest level of detail, whose error is not noticeable from given viewpoint. All submeshes
+    /// switch levels together, so there are no cracks between them.
+    /// \param eyePosition camera position in world space
+    /// \param maxErrorPerDistance acceptable error of an object at unit distance from the eye in world space units, it's
+    /// proportional to the size of a pixel at unit distance
+    /// \return level to be passed to getLod
+    UINT selectLodLevel(const XMMATRIX &modelMatrix, const XMFLOAT3 &eyePosition, FLOAT maxErrorPerDistance) const;
+
+    /// Selects index ranges of meshlets potentially visible from given viewpoint. Level of detail without meshlets is
+    /// returned as a single range.
+    /// \param eyePosition camera position in world space, nullptr disables back facing meshlets culling
+    void cullMeshlets(const MeshLod &lod, const XMMATRIX &modelMatrix, const XMMATRIX &viewProjectionMatrix, const XMFLOAT3 *eyePosition,
+                      std::vector<IndexRange> &outVisibleRanges) const;
 
-    auto &getVertexBuffer() { return vertexBuffer; }
-    auto &getIndexBuffer() { return indexBuffer; }
+    // Location of the geometry in the pools of ApplicationImpl, draws address it with these offsets
+    const GeometryAllocation &getVertexAllocation() const { return vertexAllocation; }
+    const GeometryAllocation &getIndexAllocation() const { return indexAllocation; }
+    const GeometryAllocation &getPositionAllocation() const { return positionAllocation; }
+    INT getBaseVertexLocation() const { return vertexAllocation.getFirstElement(); }
+    INT getPositionBaseVertexLocation() const { return positionAllocation.getFirstElement(); }
+    UINT getStartIndexLocation() const { return indexAllocation.isNull() ? 0u : indexAllocation.getFirstElement(); }
 
     // Helpers
     static MeshType computeMeshType(const std::vector<FLOAT> &normals, const std::vector<FLOAT> &textureCoordinates,
@@ -90,24 +284,58 @@ public:
     static UINT computeVertexSize(MeshType meshType);
 
 private:
+    static std::shared_ptr<MeshImpl> acquire(const std::wstring &filePath, UINT loadFlags, const AssetCache<MeshImpl>::Factory &factory, bool &outCreated);
+    static std::shared_ptr<MeshImpl> createWithObjLoadOperation();
+    static std::shared_ptr<MeshImpl> createWithGltfLoadOperation();
+    static std::shared_ptr<MeshImpl> createWithMemoryLoadOperation();
+    bool hasLoadFailed() const;
     static std::map<MeshType, PipelineStateController::Identifier> getPipelineStateIdentifierMap();
     static PipelineStateController::Identifier computePipelineStateIdentifier(MeshType meshType);
-    static std::map<MeshType, PipelineStateController::Identifier> getShadowMapPipelineStateIdentifierMap();
-    static PipelineStateController::Identifier computeShadowMapPipelineStateIdentifier(MeshType meshType);
 
 protected:
-    // Load operation
-    ObjLoadCpuGpuOperation loadOperation;
+    // Load operation, only the one matching source of the geometry is created
+    std::unique_ptr<ObjLoadCpuGpuOperation> objLoadOperation = {};
+    std::unique_ptr<GltfLoadCpuGpuOperation> gltfLoadOperation = {};
+    std::unique_ptr<MemoryLoadCpuGpuOperation> memoryLoadOperation = {};
 
     // CPU data, set during load time
     MeshType meshType = UNKNOWN;
     UINT vertexSizeInBytes = 0;
     UINT verticesCount = 0;
     UINT indicesCount = 0;
+    DXGI_FORMAT indexFormat = DXGI_FORMAT_R32_UINT; // 16-bit if all vertices can be addressed with it
+    XMFLOAT3 boundsMin = {};
+    XMFLOAT3 boundsMax = {};
+    XMFLOAT3 boundingSphereCenter = {};
+    FLOAT boundingSphereRadius = 0.f;
+    std::vector<Meshlet> meshlets = {};
+    std::vector<MeshLod> lods = {};
+    std::vector<MeshSubmesh> submeshes = {}; // meshes without materials have one submesh
     PipelineStateController::Identifier pipelineStateIdentifier;
-    PipelineStateController::Identifier shadowMapPipelineStateIdentifier;
 
     // GPU data, set during upload time
-    std::unique_ptr<VertexBuffer> vertexBuffer = {};
-    std::unique_ptr<IndexBuffer> indexBuffer = {};
+    GeometryAllocation vertexAllocation = {};
+    GeometryAllocation indexAllocation = {};
+    GeometryAllocation positionAllocation = {}; // positions only, for depth only passes
+    GpuDependencies gpuUploadDependencies = {};
+    std::mutex gpuUploadDependenciesLock = {};
+};
+
+/// \brief Implementation of DXD::Mesh returned to the application
+///
+/// Many handles can share one MeshImpl, which is destroyed along with the last handle or DXD::Object using it.
+class MeshHandle : public DXD::Mesh {
+public:
+    MeshHandle(const std::shared_ptr<MeshImpl> &mesh) : mesh(mesh) {}
+
+    // DXD::Mesh overrides
+    XMFLOAT3 getBoundingBoxMin() const override { return mesh->getBoundingBoxMin(); }
+    XMFLOAT3 getBoundingBoxMax() const override { return mesh->getBoundingBoxMax(); }
+    XMFLOAT3 getBoundingSphereCenter() const override { return mesh->getBoundingSphereCenter(); }
+    FLOAT getBoundingSphereRadius() const override { return mesh->getBoundingSphereRadius(); }
+
+    const std::shared_ptr<MeshImpl> &getMeshImpl() const { return mesh; }
+
+private:
+    std::shared_ptr<MeshImpl> mesh;
 };
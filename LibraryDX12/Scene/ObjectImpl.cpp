@@ -1,5 +1,7 @@
 #include "ObjectImpl.h"
 
+#include "Utility/MathHelper.h"
+
 #include <fstream>
 
 class TextureImpl;
@@ -10,7 +12,7 @@ std::unique_ptr<Object> Object::create(DXD::Mesh &mesh) {
 }
 } // namespace DXD
 
-ObjectImpl::ObjectImpl(DXD::Mesh &mesh) : mesh(*static_cast<MeshImpl *>(&mesh)) {
+ObjectImpl::ObjectImpl(DXD::Mesh &mesh) : mesh(static_cast<MeshHandle *>(&mesh)->getMeshImpl()) {
 }
 
 const XMMATRIX &ObjectImpl::getModelMatrix() {
@@ -31,6 +33,7 @@ void ObjectImpl::setPosition(FLOAT x, FLOAT y, FLOAT z) {
 
 void ObjectImpl::setPosition(XMFLOAT3 pos) {
     modelMatrixDirty = true;
+    worldBoundsDirty = true;
     this->position = XMLoadFloat3(&pos);
 }
 
@@ -40,11 +43,13 @@ XMFLOAT3 ObjectImpl::getPosition() const {
 
 void ObjectImpl::setRotation(XMFLOAT3 axis, float angle) {
     modelMatrixDirty = true;
+    worldBoundsDirty = true;
     this->rotationQuaternion = XMQuaternionRotationAxis(XMLoadFloat3(&axis), angle);
 }
 
 void ObjectImpl::setRotation(float roll, float yaw, float pitch) {
     modelMatrixDirty = true;
+    worldBoundsDirty = true;
     this->rotationQuaternion = XMQuaternionRotationRollPitchYaw(pitch, yaw, roll);
 }
 
@@ -58,6 +63,7 @@ void ObjectImpl::setRotationOrigin(FLOAT x, FLOAT y, FLOAT z) {
 
 void ObjectImpl::setRotationOrigin(XMFLOAT3 pos) {
     modelMatrixDirty = true;
+    worldBoundsDirty = true;
     this->rotationOrigin = XMLoadFloat3(&pos);
 }
 
@@ -71,6 +77,7 @@ void ObjectImpl::setScale(FLOAT x, FLOAT y, FLOAT z) {
 
 void ObjectImpl::setScale(XMFLOAT3 scale) {
     modelMatrixDirty = true;
+    worldBoundsDirty = true;
     this->scale = XMLoadFloat3(&scale);
 }
 
@@ -102,6 +109,16 @@ float ObjectImpl::getBloomFactor() const {
     return bloomFactor;
 }
 
+void ObjectImpl::setTexture(DXD::Texture *texture) {
+    this->texture = texture;
+    this->textureImpl = TextureHandle::getTextureImpl(texture);
+}
+
+void ObjectImpl::setNormalMap(DXD::Texture *normalMap) {
+    this->normalMap = normalMap;
+    this->normalMapImpl = TextureHandle::getTextureImpl(normalMap);
+}
+
 void ObjectImpl::setTextureScale(float u, float v) {
     this->textureScale = {u, v};
 }
@@ -115,10 +132,50 @@ XMFLOAT2 ObjectImpl::getTextureScale() const {
 }
 
 bool ObjectImpl::isReady() {
-    if (!mesh.isReady()) {
+    if (!mesh->isReady()) {
         return false;
     }
 
-    const bool textureReady = !mesh.requiresTexture() || (texture != nullptr && texture->isReady());
+    const bool textureReady = !mesh->requiresTexture() || (textureImpl != nullptr && textureImpl->isReady());
     return textureReady;
 }
+
+XMFLOAT3 ObjectImpl::getWorldBoundingBoxMin() {
+    updateWorldBounds();
+    return worldBoundingBoxMin;
+}
+
+XMFLOAT3 ObjectImpl::getWorldBoundingBoxMax() {
+    updateWorldBounds();
+    return worldBoundingBoxMax;
+}
+
+XMFLOAT3 ObjectImpl::getWorldBoundingSphereCenter() {
+    updateWorldBounds();
+    return worldBoundingSphereCenter;
+}
+
+FLOAT ObjectImpl::getWorldBoundingSphereRadius() {
+    updateWorldBounds();
+    return worldBoundingSphereRadius;
+}
+
+void ObjectImpl::updateWorldBounds() {
+    if (!worldBoundsDirty) {
+        return;
+    }
+
+    // Mesh bounds are empty until the mesh is ready, so until then the object is treated as a point and its
+    // bounds are recomputed on every call
+    const bool meshReady = mesh->isReady();
+    const XMFLOAT3 boundsMin = mesh->getBoundingBoxMin();
+    const XMFLOAT3 boundsMax = mesh->getBoundingBoxMax();
+    const XMFLOAT3 sphereCenter = mesh->getBoundingSphereCenter();
+    const FLOAT sphereRadius = mesh->getBoundingSphereRadius();
+
+    const XMMATRIX &modelMatrix = getModelMatrix();
+    MathHelper::transformBoundingBox(boundsMin, boundsMax, modelMatrix, worldBoundingBoxMin, worldBoundingBoxMax);
+    worldBoundingSphereCenter = XMStoreFloat3(XMVector3TransformCoord(XMLoadFloat3(&sphereCenter), modelMatrix));
+    worldBoundingSphereRadius = sphereRadius * MathHelper::getMaxScale(modelMatrix);
+    worldBoundsDirty = !meshReady;
+}
@@ -6,14 +6,16 @@
 #include "DXD/Mesh.h"
 #include "DXD/Object.h"
 
+#include <memory>
+
 class ObjectImpl : public DXD::Object {
 protected:
     friend class DXD::Object;
     ObjectImpl(DXD::Mesh &mesh);
 
 public:
-    MeshImpl &getMesh() { return mesh; }
-    const MeshImpl &getMesh() const { return mesh; }
+    MeshImpl &getMesh() { return *mesh; }
+    const MeshImpl &getMesh() const { return *mesh; }
     const XMMATRIX &getModelMatrix();
 
     void setPosition(FLOAT x, FLOAT y, FLOAT z) override;
@@ -41,24 +43,34 @@ public:
     void setBloomFactor(float bloomFactor) override;
     float getBloomFactor() const override;
 
-    void setTexture(DXD::Texture *texture) override { this->texture = static_cast<TextureImpl *>(texture); }
+    void setTexture(DXD::Texture *texture) override;
     DXD::Texture *getTexture() override { return texture; }
-    TextureImpl *getTextureImpl() { return texture; }
+    TextureImpl *getTextureImpl() { return textureImpl.get(); }
 
-    void setNormalMap(DXD::Texture *normalMap) override { this->normalMap = static_cast<TextureImpl *>(normalMap); }
+    void setNormalMap(DXD::Texture *normalMap) override;
     DXD::Texture *getNormalMap() override { return normalMap; }
-    TextureImpl *getNormalMapImpl() { return normalMap; }
+    TextureImpl *getNormalMapImpl() { return normalMapImpl.get(); }
 
     void setTextureScale(float u, float v) override;
     void setTextureScale(XMFLOAT2 uv) override;
     XMFLOAT2 getTextureScale() const override;
 
+    XMFLOAT3 getWorldBoundingBoxMin() override;
+    XMFLOAT3 getWorldBoundingBoxMax() override;
+    XMFLOAT3 getWorldBoundingSphereCenter() override;
+    FLOAT getWorldBoundingSphereRadius() override;
+
     bool isReady();
 
 protected:
-    MeshImpl &mesh;
-    TextureImpl *texture = {};
-    TextureImpl *normalMap = {};
+    void updateWorldBounds();
+
+    // Shared assets are kept alive as long as the object uses them
+    std::shared_ptr<MeshImpl> mesh;
+    DXD::Texture *texture = {};
+    DXD::Texture *normalMap = {};
+    std::shared_ptr<TextureImpl> textureImpl = {};
+    std::shared_ptr<TextureImpl> normalMapImpl = {};
     XMFLOAT2 textureScale = {1, 1};
 
     XMVECTOR scale = {1, 1, 1};
@@ -72,4 +84,10 @@ protected:
 
     XMMATRIX modelMatrix;
     bool modelMatrixDirty = true;
+
+    XMFLOAT3 worldBoundingBoxMin = {};
+    XMFLOAT3 worldBoundingBoxMax = {};
+    XMFLOAT3 worldBoundingSphereCenter = {};
+    FLOAT worldBoundingSphereRadius = 0.f;
+    bool worldBoundsDirty = true;
 };
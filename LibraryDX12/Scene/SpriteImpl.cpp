@@ -6,11 +6,11 @@
 namespace DXD {
 std::unique_ptr<Sprite> Sprite::create(Texture &texture, int textureSizeX, int textureOffsetX, int textureSizeY, int textureOffsetY,
                                        HorizontalAlignment horizontalAlignment, VerticalAlignment verticalAlignment) {
-    return std::unique_ptr<Sprite>(new SpriteImpl(*static_cast<TextureImpl *>(&texture), textureSizeX, textureOffsetX, textureSizeY, textureOffsetY, horizontalAlignment, verticalAlignment));
+    return std::unique_ptr<Sprite>(new SpriteImpl(TextureHandle::getTextureImpl(&texture), textureSizeX, textureOffsetX, textureSizeY, textureOffsetY, horizontalAlignment, verticalAlignment));
 }
 } // namespace DXD
 
-SpriteImpl::SpriteImpl(TextureImpl &texture, int textureSizeX, int textureOffsetX, int textureSizeY, int textureOffsetY,
+SpriteImpl::SpriteImpl(const std::shared_ptr<TextureImpl> &texture, int textureSizeX, int textureOffsetX, int textureSizeY, int textureOffsetY,
                        HorizontalAlignment horizontalAlignment, VerticalAlignment verticalAlignment)
     : texture(texture), textureSizeX(textureSizeX), textureOffsetX(textureOffsetX), textureSizeY(textureSizeY), textureOffsetY(textureOffsetY), horizontalAlignment(horizontalAlignment), verticalAlignment(verticalAlignment) {
 }
@@ -7,21 +7,23 @@
 #include "DXD/Texture.h"
 
 #include <ExternalHeaders/Wrappers/d3dx12.h>
+#include <memory>
+
 class TextureImpl;
 class SpriteImpl : public DXD::Sprite {
 protected:
     friend class DXD::Sprite;
 
 public:
-    SpriteImpl(TextureImpl &texture, int textureSizeX, int textureOffsetX, int textureSizeY, int textureOffsetY,
+    SpriteImpl(const std::shared_ptr<TextureImpl> &texture, int textureSizeX, int textureOffsetX, int textureSizeY, int textureOffsetY,
                HorizontalAlignment horizontalAlignment, VerticalAlignment verticalAlignment);
     ~SpriteImpl() = default;
 
-    TextureImpl &getTextureImpl() { return texture; }
+    TextureImpl &getTextureImpl() { return *texture; }
     SpriteCB getData();
 
 private:
-    TextureImpl &texture;
+    std::shared_ptr<TextureImpl> texture;
     int textureSizeX;
     int textureOffsetX;
     int textureSizeY;
@@ -1,3 +1,5 @@
+#include "vertex_quantization.hlsli"
+
 struct ModelViewProjection {
     matrix modelMatrix;
     matrix mvpMatrix;
@@ -7,7 +9,7 @@ ConstantBuffer<ModelViewProjection> mmvp : register(b0);
 
 struct VertexShaderInput {
     float3 Position : POSITION;
-    float3 Normal : NORMAL;
+    PACKED_DIRECTION Normal : NORMAL;
 };
 
 struct VertexShaderOutput {
@@ -17,9 +19,10 @@ struct VertexShaderOutput {
 
 VertexShaderOutput main(VertexShaderInput IN) {
     VertexShaderOutput OUT;
+    const float3 normal = unpackDirection(IN.Normal);
 
     OUT.Position = mul(mmvp.mvpMatrix, float4(IN.Position, 1.0f));
-    OUT.Normal = mul(mmvp.modelMatrix, float4(IN.Normal, 0.0f));
+    OUT.Normal = mul(mmvp.modelMatrix, float4(normal, 0.0f));
 
     return OUT;
 }
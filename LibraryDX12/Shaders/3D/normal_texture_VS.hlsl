@@ -1,3 +1,5 @@
+#include "vertex_quantization.hlsli"
+
 struct NormalTextureCB {
     matrix modelMatrix;
     matrix mvpMatrix;
@@ -8,7 +10,7 @@ ConstantBuffer<NormalTextureCB> cb : register(b0);
 
 struct VertexShaderInput {
     float3 Position : POSITION;
-    float3 Normal : NORMAL;
+    PACKED_DIRECTION Normal : NORMAL;
     float2 UV : TEXCOORD;
 };
 
@@ -20,8 +22,9 @@ struct VertexShaderOutput {
 
 VertexShaderOutput main(VertexShaderInput IN) {
     VertexShaderOutput OUT;
+    const float3 normal = unpackDirection(IN.Normal);
     OUT.Position = mul(cb.mvpMatrix, float4(IN.Position, 1.0f));
-    OUT.Normal = mul(cb.modelMatrix, float4(IN.Normal, 0.0f));
+    OUT.Normal = mul(cb.modelMatrix, float4(normal, 0.0f));
     OUT.UV = IN.UV * cb.textureScale;
     return OUT;
 }
@@ -1,3 +1,5 @@
+#include "vertex_quantization.hlsli"
+
 struct TextureNormalMapCB {
     matrix modelMatrix;
     matrix modelViewProjectionMatrix;
@@ -10,8 +12,8 @@ ConstantBuffer<TextureNormalMapCB> cb : register(b0);
 
 struct VertexShaderInput {
     float3 Position : POSITION;
-    float3 Normal : NORMAL;
-    float3 Tangent : TANGENT;
+    PACKED_DIRECTION Normal : NORMAL;
+    PACKED_DIRECTION Tangent : TANGENT;
     float2 UV : TEXCOORD;
 };
 
@@ -23,18 +25,20 @@ struct VertexShaderOutput {
 
 VertexShaderOutput main(VertexShaderInput IN) {
     VertexShaderOutput OUT;
+    const float3 normal = unpackDirection(IN.Normal);
+    const float3 tangent = unpackDirection(IN.Tangent);
     OUT.Position = mul(cb.modelViewProjectionMatrix, float4(IN.Position, 1.0f));
     OUT.UV = IN.UV * cb.textureScale;
 
     if (cb.normalMapAvailable) {
         // Pixel shader will sample normal from the normal map and use TBN matrix to transform it
-        const float3 bitangent = cross(IN.Normal, IN.Tangent);
-        OUT.tbn = transpose(float3x3(IN.Tangent, bitangent, IN.Normal));
+        const float3 bitangent = cross(normal, tangent);
+        OUT.tbn = transpose(float3x3(tangent, bitangent, normal));
         OUT.tbn = mul(cb.modelMatrix, OUT.tbn);
     } else {
         // Pixel shader will use per-vertex normal, we can pass it in the matrix
-        const float3 normal = mul(cb.modelMatrix, IN.Normal);
-        OUT.tbn = float3x3(normal, float3(0, 0, 0), float3(0, 0, 0));
+        const float3 worldNormal = mul(cb.modelMatrix, normal);
+        OUT.tbn = float3x3(worldNormal, float3(0, 0, 0), float3(0, 0, 0));
     }
 
     return OUT;
@@ -0,0 +1,23 @@
+// Decoding of vertex attributes for meshes with quantized vertices (see QuantizedVertexLayout)
+// QUANTIZED - defined for quantized vertices, not defined for float vertices
+//
+// Positions and texture coordinates are converted by the input assembler. Positions stay relative
+// to mesh bounds, which is accounted for in the matrices. Directions (normals and tangents) are
+// octahedral-encoded in two components and have to be decoded in the shader.
+
+#ifdef QUANTIZED
+#define PACKED_DIRECTION float2
+
+float3 unpackDirection(float2 encoded) {
+    float3 direction = float3(encoded.x, encoded.y, 1.0f - abs(encoded.x) - abs(encoded.y));
+    const float fold = saturate(-direction.z);
+    direction.xy += (direction.xy >= 0.0f) ? -fold : fold;
+    return normalize(direction);
+}
+#else
+#define PACKED_DIRECTION float3
+
+float3 unpackDirection(float3 direction) {
+    return direction;
+}
+#endif
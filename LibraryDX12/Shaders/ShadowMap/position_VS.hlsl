@@ -6,7 +6,6 @@ ConstantBuffer<ShadowMapCB> cb : register(b0);
 
 struct VertexShaderInput {
     float3 Position : POSITION;
-    float3 Normal : NORMAL;
 };
 
 struct VertexShaderOutput {
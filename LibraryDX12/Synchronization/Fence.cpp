@@ -13,6 +13,22 @@ void Fence::waitOnCpu(UINT64 fenceValue) const {
     event.wait();
 }
 
+bool Fence::waitOnCpu(UINT64 fenceValue, std::chrono::milliseconds timeout) const {
+    // Every thread waits on its own event, so concurrent waits for different values do not consume each other's
+    // signals. Event may be signalled late by a wait which has timed out, hence the value is checked after waking up
+    thread_local const KernelEvent completionEvent{};
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!isComplete(fenceValue)) {
+        const auto remainingTime = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+        if (remainingTime.count() <= 0) {
+            return false;
+        }
+        throwIfFailed(fence->SetEventOnCompletion(fenceValue, completionEvent.getHandle()));
+        completionEvent.tryWait(static_cast<DWORD>(remainingTime.count()));
+    }
+    return true;
+}
+
 uint64_t Fence::signal(ID3D12CommandQueuePtr commandQueue) {
     // Updates fenceValue to value being signaled
     lastSignalledFence++;
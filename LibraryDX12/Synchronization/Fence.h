@@ -5,6 +5,7 @@
 #include "DXD/Utility/NonCopyableAndMovable.h"
 
 #include <DXD/ExternalHeadersWrappers/d3d12.h>
+#include <chrono>
 #include <stdint.h>
 
 class Fence : DXD::NonCopyable {
@@ -14,6 +15,7 @@ public:
     Fence &operator=(Fence &&other) = default;
 
     void waitOnCpu(UINT64 fenceValue) const;
+    bool waitOnCpu(UINT64 fenceValue, std::chrono::milliseconds timeout) const;
     uint64_t signal(ID3D12CommandQueuePtr commandQueue);
 
     bool isComplete(UINT64 fenceValue) const;
@@ -36,3 +36,7 @@ void KernelEvent::wait(DWORD milliseconds) const {
 void KernelEvent::wait(std::chrono::milliseconds duration) const {
     wait(static_cast<DWORD>(duration.count()));
 }
+
+bool KernelEvent::tryWait(DWORD milliseconds) const {
+    return ::WaitForSingleObject(this->handle, milliseconds) == WAIT_OBJECT_0;
+}
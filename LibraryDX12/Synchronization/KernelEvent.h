@@ -17,6 +17,10 @@ public:
     void wait(DWORD milliseconds) const;
     void wait(std::chrono::milliseconds duration) const;
 
+    /// Waits until the event is signalled or the timeout passes
+    /// \return true if the event has been signalled
+    bool tryWait(DWORD milliseconds) const;
+
     HANDLE getHandle() const { return handle; }
 
 protected:
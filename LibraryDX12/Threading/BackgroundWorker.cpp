@@ -1,38 +1,71 @@
 #include "BackgroundWorker.h"
 
+#include "Threading/BackgroundWorkerController.h"
+
 #include <Objbase.h>
 
-BackgroundWorker::BackgroundWorker(TaskQueue &taskQueue, const std::atomic_bool &terminate)
-    : thread(work, std::reference_wrapper<TaskQueue>(taskQueue), std::reference_wrapper<const std::atomic_bool>(terminate)) {
+thread_local BackgroundWorker *BackgroundWorker::currentWorker = nullptr;
+
+BackgroundWorker::BackgroundWorker(BackgroundWorkerController &controller, UINT workerIndex)
+    : controller(controller),
+      workerIndex(workerIndex),
+      randomState(workerIndex * 2654435761u + 1u) {
 }
 
 BackgroundWorker::~BackgroundWorker() {
+    join();
+}
+
+void BackgroundWorker::start() {
+    thread = std::thread{&BackgroundWorker::work, this};
+}
+
+void BackgroundWorker::join() {
     if (thread.joinable()) {
         thread.join();
     }
 }
 
-void BackgroundWorker::work(TaskQueue &taskQueue, const std::atomic_bool &terminate) {
+UINT BackgroundWorker::getRandomNumber() {
+    // Xorshift32, quality is irrelevant for picking victims
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return randomState;
+}
+
+void BackgroundWorker::execute(TaskData *taskData) {
+    // Execute task
+    if (taskData->cancellationToken.tryStart()) {
+        const TaskPriority previousTaskPriority = currentTaskPriority;
+        currentTaskPriority = taskData->priority;
+        taskData->task();
+        currentTaskPriority = previousTaskPriority;
+    }
+
+    // Signal completion to user
+    if (taskData->completed) {
+        taskData->completed->store(true);
+    }
+    if (taskData->completeCV) {
+        taskData->completeCV->notify_one();
+    }
+    controller.releaseTaskData(*this, taskData);
+}
+
+void BackgroundWorker::work() {
     CoInitializeEx(NULL, COINIT_APARTMENTTHREADED);
+    currentWorker = this;
 
-    while (!terminate.load()) {
-        // Try to pop task from queue
-        TaskData taskData = {};
-        const bool obtained = taskQueue.blockingPop(taskData);
-
-        if (obtained) {
-            // Execute task
-            taskData.task();
-
-            // Signal completion to user
-            if (taskData.completed) {
-                taskData.completed->store(true);
-            }
-            if (taskData.completeCV) {
-                taskData.completeCV->notify_one();
-            }
+    while (!controller.isTerminating()) {
+        TaskData *taskData = controller.findTask(*this);
+        if (taskData != nullptr) {
+            execute(taskData);
+        } else {
+            controller.waitForTasks();
         }
     }
 
+    currentWorker = nullptr;
     CoUninitialize();
 }
@@ -1,29 +1,81 @@
 #pragma once
 
-#include "Threading/BlockingQueue.h"
+#include "Threading/CancellationToken.h"
+#include "Threading/Task.h"
+#include "Threading/WorkStealingDeque.h"
 
+#include <DXD/ExternalHeadersWrappers/windows.h>
 #include <atomic>
+#include <condition_variable>
+#include <cstdint>
 #include <thread>
-#include <functional>
+#include <vector>
 
+class BackgroundWorkerController;
+
+/// Tasks of higher priority are always taken before tasks of lower priority
+enum class TaskPriority {
+    CRITICAL,
+    NORMAL,
+    BACKGROUND,
+};
+constexpr UINT taskPrioritiesCount = 3u;
+
+/// \brief Thread executing tasks of BackgroundWorkerController
+///
+/// Each worker owns a deque of tasks for every priority. Tasks pushed from the worker thread itself, e.g.
+/// subtasks of executeInParallel, are put to its own deque without any locking and popped in LIFO order,
+/// while their data is still in the cache. When the deque is empty, worker looks for tasks in the controller.
+/// Data of executed tasks is kept by the worker and reused for the next tasks it pushes, so pushing a task
+/// does not allocate memory in the steady state.
 class BackgroundWorker {
 public:
-    using Task = std::function<void()>;
+    using Task = ::Task;
     struct TaskData {
         Task task;
         std::condition_variable *completeCV;
         std::atomic_bool *completed;
+        TaskPriority priority = TaskPriority::NORMAL;
+        CancellationToken cancellationToken = {}; // cancelled tasks are discarded instead of executed
     };
-    using TaskQueue = BlockingQueue<TaskData>;
+    using TaskDeque = WorkStealingDeque<TaskData *>;
 
-    BackgroundWorker(TaskQueue &taskQueue, const std::atomic_bool &terminate);
-    BackgroundWorker(BackgroundWorker &&other) {
-        this->thread = std::move(other.thread);
-    }
-    BackgroundWorker &operator=(BackgroundWorker &&) = delete;
+    BackgroundWorker(BackgroundWorkerController &controller, UINT workerIndex);
+    BackgroundWorker(const BackgroundWorker &) = delete;
+    BackgroundWorker &operator=(const BackgroundWorker &) = delete;
     ~BackgroundWorker();
 
+    /// Starts the thread, has to be called once all workers of the controller are created
+    void start();
+    void join();
+
+    /// \return worker running in the calling thread or nullptr if it's not a background worker thread
+    static BackgroundWorker *getCurrentWorker() { return currentWorker; }
+
+    BackgroundWorkerController &getController() { return controller; }
+    UINT getWorkerIndex() const { return workerIndex; }
+    TaskDeque &getTaskDeque(TaskPriority priority) { return taskDeques[static_cast<UINT>(priority)]; }
+    std::vector<TaskData *> &getFreeTaskData() { return freeTaskData; }
+
+    /// \return priority of the task being executed by the calling worker or NORMAL if it's not a background worker thread
+    static TaskPriority getCurrentTaskPriority() { return currentWorker != nullptr ? currentWorker->currentTaskPriority : TaskPriority::NORMAL; }
+
+    /// Cheap random number generator for picking stealing victims, may be used only by the worker thread
+    UINT getRandomNumber();
+
+    /// Runs the task unless it's been cancelled, signals its completion and releases it for reuse
+    void execute(TaskData *taskData);
+
 private:
-    static void work(TaskQueue &taskQueue, const std::atomic_bool &terminate);
-    std::thread thread;
+    void work();
+
+    static thread_local BackgroundWorker *currentWorker;
+
+    BackgroundWorkerController &controller;
+    const UINT workerIndex;
+    TaskDeque taskDeques[taskPrioritiesCount];
+    std::vector<TaskData *> freeTaskData = {}; // released task data to reuse, accessed only by the worker thread
+    TaskPriority currentTaskPriority = TaskPriority::NORMAL;
+    uint32_t randomState;
+    std::thread thread{};
 };
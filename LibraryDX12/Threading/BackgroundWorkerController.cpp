@@ -1,42 +1,364 @@
 #include "BackgroundWorkerController.h"
 
-BackgroundWorkerController::BackgroundWorkerController() {
-    auto concurentThreadsSupported = std::thread::hardware_concurrency();
-    if (concurentThreadsSupported == 0u) {
-        concurentThreadsSupported = 1u;
-    }
+#include <algorithm>
+#include <memory>
+#include <mutex>
+
+// ------------------------------------------------------------------------------------- Creation and destruction
+
+namespace {
+UINT getDefaultWorkersCount() {
+    const auto concurentThreadsSupported = std::thread::hardware_concurrency();
+    return concurentThreadsSupported == 0u ? 1u : concurentThreadsSupported;
+}
+} // namespace
+
+BackgroundWorkerController::BackgroundWorkerController() : BackgroundWorkerController(getDefaultWorkersCount()) {}
 
-    for (auto i = 0u; i < concurentThreadsSupported; i++) {
-        this->workers.emplace_back(taskQueue, terminate);
+BackgroundWorkerController::BackgroundWorkerController(UINT workersCount) {
+    // Threads are started after all workers exist, since they may steal from each other right away
+    for (auto i = 0u; i < workersCount; i++) {
+        this->workers.push_back(std::make_unique<BackgroundWorker>(*this, i));
+        this->workers.back()->getFreeTaskData().reserve(maxFreeTaskDataPerWorker + 1);
+    }
+    sharedFreeTaskData.reserve(maxSharedFreeTaskDataCount);
+    for (auto &worker : workers) {
+        worker->start();
     }
 }
 
 BackgroundWorkerController::~BackgroundWorkerController() {
-    terminate.store(true);
-    taskQueue.clear();
-    workers.clear();
+    stop();
 }
 
+void BackgroundWorkerController::stop() {
+    {
+        std::lock_guard<std::mutex> lock{sleepLock};
+        terminate.store(true);
+        wakeCV.notify_all();
+    }
+
+    // Join the threads before discarding tasks, they may still be pushing new ones
+    for (auto &worker : workers) {
+        worker->join();
+    }
+    for (auto priority = 0u; priority < taskPrioritiesCount; priority++) {
+        for (auto &worker : workers) {
+            BackgroundWorker::TaskData *task{};
+            while (worker->getTaskDeque(static_cast<TaskPriority>(priority)).pop(task)) {
+                delete task;
+            }
+        }
+        for (BackgroundWorker::TaskData *task : sharedQueues[priority].tasks) {
+            delete task;
+        }
+        sharedQueues[priority].tasks.clear();
+        sharedQueues[priority].size.store(0u);
+    }
+    for (auto &worker : workers) {
+        for (BackgroundWorker::TaskData *taskData : worker->getFreeTaskData()) {
+            delete taskData;
+        }
+        worker->getFreeTaskData().clear();
+    }
+    for (BackgroundWorker::TaskData *taskData : sharedFreeTaskData) {
+        delete taskData;
+    }
+    sharedFreeTaskData.clear();
+    sharedFreeTaskDataCount.store(0u);
+}
+
+// ------------------------------------------------------------------------------------- Pushing tasks
+
 void BackgroundWorkerController::pushTask(BackgroundWorker::Task task) {
-    BackgroundWorker::TaskData taskData{task, nullptr, nullptr};
-    pushTask(taskData);
+    pushTask(BackgroundWorker::TaskData{std::move(task), nullptr, nullptr});
 }
 
 void BackgroundWorkerController::pushTask(BackgroundWorker::Task task, std::atomic_bool &completed) {
-    BackgroundWorker::TaskData taskData{task, nullptr, &completed};
-    pushTask(taskData);
+    pushTask(BackgroundWorker::TaskData{std::move(task), nullptr, &completed});
 }
 
 void BackgroundWorkerController::pushTask(BackgroundWorker::Task task, std::condition_variable &completed) {
-    BackgroundWorker::TaskData taskData{task, &completed, nullptr};
-    pushTask(taskData);
+    pushTask(BackgroundWorker::TaskData{std::move(task), &completed, nullptr});
 }
 
 void BackgroundWorkerController::pushTask(BackgroundWorker::Task task, std::atomic_bool &completed, std::condition_variable &completedCV) {
-    BackgroundWorker::TaskData taskData{task, &completedCV, &completed};
-    pushTask(taskData);
+    pushTask(BackgroundWorker::TaskData{std::move(task), &completedCV, &completed});
+}
+
+void BackgroundWorkerController::pushTask(BackgroundWorker::Task task, TaskPriority priority, const CancellationToken &cancellationToken) {
+    pushTask(BackgroundWorker::TaskData{std::move(task), nullptr, nullptr, priority, cancellationToken});
 }
 
 void BackgroundWorkerController::pushTask(BackgroundWorker::TaskData taskData) {
-    taskQueue.push(taskData);
+    const TaskPriority priority = taskData.priority;
+    BackgroundWorker *currentWorker = BackgroundWorker::getCurrentWorker();
+    if (currentWorker != nullptr && &currentWorker->getController() == this) {
+        BackgroundWorker::TaskData *task = acquireTaskData(*currentWorker);
+        *task = std::move(taskData);
+        currentWorker->getTaskDeque(priority).push(task);
+    } else {
+        SharedQueue &sharedQueue = sharedQueues[static_cast<UINT>(priority)];
+        std::lock_guard<std::mutex> lock{sharedQueueLock};
+        BackgroundWorker::TaskData *task = acquireSharedTaskData();
+        *task = std::move(taskData);
+        sharedQueue.tasks.push_back(task);
+        sharedQueue.size.store(sharedQueue.tasks.size());
+    }
+    wakeWorker();
+}
+
+BackgroundWorker::TaskData *BackgroundWorkerController::acquireTaskData(BackgroundWorker &worker) {
+    // Workers which push more tasks than they execute refill their free list from the other workers' surplus
+    std::vector<BackgroundWorker::TaskData *> &freeTaskData = worker.getFreeTaskData();
+    if (freeTaskData.empty() && sharedFreeTaskDataCount.load() > 0u) {
+        std::lock_guard<std::mutex> lock{sharedQueueLock};
+        const size_t batchSize = std::min(maxSharedQueueBatchSize, sharedFreeTaskData.size());
+        freeTaskData.insert(freeTaskData.end(), sharedFreeTaskData.end() - batchSize, sharedFreeTaskData.end());
+        sharedFreeTaskData.resize(sharedFreeTaskData.size() - batchSize);
+        sharedFreeTaskDataCount.store(sharedFreeTaskData.size());
+    }
+    if (freeTaskData.empty()) {
+        return new BackgroundWorker::TaskData{};
+    }
+    BackgroundWorker::TaskData *taskData = freeTaskData.back();
+    freeTaskData.pop_back();
+    return taskData;
+}
+
+BackgroundWorker::TaskData *BackgroundWorkerController::acquireSharedTaskData() {
+    // Called with sharedQueueLock held
+    if (sharedFreeTaskData.empty()) {
+        return new BackgroundWorker::TaskData{};
+    }
+    BackgroundWorker::TaskData *taskData = sharedFreeTaskData.back();
+    sharedFreeTaskData.pop_back();
+    sharedFreeTaskDataCount.store(sharedFreeTaskData.size());
+    return taskData;
+}
+
+// ------------------------------------------------------------------------------------- Interface for the workers
+
+BackgroundWorker::TaskData *BackgroundWorkerController::findTask(BackgroundWorker &worker) {
+    for (auto priorityIndex = 0u; priorityIndex < taskPrioritiesCount; priorityIndex++) {
+        const auto priority = static_cast<TaskPriority>(priorityIndex);
+        BackgroundWorker::TaskData *task{};
+        if (worker.getTaskDeque(priority).pop(task)) {
+            return task;
+        }
+        task = popFromSharedQueue(worker, priority);
+        if (task != nullptr) {
+            return task;
+        }
+        task = steal(worker, priority);
+        if (task != nullptr) {
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+void BackgroundWorkerController::waitForTasks() {
+    std::unique_lock<std::mutex> lock{sleepLock};
+    sleepingWorkersCount++;
+
+    // Pushing threads check for sleeping workers after publishing a task, so either they see this worker
+    // or it sees their task. Fences prevent both sides from reading stale values at the same time.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!hasPendingTasks() && !terminate.load()) {
+        wakeCV.wait(lock);
+    }
+    sleepingWorkersCount--;
+}
+
+void BackgroundWorkerController::releaseTaskData(BackgroundWorker &worker, BackgroundWorker::TaskData *taskData) {
+    // Captured state of the task is destroyed right away, only the storage is kept
+    *taskData = BackgroundWorker::TaskData{};
+    std::vector<BackgroundWorker::TaskData *> &freeTaskData = worker.getFreeTaskData();
+    freeTaskData.push_back(taskData);
+    if (freeTaskData.size() <= maxFreeTaskDataPerWorker) {
+        return;
+    }
+
+    // Worker executes tasks pushed by other threads, hand a batch over to them
+    std::lock_guard<std::mutex> lock{sharedQueueLock};
+    for (auto i = 0u; i < maxSharedQueueBatchSize; i++) {
+        if (sharedFreeTaskData.size() < maxSharedFreeTaskDataCount) {
+            sharedFreeTaskData.push_back(freeTaskData.back());
+        } else {
+            delete freeTaskData.back();
+        }
+        freeTaskData.pop_back();
+    }
+    sharedFreeTaskDataCount.store(sharedFreeTaskData.size());
+}
+
+BackgroundWorker::TaskData *BackgroundWorkerController::popFromSharedQueue(BackgroundWorker &worker, TaskPriority priority) {
+    SharedQueue &sharedQueue = sharedQueues[static_cast<UINT>(priority)];
+    if (sharedQueue.size.load() == 0u) {
+        return nullptr;
+    }
+
+    // Take a fair share of the queue, one task to execute and the rest to the deque, where others can steal them
+    std::lock_guard<std::mutex> lock{sharedQueueLock};
+    if (sharedQueue.tasks.empty()) {
+        return nullptr;
+    }
+    const size_t fairShare = sharedQueue.tasks.size() / getWorkersCount() + 1;
+    const size_t batchSize = std::min({maxSharedQueueBatchSize, fairShare, sharedQueue.tasks.size()});
+    BackgroundWorker::TaskData *result = sharedQueue.tasks.front();
+    sharedQueue.tasks.pop_front();
+    for (auto i = 1u; i < batchSize; i++) {
+        worker.getTaskDeque(priority).push(sharedQueue.tasks.front());
+        sharedQueue.tasks.pop_front();
+    }
+    sharedQueue.size.store(sharedQueue.tasks.size());
+    if (batchSize > 1u) {
+        wakeWorker();
+    }
+    return result;
+}
+
+BackgroundWorker::TaskData *BackgroundWorkerController::steal(BackgroundWorker &worker, TaskPriority priority) {
+    // Visit all other workers, starting from a random one, so thieves do not gang up on the same victim
+    const UINT workersCount = getWorkersCount();
+    const UINT firstVictimIndex = worker.getRandomNumber() % workersCount;
+    for (auto i = 0u; i < workersCount; i++) {
+        BackgroundWorker &victim = *workers[(firstVictimIndex + i) % workersCount];
+        BackgroundWorker::TaskData *task{};
+        if (&victim != &worker && victim.getTaskDeque(priority).steal(task)) {
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+bool BackgroundWorkerController::hasPendingTasks() const {
+    for (auto priority = 0u; priority < taskPrioritiesCount; priority++) {
+        if (sharedQueues[priority].size.load() > 0u) {
+            return true;
+        }
+        const bool hasQueuedTasks = std::any_of(workers.begin(), workers.end(), [priority](const std::unique_ptr<BackgroundWorker> &worker) {
+            return worker->getTaskDeque(static_cast<TaskPriority>(priority)).getSizeApproximation() > 0u;
+        });
+        if (hasQueuedTasks) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void BackgroundWorkerController::wakeWorker() {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (sleepingWorkersCount.load() > 0u) {
+        std::lock_guard<std::mutex> lock{sleepLock};
+        wakeCV.notify_one();
+    }
+}
+
+// ------------------------------------------------------------------------------------- Data-parallel execution
+
+void BackgroundWorkerController::executeInParallel(UINT subtasksCount, const std::function<void(UINT)> &subtask) {
+    if (subtasksCount == 0u) {
+        return;
+    }
+
+    // State is shared, because helper tasks may be dequeued after all subtasks have been executed
+    struct ParallelExecution {
+        std::function<void(UINT)> subtask;
+        UINT subtasksCount;
+        std::atomic<UINT> nextSubtaskIndex = 0u;
+        std::atomic<UINT> completedSubtasksCount = 0u;
+        std::mutex completionLock = {};
+        std::condition_variable completionCV = {};
+    };
+    auto execution = std::make_shared<ParallelExecution>();
+    execution->subtask = subtask;
+    execution->subtasksCount = subtasksCount;
+
+    auto executeSubtasks = [execution]() {
+        for (UINT index = execution->nextSubtaskIndex++; index < execution->subtasksCount; index = execution->nextSubtaskIndex++) {
+            execution->subtask(index);
+            if (++execution->completedSubtasksCount == execution->subtasksCount) {
+                std::lock_guard<std::mutex> lock{execution->completionLock};
+                execution->completionCV.notify_all();
+            }
+        }
+    };
+
+    // Calling thread takes one share of the work, so it cannot get stuck waiting for busy workers
+    const UINT helpersCount = std::min(subtasksCount - 1, getWorkersCount());
+    const TaskPriority priority = BackgroundWorker::getCurrentTaskPriority();
+    for (auto i = 0u; i < helpersCount; i++) {
+        pushTask(executeSubtasks, priority);
+    }
+    executeSubtasks();
+
+    std::unique_lock<std::mutex> lock{execution->completionLock};
+    execution->completionCV.wait(lock, [&execution]() { return execution->completedSubtasksCount == execution->subtasksCount; });
+}
+
+void BackgroundWorkerController::parallelFor(size_t begin, size_t end, size_t grainSize, const std::function<void(size_t, size_t)> &body) {
+    parallelFor(begin, end, grainSize, BackgroundWorker::getCurrentTaskPriority(), body);
+}
+
+void BackgroundWorkerController::parallelFor(size_t begin, size_t end, size_t grainSize, TaskPriority priority, const std::function<void(size_t, size_t)> &body) {
+    executeRange(begin, end, grainSize, priority, [&body](UINT, size_t subrangeBegin, size_t subrangeEnd) { body(subrangeBegin, subrangeEnd); });
+}
+
+void BackgroundWorkerController::executeRange(size_t begin, size_t end, size_t grainSize, TaskPriority priority, const RangeBody &body) {
+    if (begin >= end) {
+        return;
+    }
+
+    // State is shared, because helper tasks may be dequeued after the whole range has been processed
+    struct RangeExecution {
+        RangeBody body;
+        size_t end;
+        size_t grainSize;
+        size_t participantsCount;
+        std::atomic<size_t> nextIndex = 0u;
+        std::atomic<size_t> remainingElementsCount = 0u;
+        std::mutex completionLock = {};
+        std::condition_variable completionCV = {};
+    };
+    grainSize = std::max<size_t>(grainSize, 1u);
+    const size_t grainsCount = (end - begin + grainSize - 1) / grainSize;
+    const auto helpersCount = static_cast<UINT>(std::min<size_t>(grainsCount - 1, getWorkersCount()));
+    auto execution = std::make_shared<RangeExecution>();
+    execution->body = body;
+    execution->end = end;
+    execution->grainSize = grainSize;
+    execution->participantsCount = helpersCount + 1;
+    execution->nextIndex = begin;
+    execution->remainingElementsCount = end - begin;
+
+    auto processSubranges = [execution](UINT participantIndex) {
+        size_t subrangeBegin = execution->nextIndex.load();
+        while (subrangeBegin < execution->end) {
+            // Guided scheduling, claiming half of a fair share leaves enough elements for balancing the threads which end later
+            const size_t remainingCount = execution->end - subrangeBegin;
+            const size_t fairShare = remainingCount / (2 * execution->participantsCount);
+            const size_t subrangeSize = std::min(remainingCount, std::max(execution->grainSize, fairShare));
+            if (!execution->nextIndex.compare_exchange_weak(subrangeBegin, subrangeBegin + subrangeSize)) {
+                continue;
+            }
+
+            execution->body(participantIndex, subrangeBegin, subrangeBegin + subrangeSize);
+            if ((execution->remainingElementsCount -= subrangeSize) == 0u) {
+                std::lock_guard<std::mutex> lock{execution->completionLock};
+                execution->completionCV.notify_all();
+            }
+            subrangeBegin = execution->nextIndex.load();
+        }
+    };
+
+    // Calling thread takes subranges as well, so it cannot get stuck waiting for busy workers
+    for (auto helperIndex = 1u; helperIndex <= helpersCount; helperIndex++) {
+        pushTask([processSubranges, helperIndex]() { processSubranges(helperIndex); }, priority);
+    }
+    processSubranges(0u);
+
+    std::unique_lock<std::mutex> lock{execution->completionLock};
+    execution->completionCV.wait(lock, [&execution]() { return execution->remainingElementsCount == 0u; });
 }
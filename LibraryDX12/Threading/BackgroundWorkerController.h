@@ -2,36 +2,138 @@
 
 #include "BackgroundWorker.h"
 
-#include "Threading/BlockingQueue.h"
-
+#include <DXD/ExternalHeadersWrappers/windows.h>
 #include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
 #include <vector>
 
 /// \brief Manages multiple background thread workers performing tasks
 ///
 /// Controller creates N threads where N is number of hardware threads supported by current platform.
-/// Each thread is wrapped by BackgroundWorker class which extracts tasks from centralized BlockingQueue
-/// contained in the manager.
+/// Each thread is wrapped by BackgroundWorker class, which owns a work-stealing deque of tasks. Tasks
+/// pushed by the workers go to their own deques, tasks pushed by other threads go to a shared queue.
+/// Idle worker takes a batch of tasks from the shared queue and moves them to its deque, so the lock of
+/// the queue is taken once per batch rather than once per task, and steals from deques of randomly chosen
+/// workers when the shared queue is empty. Workers which have not found any task sleep until a new one
+/// is pushed.
+///
+/// Every priority has its own deques and shared queue. Workers look for tasks of lower priority only if
+/// there are no tasks of higher priority anywhere, so a long queue of background work cannot delay critical
+/// tasks by more than the duration of the tasks already running. Tasks can be pushed with a cancellation
+/// token, cancelled tasks are discarded when dequeued.
 ///
-/// When BackgroundWorkerController is destroyed, it clears the queue (discarding all undone tasks), sets
-/// terminate flag to let the workers now they should end execution and notify all workers, so they
-/// are awaken if waiting blocked for new tasks.
+/// When BackgroundWorkerController is stopped or destroyed, it sets terminate flag to let the workers know they
+/// should end execution, wakes them up and discards all undone tasks once they have ended.
 ///
 /// User can select how they want to be notified about completion - setting atomic_bool to true,
 /// notifying condition_variable, none or both
+///
+/// Data-parallel workloads can be split with executeInParallel, which spreads indexed subtasks across
+/// the workers and blocks until all of them are done. Loops over many small elements should use parallelFor
+/// and parallelReduce, which hand out whole subranges of elements instead of single indices.
 class BackgroundWorkerController {
 public:
     BackgroundWorkerController();
+    explicit BackgroundWorkerController(UINT workersCount);
     ~BackgroundWorkerController();
 
+    /// Blocks until the tasks being executed have ended and discards the rest. No tasks should be pushed afterwards
+    void stop();
+
     void pushTask(BackgroundWorker::Task task);
     void pushTask(BackgroundWorker::Task task, std::atomic_bool &completed);
     void pushTask(BackgroundWorker::Task task, std::condition_variable &completed);
     void pushTask(BackgroundWorker::Task task, std::atomic_bool &completed, std::condition_variable &completedCV);
+    void pushTask(BackgroundWorker::Task task, TaskPriority priority, const CancellationToken &cancellationToken = {});
     void pushTask(BackgroundWorker::TaskData taskData);
 
+    /// Calls subtask for every index in [0, subtasksCount) using background workers and returns after
+    /// all calls have ended. Calling thread also executes subtasks instead of only waiting for them,
+    /// so the method can safely be used from within a task executed by one of the workers. Subtasks have
+    /// the priority of the task calling the method.
+    void executeInParallel(UINT subtasksCount, const std::function<void(UINT)> &subtask);
+
+    /// Calls body for consecutive subranges covering [begin, end) using background workers and returns after
+    /// all calls have ended. Calling thread processes subranges as well. Ranges are split adaptively - each
+    /// thread claims a share of the remaining elements, so first subranges are long and they get shorter towards
+    /// the end, where the load has to be balanced. Subranges have the priority of the calling task.
+    /// \param grainSize minimal number of elements worth processing in one call, only the last subrange may be shorter
+    /// \param body callable taking begin and end of a subrange
+    void parallelFor(size_t begin, size_t end, size_t grainSize, const std::function<void(size_t, size_t)> &body);
+
+    /// Same as above, but subranges have the given priority. Used by threads, which are not background workers,
+    /// e.g. the render thread, whose work would otherwise wait behind queued loading tasks of NORMAL priority.
+    void parallelFor(size_t begin, size_t end, size_t grainSize, TaskPriority priority, const std::function<void(size_t, size_t)> &body);
+
+    /// Reduces elements of [begin, end) with the same splitting as parallelFor. Each thread accumulates its
+    /// subranges separately, starting from the identity, and the partial results are combined at the end.
+    /// Subrange boundaries vary between calls, so reduction should not depend on the grouping of elements,
+    /// e.g. floating point sums may differ in the last bits.
+    /// \param identity value which does not change the result when combined with another one
+    /// \param reduceRange callable taking begin and end of a subrange and accumulated value, returns the value updated with the subrange
+    /// \param combine callable returning combination of two partial results
+    /// \return identity combined with results of all elements
+    template <typename T, typename ReduceRange, typename Combine>
+    T parallelReduce(size_t begin, size_t end, size_t grainSize, const T &identity, ReduceRange reduceRange, Combine combine) {
+        std::vector<T> partialResults(getWorkersCount() + 1, identity);
+        executeRange(begin, end, grainSize, BackgroundWorker::getCurrentTaskPriority(), [&](UINT participantIndex, size_t subrangeBegin, size_t subrangeEnd) {
+            partialResults[participantIndex] = reduceRange(subrangeBegin, subrangeEnd, std::move(partialResults[participantIndex]));
+        });
+
+        T result = identity;
+        for (T &partialResult : partialResults) {
+            result = combine(std::move(result), std::move(partialResult));
+        }
+        return result;
+    }
+
+    UINT getWorkersCount() const { return static_cast<UINT>(workers.size()); }
+
+    // Interface for the workers
+    bool isTerminating() const { return terminate.load(); }
+    BackgroundWorker::TaskData *findTask(BackgroundWorker &worker);
+    void waitForTasks();
+    void releaseTaskData(BackgroundWorker &worker, BackgroundWorker::TaskData *taskData);
+
 private:
-    std::vector<BackgroundWorker> workers = {};
-    BackgroundWorker::TaskQueue taskQueue = {};
+    constexpr static size_t maxSharedQueueBatchSize = 32;
+    constexpr static size_t maxFreeTaskDataPerWorker = 2 * maxSharedQueueBatchSize;
+    constexpr static size_t maxSharedFreeTaskDataCount = 1024;
+
+    /// Calls body for subranges of [begin, end), passing index of the calling thread in [0, workersCount], 0 for the caller
+    /// \param priority priority of the helper tasks pushed to the workers
+    using RangeBody = std::function<void(UINT participantIndex, size_t subrangeBegin, size_t subrangeEnd)>;
+    void executeRange(size_t begin, size_t end, size_t grainSize, TaskPriority priority, const RangeBody &body);
+
+    BackgroundWorker::TaskData *acquireTaskData(BackgroundWorker &worker);
+    BackgroundWorker::TaskData *acquireSharedTaskData();
+    BackgroundWorker::TaskData *popFromSharedQueue(BackgroundWorker &worker, TaskPriority priority);
+    BackgroundWorker::TaskData *steal(BackgroundWorker &worker, TaskPriority priority);
+    bool hasPendingTasks() const;
+    void wakeWorker();
+
+    std::vector<std::unique_ptr<BackgroundWorker>> workers = {};
     std::atomic_bool terminate = false;
+
+    // Tasks pushed by threads other than the workers, one queue per priority
+    struct SharedQueue {
+        std::deque<BackgroundWorker::TaskData *> tasks = {};
+        std::atomic<size_t> size = 0u;
+    };
+    SharedQueue sharedQueues[taskPrioritiesCount] = {};
+    std::mutex sharedQueueLock = {};
+
+    // Task data released by the workers, which is reused by other threads, guarded by sharedQueueLock
+    std::vector<BackgroundWorker::TaskData *> sharedFreeTaskData = {};
+    std::atomic<size_t> sharedFreeTaskDataCount = 0u;
+
+    // Idle workers
+    std::atomic<UINT> sleepingWorkersCount = 0u;
+    std::mutex sleepLock = {};
+    std::condition_variable wakeCV = {};
 };
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+/// \brief Cooperative cancellation of a background task
+///
+/// Copies of a token share their state, so a token can be passed to the task and kept by its owner.
+/// Cancelling a task which has not started yet guarantees it will never start, the worker discards
+/// it instead of running. Running tasks are not interrupted, they should poll isCancellationRequested
+/// between chunks of their work and return early. Default constructed token cannot be cancelled.
+class CancellationToken {
+public:
+    CancellationToken() = default;
+
+    /// Factory function for tokens which can be cancelled
+    static CancellationToken create() {
+        CancellationToken token{};
+        token.state = std::make_shared<State>();
+        return token;
+    }
+
+    /// Requests cancellation of the task
+    /// \return true if the task has not started and never will, false if it's already running or done
+    bool cancel() {
+        if (!state) {
+            return false;
+        }
+        state->cancellationRequested.store(true);
+        Status expected = Status::NOT_STARTED;
+        return state->status.compare_exchange_strong(expected, Status::CANCELLED) || expected == Status::CANCELLED;
+    }
+
+    /// Called once before the task is executed
+    /// \return false if the task has been cancelled and must not be executed
+    bool tryStart() {
+        if (!state) {
+            return true;
+        }
+        Status expected = Status::NOT_STARTED;
+        return state->status.compare_exchange_strong(expected, Status::STARTED);
+    }
+
+    bool isCancellationRequested() const {
+        return state && state->cancellationRequested.load();
+    }
+
+private:
+    enum class Status {
+        NOT_STARTED,
+        STARTED,
+        CANCELLED,
+    };
+
+    struct State {
+        std::atomic<Status> status{Status::NOT_STARTED};
+        std::atomic_bool cancellationRequested{false};
+    };
+
+    std::shared_ptr<State> state = {};
+};
@@ -1,16 +1,26 @@
 #pragma once
 
 #include "Application/ApplicationImpl.h"
+#include "Threading/CancellationToken.h"
 #include "Threading/EventImpl.h"
 #include "Utility/ThrowIfFailed.h"
 
+#include <DXD/LoadPriority.h>
+#include <algorithm>
 #include <atomic>
 #include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
 #include <mutex>
+#include <vector>
 
 template <typename CpuLoadArgs, typename CpuLoadResult, typename OperationResult>
 class CpuGpuOperation {
 public:
+    /// Timeout of waits which should never time out, INFINITE for the kernel waits
+    constexpr static std::chrono::milliseconds infiniteTimeout{INFINITE};
+
     enum class AsyncLoadingStatus {
         NOT_STARTED,
         CPU_LOAD,
@@ -25,25 +35,93 @@ public:
     /// \param implementation-defined arguments for the operation
     /// \param operationResult optional result of CPU load returned to the client
     void runSynchronously(const CpuLoadArgs &args, OperationResult *operationResult) {
-        CpuLoadResult cpuLoadResult{};
-        runImpl(args, cpuLoadResult);
+        OperationResult result = OperationResult::TERMINATED;
+        if (cancellationToken.tryStart()) {
+            CpuLoadResult cpuLoadResult{};
+            result = runImpl(args, cpuLoadResult);
+        }
         if (operationResult) {
-            *operationResult = getOperationResult(cpuLoadResult);
+            *operationResult = result;
         }
+        complete(result);
     }
 
-    /// Main entrypoint to start the synchronous operation.
+    /// Main entrypoint to start the asynchronous operation.
     /// \param implementation-defined arguments for the operation
     /// \param operationEvent optional event tied to the asynchronous CPU load return to the client
-    void runAsynchronously(const CpuLoadArgs &args, DXD::Event<OperationResult> *operationEvent) {
-        auto task = [this, args, operationEvent]() {
+    /// \param priority priority of the CPU phase in the background workers, raised if a client attached earlier requested a higher one
+    void runAsynchronously(const CpuLoadArgs &args, DXD::Event<OperationResult> *operationEvent, DXD::LoadPriority priority) {
+        {
+            std::lock_guard<std::mutex> lock{this->completionLock};
+            if (operationEvent) {
+                attachedEvents.push_back(operationEvent);
+            }
+            asyncArgs = std::make_unique<CpuLoadArgs>(args);
+            queuedPriority = std::min(queuedPriority, priority);
+            priority = queuedPriority;
+        }
+        pushAsyncTask(args, priority);
+    }
+
+    /// Entrypoint for clients sharing an operation started by someone else. Blocks until the CPU phase
+    /// of the operation has ended and returns its result. If the operation is still waiting in the queue,
+    /// it's executed right away by the calling thread instead of waiting for all the tasks queued before it.
+    /// \param operationResult optional result of CPU load returned to the client
+    void attachSynchronously(OperationResult *operationResult) {
+        std::unique_lock<std::mutex> lock{this->completionLock};
+        if (completedResult == nullptr && asyncArgs != nullptr && cancellationToken.tryStart()) {
+            // Queued task shares the token, so it will be discarded by the worker
+            const CpuLoadArgs args = *asyncArgs;
+            lock.unlock();
             CpuLoadResult cpuLoadResult{};
-            runImpl(args, cpuLoadResult);
+            const OperationResult result = runImpl(args, cpuLoadResult);
+            complete(result);
+            lock.lock();
+        }
+        completionCV.wait(lock, [this]() { return completedResult != nullptr; });
+        if (operationResult) {
+            *operationResult = *completedResult;
+        }
+    }
+
+    /// Entrypoint for clients sharing an operation started by someone else. Returns immediately, the event
+    /// is signalled once the CPU phase of the operation has ended, or right away if it has already ended.
+    /// If the operation is still queued with a lower priority, it's promoted to the given one.
+    /// \param operationEvent optional event tied to the CPU load returned to the client
+    /// \param priority priority requested by the client
+    void attachAsynchronously(DXD::Event<OperationResult> *operationEvent, DXD::LoadPriority priority) {
+        std::unique_lock<std::mutex> lock{this->completionLock};
+        if (completedResult != nullptr) {
             if (operationEvent) {
-                operationEvent->signal(getOperationResult(cpuLoadResult));
+                operationEvent->signal(*completedResult);
             }
-        };
-        ApplicationImpl::getInstance().getBackgroundWorkerController().pushTask(task);
+            return;
+        }
+        if (operationEvent) {
+            attachedEvents.push_back(operationEvent);
+        }
+
+        // Operation is not queued yet, its priority will be raised when it's queued
+        if (asyncArgs == nullptr) {
+            queuedPriority = std::min(queuedPriority, priority);
+            return;
+        }
+
+        // Queue the same work once more with higher priority, whichever copy is dequeued first runs and the other one is discarded
+        const bool promote = status == AsyncLoadingStatus::NOT_STARTED && priority < queuedPriority;
+        if (promote) {
+            queuedPriority = priority;
+            const CpuLoadArgs args = *asyncArgs;
+            lock.unlock();
+            pushAsyncTask(args, priority);
+        }
+    }
+
+    /// Used to check whether the CPU phase has ended with an error. Results of failed operations
+    /// should not be shared with new clients.
+    /// \return true if CPU load failed
+    bool hasFailed() const {
+        return this->status == AsyncLoadingStatus::CPU_LOAD_FAIL;
     }
 
     /// Used by to check whether both CPU and GPU phase has ended successfuly.
@@ -72,25 +150,56 @@ public:
     /// Sets flags for CPU load termination, which should be occasionally checked by implementations
     /// if they have been terminated during their CPU phase with isCpuLoadTerminated call and return
     /// early. Results of terminated CPU load are ignored and GPU phase is not initiated. GPU load
-    /// cannot be terminated during execution and has to be waited for.
-    /// \param blocking flag makes the method wait for one of the final statuses indicating end of processing
+    /// cannot be terminated during execution and has to be waited for. Operations still waiting in
+    /// the queue are cancelled right away, their clients are notified with TERMINATED result and
+    /// the queued task is discarded without touching the operation, so it can be safely destroyed.
+    /// \param blocking flag makes the method wait for one of the final statuses indicating end of processing.
+    /// Time spent waiting is recorded in the wait metrics of the application as asset unload.
     void terminate(bool blocking) {
+        bool cancelledBeforeStart{};
         {
             std::lock_guard<std::mutex> lock{this->terminateLock};
-            shouldTerminate.store(true);
+            cancelledBeforeStart = cancellationToken.cancel();
+            if (cancelledBeforeStart) {
+                status = AsyncLoadingStatus::CPU_LOAD_TERMINATED;
+            }
+        }
+        if (cancelledBeforeStart) {
+            complete(OperationResult::TERMINATED);
+            return;
         }
 
         if (blocking) {
-            while (true) {
-                isReady();
-                switch (status.load()) {
-                case AsyncLoadingStatus::CPU_LOAD_TERMINATED:
-                case AsyncLoadingStatus::CPU_LOAD_FAIL:
-                case AsyncLoadingStatus::SUCCESS:
-                    return;
-                }
+            const auto waitStart = std::chrono::steady_clock::now();
+            waitForEnd(infiniteTimeout);
+            const auto waitDuration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - waitStart);
+            ApplicationImpl::getInstance().getWaitMetrics().record(WaitMetrics::Category::ASSET_UNLOAD, waitDuration);
+        }
+    }
+
+    /// Blocks until the processing has ended, i.e. CPU phase has failed or has been terminated, or both phases
+    /// have succeeded. Calling thread sleeps instead of polling. It's woken up by the end of the CPU phase and
+    /// then waits for the fence of the GPU upload.
+    /// \param timeout maximum time to wait
+    /// \return true if the processing has ended, false if the timeout has passed first
+    bool waitForEnd(std::chrono::milliseconds timeout) {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        {
+            std::unique_lock<std::mutex> lock{this->completionLock};
+            if (!completionCV.wait_until(lock, deadline, [this]() { return completedResult != nullptr; })) {
+                return false;
+            }
+        }
+
+        // Status is set before the completion, which is observed under the lock, so it's up to date here
+        if (status.load() == AsyncLoadingStatus::GPU_LOAD) {
+            const auto remainingTime = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+            if (!waitForGpuLoad(std::max(remainingTime, std::chrono::milliseconds{0}))) {
+                return false;
             }
+            isReady();
         }
+        return true;
     }
 
 protected:
@@ -114,6 +223,12 @@ protected:
     /// \return true if GPU phase is complete
     virtual bool hasGpuLoadEnded() = 0;
 
+    /// Implementation-defined blocking wait for the asynchronous GPU processing. It is called only if GPU
+    /// load has started.
+    /// \param timeout maximum time to wait
+    /// \return true if GPU phase is complete
+    virtual bool waitForGpuLoad(std::chrono::milliseconds timeout) = 0;
+
     /// Implementation-defined conversion of available operation data to final result
     /// presented to the client.
     /// \return implementation-defined operation result
@@ -123,17 +238,31 @@ protected:
     /// by the terminate call
     /// \return true if the operation should be terminated early
     bool isCpuLoadTerminated() const {
-        return shouldTerminate.load();
+        return cancellationToken.isCancellationRequested();
     }
 
 private:
-    void runImpl(const CpuLoadArgs &cpuLoadArgs, CpuLoadResult &cpuLoadResult) {
+    void pushAsyncTask(const CpuLoadArgs &args, DXD::LoadPriority priority) {
+        static_assert(static_cast<int>(DXD::LoadPriority::CRITICAL) == static_cast<int>(TaskPriority::CRITICAL) &&
+                          static_cast<int>(DXD::LoadPriority::BACKGROUND) == static_cast<int>(TaskPriority::BACKGROUND),
+                      "Load priorities are passed to the background workers as they are");
+
+        // Task is discarded by the worker if the operation is cancelled before it starts, so it may capture this
+        auto task = [this, args]() {
+            CpuLoadResult cpuLoadResult{};
+            const OperationResult result = runImpl(args, cpuLoadResult);
+            complete(result);
+        };
+        ApplicationImpl::getInstance().getBackgroundWorkerController().pushTask(std::move(task), static_cast<TaskPriority>(priority), cancellationToken);
+    }
+
+    OperationResult runImpl(const CpuLoadArgs &cpuLoadArgs, CpuLoadResult &cpuLoadResult) {
         // Enter CPU phase or return early
         {
             std::lock_guard<std::mutex> lock{this->terminateLock};
             if (isCpuLoadTerminated()) {
                 status = AsyncLoadingStatus::CPU_LOAD_TERMINATED;
-                return;
+                return OperationResult::TERMINATED;
             }
             status = AsyncLoadingStatus::CPU_LOAD;
         }
@@ -146,11 +275,11 @@ private:
             std::lock_guard<std::mutex> lock{this->terminateLock};
             if (isCpuLoadTerminated()) {
                 status = AsyncLoadingStatus::CPU_LOAD_TERMINATED;
-                return;
+                return OperationResult::TERMINATED;
             }
             if (!isCpuLoadSuccessful(cpuLoadResult)) {
                 this->status = AsyncLoadingStatus::CPU_LOAD_FAIL;
-                return;
+                return getOperationResult(cpuLoadResult);
             }
             status = AsyncLoadingStatus::GPU_LOAD_STARTING;
         }
@@ -158,9 +287,32 @@ private:
         // Run GPU load phase
         gpuLoad(cpuLoadResult);
         status = AsyncLoadingStatus::GPU_LOAD;
+        return getOperationResult(cpuLoadResult);
+    }
+
+    void complete(const OperationResult &result) {
+        std::lock_guard<std::mutex> lock{this->completionLock};
+        asyncArgs.reset();
+        completedResult = std::make_unique<OperationResult>(result);
+        for (DXD::Event<OperationResult> *attachedEvent : attachedEvents) {
+            attachedEvent->signal(result);
+        }
+        attachedEvents.clear();
+        completionCV.notify_all();
     }
 
     std::atomic<AsyncLoadingStatus> status = AsyncLoadingStatus::NOT_STARTED;
-    std::atomic_bool shouldTerminate = false;
+    CancellationToken cancellationToken = CancellationToken::create();
     std::mutex terminateLock{};
+
+    // Arguments of the queued asynchronous operation, kept for promoting it to a higher priority. Until the operation
+    // is queued, the priority is the highest one requested by clients attached to it
+    std::unique_ptr<CpuLoadArgs> asyncArgs{};
+    DXD::LoadPriority queuedPriority = DXD::LoadPriority::BACKGROUND;
+
+    // Result of the CPU phase shared with the clients attached to the operation
+    std::unique_ptr<OperationResult> completedResult{};
+    std::vector<DXD::Event<OperationResult> *> attachedEvents{};
+    std::mutex completionLock{};
+    std::condition_variable completionCV{};
 };
@@ -1,7 +1,10 @@
 #pragma once
 
 #include <DXD/Event.h>
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <condition_variable>
 #include <memory>
 #include <mutex>
 
@@ -14,11 +17,13 @@ public:
     void signal(const Data &data) override {
         auto lock = this->lock();
         this->data = std::make_unique<Data>(data);
+        complete.store(true, std::memory_order_release);
         cv.notify_all();
     }
 
     bool isComplete() const override {
-        return data != nullptr;
+        // Acquire pairs with the release in signal, data is visible to the caller once it sees the flag
+        return complete.load(std::memory_order_acquire);
     }
 
     const Data &getData() const override {
@@ -28,13 +33,22 @@ public:
     }
 
     const Data &wait() const override {
-        auto lock = this->lock();
-        while (data == nullptr) {
-            cv.wait(lock);
+        if (isComplete()) {
+            return *data;
         }
+        auto lock = this->lock();
+        cv.wait(lock, [this]() { return data != nullptr; });
         return *data;
     }
 
+    bool waitFor(unsigned int timeoutMilliseconds) const override {
+        if (isComplete()) {
+            return true;
+        }
+        auto lock = this->lock();
+        return cv.wait_for(lock, std::chrono::milliseconds{timeoutMilliseconds}, [this]() { return data != nullptr; });
+    }
+
 private:
     auto lock() const {
         return std::unique_lock<std::mutex>{mutex};
@@ -43,4 +57,5 @@ private:
     mutable std::mutex mutex{};
     mutable std::condition_variable cv{};
     std::unique_ptr<Data> data{};
+    std::atomic_bool complete = false;
 };
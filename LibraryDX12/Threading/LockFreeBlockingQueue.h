@@ -0,0 +1,201 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+
+/// \brief Bounded multi-producer multi-consumer queue with the interface of BlockingQueue
+///
+/// Elements are stored in a ring buffer of cells, each with a sequence number telling whether it's ready
+/// to be written or read in the current lap, as in the bounded MPMC queue by Dmitry Vyukov. Producers
+/// and consumers claim cells with a single CAS on their own index and never take a lock while the queue
+/// is neither empty nor full. Threads which cannot make progress spin for a moment and then park on
+/// a condition variable. The other side takes the lock to notify only if someone is actually parked.
+///
+/// Unlike BlockingQueue, capacity is fixed and push blocks while the queue is full.
+template <typename T>
+class LockFreeBlockingQueue {
+public:
+    /// \param capacity has to be a power of two
+    explicit LockFreeBlockingQueue(size_t capacity = 1024)
+        : capacity(capacity),
+          cells(new Cell[capacity]) {
+        assert(capacity >= 2 && (capacity & (capacity - 1)) == 0);
+        for (size_t i = 0; i < capacity; i++) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+    LockFreeBlockingQueue(const LockFreeBlockingQueue &) = delete;
+    LockFreeBlockingQueue(LockFreeBlockingQueue &&) = delete;
+
+    ~LockFreeBlockingQueue() {
+        T value{};
+        while (tryPop(value)) {
+        }
+    }
+
+    void push(const T &value) {
+        T copy{value};
+        push(std::move(copy));
+    }
+
+    void push(T &&value) {
+        if (!spin([&]() { return tryPush(value); })) {
+            std::unique_lock<std::mutex> lock{parkingLock};
+            waitingProducersCount++;
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            notFullCV.wait(lock, [&]() { return tryPush(value); });
+            waitingProducersCount--;
+        }
+        wakeWaiter(waitingConsumersCount, notEmptyCV);
+    }
+
+    /// Blocks until an element is available or notifyAll is called
+    /// \return false if woken up by notifyAll or clear without receiving an element
+    bool blockingPop(T &result) {
+        const uint64_t generation = wakeAllGeneration.load();
+        if (!spin([&]() { return tryPop(result); })) {
+            std::unique_lock<std::mutex> lock{parkingLock};
+            waitingConsumersCount++;
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            bool popped = false;
+            notEmptyCV.wait(lock, [&]() {
+                popped = tryPop(result);
+                return popped || wakeAllGeneration.load() != generation;
+            });
+            waitingConsumersCount--;
+            if (!popped) {
+                return false;
+            }
+        }
+        wakeWaiter(waitingProducersCount, notFullCV);
+        return true;
+    }
+
+    /// Non-blocking push
+    /// \return false if the queue was full, value is left untouched then
+    bool tryPush(T &value) {
+        size_t position = enqueuePosition.load(std::memory_order_relaxed);
+        while (true) {
+            Cell &cell = cells[position & (capacity - 1)];
+            const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (difference == 0) {
+                // Cell is free in this lap, try to claim it
+                if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    new (&cell.storage) T(std::move(value));
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                // Cell still holds an element from the previous lap
+                return false;
+            } else {
+                // Another producer has claimed the cell
+                position = enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /// Non-blocking pop
+    /// \return false if the queue was empty
+    bool tryPop(T &result) {
+        size_t position = dequeuePosition.load(std::memory_order_relaxed);
+        while (true) {
+            Cell &cell = cells[position & (capacity - 1)];
+            const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+            if (difference == 0) {
+                // Cell is written in this lap, try to claim it
+                if (dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    T *element = reinterpret_cast<T *>(&cell.storage);
+                    result = std::move(*element);
+                    element->~T();
+                    cell.sequence.store(position + capacity, std::memory_order_release);
+                    return true;
+                }
+            } else if (difference < 0) {
+                // Cell has not been written yet
+                return false;
+            } else {
+                // Another consumer has claimed the cell
+                position = dequeuePosition.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /// Result may be outdated as soon as it's returned
+    bool empty() {
+        return enqueuePosition.load(std::memory_order_relaxed) <= dequeuePosition.load(std::memory_order_relaxed);
+    }
+
+    /// Wakes up all consumers waiting in blockingPop, their calls return false
+    void notifyAll() {
+        std::lock_guard<std::mutex> lock{parkingLock};
+        wakeAllGeneration++;
+        notEmptyCV.notify_all();
+    }
+
+    void clear() {
+        T value{};
+        while (tryPop(value)) {
+        }
+        std::lock_guard<std::mutex> lock{parkingLock};
+        wakeAllGeneration++;
+        notEmptyCV.notify_all();
+        notFullCV.notify_all();
+    }
+
+    size_t getCapacity() const {
+        return capacity;
+    }
+
+private:
+    constexpr static std::uint32_t spinsCount = 64;
+
+    struct Cell {
+        std::atomic<size_t> sequence;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+    };
+
+    template <typename Attempt>
+    static bool spin(Attempt attempt) {
+        // Waiting for the other side is usually shorter than the round trip through the kernel
+        for (auto i = 0u; i < spinsCount; i++) {
+            if (attempt()) {
+                return true;
+            }
+            std::this_thread::yield();
+        }
+        return attempt();
+    }
+
+    void wakeWaiter(std::atomic<std::uint32_t> &waitingCount, std::condition_variable &cv) {
+        // Pairs with the fence of parking thread, so either it sees the change or we see it waiting
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waitingCount.load(std::memory_order_relaxed) > 0u) {
+            std::lock_guard<std::mutex> lock{parkingLock};
+            cv.notify_one();
+        }
+    }
+
+    const size_t capacity;
+    const std::unique_ptr<Cell[]> cells;
+
+    // Positions are on separate cache lines, since they're written by different threads
+    alignas(64) std::atomic<size_t> enqueuePosition{0};
+    alignas(64) std::atomic<size_t> dequeuePosition{0};
+
+    alignas(64) std::mutex parkingLock{};
+    std::condition_variable notEmptyCV{};
+    std::condition_variable notFullCV{};
+    std::atomic<std::uint32_t> waitingConsumersCount{0u};
+    std::atomic<std::uint32_t> waitingProducersCount{0u};
+    std::atomic<uint64_t> wakeAllGeneration{0u};
+};
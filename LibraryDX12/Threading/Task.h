@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/// \brief Move-only callable without arguments executed by background workers
+///
+/// Replacement of std::function<void()>, which avoids heap allocations for small callables. Callables
+/// fitting in the inline storage, e.g. lambdas capturing a few pointers or a shared_ptr, are stored
+/// directly in the Task object. Bigger ones, or ones which could throw when moved, are moved to the heap.
+class Task {
+public:
+    constexpr static size_t inlineStorageSize = 48;
+
+    Task() = default;
+
+    template <typename Callable, typename = std::enable_if_t<!std::is_same<std::decay_t<Callable>, Task>::value>>
+    Task(Callable &&callable) {
+        using StoredCallable = std::decay_t<Callable>;
+        construct<StoredCallable>(std::forward<Callable>(callable), std::integral_constant<bool, fitsInline<StoredCallable>()>{});
+    }
+
+    Task(Task &&other) noexcept {
+        moveFrom(other);
+    }
+
+    Task &operator=(Task &&other) noexcept {
+        if (this != &other) {
+            reset();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    Task(const Task &) = delete;
+    Task &operator=(const Task &) = delete;
+
+    ~Task() {
+        reset();
+    }
+
+    void operator()() {
+        operations->invoke(storage);
+    }
+
+    explicit operator bool() const {
+        return operations != nullptr;
+    }
+
+    /// \return true if the callable is stored inside the object and creating the task has not allocated memory
+    bool isStoredInline() const {
+        return operations != nullptr && operations->isInline;
+    }
+
+    void reset() {
+        if (operations != nullptr) {
+            operations->destroy(storage);
+            operations = nullptr;
+        }
+    }
+
+    template <typename Callable>
+    constexpr static bool fitsInline() {
+        return sizeof(Callable) <= inlineStorageSize && alignof(Callable) <= alignof(std::max_align_t) &&
+               std::is_nothrow_move_constructible<Callable>::value;
+    }
+
+private:
+    struct Operations {
+        void (*invoke)(void *storage);
+        void (*moveAndDestroy)(void *source, void *destination);
+        void (*destroy)(void *storage);
+        bool isInline;
+    };
+
+    template <typename Callable>
+    struct InlineCallable {
+        static void invoke(void *storage) { (*static_cast<Callable *>(storage))(); }
+        static void moveAndDestroy(void *source, void *destination) {
+            new (destination) Callable(std::move(*static_cast<Callable *>(source)));
+            static_cast<Callable *>(source)->~Callable();
+        }
+        static void destroy(void *storage) { static_cast<Callable *>(storage)->~Callable(); }
+        static const Operations operations;
+    };
+
+    template <typename Callable>
+    struct HeapCallable {
+        static void invoke(void *storage) { (**static_cast<Callable **>(storage))(); }
+        static void moveAndDestroy(void *source, void *destination) { *static_cast<Callable **>(destination) = *static_cast<Callable **>(source); }
+        static void destroy(void *storage) { delete *static_cast<Callable **>(storage); }
+        static const Operations operations;
+    };
+
+    template <typename StoredCallable, typename Callable>
+    void construct(Callable &&callable, std::true_type /*inline*/) {
+        new (storage) StoredCallable(std::forward<Callable>(callable));
+        operations = &InlineCallable<StoredCallable>::operations;
+    }
+
+    template <typename StoredCallable, typename Callable>
+    void construct(Callable &&callable, std::false_type /*inline*/) {
+        *reinterpret_cast<StoredCallable **>(storage) = new StoredCallable(std::forward<Callable>(callable));
+        operations = &HeapCallable<StoredCallable>::operations;
+    }
+
+    void moveFrom(Task &other) {
+        if (other.operations != nullptr) {
+            other.operations->moveAndDestroy(other.storage, storage);
+            operations = other.operations;
+            other.operations = nullptr;
+        }
+    }
+
+    alignas(std::max_align_t) unsigned char storage[inlineStorageSize];
+    const Operations *operations = nullptr;
+};
+
+template <typename Callable>
+const Task::Operations Task::InlineCallable<Callable>::operations = {&invoke, &moveAndDestroy, &destroy, true};
+
+template <typename Callable>
+const Task::Operations Task::HeapCallable<Callable>::operations = {&invoke, &moveAndDestroy, &destroy, false};
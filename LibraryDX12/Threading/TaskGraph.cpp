@@ -0,0 +1,144 @@
+#include "TaskGraph.h"
+
+#include "Threading/BackgroundWorkerController.h"
+
+#include <cassert>
+
+// ------------------------------------------------------------------------------------- Creation and destruction
+
+TaskGraph::TaskGraph(BackgroundWorkerController &controller)
+    : TaskGraph(controller, BackgroundWorker::getCurrentTaskPriority()) {}
+
+TaskGraph::TaskGraph(BackgroundWorkerController &controller, TaskPriority priority)
+    : controller(controller),
+      priority(priority) {}
+
+TaskGraph::~TaskGraph() {
+    wait();
+}
+
+// ------------------------------------------------------------------------------------- Declaring the graph
+
+TaskGraph::NodeIndex TaskGraph::addNode(Task work) {
+    assert(isComplete());
+    nodes.push_back(std::make_unique<Node>(std::move(work)));
+    return static_cast<NodeIndex>(nodes.size() - 1);
+}
+
+void TaskGraph::addDependency(NodeIndex predecessor, NodeIndex successor) {
+    assert(isComplete());
+    assert(predecessor < nodes.size() && successor < nodes.size() && predecessor != successor);
+    nodes[predecessor]->successors.push_back(successor);
+    nodes[successor]->predecessorsCount++;
+}
+
+bool TaskGraph::isAcyclic() const {
+    // Kahn's algorithm, every node is visited only if the graph has no cycles
+    std::vector<UINT> remainingPredecessorsCounts(nodes.size());
+    std::vector<NodeIndex> readyNodes{};
+    for (NodeIndex node = 0u; node < nodes.size(); node++) {
+        remainingPredecessorsCounts[node] = nodes[node]->predecessorsCount;
+        if (remainingPredecessorsCounts[node] == 0u) {
+            readyNodes.push_back(node);
+        }
+    }
+
+    size_t visitedNodesCount = 0u;
+    while (!readyNodes.empty()) {
+        const NodeIndex node = readyNodes.back();
+        readyNodes.pop_back();
+        visitedNodesCount++;
+        for (NodeIndex successor : nodes[node]->successors) {
+            if (--remainingPredecessorsCounts[successor] == 0u) {
+                readyNodes.push_back(successor);
+            }
+        }
+    }
+    return visitedNodesCount == nodes.size();
+}
+
+// ------------------------------------------------------------------------------------- Execution
+
+void TaskGraph::run() {
+    assert(isComplete());
+    assert(isAcyclic());
+    if (nodes.empty()) {
+        return;
+    }
+
+    for (auto &node : nodes) {
+        node->remainingPredecessorsCount.store(node->predecessorsCount);
+    }
+    {
+        std::lock_guard<std::mutex> lock{completionLock};
+        completed = false;
+        readyNodes.clear();
+    }
+    remainingNodesCount.store(static_cast<UINT>(nodes.size()));
+
+    for (NodeIndex node = 0u; node < nodes.size(); node++) {
+        if (nodes[node]->predecessorsCount == 0u) {
+            pushNode(node);
+        }
+    }
+}
+
+void TaskGraph::wait() {
+    // Completion flag is set under the lock, so the graph is not destroyed before the last node stops using it
+    std::unique_lock<std::mutex> lock{completionLock};
+    while (!completed) {
+        if (readyNodes.empty()) {
+            completionCV.wait(lock, [this]() { return completed || !readyNodes.empty(); });
+            continue;
+        }
+
+        // Ready node can be claimed by the waiting thread, if no worker has started it yet. Node may be stuck
+        // in the deque of the waiting worker, so executing it here also prevents the deadlock
+        ReadyNode readyNode = std::move(readyNodes.back());
+        readyNodes.pop_back();
+        if (readyNode.token.tryStart()) {
+            lock.unlock();
+            executeNode(readyNode.node);
+            lock.lock();
+        }
+    }
+}
+
+void TaskGraph::pushNode(NodeIndex node) {
+    // Both the worker and the waiting thread may execute the node, whichever starts it first, the other one discards it
+    CancellationToken token = CancellationToken::create();
+    {
+        std::lock_guard<std::mutex> lock{completionLock};
+        readyNodes.push_back(ReadyNode{node, token});
+        completionCV.notify_all();
+    }
+    controller.pushTask([this, node]() { executeNode(node); }, priority, token);
+}
+
+void TaskGraph::executeNode(NodeIndex node) {
+    while (true) {
+        nodes[node]->work();
+
+        // Push all successors which have become ready except one, which is executed right away
+        NodeIndex continuation = node;
+        for (NodeIndex successor : nodes[node]->successors) {
+            if (--nodes[successor]->remainingPredecessorsCount == 0u) {
+                if (continuation != node) {
+                    pushNode(continuation);
+                }
+                continuation = successor;
+            }
+        }
+
+        if (--remainingNodesCount == 0u) {
+            std::lock_guard<std::mutex> lock{completionLock};
+            completed = true;
+            completionCV.notify_all();
+            return;
+        }
+        if (continuation == node) {
+            return;
+        }
+        node = continuation;
+    }
+}
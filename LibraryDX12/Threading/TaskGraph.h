@@ -0,0 +1,90 @@
+#pragma once
+
+#include "Threading/BackgroundWorker.h"
+#include "Threading/CancellationToken.h"
+
+#include <DXD/ExternalHeadersWrappers/windows.h>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class BackgroundWorkerController;
+
+/// \brief Set of tasks with dependencies between them, executed by background workers
+///
+/// Graph is declared up front by adding nodes and dependencies between them. Each node counts its
+/// unfinished predecessors. Node which has finished decrements the counters of its successors and
+/// pushes the ones which have reached zero, so no worker ever blocks waiting for a predecessor. One of
+/// the ready successors is executed right away by the same worker, while its inputs are still in the cache.
+///
+/// Nodes without a path between them may run in any order or concurrently, but a node never starts
+/// before all of its predecessors have ended. Graph has to be acyclic and cannot be modified while running.
+/// It can be run again once completed. Destructor waits for the graph to complete.
+class TaskGraph {
+public:
+    using NodeIndex = UINT;
+
+    /// Nodes get the priority of the task creating the graph
+    explicit TaskGraph(BackgroundWorkerController &controller);
+    TaskGraph(BackgroundWorkerController &controller, TaskPriority priority);
+    TaskGraph(const TaskGraph &) = delete;
+    TaskGraph &operator=(const TaskGraph &) = delete;
+    ~TaskGraph();
+
+    /// \param work callable executed when all predecessors of the node have ended
+    /// \return index identifying the node in addDependency
+    NodeIndex addNode(Task work);
+
+    /// Declares that successor cannot start before predecessor ends
+    void addDependency(NodeIndex predecessor, NodeIndex successor);
+
+    UINT getNodesCount() const { return static_cast<UINT>(nodes.size()); }
+    UINT getPredecessorsCount(NodeIndex node) const { return nodes[node]->predecessorsCount; }
+
+    /// Pushes all nodes without predecessors to the workers and returns immediately
+    void run();
+
+    /// Blocks until all nodes have ended. In the meantime, the calling thread executes ready nodes of this
+    /// graph which have not been started by workers yet, so nodes cannot get stuck behind a waiting worker.
+    /// Tasks unrelated to the graph are never executed. If no node is ready, the thread sleeps.
+    void wait();
+
+    void runAndWait() {
+        run();
+        wait();
+    }
+
+    bool isComplete() const { return remainingNodesCount.load() == 0u; }
+
+private:
+    struct ReadyNode {
+        NodeIndex node;
+        CancellationToken token; // shared with the task pushed to the workers
+    };
+
+    struct Node {
+        explicit Node(Task work) : work(std::move(work)) {}
+
+        Task work;
+        std::vector<NodeIndex> successors = {};
+        UINT predecessorsCount = 0u;
+        std::atomic<UINT> remainingPredecessorsCount = 0u;
+    };
+
+    void pushNode(NodeIndex node);
+    void executeNode(NodeIndex node);
+    bool isAcyclic() const;
+
+    BackgroundWorkerController &controller;
+    const TaskPriority priority;
+    std::vector<std::unique_ptr<Node>> nodes = {};
+
+    // Completion
+    std::atomic<UINT> remainingNodesCount = 0u;
+    bool completed = true;
+    std::vector<ReadyNode> readyNodes = {}; // pushed nodes which can be claimed by the waiting thread
+    std::mutex completionLock = {};
+    std::condition_variable completionCV = {};
+};
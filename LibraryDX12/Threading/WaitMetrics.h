@@ -0,0 +1,61 @@
+#pragma once
+
+#include "DXD/Logger.h"
+
+#include <DXD/ExternalHeadersWrappers/windows.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/// \brief Time spent by threads blocked on background work
+///
+/// Waits are accumulated per category, so the cost of unloading assets whose loads are still in flight
+/// can be told apart from the cost of stopping the workers on shutdown. Recording is lock-free and can
+/// be done from any thread.
+class WaitMetrics {
+public:
+    enum class Category {
+        ASSET_UNLOAD, // destruction of assets waiting for their loads to end
+        SHUTDOWN,     // stopping the background workers, which finish the tasks already running
+    };
+    constexpr static UINT categoriesCount = 2u;
+
+    struct Summary {
+        uint64_t waitsCount;
+        std::chrono::microseconds totalDuration;
+        std::chrono::microseconds maxDuration;
+    };
+
+    void record(Category category, std::chrono::microseconds duration) {
+        Counters &counters = this->counters[static_cast<UINT>(category)];
+        const auto durationCount = static_cast<uint64_t>(duration.count());
+        counters.waitsCount++;
+        counters.totalMicroseconds += durationCount;
+        uint64_t maxMicroseconds = counters.maxMicroseconds.load();
+        while (durationCount > maxMicroseconds && !counters.maxMicroseconds.compare_exchange_weak(maxMicroseconds, durationCount)) {
+        }
+    }
+
+    Summary getSummary(Category category) const {
+        const Counters &counters = this->counters[static_cast<UINT>(category)];
+        return Summary{counters.waitsCount.load(), std::chrono::microseconds{counters.totalMicroseconds.load()},
+                       std::chrono::microseconds{counters.maxMicroseconds.load()}};
+    }
+
+    void log() const {
+        const char *categoryNames[categoriesCount] = {"asset unload", "shutdown"};
+        for (auto categoryIndex = 0u; categoryIndex < categoriesCount; categoryIndex++) {
+            const Summary summary = getSummary(static_cast<Category>(categoryIndex));
+            DXD::log("Waiting for background work on %s: %llu waits, %.3f ms in total, %.3f ms at most\n", categoryNames[categoryIndex],
+                     static_cast<unsigned long long>(summary.waitsCount), summary.totalDuration.count() / 1000.0, summary.maxDuration.count() / 1000.0);
+        }
+    }
+
+private:
+    struct Counters {
+        std::atomic<uint64_t> waitsCount = 0u;
+        std::atomic<uint64_t> totalMicroseconds = 0u;
+        std::atomic<uint64_t> maxMicroseconds = 0u;
+    };
+    Counters counters[categoriesCount] = {};
+};
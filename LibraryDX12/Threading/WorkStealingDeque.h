@@ -0,0 +1,122 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+/// \brief Lock-free Chase-Lev deque of a single owner thread and many thieves
+///
+/// Owner pushes and pops elements at the bottom, in LIFO order, without any atomic read-modify-write
+/// operations, unless only one element is left. Other threads steal the oldest elements from the top.
+/// Memory orderings follow "Correct and Efficient Work-Stealing for Weak Memory Models" by Le et al.
+///
+/// Elements are read by thieves before they know whether the steal succeeded, so they have to be trivially
+/// copyable, typically pointers. Circular buffer grows when full. Old buffers may still be read by thieves,
+/// hence they're released only with the deque.
+template <typename T>
+class WorkStealingDeque {
+    static_assert(std::is_trivially_copyable<T>::value, "Elements are copied concurrently with their overwrites");
+
+public:
+    /// \param initialCapacity has to be a power of two
+    explicit WorkStealingDeque(size_t initialCapacity = 1024) {
+        assert(initialCapacity > 0 && (initialCapacity & (initialCapacity - 1)) == 0);
+        buffers.push_back(std::make_unique<Buffer>(initialCapacity));
+        buffer.store(buffers.back().get(), std::memory_order_relaxed);
+    }
+    WorkStealingDeque(const WorkStealingDeque &) = delete;
+    WorkStealingDeque(WorkStealingDeque &&) = delete;
+
+    /// Can be called only by the owner
+    void push(T value) {
+        const int64_t currentBottom = bottom.load(std::memory_order_relaxed);
+        const int64_t currentTop = top.load(std::memory_order_acquire);
+        Buffer *currentBuffer = buffer.load(std::memory_order_relaxed);
+        if (currentBottom - currentTop > static_cast<int64_t>(currentBuffer->capacity) - 1) {
+            buffers.push_back(currentBuffer->grow(currentTop, currentBottom));
+            currentBuffer = buffers.back().get();
+            buffer.store(currentBuffer, std::memory_order_release);
+        }
+        currentBuffer->store(currentBottom, value);
+        // Release store instead of a release fence, the same ordering, but visible to ThreadSanitizer
+        bottom.store(currentBottom + 1, std::memory_order_release);
+    }
+
+    /// Can be called only by the owner
+    /// \return false if the deque was empty
+    bool pop(T &outValue) {
+        const int64_t currentBottom = bottom.load(std::memory_order_relaxed) - 1;
+        Buffer *currentBuffer = buffer.load(std::memory_order_relaxed);
+        bottom.store(currentBottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t currentTop = top.load(std::memory_order_relaxed);
+
+        if (currentTop > currentBottom) {
+            bottom.store(currentBottom + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        outValue = currentBuffer->load(currentBottom);
+        if (currentTop == currentBottom) {
+            // Last element, race with thieves for it
+            const bool won = top.compare_exchange_strong(currentTop, currentTop + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            bottom.store(currentBottom + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    /// Can be called by any thread
+    /// \return false if the deque was empty or another thread has taken the element first
+    bool steal(T &outValue) {
+        int64_t currentTop = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const int64_t currentBottom = bottom.load(std::memory_order_acquire);
+        if (currentTop >= currentBottom) {
+            return false;
+        }
+
+        const Buffer *currentBuffer = buffer.load(std::memory_order_acquire);
+        outValue = currentBuffer->load(currentTop);
+        return top.compare_exchange_strong(currentTop, currentTop + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    }
+
+    /// Can be called by any thread, result may be outdated as soon as it's returned
+    size_t getSizeApproximation() const {
+        const int64_t currentBottom = bottom.load(std::memory_order_relaxed);
+        const int64_t currentTop = top.load(std::memory_order_relaxed);
+        return currentBottom > currentTop ? static_cast<size_t>(currentBottom - currentTop) : 0u;
+    }
+
+    size_t getCapacity() const {
+        return buffer.load(std::memory_order_relaxed)->capacity;
+    }
+
+private:
+    struct Buffer {
+        explicit Buffer(size_t capacity) : capacity(capacity), elements(new std::atomic<T>[capacity]) {}
+
+        T load(int64_t index) const { return elements[static_cast<size_t>(index) & (capacity - 1)].load(std::memory_order_relaxed); }
+        void store(int64_t index, T value) { elements[static_cast<size_t>(index) & (capacity - 1)].store(value, std::memory_order_relaxed); }
+
+        std::unique_ptr<Buffer> grow(int64_t currentTop, int64_t currentBottom) const {
+            auto result = std::make_unique<Buffer>(capacity * 2);
+            for (int64_t index = currentTop; index < currentBottom; index++) {
+                result->store(index, load(index));
+            }
+            return result;
+        }
+
+        const size_t capacity;
+        const std::unique_ptr<std::atomic<T>[]> elements;
+    };
+
+    // Indices are on separate cache lines, since top is written by thieves and bottom by the owner
+    alignas(64) std::atomic<int64_t> top{0};
+    alignas(64) std::atomic<int64_t> bottom{0};
+    alignas(64) std::atomic<Buffer *> buffer{};
+    std::vector<std::unique_ptr<Buffer>> buffers{}; // current one and all previous ones, accessed only by the owner
+};
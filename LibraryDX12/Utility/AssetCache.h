@@ -0,0 +1,67 @@
+#pragma once
+
+#include "DXD/Utility/NonCopyableAndMovable.h"
+
+#include <DXD/ExternalHeadersWrappers/windows.h>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+
+/// \brief Registry of assets shared between all of their users
+///
+/// Assets are identified by canonical path of their source file and flags affecting the way they are loaded.
+/// Registry holds them weakly, so an asset is destroyed as soon as its last user releases it. Until then all
+/// requests for the same key get the same instance, which may still be loading.
+template <typename Asset>
+class AssetCache : DXD::NonCopyableAndMovable {
+public:
+    using Key = std::pair<std::wstring, UINT>;
+    using Factory = std::function<std::shared_ptr<Asset>()>;
+    using ReusePredicate = std::function<bool(const Asset &)>;
+
+    /// Returns asset registered for given key or creates a new one, if there is none alive. Factory is called under
+    /// the registry lock, so it should only construct the asset and leave loading it to the caller.
+    /// \param key canonical path and load flags of the asset
+    /// \param factory callable creating a new asset
+    /// \param isReusable optional predicate rejecting registered assets which should be created again, e.g. failed ones
+    /// \param outCreated set to true if the asset has been created by this call
+    /// \return shared asset
+    std::shared_ptr<Asset> getOrCreate(const Key &key, const Factory &factory, const ReusePredicate &isReusable, bool &outCreated) {
+        std::lock_guard<std::mutex> lock{this->lock};
+
+        auto it = assets.find(key);
+        if (it != assets.end()) {
+            std::shared_ptr<Asset> asset = it->second.lock();
+            if (asset != nullptr && (!isReusable || isReusable(*asset))) {
+                outCreated = false;
+                return asset;
+            }
+        }
+
+        removeExpiredAssets();
+        std::shared_ptr<Asset> asset = factory();
+        assets[key] = asset;
+        outCreated = true;
+        return asset;
+    }
+
+    /// \return number of registered assets, which are still alive
+    size_t getAssetsCount() {
+        std::lock_guard<std::mutex> lock{this->lock};
+        removeExpiredAssets();
+        return assets.size();
+    }
+
+private:
+    void removeExpiredAssets() {
+        for (auto it = assets.begin(); it != assets.end();) {
+            it = it->second.expired() ? assets.erase(it) : std::next(it);
+        }
+    }
+
+    std::map<Key, std::weak_ptr<Asset>> assets = {};
+    std::mutex lock = {};
+};
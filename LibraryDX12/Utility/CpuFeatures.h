@@ -0,0 +1,28 @@
+#pragma once
+
+#include "DXD/Utility/NonCopyableAndMovable.h"
+
+#include <intrin.h>
+
+/// \brief Runtime detection of instruction sets, used to select SIMD code paths
+struct CpuFeatures : DXD::NonInstantiatable {
+    static bool isAvxSupported() {
+        static const bool supported = queryAvxSupport();
+        return supported;
+    }
+
+private:
+    static bool queryAvxSupport() {
+        int registers[4] = {};
+        __cpuid(registers, 1);
+        const bool osXsave = (registers[2] & (1 << 27)) != 0;
+        const bool avx = (registers[2] & (1 << 28)) != 0;
+        if (!osXsave || !avx) {
+            return false;
+        }
+
+        // OS has to save upper halves of YMM registers on context switches
+        const unsigned long long xcr0 = _xgetbv(0);
+        return (xcr0 & 0x6) == 0x6;
+    }
+};
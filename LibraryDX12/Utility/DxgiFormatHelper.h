@@ -6,7 +6,7 @@
 
 namespace DxgiFormatHelper {
 
-bool isUavCompatibleFormat(DXGI_FORMAT format) {
+inline bool isUavCompatibleFormat(DXGI_FORMAT format) {
     switch (format) {
     case DXGI_FORMAT_R32G32B32A32_FLOAT:
     case DXGI_FORMAT_R32G32B32A32_UINT:
@@ -32,7 +32,7 @@ bool isUavCompatibleFormat(DXGI_FORMAT format) {
     }
 }
 
-bool isSrgbFormat(DXGI_FORMAT format) {
+inline bool isSrgbFormat(DXGI_FORMAT format) {
     switch (format) {
     case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
     case DXGI_FORMAT_BC1_UNORM_SRGB:
@@ -46,7 +46,7 @@ bool isSrgbFormat(DXGI_FORMAT format) {
     return false;
 }
 
-DXGI_FORMAT convertToNonSrgbFormat(DXGI_FORMAT format) {
+inline DXGI_FORMAT convertToNonSrgbFormat(DXGI_FORMAT format) {
     switch (format) {
     case DXGI_FORMAT_R8G8B8A8_UNORM_SRGB:
         return DXGI_FORMAT_R8G8B8A8_UNORM;
@@ -66,7 +66,7 @@ DXGI_FORMAT convertToNonSrgbFormat(DXGI_FORMAT format) {
     return format;
 }
 
-DXGI_FORMAT convertToUavCompatibleFormat(DXGI_FORMAT format) {
+inline DXGI_FORMAT convertToUavCompatibleFormat(DXGI_FORMAT format) {
     switch (format) {
     case DXGI_FORMAT_R8G8B8A8_TYPELESS:
     case DXGI_FORMAT_R8G8B8A8_UNORM:
@@ -86,7 +86,7 @@ DXGI_FORMAT convertToUavCompatibleFormat(DXGI_FORMAT format) {
     }
 }
 
-DXGI_FORMAT convertToTypelessFormat(DXGI_FORMAT format) {
+inline DXGI_FORMAT convertToTypelessFormat(DXGI_FORMAT format) {
     switch (format) {
     case DXGI_FORMAT_R32G32B32A32_TYPELESS:
     case DXGI_FORMAT_R32G32B32A32_FLOAT:
@@ -151,6 +151,23 @@ DXGI_FORMAT convertToTypelessFormat(DXGI_FORMAT format) {
     case DXGI_FORMAT_R8_SINT:
     case DXGI_FORMAT_A8_UNORM:
         return DXGI_FORMAT_R8_TYPELESS;
+
+    case DXGI_FORMAT_BC1_TYPELESS:
+    case DXGI_FORMAT_BC1_UNORM:
+    case DXGI_FORMAT_BC1_UNORM_SRGB:
+        return DXGI_FORMAT_BC1_TYPELESS;
+    case DXGI_FORMAT_BC3_TYPELESS:
+    case DXGI_FORMAT_BC3_UNORM:
+    case DXGI_FORMAT_BC3_UNORM_SRGB:
+        return DXGI_FORMAT_BC3_TYPELESS;
+    case DXGI_FORMAT_BC6H_TYPELESS:
+    case DXGI_FORMAT_BC6H_UF16:
+    case DXGI_FORMAT_BC6H_SF16:
+        return DXGI_FORMAT_BC6H_TYPELESS;
+    case DXGI_FORMAT_BC7_TYPELESS:
+    case DXGI_FORMAT_BC7_UNORM:
+    case DXGI_FORMAT_BC7_UNORM_SRGB:
+        return DXGI_FORMAT_BC7_TYPELESS;
     default:
         UNREACHABLE_CODE();
     }
@@ -16,6 +16,20 @@ struct FileHelper : DXD::NonCopyableAndMovable {
         return INVALID_FILE_ATTRIBUTES != GetFileAttributesW(path.c_str()) || GetLastError() != ERROR_FILE_NOT_FOUND;
     }
 
+    /// Returns absolute path, which is the same for all paths pointing to the file, regardless of letter case, kind
+    /// of slashes and relative components
+    static std::wstring getCanonicalPath(const std::wstring &path) {
+        const DWORD size = GetFullPathNameW(path.c_str(), 0u, nullptr, nullptr);
+        if (size == 0u) {
+            return path;
+        }
+        std::wstring result(size, L'\0');
+        const DWORD length = GetFullPathNameW(path.c_str(), size, &result[0], nullptr);
+        result.resize(length);
+        CharLowerBuffW(&result[0], length);
+        return result;
+    }
+
     template <typename CharT>
     static std::basic_string<CharT> getNameWithoutExtension(const std::basic_string<CharT> &path, bool supportDirectories) {
         const size_t fileNameStartIndex = getFileNameStartIndex(path, supportDirectories);
@@ -0,0 +1,78 @@
+#include "FreeListAllocator.h"
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+
+FreeListAllocator::FreeListAllocator(UINT64 size) : size(size), freeSize(size) {
+    if (size > 0) {
+        freeRanges[0] = size;
+    }
+}
+
+bool FreeListAllocator::allocate(UINT64 size, UINT64 alignment, UINT64 &outOffset) {
+    assert(size > 0 && alignment > 0);
+
+    for (auto it = freeRanges.begin(); it != freeRanges.end(); it++) {
+        const UINT64 rangeOffset = it->first;
+        const UINT64 rangeSize = it->second;
+        const UINT64 alignedOffset = (rangeOffset + alignment - 1) / alignment * alignment;
+        const UINT64 padding = alignedOffset - rangeOffset;
+        if (padding >= rangeSize || rangeSize - padding < size) {
+            continue;
+        }
+
+        // Space before the aligned offset stays in the same range, space after the allocation becomes a new one
+        const UINT64 remainingSize = rangeSize - padding - size;
+        if (padding > 0) {
+            it->second = padding;
+        } else {
+            freeRanges.erase(it);
+        }
+        if (remainingSize > 0) {
+            freeRanges[alignedOffset + size] = remainingSize;
+        }
+
+        freeSize -= size;
+        outOffset = alignedOffset;
+        return true;
+    }
+    return false;
+}
+
+void FreeListAllocator::free(UINT64 offset, UINT64 size) {
+    assert(size > 0 && offset + size <= this->size);
+
+    auto next = freeRanges.lower_bound(offset);
+    assert(next == freeRanges.end() || offset + size <= next->first);
+
+    // Merge with the preceding range, if they're adjacent
+    auto current = freeRanges.end();
+    if (next != freeRanges.begin()) {
+        auto previous = std::prev(next);
+        assert(previous->first + previous->second <= offset);
+        if (previous->first + previous->second == offset) {
+            previous->second += size;
+            current = previous;
+        }
+    }
+    if (current == freeRanges.end()) {
+        current = freeRanges.emplace_hint(next, offset, size);
+    }
+
+    // Merge with the following range, if they're adjacent
+    if (next != freeRanges.end() && current->first + current->second == next->first) {
+        current->second += next->second;
+        freeRanges.erase(next);
+    }
+
+    freeSize += size;
+}
+
+UINT64 FreeListAllocator::getLargestFreeRangeSize() const {
+    UINT64 result = 0;
+    for (const auto &range : freeRanges) {
+        result = std::max(result, range.second);
+    }
+    return result;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "DXD/Utility/NonCopyableAndMovable.h"
+
+#include <DXD/ExternalHeadersWrappers/windows.h>
+#include <map>
+
+/// \brief Allocator of ranges within a linear address space of fixed size
+///
+/// Only the bookkeeping is done here, there is no memory behind the offsets, so the allocator can be
+/// used for any kind of buffer, e.g. a GPU resource. Free ranges are kept sorted by offset and allocations
+/// take the first range big enough (first fit). Freed ranges are merged with their free neighbours, so the
+/// space does not fragment over time if everything is eventually freed.
+class FreeListAllocator : DXD::NonCopyable {
+public:
+    explicit FreeListAllocator(UINT64 size);
+    FreeListAllocator(FreeListAllocator &&other) = default;
+    FreeListAllocator &operator=(FreeListAllocator &&other) = default;
+
+    /// \param size size of the range, it cannot be 0
+    /// \param alignment offset of the range will be its multiple, it does not have to be a power of two
+    /// \param outOffset offset of the allocated range, unchanged if the allocation fails
+    /// \return false if there is no free range big enough
+    bool allocate(UINT64 size, UINT64 alignment, UINT64 &outOffset);
+
+    /// \param offset offset returned by allocate
+    /// \param size the same size which was passed to allocate
+    void free(UINT64 offset, UINT64 size);
+
+    UINT64 getSize() const { return size; }
+    UINT64 getFreeSize() const { return freeSize; }
+    UINT64 getLargestFreeRangeSize() const;
+    size_t getFreeRangesCount() const { return freeRanges.size(); }
+    bool isEmpty() const { return freeSize == size; }
+
+private:
+    UINT64 size;
+    UINT64 freeSize;
+    std::map<UINT64, UINT64> freeRanges = {}; // offset -> size
+};
@@ -5,6 +5,8 @@
 
 #include "DXD/Utility/NonCopyableAndMovable.h"
 
+#include <algorithm>
+#include <chrono>
 #include <vector>
 
 class GpuDependency : DXD::NonCopyable {
@@ -21,11 +23,17 @@ public:
         queue->waitOnCpu(fenceValue);
     }
 
+    bool waitOnCpu(std::chrono::milliseconds timeout) const {
+        return queue->waitOnCpu(fenceValue, timeout);
+    }
+
     void waitOnGpu(CommandQueue &queueToWaitOn) const {
         queueToWaitOn.waitOnGpu(*queue, fenceValue);
     }
 
 private:
+    friend class GpuDependencies;
+
     const CommandQueue *queue;
     uint64_t fenceValue;
 };
@@ -38,15 +46,27 @@ public:
         dependencies.emplace_back(queue, fenceValue);
     }
 
+    /// Adds all dependencies of other, so they can be waited on without holding the lock guarding other
+    void add(const GpuDependencies &other) {
+        for (const GpuDependency &dependency : other.dependencies) {
+            dependencies.emplace_back(*dependency.queue, dependency.fenceValue);
+        }
+    }
+
     void reset() {
         dependencies.clear();
     }
 
-    bool isComplete() {
+    /// Removes dependencies, which have already completed, so they're not checked or waited on again
+    void removeCompleted() {
         const auto removeIterator = std::remove_if(dependencies.begin(), dependencies.end(), [](const GpuDependency &dependency) {
             return dependency.isComplete();
         });
         dependencies.erase(removeIterator, dependencies.end());
+    }
+
+    bool isComplete() {
+        removeCompleted();
         return dependencies.size() == 0u;
     }
 
@@ -57,6 +77,19 @@ public:
         dependencies.clear();
     }
 
+    /// \return true if all dependencies have completed before the timeout
+    bool waitOnCpu(std::chrono::milliseconds timeout) {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        for (const GpuDependency &dependency : dependencies) {
+            const auto remainingTime = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+            if (!dependency.waitOnCpu(std::max(remainingTime, std::chrono::milliseconds{0}))) {
+                return false;
+            }
+        }
+        dependencies.clear();
+        return true;
+    }
+
     void waitOnGpu(CommandQueue &queueToWaitOn) const {
         for (const GpuDependency &dependency : dependencies) {
             dependency.waitOnCpu();
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "DXD/ExternalHeadersWrappers/DirectXMath.h"
 #include "DXD/ExternalHeadersWrappers/windows.h"
 
 #include <algorithm>
@@ -42,4 +43,25 @@ constexpr inline T clamp(const T &n, const T &lower, const T &upper) {
     return std::max(lower, std::min(n, upper));
 }
 
+// Length of the longest basis vector, scaling a bounding sphere radius by it keeps the sphere conservative
+inline FLOAT getMaxScale(const XMMATRIX &matrix) {
+    return std::max({XMVectorGetX(XMVector3Length(matrix.r[0])),
+                     XMVectorGetX(XMVector3Length(matrix.r[1])),
+                     XMVectorGetX(XMVector3Length(matrix.r[2]))});
+}
+
+// Smallest axis aligned box containing the transformed box. Center is transformed as a point, while the
+// extents are projected on each axis using absolute values of the matrix
+inline void transformBoundingBox(const XMFLOAT3 &min, const XMFLOAT3 &max, const XMMATRIX &matrix, XMFLOAT3 &outMin, XMFLOAT3 &outMax) {
+    const XMVECTOR minVector = XMLoadFloat3(&min);
+    const XMVECTOR maxVector = XMLoadFloat3(&max);
+    const XMVECTOR center = XMVector3TransformCoord(XMVectorScale(XMVectorAdd(minVector, maxVector), 0.5f), matrix);
+    const XMVECTOR extents = XMVectorScale(XMVectorSubtract(maxVector, minVector), 0.5f);
+    XMVECTOR transformedExtents = XMVectorMultiply(XMVectorSplatX(extents), XMVectorAbs(matrix.r[0]));
+    transformedExtents = XMVectorMultiplyAdd(XMVectorSplatY(extents), XMVectorAbs(matrix.r[1]), transformedExtents);
+    transformedExtents = XMVectorMultiplyAdd(XMVectorSplatZ(extents), XMVectorAbs(matrix.r[2]), transformedExtents);
+    outMin = XMStoreFloat3(XMVectorSubtract(center, transformedExtents));
+    outMax = XMStoreFloat3(XMVectorAdd(center, transformedExtents));
+}
+
 } // namespace MathHelper
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "DXD/Utility/NonCopyableAndMovable.h"
+
+#include <DXD/ExternalHeadersWrappers/windows.h>
+#include <string>
+
+/// \brief Read-only view of a whole file mapped into the address space of the process
+///
+/// Contents are paged in by the OS on first access, so there is no upfront copy to a user-space
+/// buffer. Mapping is released upon destruction. Files which could not be opened and empty files
+/// result in an invalid object, which should be checked with isValid before accessing the data.
+class MemoryMappedFile : DXD::NonCopyableAndMovable {
+public:
+    explicit MemoryMappedFile(const std::wstring &path) {
+        file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            return;
+        }
+
+        LARGE_INTEGER fileSize = {};
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+            return;
+        }
+
+        mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr) {
+            return;
+        }
+
+        data = static_cast<const char *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        if (data != nullptr) {
+            size = static_cast<size_t>(fileSize.QuadPart);
+        }
+    }
+
+    ~MemoryMappedFile() {
+        if (data != nullptr) {
+            UnmapViewOfFile(data);
+        }
+        if (mapping != nullptr) {
+            CloseHandle(mapping);
+        }
+        if (file != INVALID_HANDLE_VALUE) {
+            CloseHandle(file);
+        }
+    }
+
+    bool isValid() const { return data != nullptr; }
+    const char *getData() const { return data; }
+    const char *getDataEnd() const { return data + size; }
+    size_t getSize() const { return size; }
+
+private:
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = nullptr;
+    const char *data = nullptr;
+    size_t size = 0u;
+};
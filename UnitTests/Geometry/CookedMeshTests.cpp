@@ -0,0 +1,102 @@
+#include "Geometry/CookedMesh.h"
+
+#include <cmath>
+#include <cstring>
+#include <gtest/gtest.h>
+
+namespace {
+struct CookedMeshTests : ::testing::Test {
+    void SetUp() override {
+        header = CookedMeshHeader{CookedMeshHeader::expectedMagic, CookedMeshHeader::currentVersion, source, 0x5, 5 * sizeof(FLOAT), 3, 6};
+        CookedMesh::computeBounds(vertexData, header.verticesCount, header.vertexSizeInBytes, header.boundsMin, header.boundsMax);
+        CookedMesh::computeBoundingSphere(vertexData, header.verticesCount, header.vertexSizeInBytes, header.boundsMin, header.boundsMax, header.boundingSphere);
+        header.meshletsCount = 1;
+        header.lodsCount = 1;
+        header.submeshesCount = 1;
+    }
+
+    void TearDown() override {
+        DeleteFileW(path.c_str());
+    }
+
+    const std::wstring path = L"CookedMeshTests.dxdmesh";
+    const CookedMeshSource source = {1234, 5678, 0x3};
+    const FLOAT vertexData[15] = {
+        -1, 2, 3, 0.0f, 0.5f,
+        4, -5, 6, 0.5f, 1.0f,
+        7, 8, -9, 1.0f, 0.0f};
+    const UINT indexData[6] = {0, 1, 2, 2, 1, 0};
+    const Meshlet meshletData[1] = {{0, 6, {3, 1.5f, -1.5f}, 10, {0, 0, 1}, 1.f}};
+    const MeshLod lodData[1] = {{0, 6, 0, 1, 0.f}};
+    const MeshSubmesh submeshData[1] = {{1u, {1.f, 0.5f, 0.f}, 0.25f}};
+    CookedMeshHeader header = {};
+};
+} // namespace
+
+TEST_F(CookedMeshTests, givenVerticesWhenComputingBoundsThenReturnMinimalBoxContainingAllPositions) {
+    EXPECT_EQ(-1.f, header.boundsMin[0]);
+    EXPECT_EQ(-5.f, header.boundsMin[1]);
+    EXPECT_EQ(-9.f, header.boundsMin[2]);
+    EXPECT_EQ(7.f, header.boundsMax[0]);
+    EXPECT_EQ(8.f, header.boundsMax[1]);
+    EXPECT_EQ(6.f, header.boundsMax[2]);
+}
+
+TEST_F(CookedMeshTests, givenVerticesWhenComputingBoundingSphereThenItIsCenteredInBoundsAndTouchesFarthestPosition) {
+    EXPECT_EQ(3.f, header.boundingSphere[0]);
+    EXPECT_EQ(1.5f, header.boundingSphere[1]);
+    EXPECT_EQ(-1.5f, header.boundingSphere[2]);
+    EXPECT_FLOAT_EQ(std::sqrt(114.5f), header.boundingSphere[3]);
+}
+
+TEST_F(CookedMeshTests, givenWrittenCookedMeshWhenOpeningWithTheSameSourceThenDataIsMappedUnchanged) {
+    ASSERT_TRUE(CookedMesh::write(path, header, vertexData, indexData, meshletData, lodData, submeshData));
+
+    const CookedMesh cookedMesh{path, source};
+    ASSERT_TRUE(cookedMesh.isValid());
+    EXPECT_EQ(header.meshType, cookedMesh.getHeader().meshType);
+    EXPECT_EQ(header.vertexSizeInBytes, cookedMesh.getHeader().vertexSizeInBytes);
+    EXPECT_EQ(header.verticesCount, cookedMesh.getHeader().verticesCount);
+    EXPECT_EQ(header.indicesCount, cookedMesh.getHeader().indicesCount);
+    EXPECT_EQ(header.meshletsCount, cookedMesh.getHeader().meshletsCount);
+    EXPECT_EQ(header.lodsCount, cookedMesh.getHeader().lodsCount);
+    EXPECT_EQ(header.submeshesCount, cookedMesh.getHeader().submeshesCount);
+    EXPECT_EQ(0, memcmp(header.boundingSphere, cookedMesh.getHeader().boundingSphere, sizeof(header.boundingSphere)));
+    EXPECT_EQ(0, memcmp(vertexData, cookedMesh.getVertexData(), sizeof(vertexData)));
+    EXPECT_EQ(0, memcmp(indexData, cookedMesh.getIndexData(), sizeof(indexData)));
+    EXPECT_EQ(0, memcmp(meshletData, cookedMesh.getMeshletData(), sizeof(meshletData)));
+    EXPECT_EQ(0, memcmp(lodData, cookedMesh.getLodData(), sizeof(lodData)));
+    EXPECT_EQ(0, memcmp(submeshData, cookedMesh.getSubmeshData(), sizeof(submeshData)));
+}
+
+TEST_F(CookedMeshTests, givenWrittenCookedMeshWhenSourceHasChangedThenItIsInvalid) {
+    ASSERT_TRUE(CookedMesh::write(path, header, vertexData, indexData, meshletData, lodData, submeshData));
+
+    CookedMeshSource otherSource = source;
+    otherSource.lastWriteTime++;
+    EXPECT_FALSE(CookedMesh(path, otherSource).isValid());
+
+    otherSource = source;
+    otherSource.size++;
+    EXPECT_FALSE(CookedMesh(path, otherSource).isValid());
+
+    otherSource = source;
+    otherSource.loadFlags = 0x1;
+    EXPECT_FALSE(CookedMesh(path, otherSource).isValid());
+}
+
+TEST_F(CookedMeshTests, givenCookedMeshOfDifferentVersionWhenOpeningThenItIsInvalid) {
+    header.version++;
+    ASSERT_TRUE(CookedMesh::write(path, header, vertexData, indexData, meshletData, lodData, submeshData));
+    EXPECT_FALSE(CookedMesh(path, source).isValid());
+}
+
+TEST_F(CookedMeshTests, givenLodsNotMatchingSubmeshesWhenOpeningCookedMeshThenItIsInvalid) {
+    header.submeshesCount = 0;
+    ASSERT_TRUE(CookedMesh::write(path, header, vertexData, indexData, meshletData, lodData, submeshData));
+    EXPECT_FALSE(CookedMesh(path, source).isValid());
+}
+
+TEST_F(CookedMeshTests, givenMissingFileWhenOpeningCookedMeshThenItIsInvalid) {
+    EXPECT_FALSE(CookedMesh(L"NonExistingCookedMesh.dxdmesh", source).isValid());
+}
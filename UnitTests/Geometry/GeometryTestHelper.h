@@ -0,0 +1,58 @@
+#pragma once
+
+#include <DXD/ExternalHeadersWrappers/windows.h>
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+/// Procedural meshes shared by the geometry tests
+namespace GeometryTestHelper {
+
+/// Regular grid of quads in XY plane with vertices at integer coordinates. Each quad is split into two triangles
+/// along its diagonal from (x, y) to (x + 1, y + 1), rows of quads go along x
+/// \param quadsPerSide number of quads along x and y
+/// \param heightFunction callable taking x and y of a vertex and returning its z
+/// \param textureCoordinates if true, every position is followed by uv, which goes from 0 to 1 along x and y
+template <typename HeightFunction>
+inline void createGrid(UINT quadsPerSide, HeightFunction heightFunction, bool textureCoordinates,
+                       std::vector<FLOAT> &outVertexElements, std::vector<UINT> &outIndices) {
+    const UINT verticesPerSide = quadsPerSide + 1;
+    for (UINT y = 0u; y < verticesPerSide; y++) {
+        for (UINT x = 0u; x < verticesPerSide; x++) {
+            const auto fx = static_cast<FLOAT>(x);
+            const auto fy = static_cast<FLOAT>(y);
+            outVertexElements.insert(outVertexElements.end(), {fx, fy, heightFunction(fx, fy)});
+            if (textureCoordinates) {
+                outVertexElements.insert(outVertexElements.end(), {fx / quadsPerSide, fy / quadsPerSide});
+            }
+        }
+    }
+    for (UINT y = 0u; y < quadsPerSide; y++) {
+        for (UINT x = 0u; x < quadsPerSide; x++) {
+            const UINT corner = y * verticesPerSide + x;
+            outIndices.insert(outIndices.end(), {corner, corner + 1, corner + verticesPerSide + 1, corner, corner + verticesPerSide + 1, corner + verticesPerSide});
+        }
+    }
+}
+
+/// Grid with positions only and z equal to 0
+inline void createFlatGrid(UINT quadsPerSide, std::vector<FLOAT> &outVertexElements, std::vector<UINT> &outIndices) {
+    createGrid(quadsPerSide, [](FLOAT, FLOAT) { return 0.f; }, false, outVertexElements, outIndices);
+}
+
+/// Moves triangles to random places in the index buffer, order of corners within each triangle is kept
+/// \param seed makes the order repeatable
+inline void shuffleTriangles(std::vector<UINT> &indices, unsigned int seed) {
+    std::vector<std::array<UINT, 3>> triangles{};
+    for (size_t index = 0u; index < indices.size(); index += 3) {
+        triangles.push_back({indices[index], indices[index + 1], indices[index + 2]});
+    }
+    std::shuffle(triangles.begin(), triangles.end(), std::mt19937{seed});
+    indices.clear();
+    for (const auto &triangle : triangles) {
+        indices.insert(indices.end(), triangle.begin(), triangle.end());
+    }
+}
+
+} // namespace GeometryTestHelper
@@ -0,0 +1,230 @@
+#include "Geometry/GltfParser.h"
+
+#include <cstring>
+#include <gtest/gtest.h>
+#include <string>
+
+namespace {
+void appendUint32(std::vector<char> &output, uint32_t value) {
+    const char *bytes = reinterpret_cast<const char *>(&value);
+    output.insert(output.end(), bytes, bytes + sizeof(value));
+}
+
+template <typename T>
+void appendBytes(std::vector<char> &output, const T *data, size_t count) {
+    const char *bytes = reinterpret_cast<const char *>(data);
+    output.insert(output.end(), bytes, bytes + count * sizeof(T));
+}
+
+// Assembles glb file with given JSON chunk and binary chunk, both padded to 4 bytes as required by the format
+std::vector<char> createGlb(std::string json, std::vector<char> bin) {
+    while (json.size() % 4 != 0) {
+        json.push_back(' ');
+    }
+    while (bin.size() % 4 != 0) {
+        bin.push_back(0);
+    }
+
+    std::vector<char> glb{};
+    appendUint32(glb, GltfParser::glbMagic);
+    appendUint32(glb, 2u);
+    appendUint32(glb, static_cast<uint32_t>(12 + 8 + json.size() + (bin.empty() ? 0 : 8 + bin.size())));
+    appendUint32(glb, static_cast<uint32_t>(json.size()));
+    appendUint32(glb, GltfParser::jsonChunkType);
+    glb.insert(glb.end(), json.begin(), json.end());
+    if (!bin.empty()) {
+        appendUint32(glb, static_cast<uint32_t>(bin.size()));
+        appendUint32(glb, GltfParser::binChunkType);
+        glb.insert(glb.end(), bin.begin(), bin.end());
+    }
+    return glb;
+}
+
+bool parse(const std::vector<char> &glb, std::vector<GltfPrimitive> &outPrimitives) {
+    return GltfParser::parseGlb(glb.data(), glb.size(), outPrimitives);
+}
+
+const float interleavedVertices[] = {
+    0, 0, 0, 0, 0, 1,
+    1, 0, 0, 0, 0, 1,
+    0, 1, 0, 0, 0, 1,
+    1, 1, 0, 0, 0, 1};
+const uint32_t indices32[] = {0, 1, 2, 2, 1, 3};
+
+const char *interleavedJson = R"({
+    "asset": {"version": "2.0"},
+    "buffers": [{"byteLength": 120}],
+    "bufferViews": [
+        {"buffer": 0, "byteOffset": 0, "byteLength": 96, "byteStride": 24},
+        {"buffer": 0, "byteOffset": 96, "byteLength": 24}
+    ],
+    "accessors": [
+        {"bufferView": 0, "componentType": 5126, "count": 4, "type": "VEC3", "min": [0, 0, 0], "max": [1, 1, 0]},
+        {"bufferView": 0, "byteOffset": 12, "componentType": 5126, "count": 4, "type": "VEC3"},
+        {"bufferView": 1, "componentType": 5125, "count": 6, "type": "SCALAR"}
+    ],
+    "meshes": [{"primitives": [{"attributes": {"POSITION": 0, "NORMAL": 1}, "indices": 2, "mode": 4}]}]
+})";
+
+std::vector<char> createInterleavedBin() {
+    std::vector<char> bin{};
+    appendBytes(bin, interleavedVertices, 24);
+    appendBytes(bin, indices32, 6);
+    return bin;
+}
+} // namespace
+
+TEST(GltfParserTests, givenInterleavedAttributesWhenParsingThenAccessorsPointIntoBinaryChunk) {
+    const std::vector<char> glb = createGlb(interleavedJson, createInterleavedBin());
+    std::vector<GltfPrimitive> primitives{};
+    ASSERT_TRUE(parse(glb, primitives));
+    ASSERT_EQ(1u, primitives.size());
+    const GltfPrimitive &primitive = primitives[0];
+
+    const uint8_t *glbBegin = reinterpret_cast<const uint8_t *>(glb.data());
+    const uint8_t *glbEnd = glbBegin + glb.size();
+    EXPECT_GE(primitive.positions.data, glbBegin);
+    EXPECT_LT(primitive.positions.data, glbEnd);
+    EXPECT_EQ(primitive.positions.data + 12, primitive.normals.data);
+    EXPECT_EQ(primitive.positions.data + 96, primitive.indices.data);
+    EXPECT_EQ(0, std::memcmp(interleavedVertices, primitive.positions.data, sizeof(interleavedVertices)));
+    EXPECT_EQ(0, std::memcmp(indices32, primitive.indices.data, sizeof(indices32)));
+
+    EXPECT_EQ(4u, primitive.positions.count);
+    EXPECT_EQ(24u, primitive.positions.strideInBytes);
+    EXPECT_FALSE(primitive.positions.isTightlyPacked());
+    EXPECT_EQ(6u, primitive.indices.count);
+    EXPECT_TRUE(primitive.indices.isTightlyPacked());
+    EXPECT_EQ(GltfAccessor::ComponentType::UNSIGNED_INT, primitive.indices.componentType);
+    EXPECT_FALSE(primitive.tangents.isPresent());
+    EXPECT_FALSE(primitive.textureCoordinates.isPresent());
+
+    EXPECT_FLOAT_EQ(1.f, primitive.positions.readFloat(3, 0));
+    EXPECT_FLOAT_EQ(1.f, primitive.positions.readFloat(3, 1));
+    EXPECT_FLOAT_EQ(1.f, primitive.normals.readFloat(2, 2));
+    EXPECT_EQ(3u, primitive.indices.readUnsigned(5));
+}
+
+TEST(GltfParserTests, givenNormalizedTextureCoordinatesAndShortIndicesWhenReadingThenValuesAreConverted) {
+    const float positions[] = {0, 0, 0, 1, 0, 0, 0, 1, 0};
+    const uint8_t textureCoordinates[] = {0, 255, 255, 0, 51, 102, 0, 0};
+    const uint16_t indices[] = {2, 1, 0, 0};
+    std::vector<char> bin{};
+    appendBytes(bin, positions, 9);
+    appendBytes(bin, textureCoordinates, 8);
+    appendBytes(bin, indices, 4);
+    const char *json = R"({
+        "buffers": [{"byteLength": 52}],
+        "bufferViews": [{"buffer": 0, "byteLength": 36}, {"buffer": 0, "byteOffset": 36, "byteLength": 6}, {"buffer": 0, "byteOffset": 44, "byteLength": 6}],
+        "accessors": [
+            {"bufferView": 0, "componentType": 5126, "count": 3, "type": "VEC3"},
+            {"bufferView": 1, "componentType": 5121, "normalized": true, "count": 3, "type": "VEC2"},
+            {"bufferView": 2, "componentType": 5123, "count": 3, "type": "SCALAR"}
+        ],
+        "meshes": [{"primitives": [{"attributes": {"POSITION": 0, "TEXCOORD_0": 1}, "indices": 2}]}]
+    })";
+
+    const std::vector<char> glb = createGlb(json, bin);
+    std::vector<GltfPrimitive> primitives{};
+    ASSERT_TRUE(parse(glb, primitives));
+    const GltfPrimitive &primitive = primitives[0];
+    EXPECT_FALSE(primitive.normals.isPresent());
+    EXPECT_EQ(2u, primitive.textureCoordinates.strideInBytes);
+    EXPECT_FLOAT_EQ(0.f, primitive.textureCoordinates.readFloat(0, 0));
+    EXPECT_FLOAT_EQ(1.f, primitive.textureCoordinates.readFloat(0, 1));
+    EXPECT_FLOAT_EQ(0.2f, primitive.textureCoordinates.readFloat(2, 0));
+    EXPECT_FLOAT_EQ(0.4f, primitive.textureCoordinates.readFloat(2, 1));
+    EXPECT_EQ(2u, primitive.indices.readUnsigned(0));
+    EXPECT_EQ(0u, primitive.indices.readUnsigned(2));
+}
+
+TEST(GltfParserTests, givenMultiplePrimitivesWhenParsingThenReturnAllOfThem) {
+    std::string json = interleavedJson;
+    const std::string primitive = R"({"attributes": {"POSITION": 0, "NORMAL": 1}, "indices": 2})";
+    json.replace(json.find(primitive.substr(0, 14)), 0, primitive + ", ");
+
+    const std::vector<char> glb = createGlb(json, createInterleavedBin());
+    std::vector<GltfPrimitive> primitives{};
+    ASSERT_TRUE(parse(glb, primitives));
+    EXPECT_EQ(2u, primitives.size());
+}
+
+TEST(GltfParserTests, givenRequestedAttributesWhenCheckingPrimitivesThenOnlyAvailableAndSupportedCombinationsAreAccepted) {
+    const std::vector<char> glb = createGlb(interleavedJson, createInterleavedBin());
+    std::vector<GltfPrimitive> primitives{};
+    ASSERT_TRUE(parse(glb, primitives));
+    EXPECT_TRUE(GltfParser::hasRequestedAttributes(primitives, false, false));
+    EXPECT_FALSE(GltfParser::hasRequestedAttributes(primitives, true, false));
+    EXPECT_FALSE(GltfParser::hasRequestedAttributes(primitives, true, true));
+
+    // Stored tangents are not enough, normal mapping needs texture coordinates as well
+    primitives[0].tangents = primitives[0].normals;
+    EXPECT_FALSE(GltfParser::hasRequestedAttributes(primitives, false, true));
+
+    primitives[0].textureCoordinates = primitives[0].normals;
+    primitives[0].tangents = {};
+    EXPECT_TRUE(GltfParser::hasRequestedAttributes(primitives, true, false));
+    EXPECT_TRUE(GltfParser::hasRequestedAttributes(primitives, true, true));
+}
+
+TEST(GltfParserTests, givenInvalidHeaderWhenParsingThenReturnFalse) {
+    std::vector<char> glb = createGlb(interleavedJson, createInterleavedBin());
+    std::vector<GltfPrimitive> primitives{};
+
+    std::vector<char> wrongMagic = glb;
+    wrongMagic[0] = 'x';
+    EXPECT_FALSE(parse(wrongMagic, primitives));
+
+    std::vector<char> wrongVersion = glb;
+    wrongVersion[4] = 1;
+    EXPECT_FALSE(parse(wrongVersion, primitives));
+
+    std::vector<char> truncated{glb.begin(), glb.end() - 4};
+    EXPECT_FALSE(parse(truncated, primitives));
+}
+
+TEST(GltfParserTests, givenMalformedJsonWhenParsingThenReturnFalse) {
+    std::vector<GltfPrimitive> primitives{};
+    EXPECT_FALSE(parse(createGlb("{\"meshes\": [", createInterleavedBin()), primitives));
+    EXPECT_FALSE(parse(createGlb("{\"meshes\": []}", createInterleavedBin()), primitives));
+    EXPECT_FALSE(parse(createGlb("[]", createInterleavedBin()), primitives));
+}
+
+TEST(GltfParserTests, givenUnsupportedFeaturesWhenParsingThenReturnFalse) {
+    const std::pair<const char *, const char *> replacements[] = {
+        {"\"mode\": 4", "\"mode\": 1"},                                // lines instead of triangles
+        {"{\"byteLength\": 120}", "{\"byteLength\": 120, \"uri\": \"a.bin\"}"}, // external buffer
+        {"\"count\": 6", "\"count\": 6, \"sparse\": {}"},              // sparse accessor
+        {"\"count\": 6", "\"count\": 5"},                              // incomplete triangle
+    };
+    for (const auto &replacement : replacements) {
+        std::string json = interleavedJson;
+        json.replace(json.find(replacement.first), std::strlen(replacement.first), replacement.second);
+        std::vector<GltfPrimitive> primitives{};
+        EXPECT_FALSE(parse(createGlb(json, createInterleavedBin()), primitives)) << replacement.second;
+    }
+}
+
+TEST(GltfParserTests, givenOutOfRangeDataWhenParsingThenReturnFalse) {
+    const std::pair<const char *, const char *> replacements[] = {
+        {"\"byteLength\": 96,", "\"byteLength\": 200,"},              // buffer view exceeding binary chunk
+        {"\"byteOffset\": 12,", "\"byteOffset\": 16,"},               // accessor exceeding buffer view
+        {"\"byteOffset\": 12,", "\"byteOffset\": 14,"},               // misaligned accessor
+        {"\"indices\": 2", "\"indices\": 3"},                         // missing accessor
+        {"\"POSITION\": 0, \"NORMAL\": 1", "\"POSITION\": 2"},        // integer positions
+    };
+    for (const auto &replacement : replacements) {
+        std::string json = interleavedJson;
+        json.replace(json.find(replacement.first), std::strlen(replacement.first), replacement.second);
+        std::vector<GltfPrimitive> primitives{};
+        EXPECT_FALSE(parse(createGlb(json, createInterleavedBin()), primitives)) << replacement.second;
+    }
+}
+
+TEST(GltfParserTests, givenIndexReferencingMissingVertexWhenParsingThenReturnFalse) {
+    std::vector<char> bin = createInterleavedBin();
+    const uint32_t invalidIndex = 4u;
+    std::memcpy(bin.data() + 96 + 5 * sizeof(uint32_t), &invalidIndex, sizeof(invalidIndex));
+    std::vector<GltfPrimitive> primitives{};
+    EXPECT_FALSE(parse(createGlb(interleavedJson, bin), primitives));
+}
@@ -0,0 +1,89 @@
+#include "Geometry/GeometryTestHelper.h"
+#include "Geometry/MeshOptimizer.h"
+
+#include <algorithm>
+#include <array>
+#include <gtest/gtest.h>
+
+namespace {
+// Regular grid of quads in XY plane, with triangles in random order
+void createShuffledGrid(UINT quadsPerSide, std::vector<FLOAT> &outVertexElements, std::vector<UINT> &outIndices) {
+    GeometryTestHelper::createFlatGrid(quadsPerSide, outVertexElements, outIndices);
+    GeometryTestHelper::shuffleTriangles(outIndices, 1234u);
+}
+
+// Triangles rotated, so the smallest index is first (preserving winding) and sorted
+std::vector<std::array<UINT, 3>> getCanonicalTriangles(const std::vector<UINT> &indices, const std::vector<FLOAT> &vertexElements) {
+    std::vector<std::array<UINT, 3>> triangles{};
+    for (size_t i = 0u; i < indices.size(); i += 3) {
+        // Compare by positions, so the result doesn't depend on vertex order
+        std::array<UINT, 3> triangle{};
+        for (auto corner = 0u; corner < 3u; corner++) {
+            const FLOAT *position = vertexElements.data() + 3 * indices[i + corner];
+            triangle[corner] = static_cast<UINT>(position[0]) * 1000 + static_cast<UINT>(position[1]);
+        }
+        std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+        triangles.push_back(triangle);
+    }
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+} // namespace
+
+TEST(MeshOptimizerTests, givenSimpleIndexBuffersWhenAnalyzingVertexCacheThenReturnCorrectStatistics) {
+    auto statistics = MeshOptimizer::analyzeVertexCache({0, 1, 2}, 3u);
+    EXPECT_FLOAT_EQ(3.f, statistics.acmr);
+    EXPECT_FLOAT_EQ(1.f, statistics.atvr);
+
+    statistics = MeshOptimizer::analyzeVertexCache({0, 1, 2, 0, 2, 3}, 4u);
+    EXPECT_FLOAT_EQ(2.f, statistics.acmr);
+    EXPECT_FLOAT_EQ(1.f, statistics.atvr);
+
+    // With cache of size 3, vertex 0 is evicted before the last triangle
+    statistics = MeshOptimizer::analyzeVertexCache({0, 1, 2, 3, 4, 5, 0, 1, 2}, 6u, 3u);
+    EXPECT_FLOAT_EQ(3.f, statistics.acmr);
+    EXPECT_FLOAT_EQ(1.5f, statistics.atvr);
+}
+
+TEST(MeshOptimizerTests, givenShuffledGridWhenOptimizingVertexCacheThenTrianglesArePreservedAndAcmrDecreases) {
+    std::vector<FLOAT> vertexElements{};
+    std::vector<UINT> indices{};
+    createShuffledGrid(32u, vertexElements, indices);
+    const UINT verticesCount = static_cast<UINT>(vertexElements.size() / 3);
+    const auto expectedTriangles = getCanonicalTriangles(indices, vertexElements);
+    const auto statisticsBefore = MeshOptimizer::analyzeVertexCache(indices, verticesCount);
+
+    MeshOptimizer::optimizeVertexCache(indices, verticesCount);
+    const auto statisticsAfter = MeshOptimizer::analyzeVertexCache(indices, verticesCount);
+
+    EXPECT_EQ(expectedTriangles, getCanonicalTriangles(indices, vertexElements));
+    EXPECT_GT(statisticsBefore.acmr, 2.f);
+    EXPECT_LT(statisticsAfter.acmr, 1.f);
+    EXPECT_LT(statisticsAfter.atvr, statisticsBefore.atvr);
+}
+
+TEST(MeshOptimizerTests, givenOptimizedGridWhenOptimizingOverdrawThenTrianglesArePreservedAndAcmrStaysClose) {
+    std::vector<FLOAT> vertexElements{};
+    std::vector<UINT> indices{};
+    createShuffledGrid(32u, vertexElements, indices);
+    const UINT verticesCount = static_cast<UINT>(vertexElements.size() / 3);
+    const auto expectedTriangles = getCanonicalTriangles(indices, vertexElements);
+    MeshOptimizer::optimizeVertexCache(indices, verticesCount);
+    const auto statisticsBefore = MeshOptimizer::analyzeVertexCache(indices, verticesCount);
+
+    MeshOptimizer::optimizeOverdraw(indices, vertexElements, 3u);
+    const auto statisticsAfter = MeshOptimizer::analyzeVertexCache(indices, verticesCount);
+
+    EXPECT_EQ(expectedTriangles, getCanonicalTriangles(indices, vertexElements));
+    EXPECT_LT(statisticsAfter.acmr, statisticsBefore.acmr * 1.1f);
+}
+
+TEST(MeshOptimizerTests, givenIndicesWhenOptimizingVertexFetchThenVerticesAreInOrderOfFirstUseAndUnusedAreRemoved) {
+    std::vector<FLOAT> vertexElements = {0, 0, 0, 1, 1, 1, 2, 2, 2, 3, 3, 3};
+    std::vector<UINT> indices = {3, 1, 0, 0, 1, 3};
+
+    MeshOptimizer::optimizeVertexFetch(indices, vertexElements, 3u);
+
+    EXPECT_EQ((std::vector<UINT>{0, 1, 2, 2, 1, 0}), indices);
+    EXPECT_EQ((std::vector<FLOAT>{3, 3, 3, 1, 1, 1, 0, 0, 0}), vertexElements);
+}
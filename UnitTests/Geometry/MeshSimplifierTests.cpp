@@ -0,0 +1,81 @@
+#include "Geometry/GeometryTestHelper.h"
+#include "Geometry/MeshSimplifier.h"
+
+#include <algorithm>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <limits>
+
+namespace {
+constexpr FLOAT noErrorLimit = std::numeric_limits<FLOAT>::max();
+} // namespace
+
+TEST(MeshSimplifierTests, givenFlatGridWhenSimplifyingThenTargetIsReachedWithoutError) {
+    std::vector<FLOAT> vertexElements{};
+    std::vector<UINT> indices{};
+    GeometryTestHelper::createFlatGrid(10, vertexElements, indices);
+
+    std::vector<UINT> simplifiedIndices{};
+    const FLOAT error = MeshSimplifier::simplify(indices, vertexElements, 3, 60, noErrorLimit, simplifiedIndices);
+    EXPECT_GE(60u, simplifiedIndices.size());
+    EXPECT_LT(0u, simplifiedIndices.size());
+    EXPECT_EQ(0u, simplifiedIndices.size() % 3);
+    EXPECT_FLOAT_EQ(0.f, error);
+}
+
+TEST(MeshSimplifierTests, givenCurvedGridWhenSimplifyingThenErrorIsReportedAndOriginalVerticesAreReferenced) {
+    std::vector<FLOAT> vertexElements{};
+    std::vector<UINT> indices{};
+    GeometryTestHelper::createGrid(
+        16, [](FLOAT x, FLOAT y) { return std::sin(x * 0.5f) * std::cos(y * 0.5f); }, false, vertexElements, indices);
+
+    std::vector<UINT> simplifiedIndices{};
+    const FLOAT error = MeshSimplifier::simplify(indices, vertexElements, 3, static_cast<UINT>(indices.size() / 4), noErrorLimit, simplifiedIndices);
+    EXPECT_GE(indices.size() / 4, simplifiedIndices.size());
+    EXPECT_LT(0.f, error);
+    EXPECT_GT(1.f, error);
+    for (UINT index : simplifiedIndices) {
+        EXPECT_GT(vertexElements.size() / 3, index);
+    }
+}
+
+TEST(MeshSimplifierTests, givenErrorLimitWhenSimplifyingThenGridCornersArePreserved) {
+    std::vector<FLOAT> vertexElements{};
+    std::vector<UINT> indices{};
+    GeometryTestHelper::createFlatGrid(4, vertexElements, indices);
+
+    std::vector<UINT> simplifiedIndices{};
+    const FLOAT error = MeshSimplifier::simplify(indices, vertexElements, 3, 0, 0.01f, simplifiedIndices);
+    EXPECT_FLOAT_EQ(0.f, error);
+    ASSERT_EQ(6u, simplifiedIndices.size());
+    for (UINT corner : {0u, 4u, 20u, 24u}) {
+        EXPECT_NE(simplifiedIndices.end(), std::find(simplifiedIndices.begin(), simplifiedIndices.end(), corner));
+    }
+}
+
+TEST(MeshSimplifierTests, givenVerticesSplitOnSeamWhenSimplifyingThenTrianglesDoNotMixVerticesFromBothSides) {
+    // Two strips of quads touching at x=2, but with separate vertices, like on a texture seam. Last element is u coordinate.
+    std::vector<FLOAT> vertexElements{};
+    std::vector<UINT> indices{};
+    for (UINT side = 0u; side < 2u; side++) {
+        const UINT firstVertex = side * 6;
+        for (UINT y = 0u; y < 2u; y++) {
+            for (UINT x = 0u; x < 3u; x++) {
+                vertexElements.insert(vertexElements.end(), {static_cast<FLOAT>(side * 2 + x), static_cast<FLOAT>(y), 0.f, static_cast<FLOAT>(side)});
+            }
+        }
+        for (UINT x = 0u; x < 2u; x++) {
+            const UINT corner = firstVertex + x;
+            indices.insert(indices.end(), {corner, corner + 1, corner + 3, corner + 1, corner + 4, corner + 3});
+        }
+    }
+
+    std::vector<UINT> simplifiedIndices{};
+    MeshSimplifier::simplify(indices, vertexElements, 4, 12, 0.01f, simplifiedIndices);
+    ASSERT_EQ(12u, simplifiedIndices.size());
+    for (auto triangle = 0u; triangle < 4u; triangle++) {
+        const FLOAT u = vertexElements[simplifiedIndices[triangle * 3] * 4 + 3];
+        EXPECT_EQ(u, vertexElements[simplifiedIndices[triangle * 3 + 1] * 4 + 3]);
+        EXPECT_EQ(u, vertexElements[simplifiedIndices[triangle * 3 + 2] * 4 + 3]);
+    }
+}
@@ -0,0 +1,76 @@
+#include "Geometry/MeshWelder.h"
+
+#include <gtest/gtest.h>
+
+TEST(MeshWelderTests, givenDuplicatedVerticesWhenWeldingThenOnlyUniqueVerticesAreLeft) {
+    // Two triangles of a quad, sharing an edge
+    const std::vector<FLOAT> vertexElements = {
+        0, 0, 0, 1, 0, 0, 1, 1, 0,
+        0, 0, 0, 1, 1, 0, 0, 1, 0};
+
+    std::vector<FLOAT> weldedVertexElements{};
+    std::vector<UINT> indices{};
+    MeshWelder::weld(vertexElements, 3u, weldedVertexElements, indices);
+
+    EXPECT_EQ((std::vector<FLOAT>{0, 0, 0, 1, 0, 0, 1, 1, 0, 0, 1, 0}), weldedVertexElements);
+    EXPECT_EQ((std::vector<UINT>{0, 1, 2, 0, 2, 3}), indices);
+}
+
+TEST(MeshWelderTests, givenVerticesDifferingOnlyInOneAttributeWhenWeldingThenTheyAreNotMerged) {
+    // Position and uv, the same position used with two different texture coordinates
+    const std::vector<FLOAT> vertexElements = {
+        0, 0, 0, 0.f, 0.f,
+        0, 0, 0, 0.5f, 0.f,
+        0, 0, 0, 0.f, 0.f};
+
+    std::vector<FLOAT> weldedVertexElements{};
+    std::vector<UINT> indices{};
+    MeshWelder::weld(vertexElements, 5u, weldedVertexElements, indices);
+
+    EXPECT_EQ(10u, weldedVertexElements.size());
+    EXPECT_EQ((std::vector<UINT>{0, 1, 0}), indices);
+}
+
+TEST(MeshWelderTests, givenManyVerticesWhenWeldingThenEveryIndexPointsToIdenticalVertex) {
+    std::vector<FLOAT> vertexElements{};
+    for (auto i = 0u; i < 10000u; i++) {
+        const auto value = static_cast<FLOAT>(i % 1234u);
+        vertexElements.insert(vertexElements.end(), {value, value * 2, -value});
+    }
+
+    std::vector<FLOAT> weldedVertexElements{};
+    std::vector<UINT> indices{};
+    MeshWelder::weld(vertexElements, 3u, weldedVertexElements, indices);
+
+    EXPECT_EQ(1234u * 3u, weldedVertexElements.size());
+    ASSERT_EQ(10000u, indices.size());
+    for (auto i = 0u; i < indices.size(); i++) {
+        for (auto element = 0u; element < 3u; element++) {
+            EXPECT_EQ(vertexElements[3 * i + element], weldedVertexElements[3 * indices[i] + element]);
+        }
+    }
+}
+
+TEST(MeshWelderTests, givenVerticesAddedIncrementallyWithoutReservingWhenWeldingThenResultIsTheSameAsWeldingAtOnce) {
+    std::vector<FLOAT> vertexElements{};
+    for (auto i = 0u; i < 10000u; i++) {
+        const auto value = static_cast<FLOAT>((i * 7u) % 3001u);
+        vertexElements.insert(vertexElements.end(), {value, -value, value * 0.5f});
+    }
+    std::vector<FLOAT> expectedVertexElements{};
+    std::vector<UINT> expectedIndices{};
+    MeshWelder::weld(vertexElements, 3u, expectedVertexElements, expectedIndices);
+
+    // Hash table starts small, so it has to be grown multiple times
+    std::vector<FLOAT> weldedVertexElements{};
+    std::vector<UINT> indices{};
+    IncrementalMeshWelder welder{3u, weldedVertexElements, indices};
+    for (auto i = 0u; i < 10000u; i++) {
+        welder.addVertex(vertexElements.data() + 3 * i);
+    }
+
+    EXPECT_EQ(3001u * 3u, weldedVertexElements.size());
+    EXPECT_EQ(expectedVertexElements, weldedVertexElements);
+    EXPECT_EQ(expectedIndices, indices);
+    EXPECT_GE(welder.getHashTableSizeInBytes(), 2 * 3001u * sizeof(UINT));
+}
@@ -0,0 +1,78 @@
+#include "Geometry/GeometryTestHelper.h"
+#include "Geometry/MeshletBuilder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <gtest/gtest.h>
+
+TEST(MeshletBuilderTests, givenGridWhenBuildingMeshletsThenMeshletsCoverWholeIndexBufferWithinLimits) {
+    std::vector<FLOAT> vertexElements{};
+    std::vector<UINT> indices{};
+    GeometryTestHelper::createFlatGrid(20, vertexElements, indices);
+
+    std::vector<Meshlet> meshlets{};
+    MeshletBuilder::build(indices, vertexElements, 3, meshlets);
+    ASSERT_LT(1u, meshlets.size());
+
+    UINT expectedFirstIndex = 0u;
+    for (const Meshlet &meshlet : meshlets) {
+        EXPECT_EQ(expectedFirstIndex, meshlet.firstIndex);
+        EXPECT_EQ(0u, meshlet.indicesCount % 3);
+        EXPECT_GE(MeshletBuilder::defaultMaxTriangles * 3, meshlet.indicesCount);
+
+        std::vector<UINT> uniqueVertices(indices.begin() + meshlet.firstIndex, indices.begin() + meshlet.firstIndex + meshlet.indicesCount);
+        std::sort(uniqueVertices.begin(), uniqueVertices.end());
+        uniqueVertices.erase(std::unique(uniqueVertices.begin(), uniqueVertices.end()), uniqueVertices.end());
+        EXPECT_GE(MeshletBuilder::defaultMaxVertices, uniqueVertices.size());
+
+        expectedFirstIndex += meshlet.indicesCount;
+    }
+    EXPECT_EQ(indices.size(), expectedFirstIndex);
+}
+
+TEST(MeshletBuilderTests, givenTriangleLimitWhenBuildingMeshletsThenMeshletsAreSplitAtTheLimit) {
+    std::vector<FLOAT> vertexElements{};
+    std::vector<UINT> indices{};
+    GeometryTestHelper::createFlatGrid(2, vertexElements, indices);
+
+    std::vector<Meshlet> meshlets{};
+    MeshletBuilder::build(indices, vertexElements, 3, meshlets, 64, 3);
+    ASSERT_EQ(3u, meshlets.size());
+    EXPECT_EQ(9u, meshlets[0].indicesCount);
+    EXPECT_EQ(9u, meshlets[1].indicesCount);
+    EXPECT_EQ(6u, meshlets[2].indicesCount);
+}
+
+TEST(MeshletBuilderTests, givenFlatMeshletWhenBuildingMeshletsThenBoundsContainAllVerticesAndConeIsNarrow) {
+    const std::vector<FLOAT> vertexElements = {
+        0, 0, 0, 9, 9,
+        2, 0, 0, 9, 9,
+        0, 2, 0, 9, 9,
+        2, 2, 0, 9, 9};
+    const std::vector<UINT> indices = {0, 1, 2, 1, 3, 2};
+
+    std::vector<Meshlet> meshlets{};
+    MeshletBuilder::build(indices, vertexElements, 5, meshlets);
+    ASSERT_EQ(1u, meshlets.size());
+    EXPECT_FLOAT_EQ(1.f, meshlets[0].center[0]);
+    EXPECT_FLOAT_EQ(1.f, meshlets[0].center[1]);
+    EXPECT_FLOAT_EQ(0.f, meshlets[0].center[2]);
+    EXPECT_FLOAT_EQ(std::sqrt(2.f), meshlets[0].radius);
+    EXPECT_FLOAT_EQ(0.f, meshlets[0].coneAxis[0]);
+    EXPECT_FLOAT_EQ(0.f, meshlets[0].coneAxis[1]);
+    EXPECT_FLOAT_EQ(1.f, meshlets[0].coneAxis[2]);
+    EXPECT_FLOAT_EQ(0.f, meshlets[0].coneCutoff);
+}
+
+TEST(MeshletBuilderTests, givenTrianglesFacingOppositeDirectionsWhenBuildingMeshletsThenConeIsDisabled) {
+    const std::vector<FLOAT> vertexElements = {
+        0, 0, 0,
+        1, 0, 0,
+        0, 1, 0};
+    const std::vector<UINT> indices = {0, 1, 2, 0, 2, 1};
+
+    std::vector<Meshlet> meshlets{};
+    MeshletBuilder::build(indices, vertexElements, 3, meshlets);
+    ASSERT_EQ(1u, meshlets.size());
+    EXPECT_LE(1.f, meshlets[0].coneCutoff);
+}
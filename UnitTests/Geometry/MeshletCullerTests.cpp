@@ -0,0 +1,75 @@
+#include "Geometry/MeshletCuller.h"
+
+#include <gtest/gtest.h>
+
+namespace {
+struct MeshletCullerTests : ::testing::Test {
+    void SetUp() override {
+        // Identity clip space transform, visible volume is x,y in [-1,1] and z in [0,1]
+        objectToClip = XMFLOAT4X4(1, 0, 0, 0,
+                                  0, 1, 0, 0,
+                                  0, 0, 1, 0,
+                                  0, 0, 0, 1);
+    }
+
+    static Meshlet createMeshlet(UINT firstIndex, FLOAT x, FLOAT y, FLOAT z, FLOAT radius, FLOAT coneCutoff = 1.f) {
+        return Meshlet{firstIndex, 3, {x, y, z}, radius, {0, 0, 1}, coneCutoff};
+    }
+
+    XMFLOAT4X4 objectToClip;
+    std::vector<IndexRange> visibleRanges{};
+};
+} // namespace
+
+TEST_F(MeshletCullerTests, givenMeshletsOutsideFrustumWhenCullingThenTheyAreRejected) {
+    const std::vector<Meshlet> meshlets = {
+        createMeshlet(0, 5.f, 0.f, 0.5f, 1.f),
+        createMeshlet(3, 0.f, 0.f, 0.5f, 0.1f),
+        createMeshlet(6, 0.f, 0.f, -2.f, 1.f),
+        createMeshlet(9, 0.f, -1.5f, 0.5f, 1.f),
+        createMeshlet(12, 0.f, 0.f, 3.f, 1.f),
+    };
+
+    MeshletCuller::cull(meshlets.data(), static_cast<UINT>(meshlets.size()), objectToClip, nullptr, visibleRanges);
+    ASSERT_EQ(2u, visibleRanges.size());
+    EXPECT_EQ(3u, visibleRanges[0].firstIndex);
+    EXPECT_EQ(3u, visibleRanges[0].indicesCount);
+    EXPECT_EQ(9u, visibleRanges[1].firstIndex);
+    EXPECT_EQ(3u, visibleRanges[1].indicesCount);
+}
+
+TEST_F(MeshletCullerTests, givenAdjacentVisibleMeshletsWhenCullingThenRangesAreMerged) {
+    const std::vector<Meshlet> meshlets = {
+        createMeshlet(0, 0.f, 0.f, 0.5f, 0.1f),
+        createMeshlet(3, 0.f, 0.f, 0.5f, 0.1f),
+        createMeshlet(6, 0.f, 0.f, 0.5f, 0.1f),
+    };
+
+    MeshletCuller::cull(meshlets.data(), static_cast<UINT>(meshlets.size()), objectToClip, nullptr, visibleRanges);
+    ASSERT_EQ(1u, visibleRanges.size());
+    EXPECT_EQ(0u, visibleRanges[0].firstIndex);
+    EXPECT_EQ(9u, visibleRanges[0].indicesCount);
+}
+
+TEST_F(MeshletCullerTests, givenMeshletFacingAwayFromEyeWhenCullingThenItIsRejected) {
+    const std::vector<Meshlet> meshlets = {createMeshlet(0, 0.f, 0.f, 0.5f, 0.1f, 0.f)};
+
+    const XMFLOAT3 eyeBehind{0.f, 0.f, -10.f};
+    MeshletCuller::cull(meshlets.data(), static_cast<UINT>(meshlets.size()), objectToClip, &eyeBehind, visibleRanges);
+    EXPECT_EQ(0u, visibleRanges.size());
+
+    const XMFLOAT3 eyeInFront{0.f, 0.f, 10.f};
+    MeshletCuller::cull(meshlets.data(), static_cast<UINT>(meshlets.size()), objectToClip, &eyeInFront, visibleRanges);
+    EXPECT_EQ(1u, visibleRanges.size());
+
+    MeshletCuller::cull(meshlets.data(), static_cast<UINT>(meshlets.size()), objectToClip, nullptr, visibleRanges);
+    EXPECT_EQ(1u, visibleRanges.size());
+}
+
+TEST_F(MeshletCullerTests, givenMeshletWithDisabledConeWhenCullingThenItIsNeverBackFacing) {
+    const std::vector<Meshlet> meshlets = {createMeshlet(0, 0.f, 0.f, 0.5f, 0.f, 1.f)};
+
+    const XMFLOAT3 eyeBehind{0.f, 0.f, -10.f};
+    MeshletCuller::cull(meshlets.data(), static_cast<UINT>(meshlets.size()), objectToClip, &eyeBehind, visibleRanges);
+    EXPECT_EQ(1u, visibleRanges.size());
+}
@@ -0,0 +1,306 @@
+#include "Geometry/ObjParser.h"
+
+#include <cstring>
+#include <gtest/gtest.h>
+
+namespace {
+bool parseString(const char *text, ObjData &outData) {
+    return ObjParser::parse(text, text + std::strlen(text), outData);
+}
+} // namespace
+
+TEST(ObjParserTests, givenVariousFloatFormatsWhenParsingFloatThenReturnCorrectValues) {
+    const char *inputs[] = {"0", "1", "-1", "+2.5", "0.125", ".5", "-0.830351", "1e3", "2.5E-2", "-1.5e+1"};
+    const FLOAT expected[] = {0.f, 1.f, -1.f, 2.5f, 0.125f, 0.5f, -0.830351f, 1000.f, 0.025f, -15.f};
+    for (auto i = 0u; i < sizeof(inputs) / sizeof(inputs[0]); i++) {
+        FLOAT value = -123.f;
+        const char *end = inputs[i] + std::strlen(inputs[i]);
+        EXPECT_EQ(end, ObjParser::parseFloat(inputs[i], end, value));
+        EXPECT_FLOAT_EQ(expected[i], value);
+    }
+}
+
+TEST(ObjParserTests, givenInvalidFloatWhenParsingFloatThenReturnNullptr) {
+    const char *inputs[] = {"", "-", ".", "abc", "e5"};
+    for (const char *input : inputs) {
+        FLOAT value = 0.f;
+        EXPECT_EQ(nullptr, ObjParser::parseFloat(input, input + std::strlen(input), value));
+    }
+}
+
+TEST(ObjParserTests, givenExponentMarkerWithoutDigitsWhenParsingFloatThenItIsNotConsumed) {
+    const char *input = "3e";
+    FLOAT value = 0.f;
+    EXPECT_EQ(input + 1, ObjParser::parseFloat(input, input + 2, value));
+    EXPECT_FLOAT_EQ(3.f, value);
+}
+
+TEST(ObjParserTests, givenUnsignedNumbersWhenParsingThenReturnCorrectValuesOrFail) {
+    UINT value = 0u;
+    const char *input = "1234/";
+    EXPECT_EQ(input + 4, ObjParser::parseUnsigned(input, input + 5, value));
+    EXPECT_EQ(1234u, value);
+
+    input = "-1";
+    EXPECT_EQ(nullptr, ObjParser::parseUnsigned(input, input + 2, value));
+    input = "99999999999";
+    EXPECT_EQ(nullptr, ObjParser::parseUnsigned(input, input + 11, value));
+}
+
+TEST(ObjParserTests, givenAttributeStatementsWhenParsingThenAttributesAreAppended) {
+    ObjData data{};
+    EXPECT_TRUE(parseString("# comment\r\n"
+                            "v 1 2 3\r\n"
+                            "vn 0 1 0\n"
+                            "vt 0.5 0.25 1\n"
+                            "   v\t-1 -2 -3\n"
+                            "o someObject\n",
+                            data));
+    EXPECT_EQ((std::vector<FLOAT>{1, 2, 3, -1, -2, -3}), data.positions);
+    EXPECT_EQ((std::vector<FLOAT>{0, 1, 0}), data.normals);
+    EXPECT_EQ((std::vector<FLOAT>{0.5f, 0.25f}), data.textureCoordinates);
+    EXPECT_TRUE(data.faceCorners.empty());
+}
+
+TEST(ObjParserTests, givenFaceCornersInAllFormatsWhenParsingThenIndicesAreZeroBased) {
+    ObjData data{};
+    EXPECT_TRUE(parseString("f 1 2 3\n"
+                            "f 4/5 6/7 8/9\n"
+                            "f 1//2 3//4 5//6\n"
+                            "f 7/8/9 10/11/12 13/14/15 \n",
+                            data));
+    ASSERT_EQ(12u, data.faceCorners.size());
+
+    EXPECT_EQ(0u, data.faceCorners[0].position);
+    EXPECT_EQ(0u, data.faceCorners[0].textureCoordinate);
+    EXPECT_EQ(0u, data.faceCorners[0].normal);
+
+    EXPECT_EQ(3u, data.faceCorners[3].position);
+    EXPECT_EQ(4u, data.faceCorners[3].textureCoordinate);
+    EXPECT_EQ(0u, data.faceCorners[3].normal);
+
+    EXPECT_EQ(0u, data.faceCorners[6].position);
+    EXPECT_EQ(0u, data.faceCorners[6].textureCoordinate);
+    EXPECT_EQ(1u, data.faceCorners[6].normal);
+
+    EXPECT_EQ(12u, data.faceCorners[11].position);
+    EXPECT_EQ(13u, data.faceCorners[11].textureCoordinate);
+    EXPECT_EQ(14u, data.faceCorners[11].normal);
+}
+
+TEST(ObjParserTests, givenPolygonFaceWhenParsingThenItIsTriangulatedAsFan) {
+    ObjData data{};
+    EXPECT_TRUE(parseString("f 1 2 3 4 5\n", data));
+    const UINT expectedPositions[] = {0, 1, 2, 0, 2, 3, 0, 3, 4};
+    ASSERT_EQ(9u, data.faceCorners.size());
+    for (auto i = 0u; i < 9u; i++) {
+        EXPECT_EQ(expectedPositions[i], data.faceCorners[i].position);
+    }
+}
+
+TEST(ObjParserTests, givenMalformedFaceWhenParsingThenReturnFalse) {
+    const char *inputs[] = {"f 1 2\n", "f 0 1 2\n", "f 1 a 2\n", "f 1/ 2/ 3/\n"};
+    for (const char *input : inputs) {
+        ObjData data{};
+        EXPECT_FALSE(parseString(input, data));
+    }
+}
+
+TEST(ObjParserTests, givenRangeWhenFindingLineAlignedChunkEndThenChunkEndsAfterLineFeed) {
+    const char *text = "v 1 2 3\nv 4 5 6\nv 7 8 9";
+    const char *end = text + std::strlen(text);
+    EXPECT_EQ(text + 8, ObjParser::findLineAlignedChunkEnd(text, end, 1));
+    EXPECT_EQ(text + 8, ObjParser::findLineAlignedChunkEnd(text, end, 8));
+    EXPECT_EQ(text + 16, ObjParser::findLineAlignedChunkEnd(text, end, 9));
+    EXPECT_EQ(end, ObjParser::findLineAlignedChunkEnd(text, end, 17));
+    EXPECT_EQ(end, ObjParser::findLineAlignedChunkEnd(text, end, 1000));
+}
+
+TEST(ObjParserTests, givenRangeWhenSplittingIntoChunksThenChunksAreLineAlignedAndCoverWholeRange) {
+    const char *text = "v 1 2 3\nv 4 5 6\nv 7 8 9\nv 1 1 1\n";
+    const char *end = text + std::strlen(text);
+
+    const auto chunks = ObjParser::splitIntoChunks(text, end, 4, 1);
+    ASSERT_EQ(4u, chunks.size());
+    EXPECT_EQ(text, chunks[0].begin);
+    for (auto i = 1u; i < chunks.size(); i++) {
+        EXPECT_EQ(chunks[i - 1].end, chunks[i].begin);
+        EXPECT_EQ('\n', chunks[i].begin[-1]);
+    }
+    EXPECT_EQ(end, chunks.back().end);
+}
+
+TEST(ObjParserTests, givenRangeSmallerThanMinChunkSizeWhenSplittingIntoChunksThenReturnOneChunk) {
+    const char *text = "v 1 2 3\nv 4 5 6\n";
+    const char *end = text + std::strlen(text);
+
+    const auto chunks = ObjParser::splitIntoChunks(text, end, 8, 1024);
+    ASSERT_EQ(1u, chunks.size());
+    EXPECT_EQ(text, chunks[0].begin);
+    EXPECT_EQ(end, chunks[0].end);
+}
+
+TEST(ObjParserTests, givenChunksParsedSeparatelyWhenMergingThenResultIsTheSameAsParsingWholeRange) {
+    const char *text = "v 1 2 3\nvt 0 1\nvn 0 0 1\n"
+                       "v 4 5 6\nf 1/1/1 2/1/1 3/1/1\n"
+                       "v 7 8 9\nvt 1 0\nf 2/2/1 3/1/1 4/2/1\n";
+    const char *end = text + std::strlen(text);
+    ObjData expectedData{};
+    ASSERT_TRUE(ObjParser::parse(text, end, expectedData));
+
+    const auto chunks = ObjParser::splitIntoChunks(text, end, 3, 1);
+    ASSERT_EQ(3u, chunks.size());
+    std::vector<ObjData> chunksData(chunks.size());
+    for (auto i = 0u; i < chunks.size(); i++) {
+        ASSERT_TRUE(ObjParser::parse(chunks[i].begin, chunks[i].end, chunksData[i]));
+    }
+    ObjData mergedData{};
+    ObjParser::merge(chunksData, mergedData);
+
+    EXPECT_EQ(expectedData.positions, mergedData.positions);
+    EXPECT_EQ(expectedData.normals, mergedData.normals);
+    EXPECT_EQ(expectedData.textureCoordinates, mergedData.textureCoordinates);
+    ASSERT_EQ(expectedData.faceCorners.size(), mergedData.faceCorners.size());
+    for (auto i = 0u; i < expectedData.faceCorners.size(); i++) {
+        EXPECT_EQ(expectedData.faceCorners[i].position, mergedData.faceCorners[i].position);
+        EXPECT_EQ(expectedData.faceCorners[i].textureCoordinate, mergedData.faceCorners[i].textureCoordinate);
+        EXPECT_EQ(expectedData.faceCorners[i].normal, mergedData.faceCorners[i].normal);
+    }
+}
+
+TEST(ObjParserTests, givenRangeParsedInTwoPassesWhenComparingWithParsingAtOnceThenResultIsTheSame) {
+    const char *text = "v 1 2 3\nvt 0 1\nvn 0 0 1\n"
+                       "v 4 5 6\nf 1/1/1 2/1/1 3/1/1\n"
+                       "v 7 8 9\nvt 1 0\nf 2/2/1 3/1/1 4/2/1 1/1/1\n";
+    const char *end = text + std::strlen(text);
+    ObjData expectedData{};
+    ASSERT_TRUE(ObjParser::parse(text, end, expectedData));
+
+    ObjData attributesData{};
+    size_t faceCornersCount = 0u;
+    ASSERT_TRUE(ObjParser::parseAttributes(text, end, attributesData, faceCornersCount));
+    EXPECT_EQ(expectedData.positions, attributesData.positions);
+    EXPECT_EQ(expectedData.normals, attributesData.normals);
+    EXPECT_EQ(expectedData.textureCoordinates, attributesData.textureCoordinates);
+    EXPECT_TRUE(attributesData.faceCorners.empty());
+    EXPECT_EQ(9u, faceCornersCount);
+
+    std::vector<ObjFaceCorner> faceCorners{};
+    for (const ObjChunk &chunk : ObjParser::splitIntoChunks(text, end, 3, 1)) {
+        ASSERT_TRUE(ObjParser::parseFaces(chunk.begin, chunk.end, faceCorners));
+    }
+    ASSERT_EQ(expectedData.faceCorners.size(), faceCorners.size());
+    for (auto i = 0u; i < expectedData.faceCorners.size(); i++) {
+        EXPECT_EQ(expectedData.faceCorners[i].position, faceCorners[i].position);
+        EXPECT_EQ(expectedData.faceCorners[i].textureCoordinate, faceCorners[i].textureCoordinate);
+        EXPECT_EQ(expectedData.faceCorners[i].normal, faceCorners[i].normal);
+    }
+}
+
+TEST(ObjParserTests, givenMalformedFaceWhenParsingInTwoPassesThenBothPassesReturnFalse) {
+    const char *text = "v 1 2 3\nv 4 5 6\nv 7 8 9\nf 1 2\n";
+    const char *end = text + std::strlen(text);
+
+    ObjData data{};
+    size_t faceCornersCount = 0u;
+    EXPECT_FALSE(ObjParser::parseAttributes(text, end, data, faceCornersCount));
+    std::vector<ObjFaceCorner> faceCorners{};
+    EXPECT_FALSE(ObjParser::parseFaces(text, end, faceCorners));
+}
+
+TEST(ObjParserTests, givenMaterialStatementsWhenParsingThenMaterialSwitchesAreRecorded) {
+    ObjData data{};
+    EXPECT_TRUE(parseString("mtllib  car parts.mtl \r\n"
+                            "f 1 2 3\n"
+                            "g body\n"
+                            "usemtl paint\n"
+                            "f 1 2 3 4\n"
+                            "usemtl glass\n"
+                            "usemtl paint\n"
+                            "f 1 2 3\n"
+                            "usemtl glass\n"
+                            "f 1 2 3\n",
+                            data));
+    EXPECT_EQ("car parts.mtl", data.materialLibrary);
+    EXPECT_EQ((std::vector<std::string>{"paint", "glass"}), data.materialNames);
+    ASSERT_EQ(2u, data.materialSwitches.size());
+    EXPECT_EQ(3u, data.materialSwitches[0].firstFaceCorner);
+    EXPECT_EQ(0u, data.materialSwitches[0].material);
+    EXPECT_EQ(12u, data.materialSwitches[1].firstFaceCorner);
+    EXPECT_EQ(1u, data.materialSwitches[1].material);
+}
+
+TEST(ObjParserTests, givenMaterialsInSeparateChunksWhenMergingThenMaterialsAreRemappedByName) {
+    const char *text = "usemtl a\nf 1 2 3\n"
+                       "usemtl b\nf 1 2 3\n"
+                       "f 1 2 3\nusemtl a\nf 1 2 3\n";
+    const char *end = text + std::strlen(text);
+    const auto chunks = ObjParser::splitIntoChunks(text, end, 3, 1);
+    ASSERT_EQ(3u, chunks.size());
+    std::vector<ObjData> chunksData(chunks.size());
+    for (auto i = 0u; i < chunks.size(); i++) {
+        ASSERT_TRUE(ObjParser::parse(chunks[i].begin, chunks[i].end, chunksData[i]));
+    }
+    ObjData mergedData{};
+    ObjParser::merge(chunksData, mergedData);
+
+    EXPECT_EQ((std::vector<std::string>{"a", "b"}), mergedData.materialNames);
+    ASSERT_EQ(3u, mergedData.materialSwitches.size());
+    const size_t expectedCorners[] = {0u, 3u, 9u};
+    const UINT expectedMaterials[] = {0u, 1u, 0u};
+    for (auto i = 0u; i < 3u; i++) {
+        EXPECT_EQ(expectedCorners[i], mergedData.materialSwitches[i].firstFaceCorner);
+        EXPECT_EQ(expectedMaterials[i], mergedData.materialSwitches[i].material);
+    }
+}
+
+TEST(ObjParserTests, givenMaterialSwitchesWhenGroupingTrianglesThenEachMaterialIsContiguous) {
+    // Triangle i has indices i * 10 + 0..2, materials: none, 1, 0, 1, 0
+    std::vector<UINT> indices{};
+    for (auto triangle = 0u; triangle < 5u; triangle++) {
+        indices.insert(indices.end(), {triangle * 10, triangle * 10 + 1, triangle * 10 + 2});
+    }
+    const std::vector<ObjMaterialSwitch> materialSwitches = {{3u, 1u}, {6u, 0u}, {9u, 1u}, {12u, 0u}};
+
+    std::vector<ObjMaterialGroup> groups{};
+    ObjParser::groupTrianglesByMaterial(materialSwitches, 2u, indices, groups);
+    ASSERT_EQ(3u, groups.size());
+    EXPECT_EQ(ObjMaterialSwitch::noMaterial, groups[0].material);
+    EXPECT_EQ(0u, groups[0].firstIndex);
+    EXPECT_EQ(3u, groups[0].indicesCount);
+    EXPECT_EQ(0u, groups[1].material);
+    EXPECT_EQ(3u, groups[1].firstIndex);
+    EXPECT_EQ(6u, groups[1].indicesCount);
+    EXPECT_EQ(1u, groups[2].material);
+    EXPECT_EQ(9u, groups[2].firstIndex);
+    EXPECT_EQ(6u, groups[2].indicesCount);
+
+    const std::vector<UINT> expectedIndices = {0, 1, 2, 20, 21, 22, 40, 41, 42, 10, 11, 12, 30, 31, 32};
+    EXPECT_EQ(expectedIndices, indices);
+}
+
+TEST(ObjParserTests, givenMaterialLibraryWhenParsingThenSupportedPropertiesAreRead) {
+    const char *text = "Kd 0 0 0\n"
+                       "newmtl red paint\n"
+                       "Ka 0.1 0.1 0.1\n"
+                       "Kd 1 0 0\n"
+                       "Ks 0.5\n"
+                       "newmtl glass\n"
+                       "map_Kd glass.png\n";
+    std::vector<ObjMaterial> materials{};
+    ObjParser::parseMaterialLibrary(text, text + std::strlen(text), materials);
+    ASSERT_EQ(2u, materials.size());
+
+    EXPECT_EQ("red paint", materials[0].name);
+    EXPECT_FLOAT_EQ(1.f, materials[0].diffuseColor[0]);
+    EXPECT_FLOAT_EQ(0.f, materials[0].diffuseColor[1]);
+    EXPECT_FLOAT_EQ(0.f, materials[0].diffuseColor[2]);
+    for (FLOAT component : materials[0].specularColor) {
+        EXPECT_FLOAT_EQ(0.5f, component);
+    }
+
+    EXPECT_EQ("glass", materials[1].name);
+    for (FLOAT component : materials[1].diffuseColor) {
+        EXPECT_FLOAT_EQ(1.f, component);
+    }
+}
@@ -0,0 +1,133 @@
+#include "Geometry/GeometryTestHelper.h"
+#include "Geometry/TangentSpaceGenerator.h"
+#include "Utility/CpuFeatures.h"
+
+#include <algorithm>
+#include <cmath>
+#include <gtest/gtest.h>
+
+namespace {
+using Weighting = TangentSpaceGenerator::Weighting;
+using SimdLevel = TangentSpaceGenerator::SimdLevel;
+
+// Corner of a box at the origin - two faces are single triangles, the third one is split into two
+const std::vector<FLOAT> boxCornerPositions = {0, 0, 0, 0, 0, 1, 0, 1, 0, 1, 0, 0, 1, 1, 0};
+const std::vector<UINT> boxCornerIndices = {0, 1, 2, 0, 3, 1, 0, 2, 4, 0, 4, 3};
+
+// Wavy grid with texture coordinates following x and y, positions and uvs interleaved
+void createWavyGrid(UINT quadsPerSide, std::vector<FLOAT> &outVertexElements, std::vector<UINT> &outIndices) {
+    GeometryTestHelper::createGrid(
+        quadsPerSide, [](FLOAT x, FLOAT y) { return std::sin(0.7f * x) * std::cos(0.3f * y); }, true, outVertexElements, outIndices);
+}
+} // namespace
+
+TEST(TangentSpaceGeneratorTests, givenBoxCornerWhenComputingAngleWeightedNormalsThenCornerNormalIsIndependentOfTriangulation) {
+    std::vector<FLOAT> normals(boxCornerPositions.size());
+    TangentSpaceGenerator::computeNormals({boxCornerPositions.data(), 3u}, 5u, boxCornerIndices, Weighting::ANGLE, normals.data(), 3u);
+
+    const FLOAT expected = -1.f / std::sqrt(3.f);
+    EXPECT_NEAR(expected, normals[0], 1e-4f);
+    EXPECT_NEAR(expected, normals[1], 1e-4f);
+    EXPECT_NEAR(expected, normals[2], 1e-4f);
+}
+
+TEST(TangentSpaceGeneratorTests, givenBoxCornerWhenComputingAreaWeightedNormalsThenFaceWithMoreAreaDominates) {
+    std::vector<FLOAT> normals(boxCornerPositions.size());
+    TangentSpaceGenerator::computeNormals({boxCornerPositions.data(), 3u}, 5u, boxCornerIndices, Weighting::AREA, normals.data(), 3u);
+
+    EXPECT_NEAR(normals[0], normals[1], 1e-6f);
+    EXPECT_LT(normals[2], normals[0]);
+    EXPECT_NEAR(1.f, normals[0] * normals[0] + normals[1] * normals[1] + normals[2] * normals[2], 1e-5f);
+}
+
+TEST(TangentSpaceGeneratorTests, givenFlatQuadWhenComputingNormalsAndTangentsThenTheyAreAlignedWithPlaneAndUAxis) {
+    // Positions and uvs interleaved
+    const std::vector<FLOAT> vertexElements = {0, 0, 0, 0, 0, 2, 0, 0, 1, 0, 2, 2, 0, 1, 1, 0, 2, 0, 0, 1};
+    const std::vector<UINT> indices = {0, 1, 2, 0, 2, 3};
+    for (auto weighting : {Weighting::AREA, Weighting::ANGLE}) {
+        std::vector<FLOAT> normals(12);
+        std::vector<FLOAT> tangents(12);
+        TangentSpaceGenerator::computeNormals({vertexElements.data(), 5u}, 4u, indices, weighting, normals.data(), 3u);
+        TangentSpaceGenerator::computeTangents({vertexElements.data(), 5u}, {vertexElements.data() + 3, 5u}, {normals.data(), 3u},
+                                               4u, indices, weighting, tangents.data(), 3u);
+        for (auto vertex = 0u; vertex < 4u; vertex++) {
+            EXPECT_NEAR(0.f, normals[3 * vertex + 0], 1e-6f);
+            EXPECT_NEAR(0.f, normals[3 * vertex + 1], 1e-6f);
+            EXPECT_NEAR(1.f, normals[3 * vertex + 2], 1e-6f);
+            EXPECT_NEAR(1.f, tangents[3 * vertex + 0], 1e-6f);
+            EXPECT_NEAR(0.f, tangents[3 * vertex + 1], 1e-6f);
+            EXPECT_NEAR(0.f, tangents[3 * vertex + 2], 1e-6f);
+        }
+    }
+}
+
+TEST(TangentSpaceGeneratorTests, givenUnusedVertexWhenComputingNormalsAndTangentsThenUnitVectorsAreReturned) {
+    const std::vector<FLOAT> positions = {0, 0, 0, 1, 0, 0, 0, 1, 0, 5, 5, 5};
+    const std::vector<FLOAT> textureCoordinates = {0, 0, 0, 0, 0, 0, 0, 0};
+    const std::vector<UINT> indices = {0, 1, 2};
+    std::vector<FLOAT> normals(12);
+    std::vector<FLOAT> tangents(12);
+    TangentSpaceGenerator::computeNormals({positions.data(), 3u}, 4u, indices, Weighting::ANGLE, normals.data(), 3u);
+    TangentSpaceGenerator::computeTangents({positions.data(), 3u}, {textureCoordinates.data(), 2u}, {normals.data(), 3u},
+                                           4u, indices, Weighting::ANGLE, tangents.data(), 3u);
+    for (auto vertex = 0u; vertex < 4u; vertex++) {
+        const FLOAT *normal = normals.data() + 3 * vertex;
+        const FLOAT *tangent = tangents.data() + 3 * vertex;
+        EXPECT_NEAR(1.f, normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2], 1e-5f);
+        EXPECT_NEAR(1.f, tangent[0] * tangent[0] + tangent[1] * tangent[1] + tangent[2] * tangent[2], 1e-5f);
+        EXPECT_NEAR(0.f, normal[0] * tangent[0] + normal[1] * tangent[1] + normal[2] * tangent[2], 1e-5f);
+    }
+}
+
+TEST(TangentSpaceGeneratorTests, givenTrianglesAccumulatedInBatchesWhenNormalizingThenNormalsAreTheSameAsComputedAtOnce) {
+    std::vector<FLOAT> vertexElements{};
+    std::vector<UINT> indices{};
+    createWavyGrid(8u, vertexElements, indices);
+    const auto verticesCount = static_cast<UINT>(vertexElements.size() / 5);
+    std::vector<FLOAT> expectedNormals(3 * verticesCount);
+    TangentSpaceGenerator::computeNormals({vertexElements.data(), 5u}, verticesCount, indices, Weighting::ANGLE, expectedNormals.data(), 3u);
+
+    // Batches of different sizes, normalized in place
+    std::vector<FLOAT> normals(3 * verticesCount, 0.f);
+    for (size_t firstIndex = 0u, batchSize = 3u; firstIndex < indices.size(); firstIndex += batchSize, batchSize += 3u) {
+        const size_t lastIndex = std::min(firstIndex + batchSize, indices.size());
+        const std::vector<UINT> batchIndices(indices.begin() + firstIndex, indices.begin() + lastIndex);
+        TangentSpaceGenerator::accumulateNormals({vertexElements.data(), 5u}, verticesCount, batchIndices, Weighting::ANGLE, normals.data());
+    }
+    TangentSpaceGenerator::normalizeAccumulatedNormals(normals.data(), verticesCount, normals.data(), 3u);
+
+    for (auto i = 0u; i < normals.size(); i++) {
+        EXPECT_NEAR(expectedNormals[i], normals[i], 1e-5f);
+    }
+}
+
+TEST(TangentSpaceGeneratorTests, givenWavyGridWhenComputingWithDifferentSimdLevelsThenResultsAreTheSame) {
+    std::vector<FLOAT> vertexElements{};
+    std::vector<UINT> indices{};
+    createWavyGrid(13u, vertexElements, indices); // odd number of triangles per row, so SIMD kernels also process the remainder
+    const auto verticesCount = static_cast<UINT>(vertexElements.size() / 5);
+
+    std::vector<SimdLevel> simdLevels = {SimdLevel::SCALAR, SimdLevel::SSE};
+    if (CpuFeatures::isAvxSupported()) {
+        simdLevels.push_back(SimdLevel::AVX);
+    }
+    for (auto weighting : {Weighting::AREA, Weighting::ANGLE}) {
+        std::vector<FLOAT> referenceNormals{}, referenceTangents{};
+        for (SimdLevel simdLevel : simdLevels) {
+            std::vector<FLOAT> normals(3 * verticesCount);
+            std::vector<FLOAT> tangents(3 * verticesCount);
+            TangentSpaceGenerator::computeNormals({vertexElements.data(), 5u}, verticesCount, indices, weighting, normals.data(), 3u, simdLevel);
+            TangentSpaceGenerator::computeTangents({vertexElements.data(), 5u}, {vertexElements.data() + 3, 5u}, {normals.data(), 3u},
+                                                   verticesCount, indices, weighting, tangents.data(), 3u, simdLevel);
+            if (referenceNormals.empty()) {
+                referenceNormals = normals;
+                referenceTangents = tangents;
+                continue;
+            }
+            for (auto i = 0u; i < normals.size(); i++) {
+                EXPECT_NEAR(referenceNormals[i], normals[i], 1e-5f);
+                EXPECT_NEAR(referenceTangents[i], tangents[i], 1e-5f);
+            }
+        }
+    }
+}
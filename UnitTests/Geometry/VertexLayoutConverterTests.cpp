@@ -0,0 +1,94 @@
+#include "Geometry/VertexLayoutConverter.h"
+
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace {
+// Texture coordinates first, then padding, normal and position
+DXD::VertexLayout createShuffledLayout() {
+    DXD::VertexLayout layout{};
+    layout.strideInBytes = 9 * sizeof(FLOAT);
+    layout.textureCoordinatesOffset = 0;
+    layout.normalOffset = 3 * sizeof(FLOAT);
+    layout.positionOffset = 6 * sizeof(FLOAT);
+    return layout;
+}
+} // namespace
+
+TEST(VertexLayoutConverterTests, givenOptionalAttributesWhenGettingPackedLayoutThenTheyFollowNormals) {
+    const DXD::VertexLayout minimal = VertexLayoutConverter::getPackedLayout(false, false);
+    EXPECT_EQ(24u, minimal.strideInBytes);
+    EXPECT_EQ(0, minimal.positionOffset);
+    EXPECT_EQ(12, minimal.normalOffset);
+    EXPECT_FALSE(minimal.hasTangents());
+    EXPECT_FALSE(minimal.hasTextureCoordinates());
+
+    const DXD::VertexLayout textured = VertexLayoutConverter::getPackedLayout(false, true);
+    EXPECT_EQ(32u, textured.strideInBytes);
+    EXPECT_EQ(24, textured.textureCoordinatesOffset);
+
+    const DXD::VertexLayout full = VertexLayoutConverter::getPackedLayout(true, true);
+    EXPECT_EQ(44u, full.strideInBytes);
+    EXPECT_EQ(24, full.tangentOffset);
+    EXPECT_EQ(36, full.textureCoordinatesOffset);
+    EXPECT_TRUE(VertexLayoutConverter::validateLayout(full));
+}
+
+TEST(VertexLayoutConverterTests, givenInvalidLayoutsWhenValidatingThenReturnFalse) {
+    EXPECT_TRUE(VertexLayoutConverter::validateLayout(createShuffledLayout()));
+
+    DXD::VertexLayout layout = createShuffledLayout();
+    layout.normalOffset = DXD::VertexLayout::absent;
+    EXPECT_FALSE(VertexLayoutConverter::validateLayout(layout));
+
+    layout = createShuffledLayout();
+    layout.positionOffset = 7 * sizeof(FLOAT); // exceeds the stride
+    EXPECT_FALSE(VertexLayoutConverter::validateLayout(layout));
+
+    layout = createShuffledLayout();
+    layout.normalOffset = 2; // misaligned
+    EXPECT_FALSE(VertexLayoutConverter::validateLayout(layout));
+
+    layout = createShuffledLayout();
+    layout.tangentOffset = 3 * sizeof(FLOAT);
+    layout.textureCoordinatesOffset = DXD::VertexLayout::absent; // tangents without texture coordinates
+    EXPECT_FALSE(VertexLayoutConverter::validateLayout(layout));
+
+    layout = createShuffledLayout();
+    layout.strideInBytes = 38;
+    EXPECT_FALSE(VertexLayoutConverter::validateLayout(layout));
+}
+
+TEST(VertexLayoutConverterTests, givenIndicesWhenValidatingThenAcceptOnlyCompleteTrianglesOfExistingVertices) {
+    const UINT indices[] = {0, 1, 2, 2, 1, 3};
+    EXPECT_TRUE(VertexLayoutConverter::validateIndices(indices, 6, 4));
+    EXPECT_FALSE(VertexLayoutConverter::validateIndices(indices, 6, 3));
+    EXPECT_FALSE(VertexLayoutConverter::validateIndices(indices, 5, 4));
+    EXPECT_FALSE(VertexLayoutConverter::validateIndices(nullptr, 0, 4));
+}
+
+TEST(VertexLayoutConverterTests, givenShuffledLayoutWhenConvertingThenAttributesArePacked) {
+    const FLOAT vertices[] = {
+        0.1f, 0.2f, -1.f, 0, 0, 1, 1, 2, 3,
+        0.3f, 0.4f, -1.f, 0, 1, 0, 4, 5, 6};
+    const DXD::VertexLayout layout = createShuffledLayout();
+    const DXD::VertexLayout packedLayout = VertexLayoutConverter::getPackedLayout(false, true);
+    EXPECT_FALSE(VertexLayoutConverter::isSameLayout(layout, packedLayout));
+
+    std::vector<FLOAT> packed{};
+    VertexLayoutConverter::convert(vertices, 2, layout, packedLayout, packed);
+    const std::vector<FLOAT> expected = {
+        1, 2, 3, 0, 0, 1, 0.1f, 0.2f,
+        4, 5, 6, 0, 1, 0, 0.3f, 0.4f};
+    EXPECT_EQ(expected, packed);
+}
+
+TEST(VertexLayoutConverterTests, givenPackedLayoutWhenConvertingThenVerticesAreUnchanged) {
+    const FLOAT vertices[] = {1, 2, 3, 0, 0, 1, 4, 5, 6, 0, 1, 0};
+    const DXD::VertexLayout layout = VertexLayoutConverter::getPackedLayout(false, false);
+    EXPECT_TRUE(VertexLayoutConverter::isSameLayout(layout, VertexLayoutConverter::getPackedLayout(false, false)));
+
+    std::vector<FLOAT> packed{};
+    VertexLayoutConverter::convert(vertices, 2, layout, layout, packed);
+    EXPECT_EQ(std::vector<FLOAT>(vertices, vertices + 12), packed);
+}
@@ -0,0 +1,123 @@
+#include "Geometry/VertexQuantizer.h"
+
+#include <cmath>
+#include <gtest/gtest.h>
+
+TEST(VertexQuantizerTests, givenValuesWhenEncodingHalfThenResultsMatchIeeeHalfPrecision) {
+    EXPECT_EQ(0x0000u, VertexQuantizer::encodeHalf(0.f));
+    EXPECT_EQ(0x8000u, VertexQuantizer::encodeHalf(-0.f));
+    EXPECT_EQ(0x3C00u, VertexQuantizer::encodeHalf(1.f));
+    EXPECT_EQ(0xC000u, VertexQuantizer::encodeHalf(-2.f));
+    EXPECT_EQ(0x3555u, VertexQuantizer::encodeHalf(1.f / 3.f));
+    EXPECT_EQ(0x7BFFu, VertexQuantizer::encodeHalf(65504.f));
+    EXPECT_EQ(0x7C00u, VertexQuantizer::encodeHalf(65520.f));     // rounds up to infinity
+    EXPECT_EQ(0x0001u, VertexQuantizer::encodeHalf(5.9604645e-8f)); // smallest subnormal
+    EXPECT_EQ(0x3C00u, VertexQuantizer::encodeHalf(1.00048828125f)); // halfway between 1 and next half, rounds to even
+    EXPECT_EQ(0x3C02u, VertexQuantizer::encodeHalf(1.00146484375f)); // halfway between odd and even, rounds to even
+    EXPECT_EQ(0x7E00u, VertexQuantizer::encodeHalf(std::nanf("")));
+}
+
+TEST(VertexQuantizerTests, givenAllHalfValuesWhenDecodingAndEncodingAgainThenTheyAreUnchanged) {
+    for (UINT32 value = 0u; value <= 0xFFFFu; value++) {
+        const bool isNan = (value & 0x7C00u) == 0x7C00u && (value & 0x3FFu) != 0u;
+        if (!isNan) {
+            EXPECT_EQ(value, VertexQuantizer::encodeHalf(VertexQuantizer::decodeHalf(static_cast<UINT16>(value))));
+        }
+    }
+}
+
+TEST(VertexQuantizerTests, givenNormalizedValuesWhenEncodingThenTheyAreClampedAndRounded) {
+    EXPECT_EQ(0u, VertexQuantizer::encodeUnorm16(-1.f));
+    EXPECT_EQ(65535u, VertexQuantizer::encodeUnorm16(2.f));
+    EXPECT_EQ(32768u, VertexQuantizer::encodeUnorm16(0.5f));
+    EXPECT_EQ(32767, VertexQuantizer::encodeSnorm16(1.f));
+    EXPECT_EQ(-32767, VertexQuantizer::encodeSnorm16(-3.f));
+    EXPECT_EQ(-1.f, VertexQuantizer::decodeSnorm16(-32768));
+}
+
+TEST(VertexQuantizerTests, givenUnitVectorsWhenEncodingOctahedralThenDecodedVectorsAreClose) {
+    const FLOAT directions[][3] = {
+        {0, 0, 1}, {0, 0, -1}, {1, 0, 0}, {0, -1, 0}, {1, 1, 1}, {-1, 2, -3}, {0.3f, -0.2f, -0.9f}, {-5, -5, 0.01f}};
+    for (const auto &direction : directions) {
+        const FLOAT length = std::sqrt(direction[0] * direction[0] + direction[1] * direction[1] + direction[2] * direction[2]);
+        const FLOAT expected[3] = {direction[0] / length, direction[1] / length, direction[2] / length};
+
+        INT16 encoded[2] = {};
+        FLOAT decoded[3] = {};
+        VertexQuantizer::encodeOctahedral(expected, encoded);
+        VertexQuantizer::decodeOctahedral(encoded, decoded);
+        EXPECT_NEAR(expected[0], decoded[0], 1e-4f);
+        EXPECT_NEAR(expected[1], decoded[1], 1e-4f);
+        EXPECT_NEAR(expected[2], decoded[2], 1e-4f);
+    }
+}
+
+TEST(VertexQuantizerTests, givenFloatVerticesWhenQuantizingThenEveryAttributeIsEncodedInPlace) {
+    const QuantizedVertexLayout layout{true, true};
+    const std::vector<FLOAT> vertexElements = {
+        -1, 2, 10, 0, 0, 1, 1, 0, 0, 0.25f, 0.75f,
+        3, 4, 10, 0, 1, 0, 0, 0, -1, 1.5f, -2.f};
+    const FLOAT boundsMin[3] = {-1, 2, 10};
+    const FLOAT boundsMax[3] = {3, 4, 10};
+
+    std::vector<UINT16> quantized{};
+    VertexQuantizer::quantizeVertices(vertexElements, layout, boundsMin, boundsMax, quantized);
+    ASSERT_EQ(2u * layout.getQuantizedVertexSizeInElements(), quantized.size());
+    EXPECT_EQ(20u, layout.getQuantizedVertexSizeInElements() * sizeof(UINT16));
+
+    const UINT16 expectedPositions[] = {0u, 0u, 0u, 0u, 65535u, 65535u, 0u, 0u};
+    for (auto vertex = 0u; vertex < 2u; vertex++) {
+        const UINT16 *quantizedVertex = quantized.data() + vertex * layout.getQuantizedVertexSizeInElements();
+        const FLOAT *floatVertex = vertexElements.data() + vertex * layout.getFloatVertexSizeInFloats();
+        for (auto component = 0u; component < 4u; component++) {
+            EXPECT_EQ(expectedPositions[4 * vertex + component], quantizedVertex[component]);
+        }
+
+        for (auto attribute = 0u; attribute < 2u; attribute++) {
+            FLOAT decoded[3] = {};
+            VertexQuantizer::decodeOctahedral(reinterpret_cast<const INT16 *>(quantizedVertex + 4 + 2 * attribute), decoded);
+            for (auto component = 0u; component < 3u; component++) {
+                EXPECT_NEAR(floatVertex[3 + 3 * attribute + component], decoded[component], 1e-4f);
+            }
+        }
+
+        EXPECT_EQ(floatVertex[9], VertexQuantizer::decodeHalf(quantizedVertex[8]));
+        EXPECT_EQ(floatVertex[10], VertexQuantizer::decodeHalf(quantizedVertex[9]));
+    }
+}
+
+TEST(VertexQuantizerTests, givenFloatOrQuantizedVerticesWhenExtractingPositionsThenTheyAreTheSame) {
+    const QuantizedVertexLayout layout{false, true};
+    const std::vector<FLOAT> vertexElements = {
+        -1, 2, 10, 0, 0, 1, 0.25f, 0.75f,
+        3, 4, 10, 0, 1, 0, 1.5f, -2.f,
+        1, 3, 10, 1, 0, 0, 0.f, 0.f};
+    const FLOAT boundsMin[3] = {-1, 2, 10};
+    const FLOAT boundsMax[3] = {3, 4, 10};
+    std::vector<UINT16> quantized{};
+    VertexQuantizer::quantizeVertices(vertexElements, layout, boundsMin, boundsMax, quantized);
+
+    std::vector<UINT16> positionsFromFloats{};
+    std::vector<UINT16> positionsFromQuantized{};
+    VertexQuantizer::extractQuantizedPositions(vertexElements.data(), 3u, layout.getFloatVertexSizeInFloats() * sizeof(FLOAT), false,
+                                               boundsMin, boundsMax, positionsFromFloats);
+    VertexQuantizer::extractQuantizedPositions(quantized.data(), 3u, layout.getQuantizedVertexSizeInElements() * sizeof(UINT16), true,
+                                               boundsMin, boundsMax, positionsFromQuantized);
+
+    const std::vector<UINT16> expectedPositions = {0u, 0u, 0u, 0u, 65535u, 65535u, 0u, 0u, 32768u, 32768u, 0u, 0u};
+    EXPECT_EQ(expectedPositions, positionsFromFloats);
+    EXPECT_EQ(expectedPositions, positionsFromQuantized);
+}
+
+TEST(VertexQuantizerTests, givenFloatVerticesWhenExtractingPositionsThenFullPrecisionPositionsArePacked) {
+    const QuantizedVertexLayout layout{false, true};
+    const std::vector<FLOAT> vertexElements = {
+        -1.123456f, 2, 10, 0, 0, 1, 0.25f, 0.75f,
+        3, 4.000001f, 10, 0, 1, 0, 1.5f, -2.f};
+
+    std::vector<FLOAT> positions = {7.f};
+    VertexQuantizer::extractPositions(vertexElements.data(), 2u, layout.getFloatVertexSizeInFloats() * sizeof(FLOAT), positions);
+
+    const std::vector<FLOAT> expectedPositions = {-1.123456f, 2, 10, 3, 4.000001f, 10};
+    EXPECT_EQ(expectedPositions, positions);
+}
@@ -0,0 +1,88 @@
+#include "Resource/CookedTexture.h"
+
+#include <cstring>
+#include <gtest/gtest.h>
+
+namespace {
+struct CookedTextureTests : ::testing::Test {
+    void SetUp() override {
+        ASSERT_TRUE(SUCCEEDED(image.Initialize2D(DXGI_FORMAT_R8G8B8A8_UNORM, 8, 4, 1, 3)));
+        for (auto byteIndex = 0u; byteIndex < image.GetPixelsSize(); byteIndex++) {
+            image.GetPixels()[byteIndex] = static_cast<uint8_t>(byteIndex);
+        }
+    }
+
+    void TearDown() override {
+        DeleteFileW(path.c_str());
+    }
+
+    const std::wstring path = L"CookedTextureTests.dxdtex";
+    const CookedMeshSource source = {1234, 5678, static_cast<UINT>(DXD::Texture::TextureType::ALBEDO)};
+    DirectX::ScratchImage image = {};
+};
+} // namespace
+
+TEST_F(CookedTextureTests, givenWrittenCookedTextureWhenOpeningWithTheSameSourceThenAllMipsAreMappedUnchanged) {
+    ASSERT_TRUE(CookedTexture::write(path, source, image));
+
+    const CookedTexture cookedTexture{path, source};
+    ASSERT_TRUE(cookedTexture.isValid());
+    EXPECT_EQ(DXGI_FORMAT_R8G8B8A8_UNORM, cookedTexture.getHeader().format);
+    EXPECT_EQ(8u, cookedTexture.getHeader().width);
+    EXPECT_EQ(4u, cookedTexture.getHeader().height);
+    EXPECT_EQ(3u, cookedTexture.getHeader().mipLevels);
+
+    std::vector<D3D12_SUBRESOURCE_DATA> subresources{};
+    cookedTexture.getSubresources(subresources);
+    ASSERT_EQ(3u, subresources.size());
+    for (auto mip = 0u; mip < 3u; mip++) {
+        const DirectX::Image &mipImage = *image.GetImage(mip, 0, 0);
+        EXPECT_EQ(static_cast<LONG_PTR>(mipImage.rowPitch), subresources[mip].RowPitch);
+        EXPECT_EQ(static_cast<LONG_PTR>(mipImage.slicePitch), subresources[mip].SlicePitch);
+        EXPECT_EQ(0, memcmp(mipImage.pixels, subresources[mip].pData, mipImage.slicePitch));
+    }
+}
+
+TEST_F(CookedTextureTests, givenWrittenCookedTextureWhenSourceHasChangedThenItIsInvalid) {
+    ASSERT_TRUE(CookedTexture::write(path, source, image));
+
+    CookedMeshSource otherSource = source;
+    otherSource.lastWriteTime++;
+    EXPECT_FALSE(CookedTexture(path, otherSource).isValid());
+
+    otherSource = source;
+    otherSource.loadFlags = static_cast<UINT>(DXD::Texture::TextureType::NORMAL_MAP);
+    EXPECT_FALSE(CookedTexture(path, otherSource).isValid());
+}
+
+TEST_F(CookedTextureTests, givenImageWithDimensionsDivisibleBy4WhenCookingThenMipsAreGeneratedAndCompressed) {
+    DirectX::ScratchImage sourceImage{};
+    ASSERT_TRUE(SUCCEEDED(sourceImage.InitializeFromImage(*image.GetImage(0, 0, 0))));
+
+    DirectX::ScratchImage albedo{};
+    ASSERT_TRUE(SUCCEEDED(CookedTexture::cook(sourceImage, DXD::Texture::TextureType::ALBEDO, albedo)));
+    EXPECT_EQ(DXGI_FORMAT_BC7_UNORM, albedo.GetMetadata().format);
+    EXPECT_EQ(3u, albedo.GetMetadata().mipLevels);
+
+    ASSERT_TRUE(sourceImage.OverrideFormat(DXGI_FORMAT_R8G8B8A8_UNORM_SRGB));
+    ASSERT_TRUE(SUCCEEDED(CookedTexture::cook(sourceImage, DXD::Texture::TextureType::ALBEDO, albedo)));
+    EXPECT_EQ(DXGI_FORMAT_BC7_UNORM_SRGB, albedo.GetMetadata().format);
+
+    DirectX::ScratchImage normalMap{};
+    ASSERT_TRUE(SUCCEEDED(CookedTexture::cook(sourceImage, DXD::Texture::TextureType::NORMAL_MAP, normalMap)));
+    EXPECT_EQ(DXGI_FORMAT_BC7_UNORM, normalMap.GetMetadata().format);
+}
+
+TEST_F(CookedTextureTests, givenImageWithDimensionsNotDivisibleBy4WhenCookingThenMipsAreGeneratedWithoutCompression) {
+    DirectX::ScratchImage sourceImage{};
+    ASSERT_TRUE(SUCCEEDED(sourceImage.Initialize2D(DXGI_FORMAT_R8G8B8A8_UNORM, 6, 3, 1, 1)));
+
+    DirectX::ScratchImage cookedImage{};
+    ASSERT_TRUE(SUCCEEDED(CookedTexture::cook(sourceImage, DXD::Texture::TextureType::ALBEDO, cookedImage)));
+    EXPECT_EQ(DXGI_FORMAT_R8G8B8A8_UNORM, cookedImage.GetMetadata().format);
+    EXPECT_EQ(2u, cookedImage.GetMetadata().mipLevels);
+}
+
+TEST_F(CookedTextureTests, givenMissingFileWhenOpeningCookedTextureThenItIsInvalid) {
+    EXPECT_FALSE(CookedTexture(L"NonExistingCookedTexture.dxdtex", source).isValid());
+}
@@ -0,0 +1,24 @@
+#include "Resource/VertexOrIndexBuffer.h"
+
+#include <gtest/gtest.h>
+
+TEST(IndexBufferTests, givenVerticesCountWhenSelectingFormatThenUse16BitIndicesIfTheyAreEnough) {
+    EXPECT_EQ(DXGI_FORMAT_R16_UINT, IndexBuffer::selectFormat(3u));
+    EXPECT_EQ(DXGI_FORMAT_R16_UINT, IndexBuffer::selectFormat(0xFFFFu));
+    EXPECT_EQ(DXGI_FORMAT_R32_UINT, IndexBuffer::selectFormat(0x10000u));
+    EXPECT_EQ(DXGI_FORMAT_R32_UINT, IndexBuffer::selectFormat(1000000u));
+}
+
+TEST(IndexBufferTests, givenFormatWhenGettingIndexSizeThenReturnCorrectSize) {
+    EXPECT_EQ(2u, IndexBuffer::getIndexSize(DXGI_FORMAT_R16_UINT));
+    EXPECT_EQ(4u, IndexBuffer::getIndexSize(DXGI_FORMAT_R32_UINT));
+}
+
+TEST(IndexBufferTests, givenIndicesWhenNarrowingThemThenValuesArePreserved) {
+    const UINT indices[] = {0u, 1u, 2u, 0xFFFEu, 300u, 2u};
+    const std::vector<UINT16> narrowed = IndexBuffer::narrowIndices(indices, 6u);
+    ASSERT_EQ(6u, narrowed.size());
+    for (auto i = 0u; i < 6u; i++) {
+        EXPECT_EQ(indices[i], narrowed[i]);
+    }
+}
@@ -0,0 +1,325 @@
+#include "Threading/BackgroundWorkerController.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+TEST(BackgroundWorkerControllerTests, givenTasksPushedFromExternalThreadWhenWaitingThenAllOfThemAreExecuted) {
+    BackgroundWorkerController controller{4};
+    constexpr int tasksCount = 10000;
+    std::atomic<int> executedCount{0};
+    std::atomic_bool lastTaskCompleted{false};
+    for (int i = 0; i < tasksCount - 1; i++) {
+        controller.pushTask([&executedCount]() { executedCount++; });
+    }
+    controller.pushTask([&executedCount]() { executedCount++; }, lastTaskCompleted);
+
+    while (executedCount.load() != tasksCount) {
+        std::this_thread::yield();
+    }
+    EXPECT_EQ(tasksCount, executedCount.load());
+    EXPECT_TRUE(lastTaskCompleted.load());
+}
+
+TEST(BackgroundWorkerControllerTests, givenSingleWorkerWhenPushingTasksFromExternalThreadThenAllOfThemAreExecuted) {
+    BackgroundWorkerController controller{1};
+    std::atomic<int> executedCount{0};
+    for (int i = 0; i < 100; i++) {
+        controller.pushTask([&executedCount]() { executedCount++; });
+    }
+
+    while (executedCount.load() != 100) {
+        std::this_thread::yield();
+    }
+    EXPECT_EQ(100, executedCount.load());
+}
+
+TEST(BackgroundWorkerControllerTests, givenTasksPushedFromWorkersWhenWaitingThenAllOfThemAreExecuted) {
+    BackgroundWorkerController controller{4};
+    constexpr int childrenCount = 1000;
+    std::atomic<int> executedCount{0};
+    controller.pushTask([&]() {
+        for (int i = 0; i < childrenCount; i++) {
+            controller.pushTask([&executedCount]() { executedCount++; });
+        }
+    });
+
+    while (executedCount.load() != childrenCount) {
+        std::this_thread::yield();
+    }
+    EXPECT_EQ(childrenCount, executedCount.load());
+}
+
+TEST(BackgroundWorkerControllerTests, givenBlockedWorkerWhenItHasQueuedTasksThenOtherWorkersStealThem) {
+    BackgroundWorkerController controller{2};
+    std::mutex blockLock{};
+    std::unique_lock<std::mutex> block{blockLock};
+    std::atomic<int> executedCount{0};
+    controller.pushTask([&]() {
+        // Children land in the deque of this worker, which is blocked until they're done by the other one
+        for (int i = 0; i < 100; i++) {
+            controller.pushTask([&executedCount]() { executedCount++; });
+        }
+        std::lock_guard<std::mutex> wait{blockLock};
+    });
+
+    while (executedCount.load() != 100) {
+        std::this_thread::yield();
+    }
+    block.unlock();
+    EXPECT_EQ(100, executedCount.load());
+}
+
+TEST(BackgroundWorkerControllerTests, givenNestedParallelExecutionWhenCalledFromWorkersThenAllSubtasksAreExecuted) {
+    BackgroundWorkerController controller{3};
+    std::vector<std::atomic<int>> executedCounts(64);
+    controller.executeInParallel(8u, [&](UINT outerIndex) {
+        controller.executeInParallel(8u, [&](UINT innerIndex) {
+            executedCounts[outerIndex * 8 + innerIndex]++;
+        });
+    });
+
+    for (const std::atomic<int> &count : executedCounts) {
+        EXPECT_EQ(1, count.load());
+    }
+}
+
+TEST(BackgroundWorkerControllerTests, givenQueuedTasksOfDifferentPrioritiesWhenWorkerIsFreeThenHigherPrioritiesAreExecutedFirst) {
+    BackgroundWorkerController controller{1};
+    std::mutex blockLock{};
+    std::unique_lock<std::mutex> block{blockLock};
+    std::atomic_bool blockerStarted{false};
+    controller.pushTask([&]() {
+        blockerStarted = true;
+        std::lock_guard<std::mutex> wait{blockLock};
+    });
+    while (!blockerStarted.load()) {
+        std::this_thread::yield();
+    }
+
+    std::vector<TaskPriority> executionOrder{};
+    std::atomic<int> executedCount{0};
+    const TaskPriority pushOrder[] = {TaskPriority::BACKGROUND, TaskPriority::NORMAL, TaskPriority::CRITICAL,
+                                      TaskPriority::BACKGROUND, TaskPriority::CRITICAL, TaskPriority::NORMAL};
+    for (TaskPriority priority : pushOrder) {
+        auto task = [&executionOrder, &executedCount, priority]() {
+            executionOrder.push_back(priority);
+            executedCount++;
+        };
+        controller.pushTask(std::move(task), priority);
+    }
+    block.unlock();
+
+    while (executedCount.load() != 6) {
+        std::this_thread::yield();
+    }
+    const std::vector<TaskPriority> expectedOrder{TaskPriority::CRITICAL, TaskPriority::CRITICAL, TaskPriority::NORMAL,
+                                                  TaskPriority::NORMAL, TaskPriority::BACKGROUND, TaskPriority::BACKGROUND};
+    EXPECT_EQ(expectedOrder, executionOrder);
+}
+
+TEST(BackgroundWorkerControllerTests, givenCancelledTaskWhenDequeuedThenItIsNotExecutedButCompletionIsSignalled) {
+    BackgroundWorkerController controller{1};
+    std::mutex blockLock{};
+    std::unique_lock<std::mutex> block{blockLock};
+    controller.pushTask([&]() {
+        std::lock_guard<std::mutex> wait{blockLock};
+    });
+
+    std::atomic_bool executed{false};
+    std::atomic_bool completed{false};
+    CancellationToken token = CancellationToken::create();
+    controller.pushTask(BackgroundWorker::TaskData{[&executed]() { executed = true; }, nullptr, &completed, TaskPriority::NORMAL, token});
+    EXPECT_TRUE(token.cancel());
+    block.unlock();
+
+    while (!completed.load()) {
+        std::this_thread::yield();
+    }
+    EXPECT_FALSE(executed.load());
+}
+
+TEST(BackgroundWorkerControllerTests, givenParallelExecutionInsideTaskThenSubtasksInheritItsPriority) {
+    BackgroundWorkerController controller{2};
+    std::atomic<int> wrongPrioritiesCount{0};
+    std::atomic_bool completed{false};
+    auto task = [&]() {
+        controller.executeInParallel(16u, [&](UINT) {
+            // Calling thread is a worker too, so every subtask is executed by a worker
+            if (BackgroundWorker::getCurrentTaskPriority() != TaskPriority::CRITICAL) {
+                wrongPrioritiesCount++;
+            }
+        });
+    };
+    controller.pushTask(BackgroundWorker::TaskData{std::move(task), nullptr, &completed, TaskPriority::CRITICAL});
+
+    while (!completed.load()) {
+        std::this_thread::yield();
+    }
+    EXPECT_EQ(0, wrongPrioritiesCount.load());
+}
+
+TEST(BackgroundWorkerControllerTests, givenExplicitPriorityWhenExecutingParallelForThenHelpersHaveThatPriority) {
+    BackgroundWorkerController controller{2};
+    const std::thread::id callingThreadId = std::this_thread::get_id();
+    std::atomic<int> wrongPrioritiesCount{0};
+    controller.parallelFor(0u, 1000u, 1u, TaskPriority::CRITICAL, [&](size_t, size_t) {
+        // Calling thread is not a worker, it has no task priority
+        if (std::this_thread::get_id() != callingThreadId && BackgroundWorker::getCurrentTaskPriority() != TaskPriority::CRITICAL) {
+            wrongPrioritiesCount++;
+        }
+    });
+    EXPECT_EQ(0, wrongPrioritiesCount.load());
+}
+
+TEST(BackgroundWorkerControllerTests, givenPendingTasksWhenDestroyingControllerThenItDoesNotHang) {
+    std::atomic<int> executedCount{0};
+    {
+        BackgroundWorkerController controller{2};
+        for (int i = 0; i < 1000; i++) {
+            controller.pushTask([&executedCount]() { executedCount++; });
+        }
+    }
+    EXPECT_LE(executedCount.load(), 1000);
+}
+
+TEST(BackgroundWorkerControllerTests, givenRangeWhenExecutingParallelForThenEveryElementIsProcessedOnce) {
+    BackgroundWorkerController controller{4};
+    for (size_t elementsCount : {0u, 1u, 7u, 1000u, 100000u}) {
+        for (size_t grainSize : {0u, 1u, 64u, 5000u}) {
+            std::vector<std::atomic<int>> visitsCounts(elementsCount + 10);
+            for (auto &visitsCount : visitsCounts) {
+                visitsCount.store(0);
+            }
+            controller.parallelFor(10u, elementsCount + 10, grainSize, [&](size_t begin, size_t end) {
+                for (size_t index = begin; index < end; index++) {
+                    visitsCounts[index]++;
+                }
+            });
+            for (size_t index = 0u; index < visitsCounts.size(); index++) {
+                EXPECT_EQ(index < 10u ? 0 : 1, visitsCounts[index].load());
+            }
+        }
+    }
+}
+
+TEST(BackgroundWorkerControllerTests, givenGrainSizeWhenExecutingParallelForThenOnlyLastSubrangeIsShorter) {
+    BackgroundWorkerController controller{4};
+    constexpr size_t elementsCount = 10007u;
+    constexpr size_t grainSize = 100u;
+    std::mutex subrangesLock{};
+    std::vector<std::pair<size_t, size_t>> subranges{};
+    controller.parallelFor(0u, elementsCount, grainSize, [&](size_t begin, size_t end) {
+        std::lock_guard<std::mutex> lock{subrangesLock};
+        subranges.emplace_back(begin, end);
+    });
+
+    std::sort(subranges.begin(), subranges.end());
+    size_t expectedBegin = 0u;
+    for (size_t subrangeIndex = 0u; subrangeIndex < subranges.size(); subrangeIndex++) {
+        EXPECT_EQ(expectedBegin, subranges[subrangeIndex].first);
+        if (subrangeIndex + 1 < subranges.size()) {
+            EXPECT_GE(subranges[subrangeIndex].second - subranges[subrangeIndex].first, grainSize);
+        }
+        expectedBegin = subranges[subrangeIndex].second;
+    }
+    EXPECT_EQ(elementsCount, expectedBegin);
+}
+
+TEST(BackgroundWorkerControllerTests, givenRangeWhenExecutingParallelReduceThenResultIsTheSameAsSequential) {
+    BackgroundWorkerController controller{4};
+    constexpr size_t elementsCount = 100000u;
+    std::vector<uint64_t> values(elementsCount);
+    for (size_t index = 0u; index < elementsCount; index++) {
+        values[index] = index * index % 1009;
+    }
+    uint64_t expectedSum = 0u;
+    uint64_t expectedMax = 0u;
+    for (uint64_t value : values) {
+        expectedSum += value;
+        expectedMax = std::max(expectedMax, value);
+    }
+
+    for (int repetition = 0; repetition < 20; repetition++) {
+        const uint64_t sum = controller.parallelReduce<uint64_t>(
+            0u, elementsCount, 256u, 0u,
+            [&](size_t begin, size_t end, uint64_t accumulator) {
+                for (size_t index = begin; index < end; index++) {
+                    accumulator += values[index];
+                }
+                return accumulator;
+            },
+            [](uint64_t left, uint64_t right) { return left + right; });
+        const uint64_t max = controller.parallelReduce<uint64_t>(
+            0u, elementsCount, 256u, 0u,
+            [&](size_t begin, size_t end, uint64_t accumulator) { return std::max(accumulator, *std::max_element(values.begin() + begin, values.begin() + end)); },
+            [](uint64_t left, uint64_t right) { return std::max(left, right); });
+        EXPECT_EQ(expectedSum, sum);
+        EXPECT_EQ(expectedMax, max);
+    }
+}
+
+TEST(BackgroundWorkerControllerTests, givenEmptyRangeWhenExecutingParallelReduceThenIdentityIsReturned) {
+    BackgroundWorkerController controller{2};
+    const int result = controller.parallelReduce<int>(
+        5u, 5u, 1u, 42, [](size_t, size_t, int accumulator) { return accumulator + 1; }, [](int left, int right) { return left + right - 42; });
+    EXPECT_EQ(42, result);
+}
+
+TEST(BackgroundWorkerControllerTests, givenNestedParallelForInsideWorkerWhenOnlyOneWorkerThenItDoesNotDeadlock) {
+    BackgroundWorkerController controller{1};
+    std::atomic<int> processedCount{0};
+    std::atomic_bool completed{false};
+    controller.pushTask([&]() {
+        controller.parallelFor(0u, 100u, 1u, [&](size_t outerBegin, size_t outerEnd) {
+            for (size_t outerIndex = outerBegin; outerIndex < outerEnd; outerIndex++) {
+                controller.parallelFor(0u, 100u, 10u, [&](size_t begin, size_t end) { processedCount += static_cast<int>(end - begin); });
+            }
+        });
+    }, completed);
+
+    while (!completed.load()) {
+        std::this_thread::yield();
+    }
+    EXPECT_EQ(10000, processedCount.load());
+}
+
+TEST(BackgroundWorkerControllerTests, givenControllerStoppedWithQueuedTasksWhenStoppedAgainAndDestroyedThenItDoesNotHang) {
+    std::atomic<int> executedCount{0};
+    {
+        BackgroundWorkerController controller{2};
+        for (int i = 0; i < 1000; i++) {
+            controller.pushTask([&executedCount]() { executedCount++; });
+        }
+        controller.stop();
+        const int executedCountAfterStop = executedCount.load();
+        controller.stop();
+        EXPECT_EQ(executedCountAfterStop, executedCount.load());
+    }
+    EXPECT_LE(executedCount.load(), 1000);
+}
+
+TEST(BackgroundWorkerControllerTests, givenExecutedTasksWhenTheirDataIsReusedThenCapturedStateIsReleased) {
+    BackgroundWorkerController controller{2};
+    auto state = std::make_shared<int>(0);
+    std::weak_ptr<int> weakState = state;
+    std::atomic<int> executedCount{0};
+    std::atomic_bool outerTaskCompleted{false};
+    controller.pushTask([&, state]() {
+        // Pushed from a worker, so the data of the tasks is recycled through the free lists of the workers
+        for (int i = 0; i < 1000; i++) {
+            controller.pushTask([state, &executedCount]() { executedCount++; });
+        }
+    }, outerTaskCompleted);
+    state.reset();
+
+    while (!outerTaskCompleted.load() || executedCount.load() < 1000 || !weakState.expired()) {
+        std::this_thread::yield();
+    }
+    EXPECT_EQ(1000, executedCount.load());
+}
@@ -0,0 +1,33 @@
+#include "Threading/CancellationToken.h"
+
+#include <gtest/gtest.h>
+
+TEST(CancellationTokenTests, givenDefaultTokenThenItCannotBeCancelled) {
+    CancellationToken token{};
+    EXPECT_FALSE(token.cancel());
+    EXPECT_FALSE(token.isCancellationRequested());
+    EXPECT_TRUE(token.tryStart());
+}
+
+TEST(CancellationTokenTests, givenNotStartedTaskWhenCancellingThenItNeverStarts) {
+    CancellationToken token = CancellationToken::create();
+    CancellationToken copy = token;
+    EXPECT_TRUE(token.cancel());
+    EXPECT_TRUE(copy.isCancellationRequested());
+    EXPECT_FALSE(copy.tryStart());
+    EXPECT_TRUE(token.cancel());
+}
+
+TEST(CancellationTokenTests, givenStartedTaskWhenCancellingThenCancellationIsOnlyRequested) {
+    CancellationToken token = CancellationToken::create();
+    EXPECT_TRUE(token.tryStart());
+    EXPECT_FALSE(token.isCancellationRequested());
+    EXPECT_FALSE(token.cancel());
+    EXPECT_TRUE(token.isCancellationRequested());
+}
+
+TEST(CancellationTokenTests, givenTaskQueuedTwiceWhenStartingThenOnlyFirstCopyStarts) {
+    CancellationToken token = CancellationToken::create();
+    EXPECT_TRUE(token.tryStart());
+    EXPECT_FALSE(token.tryStart());
+}
@@ -0,0 +1,158 @@
+#include "Threading/LockFreeBlockingQueue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+TEST(LockFreeBlockingQueueTests, givenPushedElementsWhenPoppingThenTheyAreReturnedInFifoOrder) {
+    LockFreeBlockingQueue<int> queue{4};
+    EXPECT_TRUE(queue.empty());
+
+    // Push more elements than the capacity in total, so cells are reused in the next laps
+    int value{};
+    for (int lap = 0; lap < 3; lap++) {
+        for (int i = 0; i < 3; i++) {
+            queue.push(lap * 10 + i);
+        }
+        EXPECT_FALSE(queue.empty());
+        for (int i = 0; i < 3; i++) {
+            ASSERT_TRUE(queue.blockingPop(value));
+            EXPECT_EQ(lap * 10 + i, value);
+        }
+        EXPECT_TRUE(queue.empty());
+    }
+}
+
+TEST(LockFreeBlockingQueueTests, givenFullQueueWhenTryingToPushThenItFailsAndValueIsNotConsumed) {
+    LockFreeBlockingQueue<std::unique_ptr<int>> queue{2};
+    auto value = std::make_unique<int>(1);
+    ASSERT_TRUE(queue.tryPush(value));
+    value = std::make_unique<int>(2);
+    ASSERT_TRUE(queue.tryPush(value));
+
+    value = std::make_unique<int>(3);
+    EXPECT_FALSE(queue.tryPush(value));
+    ASSERT_NE(nullptr, value);
+    EXPECT_EQ(3, *value);
+
+    std::unique_ptr<int> result{};
+    ASSERT_TRUE(queue.tryPop(result));
+    EXPECT_EQ(1, *result);
+    EXPECT_TRUE(queue.tryPush(value));
+}
+
+TEST(LockFreeBlockingQueueTests, givenEmptyQueueWhenTryingToPopThenItFails) {
+    LockFreeBlockingQueue<int> queue{2};
+    int value = 5;
+    EXPECT_FALSE(queue.tryPop(value));
+    EXPECT_EQ(5, value);
+}
+
+TEST(LockFreeBlockingQueueTests, givenQueueWithElementsWhenDestroyedThenElementsAreReleased) {
+    auto counter = std::make_shared<int>(0);
+    {
+        LockFreeBlockingQueue<std::shared_ptr<int>> queue{4};
+        queue.push(counter);
+        queue.push(counter);
+        EXPECT_EQ(3, counter.use_count());
+    }
+    EXPECT_EQ(1, counter.use_count());
+}
+
+TEST(LockFreeBlockingQueueTests, givenBlockedConsumerWhenNotifyingAllThenPopReturnsFalse) {
+    LockFreeBlockingQueue<int> queue{2};
+    std::atomic_bool popResult{true};
+    std::thread consumer{[&]() {
+        int value{};
+        popResult = queue.blockingPop(value);
+    }};
+
+    while (popResult.load()) {
+        queue.notifyAll();
+        std::this_thread::yield();
+    }
+    consumer.join();
+    EXPECT_FALSE(popResult.load());
+}
+
+TEST(LockFreeBlockingQueueTests, givenBlockedConsumerWhenPushingThenConsumerReceivesElement) {
+    LockFreeBlockingQueue<int> queue{2};
+    int value{};
+    bool popResult{};
+    std::thread consumer{[&]() {
+        popResult = queue.blockingPop(value);
+    }};
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    queue.push(7);
+    consumer.join();
+    EXPECT_TRUE(popResult);
+    EXPECT_EQ(7, value);
+}
+
+TEST(LockFreeBlockingQueueTests, givenFullQueueWhenPushingThenProducerWaitsForConsumer) {
+    LockFreeBlockingQueue<int> queue{2};
+    queue.push(0);
+    queue.push(1);
+    std::atomic_bool pushed{false};
+    std::thread producer{[&]() {
+        queue.push(2);
+        pushed = true;
+    }};
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_FALSE(pushed.load());
+    int value{};
+    for (int i = 0; i < 3; i++) {
+        ASSERT_TRUE(queue.blockingPop(value));
+        EXPECT_EQ(i, value);
+    }
+    producer.join();
+    EXPECT_TRUE(pushed.load());
+}
+
+TEST(LockFreeBlockingQueueTests, givenManyProducersAndConsumersThenEveryElementIsReceivedExactlyOnceInProducerOrder) {
+    constexpr int threadsCount = 4;
+    constexpr int elementsPerProducer = 50000;
+    LockFreeBlockingQueue<int> queue{64};
+    std::vector<std::atomic<int>> receivedCounts(threadsCount * elementsPerProducer);
+    std::atomic<int> outOfOrderCount{0};
+
+    std::vector<std::thread> threads{};
+    for (int producerIndex = 0; producerIndex < threadsCount; producerIndex++) {
+        threads.emplace_back([&, producerIndex]() {
+            for (int i = 0; i < elementsPerProducer; i++) {
+                queue.push(producerIndex * elementsPerProducer + i);
+            }
+        });
+    }
+    for (int consumerIndex = 0; consumerIndex < threadsCount; consumerIndex++) {
+        threads.emplace_back([&]() {
+            // Each consumer has to see elements of a single producer in the order they were pushed
+            std::vector<int> lastValues(threadsCount, -1);
+            int value{};
+            for (int i = 0; i < elementsPerProducer; i++) {
+                if (!queue.blockingPop(value)) {
+                    i--;
+                    continue;
+                }
+                receivedCounts[value]++;
+                int &lastValue = lastValues[value / elementsPerProducer];
+                if (value <= lastValue) {
+                    outOfOrderCount++;
+                }
+                lastValue = value;
+            }
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_TRUE(queue.empty());
+    EXPECT_EQ(0, outOfOrderCount.load());
+    EXPECT_TRUE(std::all_of(receivedCounts.begin(), receivedCounts.end(), [](const std::atomic<int> &count) { return count.load() == 1; }));
+}
@@ -0,0 +1,210 @@
+#include "Threading/BackgroundWorkerController.h"
+#include "Threading/TaskGraph.h"
+
+#include <algorithm>
+#include <atomic>
+#include <gtest/gtest.h>
+#include <utility>
+#include <vector>
+
+namespace {
+// Records a global sequence number for every executed node, so ordering constraints can be checked afterwards
+struct ExecutionRecorder {
+    explicit ExecutionRecorder(size_t nodesCount) : sequenceNumbers(nodesCount) {
+        for (auto &sequenceNumber : sequenceNumbers) {
+            sequenceNumber.store(0u);
+        }
+    }
+
+    Task record(size_t node) {
+        return [this, node]() { sequenceNumbers[node].store(++lastSequenceNumber); };
+    }
+
+    UINT get(size_t node) const { return sequenceNumbers[node].load(); }
+
+    std::vector<std::atomic<UINT>> sequenceNumbers;
+    std::atomic<UINT> lastSequenceNumber{0u};
+};
+
+void expectDependenciesRespected(const ExecutionRecorder &recorder, const std::vector<std::pair<UINT, UINT>> &dependencies) {
+    for (const auto &dependency : dependencies) {
+        EXPECT_NE(0u, recorder.get(dependency.first));
+        EXPECT_LT(recorder.get(dependency.first), recorder.get(dependency.second));
+    }
+}
+} // namespace
+
+TEST(TaskGraphTests, givenEmptyGraphWhenWaitingThenReturnsImmediately) {
+    BackgroundWorkerController controller{2};
+    TaskGraph graph{controller};
+    graph.runAndWait();
+    EXPECT_TRUE(graph.isComplete());
+}
+
+TEST(TaskGraphTests, givenDependenciesWhenAddedThenPredecessorsAreCounted) {
+    BackgroundWorkerController controller{1};
+    TaskGraph graph{controller};
+    const auto a = graph.addNode([]() {});
+    const auto b = graph.addNode([]() {});
+    const auto c = graph.addNode([]() {});
+    graph.addDependency(a, c);
+    graph.addDependency(b, c);
+    EXPECT_EQ(3u, graph.getNodesCount());
+    EXPECT_EQ(0u, graph.getPredecessorsCount(a));
+    EXPECT_EQ(2u, graph.getPredecessorsCount(c));
+    EXPECT_TRUE(graph.isComplete());
+}
+
+TEST(TaskGraphTests, givenChainWhenRunThenNodesAreExecutedInOrder) {
+    BackgroundWorkerController controller{4};
+    constexpr UINT nodesCount = 100;
+    std::vector<UINT> order{};
+    TaskGraph graph{controller};
+    for (auto i = 0u; i < nodesCount; i++) {
+        graph.addNode([&order, i]() { order.push_back(i); });
+        if (i > 0) {
+            graph.addDependency(i - 1, i);
+        }
+    }
+    graph.runAndWait();
+
+    ASSERT_EQ(nodesCount, order.size());
+    for (auto i = 0u; i < nodesCount; i++) {
+        EXPECT_EQ(i, order[i]);
+    }
+}
+
+TEST(TaskGraphTests, givenDiamondWhenRunRepeatedlyThenOrderingConstraintsAreAlwaysRespected) {
+    BackgroundWorkerController controller{4};
+    for (int repetition = 0; repetition < 200; repetition++) {
+        ExecutionRecorder recorder{4};
+        TaskGraph graph{controller};
+        for (auto node = 0u; node < 4u; node++) {
+            graph.addNode(recorder.record(node));
+        }
+        const std::vector<std::pair<UINT, UINT>> dependencies = {{0, 1}, {0, 2}, {1, 3}, {2, 3}};
+        for (const auto &dependency : dependencies) {
+            graph.addDependency(dependency.first, dependency.second);
+        }
+        graph.runAndWait();
+
+        expectDependenciesRespected(recorder, dependencies);
+        EXPECT_EQ(1u, recorder.get(0));
+        EXPECT_EQ(4u, recorder.get(3));
+    }
+}
+
+TEST(TaskGraphTests, givenLayeredGraphWhenRunRepeatedlyThenResultIsDeterministic) {
+    // Every node sums values of its predecessors, any ordering violation would change the result
+    BackgroundWorkerController controller{4};
+    constexpr UINT layersCount = 6;
+    constexpr UINT layerSize = 8;
+    constexpr UINT nodesCount = layersCount * layerSize;
+
+    uint64_t expectedResult = 0u;
+    for (int repetition = 0; repetition < 50; repetition++) {
+        std::vector<uint64_t> values(nodesCount, 0u);
+        std::vector<std::vector<UINT>> predecessors(nodesCount);
+        TaskGraph graph{controller};
+        for (auto node = 0u; node < nodesCount; node++) {
+            graph.addNode([&values, &predecessors, node]() {
+                uint64_t value = node + 1;
+                for (UINT predecessor : predecessors[node]) {
+                    value += values[predecessor] * (predecessor + 3);
+                }
+                values[node] = value;
+            });
+        }
+        for (auto layer = 1u; layer < layersCount; layer++) {
+            for (auto i = 0u; i < layerSize; i++) {
+                const UINT node = layer * layerSize + i;
+                for (UINT predecessor : {(layer - 1) * layerSize + i, (layer - 1) * layerSize + (i * 5 + 3) % layerSize}) {
+                    if (std::find(predecessors[node].begin(), predecessors[node].end(), predecessor) == predecessors[node].end()) {
+                        predecessors[node].push_back(predecessor);
+                        graph.addDependency(predecessor, node);
+                    }
+                }
+            }
+        }
+        graph.runAndWait();
+
+        uint64_t result = 0u;
+        for (auto i = 0u; i < layerSize; i++) {
+            result = result * 31 + values[(layersCount - 1) * layerSize + i];
+        }
+        if (repetition == 0) {
+            expectedResult = result;
+        }
+        EXPECT_EQ(expectedResult, result);
+    }
+}
+
+TEST(TaskGraphTests, givenCompletedGraphWhenRunAgainThenAllNodesAreExecutedAgain) {
+    BackgroundWorkerController controller{2};
+    std::atomic<int> executedCount{0};
+    TaskGraph graph{controller};
+    const auto root = graph.addNode([&executedCount]() { executedCount++; });
+    for (int i = 0; i < 10; i++) {
+        graph.addDependency(root, graph.addNode([&executedCount]() { executedCount++; }));
+    }
+
+    graph.runAndWait();
+    EXPECT_EQ(11, executedCount.load());
+    graph.runAndWait();
+    EXPECT_EQ(22, executedCount.load());
+}
+
+TEST(TaskGraphTests, givenGraphWaitedFromWorkerWhenOnlyOneWorkerThenItDoesNotDeadlock) {
+    BackgroundWorkerController controller{1};
+    std::atomic<int> executedCount{0};
+    std::atomic_bool outerTaskCompleted{false};
+    controller.pushTask([&]() {
+        TaskGraph graph{controller};
+        const auto first = graph.addNode([&executedCount]() { executedCount++; });
+        const auto second = graph.addNode([&executedCount]() { executedCount++; });
+        graph.addDependency(first, second);
+        graph.runAndWait();
+    }, outerTaskCompleted);
+
+    while (!outerTaskCompleted.load()) {
+        std::this_thread::yield();
+    }
+    EXPECT_EQ(2, executedCount.load());
+}
+
+TEST(TaskGraphTests, givenUnrelatedTasksQueuedWhenGraphIsWaitedFromWorkerThenOnlyNodesOfTheGraphAreExecuted) {
+    BackgroundWorkerController controller{1};
+    std::atomic_bool unrelatedTaskExecuted{false};
+    std::atomic_bool unrelatedTaskExecutedDuringWait{true};
+    std::atomic_bool outerTaskCompleted{false};
+    controller.pushTask([&]() {
+        controller.pushTask([&unrelatedTaskExecuted]() { unrelatedTaskExecuted = true; });
+        TaskGraph graph{controller};
+        const auto first = graph.addNode([]() {});
+        graph.addDependency(first, graph.addNode([]() {}));
+        graph.runAndWait();
+        unrelatedTaskExecutedDuringWait = unrelatedTaskExecuted.load();
+    }, outerTaskCompleted);
+
+    while (!outerTaskCompleted.load() || !unrelatedTaskExecuted.load()) {
+        std::this_thread::yield();
+    }
+    EXPECT_FALSE(unrelatedTaskExecutedDuringWait.load());
+}
+
+TEST(TaskGraphTests, givenGraphCreatedByTaskWhenNoPriorityGivenThenNodesInheritPriorityOfTheTask) {
+    BackgroundWorkerController controller{1};
+    std::atomic<TaskPriority> nodePriority{TaskPriority::NORMAL};
+    std::atomic_bool outerTaskCompleted{false};
+    controller.pushTask(BackgroundWorker::TaskData{[&]() {
+                                                       TaskGraph graph{controller};
+                                                       graph.addNode([&nodePriority]() { nodePriority = BackgroundWorker::getCurrentTaskPriority(); });
+                                                       graph.runAndWait();
+                                                   },
+                                                   nullptr, &outerTaskCompleted, TaskPriority::BACKGROUND});
+
+    while (!outerTaskCompleted.load()) {
+        std::this_thread::yield();
+    }
+    EXPECT_EQ(TaskPriority::BACKGROUND, nodePriority.load());
+}
@@ -0,0 +1,59 @@
+#include "Threading/Task.h"
+
+#include <array>
+#include <gtest/gtest.h>
+#include <memory>
+
+TEST(TaskTests, givenSmallCallableWhenCreatingTaskThenItIsStoredInlineAndCanBeCalled) {
+    int calls = 0;
+    Task task{[&calls]() { calls++; }};
+    ASSERT_TRUE(static_cast<bool>(task));
+    EXPECT_TRUE(task.isStoredInline());
+    task();
+    task();
+    EXPECT_EQ(2, calls);
+}
+
+TEST(TaskTests, givenBigCallableWhenCreatingTaskThenItIsStoredOnHeapAndCanBeCalled) {
+    std::array<int, 32> values{};
+    values[31] = 5;
+    int result = 0;
+    Task task{[values, &result]() { result = values[31]; }};
+    EXPECT_FALSE(task.isStoredInline());
+    task();
+    EXPECT_EQ(5, result);
+}
+
+TEST(TaskTests, givenTaskWhenMovingItThenCallableIsMovedAndSourceIsEmpty) {
+    auto counter = std::make_shared<int>(0);
+    Task inlineTask{[counter]() { (*counter)++; }};
+    std::array<int, 32> padding{};
+    Task heapTask{[counter, padding]() { (*counter) += 10 + padding[0]; }};
+    EXPECT_EQ(3, counter.use_count());
+
+    Task movedInlineTask{std::move(inlineTask)};
+    Task movedHeapTask{};
+    movedHeapTask = std::move(heapTask);
+    EXPECT_FALSE(static_cast<bool>(inlineTask));
+    EXPECT_FALSE(static_cast<bool>(heapTask));
+    EXPECT_EQ(3, counter.use_count());
+
+    movedInlineTask();
+    movedHeapTask();
+    EXPECT_EQ(11, *counter);
+}
+
+TEST(TaskTests, givenTaskWhenResettingOrDestroyingItThenCallableIsDestroyed) {
+    auto counter = std::make_shared<int>(0);
+    {
+        Task task{[counter]() {}};
+        EXPECT_EQ(2, counter.use_count());
+        task.reset();
+        EXPECT_FALSE(static_cast<bool>(task));
+        EXPECT_EQ(1, counter.use_count());
+
+        task = Task{[counter]() {}};
+        EXPECT_EQ(2, counter.use_count());
+    }
+    EXPECT_EQ(1, counter.use_count());
+}
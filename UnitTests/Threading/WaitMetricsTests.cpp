@@ -0,0 +1,54 @@
+#include "Threading/WaitMetrics.h"
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+TEST(WaitMetricsTests, givenNoWaitsRecordedWhenGettingSummaryThenItIsEmpty) {
+    WaitMetrics metrics{};
+    const WaitMetrics::Summary summary = metrics.getSummary(WaitMetrics::Category::SHUTDOWN);
+    EXPECT_EQ(0u, summary.waitsCount);
+    EXPECT_EQ(0, summary.totalDuration.count());
+    EXPECT_EQ(0, summary.maxDuration.count());
+}
+
+TEST(WaitMetricsTests, givenWaitsRecordedWhenGettingSummaryThenTheyAreAccumulatedPerCategory) {
+    WaitMetrics metrics{};
+    metrics.record(WaitMetrics::Category::ASSET_UNLOAD, std::chrono::microseconds{30});
+    metrics.record(WaitMetrics::Category::ASSET_UNLOAD, std::chrono::microseconds{50});
+    metrics.record(WaitMetrics::Category::ASSET_UNLOAD, std::chrono::microseconds{20});
+    metrics.record(WaitMetrics::Category::SHUTDOWN, std::chrono::microseconds{7});
+
+    const WaitMetrics::Summary unloadSummary = metrics.getSummary(WaitMetrics::Category::ASSET_UNLOAD);
+    EXPECT_EQ(3u, unloadSummary.waitsCount);
+    EXPECT_EQ(100, unloadSummary.totalDuration.count());
+    EXPECT_EQ(50, unloadSummary.maxDuration.count());
+
+    const WaitMetrics::Summary shutdownSummary = metrics.getSummary(WaitMetrics::Category::SHUTDOWN);
+    EXPECT_EQ(1u, shutdownSummary.waitsCount);
+    EXPECT_EQ(7, shutdownSummary.totalDuration.count());
+    EXPECT_EQ(7, shutdownSummary.maxDuration.count());
+}
+
+TEST(WaitMetricsTests, givenWaitsRecordedConcurrentlyWhenGettingSummaryThenNoneIsLost) {
+    WaitMetrics metrics{};
+    constexpr int threadsCount = 4;
+    constexpr int waitsPerThread = 10000;
+    std::vector<std::thread> threads{};
+    for (int threadIndex = 0; threadIndex < threadsCount; threadIndex++) {
+        threads.emplace_back([&metrics, threadIndex]() {
+            for (int i = 0; i < waitsPerThread; i++) {
+                metrics.record(WaitMetrics::Category::ASSET_UNLOAD, std::chrono::microseconds{threadIndex * waitsPerThread + i});
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    const WaitMetrics::Summary summary = metrics.getSummary(WaitMetrics::Category::ASSET_UNLOAD);
+    constexpr uint64_t waitsCount = threadsCount * waitsPerThread;
+    EXPECT_EQ(waitsCount, summary.waitsCount);
+    EXPECT_EQ(static_cast<int64_t>(waitsCount * (waitsCount - 1) / 2), summary.totalDuration.count());
+    EXPECT_EQ(static_cast<int64_t>(waitsCount - 1), summary.maxDuration.count());
+}
@@ -0,0 +1,95 @@
+#include "Threading/WorkStealingDeque.h"
+
+#include <algorithm>
+#include <atomic>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+TEST(WorkStealingDequeTests, givenPushedElementsWhenPoppingThenTheyAreReturnedInLifoOrder) {
+    WorkStealingDeque<int> deque{4};
+    for (int i = 0; i < 3; i++) {
+        deque.push(i);
+    }
+    EXPECT_EQ(3u, deque.getSizeApproximation());
+
+    int value{};
+    for (int i = 2; i >= 0; i--) {
+        ASSERT_TRUE(deque.pop(value));
+        EXPECT_EQ(i, value);
+    }
+    EXPECT_FALSE(deque.pop(value));
+    EXPECT_EQ(0u, deque.getSizeApproximation());
+}
+
+TEST(WorkStealingDequeTests, givenPushedElementsWhenStealingThenTheyAreReturnedInFifoOrder) {
+    WorkStealingDeque<int> deque{4};
+    for (int i = 0; i < 3; i++) {
+        deque.push(i);
+    }
+
+    int value{};
+    ASSERT_TRUE(deque.steal(value));
+    EXPECT_EQ(0, value);
+    ASSERT_TRUE(deque.pop(value));
+    EXPECT_EQ(2, value);
+    ASSERT_TRUE(deque.steal(value));
+    EXPECT_EQ(1, value);
+    EXPECT_FALSE(deque.steal(value));
+    EXPECT_FALSE(deque.pop(value));
+}
+
+TEST(WorkStealingDequeTests, givenMoreElementsThanCapacityWhenPushingThenDequeGrowsAndKeepsAllElements) {
+    WorkStealingDeque<int> deque{2};
+    int value{};
+    deque.push(-1);
+    ASSERT_TRUE(deque.steal(value)); // moves the top, so the copied range wraps around the buffer
+    for (int i = 0; i < 10; i++) {
+        deque.push(i);
+    }
+    EXPECT_EQ(16u, deque.getCapacity());
+    EXPECT_EQ(10u, deque.getSizeApproximation());
+
+    for (int i = 0; i < 10; i++) {
+        ASSERT_TRUE(deque.steal(value));
+        EXPECT_EQ(i, value);
+    }
+}
+
+TEST(WorkStealingDequeTests, givenOwnerAndThievesWorkingConcurrentlyThenEveryElementIsTakenExactlyOnce) {
+    constexpr int elementsCount = 200000;
+    constexpr int thievesCount = 3;
+    WorkStealingDeque<int> deque{64};
+    std::vector<std::atomic<int>> takenCounts(elementsCount);
+    std::atomic_bool ownerDone{false};
+
+    std::vector<std::thread> thieves{};
+    for (int thiefIndex = 0; thiefIndex < thievesCount; thiefIndex++) {
+        thieves.emplace_back([&]() {
+            int value{};
+            while (!ownerDone.load() || deque.getSizeApproximation() > 0u) {
+                if (deque.steal(value)) {
+                    takenCounts[value]++;
+                }
+            }
+        });
+    }
+
+    // Owner interleaves pushes with pops, so it races with thieves for the last elements
+    int value{};
+    for (int i = 0; i < elementsCount; i++) {
+        deque.push(i);
+        if (i % 3 == 0 && deque.pop(value)) {
+            takenCounts[value]++;
+        }
+    }
+    while (deque.pop(value)) {
+        takenCounts[value]++;
+    }
+    ownerDone.store(true);
+    for (std::thread &thief : thieves) {
+        thief.join();
+    }
+
+    EXPECT_TRUE(std::all_of(takenCounts.begin(), takenCounts.end(), [](const std::atomic<int> &count) { return count.load() == 1; }));
+}
@@ -0,0 +1,77 @@
+#include "Utility/AssetCache.h"
+
+#include <gtest/gtest.h>
+
+namespace {
+struct MockAsset {
+    int id;
+    bool failed = false;
+};
+
+struct AssetCacheTests : ::testing::Test {
+    std::shared_ptr<MockAsset> getOrCreate(const std::wstring &path, UINT flags, bool &outCreated) {
+        auto factory = [this]() { return std::make_shared<MockAsset>(MockAsset{createdAssetsCount++}); };
+        auto isReusable = [](const MockAsset &asset) { return !asset.failed; };
+        return cache.getOrCreate(AssetCache<MockAsset>::Key{path, flags}, factory, isReusable, outCreated);
+    }
+
+    AssetCache<MockAsset> cache{};
+    int createdAssetsCount = 0;
+};
+} // namespace
+
+TEST_F(AssetCacheTests, givenEmptyCacheWhenGettingAssetThenCreateIt) {
+    bool created{};
+    auto asset = getOrCreate(L"a.obj", 0u, created);
+    ASSERT_NE(nullptr, asset);
+    EXPECT_TRUE(created);
+    EXPECT_EQ(0, asset->id);
+    EXPECT_EQ(1u, cache.getAssetsCount());
+}
+
+TEST_F(AssetCacheTests, givenAliveAssetWhenGettingItAgainThenReturnTheSameInstance) {
+    bool created{};
+    auto asset1 = getOrCreate(L"a.obj", 0u, created);
+    auto asset2 = getOrCreate(L"a.obj", 0u, created);
+    EXPECT_FALSE(created);
+    EXPECT_EQ(asset1, asset2);
+    EXPECT_EQ(1, createdAssetsCount);
+    EXPECT_EQ(1u, cache.getAssetsCount());
+}
+
+TEST_F(AssetCacheTests, givenDifferentPathsOrFlagsWhenGettingAssetsThenCreateSeparateInstances) {
+    bool created{};
+    auto asset1 = getOrCreate(L"a.obj", 0u, created);
+    auto asset2 = getOrCreate(L"b.obj", 0u, created);
+    EXPECT_TRUE(created);
+    auto asset3 = getOrCreate(L"a.obj", 1u, created);
+    EXPECT_TRUE(created);
+    EXPECT_NE(asset1, asset2);
+    EXPECT_NE(asset1, asset3);
+    EXPECT_EQ(3u, cache.getAssetsCount());
+}
+
+TEST_F(AssetCacheTests, givenReleasedAssetWhenGettingItAgainThenCreateNewInstance) {
+    bool created{};
+    auto asset = getOrCreate(L"a.obj", 0u, created);
+    asset.reset();
+    EXPECT_EQ(0u, cache.getAssetsCount());
+
+    asset = getOrCreate(L"a.obj", 0u, created);
+    EXPECT_TRUE(created);
+    EXPECT_EQ(1, asset->id);
+}
+
+TEST_F(AssetCacheTests, givenNotReusableAssetWhenGettingItAgainThenReplaceIt) {
+    bool created{};
+    auto failedAsset = getOrCreate(L"a.obj", 0u, created);
+    failedAsset->failed = true;
+
+    auto asset = getOrCreate(L"a.obj", 0u, created);
+    EXPECT_TRUE(created);
+    EXPECT_NE(failedAsset, asset);
+
+    auto sameAsset = getOrCreate(L"a.obj", 0u, created);
+    EXPECT_FALSE(created);
+    EXPECT_EQ(asset, sameAsset);
+}
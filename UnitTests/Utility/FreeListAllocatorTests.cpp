@@ -0,0 +1,114 @@
+#include "Utility/FreeListAllocator.h"
+
+#include <gtest/gtest.h>
+#include <vector>
+
+TEST(FreeListAllocatorTests, givenEmptyAllocatorWhenAllocatingThenReturnConsecutiveRanges) {
+    FreeListAllocator allocator{100};
+    UINT64 offset1{}, offset2{};
+    ASSERT_TRUE(allocator.allocate(30, 1, offset1));
+    ASSERT_TRUE(allocator.allocate(50, 1, offset2));
+    EXPECT_EQ(0u, offset1);
+    EXPECT_EQ(30u, offset2);
+    EXPECT_EQ(20u, allocator.getFreeSize());
+    EXPECT_EQ(20u, allocator.getLargestFreeRangeSize());
+    EXPECT_FALSE(allocator.isEmpty());
+}
+
+TEST(FreeListAllocatorTests, givenNotEnoughSpaceWhenAllocatingThenFailAndKeepOffset) {
+    FreeListAllocator allocator{100};
+    UINT64 offset{};
+    ASSERT_TRUE(allocator.allocate(60, 1, offset));
+
+    offset = 12345u;
+    EXPECT_FALSE(allocator.allocate(41, 1, offset));
+    EXPECT_EQ(12345u, offset);
+    EXPECT_TRUE(allocator.allocate(40, 1, offset));
+    EXPECT_EQ(0u, allocator.getFreeSize());
+    EXPECT_FALSE(allocator.allocate(1, 1, offset));
+}
+
+TEST(FreeListAllocatorTests, givenAlignmentWhenAllocatingThenOffsetIsItsMultipleAndPaddingStaysFree) {
+    FreeListAllocator allocator{100};
+    UINT64 offset{};
+    ASSERT_TRUE(allocator.allocate(3, 1, offset));
+
+    // Vertex strides are not always powers of two
+    ASSERT_TRUE(allocator.allocate(24, 12, offset));
+    EXPECT_EQ(12u, offset);
+    EXPECT_EQ(100u - 3u - 24u, allocator.getFreeSize());
+    EXPECT_EQ(2u, allocator.getFreeRangesCount());
+
+    // Padding can be used by a later allocation
+    ASSERT_TRUE(allocator.allocate(9, 1, offset));
+    EXPECT_EQ(3u, offset);
+}
+
+TEST(FreeListAllocatorTests, givenFragmentedSpaceWhenAllocatingThenUseFirstRangeBigEnough) {
+    FreeListAllocator allocator{100};
+    UINT64 offsets[5]{};
+    for (auto &offset : offsets) {
+        ASSERT_TRUE(allocator.allocate(20, 1, offset));
+    }
+    allocator.free(offsets[1], 20);
+    allocator.free(offsets[3], 20);
+    EXPECT_EQ(40u, allocator.getFreeSize());
+    EXPECT_EQ(20u, allocator.getLargestFreeRangeSize());
+
+    UINT64 offset{};
+    EXPECT_FALSE(allocator.allocate(30, 1, offset));
+    ASSERT_TRUE(allocator.allocate(10, 1, offset));
+    EXPECT_EQ(offsets[1], offset);
+}
+
+TEST(FreeListAllocatorTests, givenAdjacentFreeRangesWhenFreeingThenMergeThem) {
+    FreeListAllocator allocator{100};
+    UINT64 offsets[4]{};
+    for (auto &offset : offsets) {
+        ASSERT_TRUE(allocator.allocate(25, 1, offset));
+    }
+
+    allocator.free(offsets[0], 25);
+    allocator.free(offsets[2], 25);
+    EXPECT_EQ(2u, allocator.getFreeRangesCount());
+
+    allocator.free(offsets[1], 25); // merged with both neighbours
+    EXPECT_EQ(1u, allocator.getFreeRangesCount());
+    EXPECT_EQ(75u, allocator.getLargestFreeRangeSize());
+
+    allocator.free(offsets[3], 25); // merged with the preceding range
+    EXPECT_EQ(1u, allocator.getFreeRangesCount());
+    EXPECT_TRUE(allocator.isEmpty());
+
+    UINT64 offset{};
+    EXPECT_TRUE(allocator.allocate(100, 1, offset));
+}
+
+TEST(FreeListAllocatorTests, givenRandomAllocationsAndFreesWhenAllOfThemAreFreedThenSpaceIsNotFragmented) {
+    FreeListAllocator allocator{1000};
+    std::vector<std::pair<UINT64, UINT64>> allocations{};
+    UINT seed = 7u;
+    for (auto i = 0; i < 500; i++) {
+        seed = seed * 1103515245u + 12345u;
+        const UINT64 size = 1 + (seed >> 16) % 50;
+        const UINT64 alignment = 1 + (seed >> 8) % 8;
+        UINT64 offset{};
+        if ((seed & 0x3) != 0 && allocator.allocate(size, alignment, offset)) {
+            EXPECT_EQ(0u, offset % alignment);
+            for (const auto &allocation : allocations) {
+                EXPECT_TRUE(offset + size <= allocation.first || allocation.first + allocation.second <= offset);
+            }
+            allocations.emplace_back(offset, size);
+        } else if (!allocations.empty()) {
+            const auto index = (seed >> 4) % allocations.size();
+            allocator.free(allocations[index].first, allocations[index].second);
+            allocations.erase(allocations.begin() + index);
+        }
+    }
+
+    for (const auto &allocation : allocations) {
+        allocator.free(allocation.first, allocation.second);
+    }
+    EXPECT_TRUE(allocator.isEmpty());
+    EXPECT_EQ(1u, allocator.getFreeRangesCount());
+}
@@ -68,4 +68,23 @@ TEST(MathHelperTests, givenInputsToClampThenItReturnsCorrectResults) {
     EXPECT_EQ(max, MathHelper::clamp(max, min, max));
     EXPECT_EQ(max, MathHelper::clamp(21, min, max));
     EXPECT_EQ(max, MathHelper::clamp(26, min, max));
-}
\ No newline at end of file
+}
+
+TEST(MathHelperTests, givenRotatedAndTranslatedBoxWhenTransformingBoundingBoxThenResultIsAxisAlignedBoxAroundIt) {
+    const XMMATRIX matrix = XMMatrixMultiply(XMMatrixRotationZ(XM_PIDIV2), XMMatrixTranslation(10, 0, 0));
+    XMFLOAT3 min{}, max{};
+    MathHelper::transformBoundingBox(XMFLOAT3{-1, -2, -3}, XMFLOAT3{1, 2, 3}, matrix, min, max);
+
+    // Rotation by 90 degrees swaps x and y extents
+    EXPECT_NEAR(8.f, min.x, 1e-5f);
+    EXPECT_NEAR(-1.f, min.y, 1e-5f);
+    EXPECT_NEAR(-3.f, min.z, 1e-5f);
+    EXPECT_NEAR(12.f, max.x, 1e-5f);
+    EXPECT_NEAR(1.f, max.y, 1e-5f);
+    EXPECT_NEAR(3.f, max.z, 1e-5f);
+}
+
+TEST(MathHelperTests, givenRotatedNonUniformScaleWhenGettingMaxScaleThenReturnLargestScaleFactor) {
+    const XMMATRIX matrix = XMMatrixMultiply(XMMatrixScaling(2, 5, 3), XMMatrixRotationY(0.3f));
+    EXPECT_NEAR(5.f, MathHelper::getMaxScale(matrix), 1e-5f);
+}